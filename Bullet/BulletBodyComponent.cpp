@@ -158,7 +158,7 @@ void DoPreProcessPhysics( BulletBodyComponent *pBodyComponent, Helium::Transform
 	}
 };
 
-HELIUM_DEFINE_TASK( PreProcessPhysics, (ForEachWorld< QueryComponents< BulletBodyComponent, TransformComponent, DoPreProcessPhysics > >), TickTypes::Gameplay )
+HELIUM_DEFINE_TASK( PreProcessPhysics, (ForEachWorld< ParallelQueryComponents< BulletBodyComponent, TransformComponent, DoPreProcessPhysics > >), TickTypes::Gameplay )
 
 void PreProcessPhysics::DefineContract( Helium::TaskContract &rContract )
 {
@@ -200,7 +200,7 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 			worldBounds.TransformBy( transform );
 		}
 
-		pSceneObject->SetWorldBounds( worldBounds );
+		pScene->SetSceneObjectWorldBounds( graphicsSceneObjectId, worldBounds );
 
 		return;
 	}
@@ -216,7 +216,7 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		worldBounds.TransformBy( transform );
 	}
 
-	pSceneObject->SetWorldBounds( worldBounds );
+	pScene->SetSceneObjectWorldBounds( graphicsSceneObjectId, worldBounds );
 
 	const DynamicArray< size_t >& rSubMeshDataIds = pThis->m_graphicsSceneObjectSubMeshDataIds;
 	size_t subMeshCount = rSubMeshDataIds.GetSize();
@@ -224,8 +224,8 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 
 	if( !pVertexBuffer || !pIndexBuffer )
 	{
-		pSceneObject->SetVertexData( NULL, NULL, 0 );
-		pSceneObject->SetIndexBuffer( NULL );
+		pScene->SetSceneObjectVertexData( graphicsSceneObjectId, NULL, NULL, 0 );
+		pScene->SetSceneObjectIndexBuffer( graphicsSceneObjectId, NULL );
 	}
 	else
 	{
@@ -244,8 +244,8 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 			vertexStride = static_cast< uint32_t >( sizeof( StaticMeshVertex< 1 > ) );
 		}
 
-		pSceneObject->SetVertexData( pVertexBuffer, pVertexDescription, vertexStride );
-		pSceneObject->SetIndexBuffer( pIndexBuffer );
+		pScene->SetSceneObjectVertexData( graphicsSceneObjectId, pVertexBuffer, pVertexDescription, vertexStride );
+		pScene->SetSceneObjectIndexBuffer( graphicsSceneObjectId, pIndexBuffer );
 
 		meshSectionCount = pMesh->GetSectionCount();
 		if( meshSectionCount > subMeshCount )
@@ -257,19 +257,21 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		uint32_t sectionIndexOffset = 0;
 		for( size_t meshSectionIndex = 0; meshSectionIndex < meshSectionCount; ++meshSectionIndex )
 		{
-			GraphicsSceneObject::SubMeshData* pSubMeshData = pScene->GetSceneObjectSubMeshData(
-				rSubMeshDataIds[ meshSectionIndex ] );
+			size_t subMeshDataId = rSubMeshDataIds[ meshSectionIndex ];
+			GraphicsSceneObject::SubMeshData* pSubMeshData = pScene->GetSceneObjectSubMeshData( subMeshDataId );
 			HELIUM_ASSERT( pSubMeshData );
 
 			uint32_t vertexCount = pMesh->GetSectionVertexCount( meshSectionIndex );
 			uint32_t triangleCount = pMesh->GetSectionTriangleCount( meshSectionIndex );
 
 			pSubMeshData->SetMaterial( pThis->GetMaterial( meshSectionIndex ) );
-			pSubMeshData->SetPrimitiveType( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST );
-			pSubMeshData->SetPrimitiveCount( triangleCount );
-			pSubMeshData->SetStartVertex( sectionVertexOffset );
-			pSubMeshData->SetVertexRange( vertexCount );
-			pSubMeshData->SetStartIndex( sectionIndexOffset );
+			pScene->SetSceneObjectSubMeshPrimitives(
+				subMeshDataId,
+				RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST,
+				triangleCount,
+				sectionVertexOffset,
+				vertexCount,
+				sectionIndexOffset );
 
 			sectionVertexOffset += vertexCount;
 			sectionIndexOffset += triangleCount * 3;
@@ -278,16 +280,12 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 
 	for( size_t unusedSubMeshIndex = meshSectionCount; unusedSubMeshIndex < subMeshCount; ++unusedSubMeshIndex )
 	{
-		GraphicsSceneObject::SubMeshData* pSubMeshData = pScene->GetSceneObjectSubMeshData(
-			rSubMeshDataIds[ unusedSubMeshIndex ] );
+		size_t subMeshDataId = rSubMeshDataIds[ unusedSubMeshIndex ];
+		GraphicsSceneObject::SubMeshData* pSubMeshData = pScene->GetSceneObjectSubMeshData( subMeshDataId );
 		HELIUM_ASSERT( pSubMeshData );
 
 		pSubMeshData->SetMaterial( NULL );
-		pSubMeshData->SetPrimitiveType( RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST );
-		pSubMeshData->SetPrimitiveCount( 0 );
-		pSubMeshData->SetStartVertex( 0 );
-		pSubMeshData->SetVertexRange( 0 );
-		pSubMeshData->SetStartIndex( 0 );
+		pScene->SetSceneObjectSubMeshPrimitives( subMeshDataId, RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST, 0, 0, 0, 0 );
 	}
 }
 
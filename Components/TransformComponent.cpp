@@ -57,6 +57,8 @@ void ClearTransformComponentDirtyFlags( TransformComponent *pComponent )
 void Helium::ClearTransformComponentDirtyFlagsTask::DefineContract( TaskContract &rContract )
 {
 	rContract.ExecuteAfter<StandardDependencies::Render>();
+	rContract.WritesComponents<TransformComponent>();
+	rContract.RunsPerWorld();
 }
 
 //HELIUM_DEFINE_TASK(ClearTransformComponentDirtyFlagsTask, ForEachWorld<ClearTransformComponentDirtyFlags> )
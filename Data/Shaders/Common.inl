@@ -50,6 +50,11 @@ struct ViewPixelConstantBasePassData
 
     /// Inverse shadow map resolution (z & w components are unused).
     float4 inverseShadowMapResolution;
+
+    /// Scale (xy) and offset (zw) from the first shadow cascade's UV space to each cascade's shadow map tile.
+    float4 shadowCascadeUvScaleOffsets[ 4 ];
+    /// View depth at which each shadow cascade ends.
+    float4 shadowCascadeSplitDepths;
 };
 
 /// Per-instance vertex shader constant data for all passes.
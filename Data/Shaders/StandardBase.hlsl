@@ -9,7 +9,7 @@
 //! @toggle_p NORMAL_MAP
 //! @select SPECULAR NONE SPECULAR_DIFFUSE_ALPHA SPECULAR_MAP
 //! @sysselect_v SKINNING NONE SKINNING_SMOOTH SKINNING_RIGID
-//! @sysselect SHADOWS NONE SHADOWS_SIMPLE SHADOWS_PCF_DITHERED
+//! @sysselect SHADOWS NONE SHADOWS_SIMPLE SHADOWS_PCF_DITHERED SHADOWS_CASCADED
 
 #include "Common.inl"
 
@@ -29,7 +29,7 @@ struct VertexOutput
 #if SHADOWS
     float3 shadowPos          : TEXCOORD4;
 #endif
-#if SHADOWS_PCF_DITHERED
+#if SHADOWS_PCF_DITHERED || SHADOWS_CASCADED
     float3 screenPos          : TEXCOORD5;
 #endif
 };
@@ -122,7 +122,7 @@ float4 main( VertexInput vIn, out VertexOutput vOut ) : POSITION
     
     float4 outPosition = mul( worldInvViewProjection, localPosition );
 
-#if SHADOWS_PCF_DITHERED
+#if SHADOWS_PCF_DITHERED || SHADOWS_CASCADED
     vOut.screenPos =
 		float3( ( outPosition.xy + outPosition.ww ) * ViewPassData.screenPointAdjustments.xy + 0.5 * outPosition.w, outPosition.w );
 #endif
@@ -187,15 +187,15 @@ cbuffer ViewPassData
 cbuffer MaterialParameters
 {
 #if NORMAL_MAP
-    float NormalMapHeightScale : register( c4 );
+    float NormalMapHeightScale : register( c9 );
 #endif
 
 #if SPECULAR
-    float SpecularExponent : register( c5 );
+    float SpecularExponent : register( c10 );
 #endif
 }
 
-#if SHADOWS_PCF_DITHERED
+#if SHADOWS_PCF_DITHERED || SHADOWS_CASCADED
 static const float4 PCF_BASE_KERNEL[] =
 {
 	float4( -1.5f,  0.5f, 0.5f, -1.5f ),
@@ -236,7 +236,18 @@ float4 main( VertexOutput vOut ) : SV_Target
 #else
 	shadow = half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xyz, 1 ) ).r );
 #endif
-#elif SHADOWS_PCF_DITHERED
+#elif SHADOWS_PCF_DITHERED || SHADOWS_CASCADED
+	float3 shadowPos = vOut.shadowPos;
+#if SHADOWS_CASCADED
+	// Select the cascade covering the pixel's view depth and map the shadow position into its shadow map tile.
+	float4 cascadeSteps = step( ViewPassData.shadowCascadeSplitDepths, vOut.screenPos.zzzz );
+	float4 cascadeUvScaleOffset = ViewPassData.shadowCascadeUvScaleOffsets[ 0 ];
+	cascadeUvScaleOffset = lerp( cascadeUvScaleOffset, ViewPassData.shadowCascadeUvScaleOffsets[ 1 ], cascadeSteps.x );
+	cascadeUvScaleOffset = lerp( cascadeUvScaleOffset, ViewPassData.shadowCascadeUvScaleOffsets[ 2 ], cascadeSteps.y );
+	cascadeUvScaleOffset = lerp( cascadeUvScaleOffset, ViewPassData.shadowCascadeUvScaleOffsets[ 3 ], cascadeSteps.z );
+	shadowPos.xy = shadowPos.xy * cascadeUvScaleOffset.xy + cascadeUvScaleOffset.zw;
+#endif
+
 	float2 screenPos = vOut.screenPos.xy / vOut.screenPos.z;
 	float2 pcfDitherOffset = float2( frac( screenPos * 0.5 ) > 0.5 );
 	pcfDitherOffset.y = float( frac( dot( pcfDitherOffset, float2( 0.5, 0.5 ) ) ) > 0.25 );
@@ -253,18 +264,21 @@ float4 main( VertexOutput vOut ) : SV_Target
 
 #if HELIUM_PROFILE_PC_SM4
 	half4 shadowComponents = half4(
-		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy + pcfOffsets[ 0 ].xy, vOut.shadowPos.z ) ),
-		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy + pcfOffsets[ 0 ].zw, vOut.shadowPos.z ) ),
-		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy + pcfOffsets[ 1 ].xy, vOut.shadowPos.z ) ),
-		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy + pcfOffsets[ 1 ].zw, vOut.shadowPos.z ) ) );
+		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy + pcfOffsets[ 0 ].xy, shadowPos.z ) ),
+		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy + pcfOffsets[ 0 ].zw, shadowPos.z ) ),
+		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy + pcfOffsets[ 1 ].xy, shadowPos.z ) ),
+		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy + pcfOffsets[ 1 ].zw, shadowPos.z ) ) );
 #else
 	half4 shadowComponents = half4(
-		half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xy + pcfOffsets[ 0 ].xy, vOut.shadowPos.z, 1 ) ).r ),
-		half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xy + pcfOffsets[ 0 ].zw, vOut.shadowPos.z, 1 ) ).r ),
-		half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xy + pcfOffsets[ 1 ].xy, vOut.shadowPos.z, 1 ) ).r ),
-		half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xy + pcfOffsets[ 1 ].zw, vOut.shadowPos.z, 1 ) ).r ) );
+		half( tex2Dproj( _ShadowMap, half4( shadowPos.xy + pcfOffsets[ 0 ].xy, shadowPos.z, 1 ) ).r ),
+		half( tex2Dproj( _ShadowMap, half4( shadowPos.xy + pcfOffsets[ 0 ].zw, shadowPos.z, 1 ) ).r ),
+		half( tex2Dproj( _ShadowMap, half4( shadowPos.xy + pcfOffsets[ 1 ].xy, shadowPos.z, 1 ) ).r ),
+		half( tex2Dproj( _ShadowMap, half4( shadowPos.xy + pcfOffsets[ 1 ].zw, shadowPos.z, 1 ) ).r ) );
 #endif
 	shadow = dot( shadowComponents, half4( 0.25, 0.25, 0.25, 0.25 ) );
+#if SHADOWS_CASCADED
+	shadow = lerp( shadow, half( 1.0 ), half( cascadeSteps.w ) );
+#endif
 #endif
 
     half3 toDirectionalLight = half3( normalize( vOut.toDirectionalLight ) );
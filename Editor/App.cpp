@@ -21,6 +21,9 @@
 #include "Application/DocumentManager.h"
 
 #include "Engine/FileLocations.h"
+#include "Engine/AssetLoadProfiler.h"
+#include "Engine/AsyncDeserializer.h"
+#include "Engine/JobManager.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/AssetLoader.h"
 #include "Engine/CacheManager.h"
@@ -60,6 +63,7 @@
 #include "Editor/Vault/VaultSettings.h"
 
 #include "Editor/Commands/ProfileDumpCommand.h"
+#include "Editor/Commands/CacheCompactCommand.h"
 
 #include "Editor/Clipboard/ClipboardDataWrapper.h"
 #include "Editor/Clipboard/ClipboardFileList.h"
@@ -225,6 +229,19 @@ bool App::OnInit()
 	HELIUM_VERIFY( asyncLoader.Initialize() );
 	m_InitializerStack.Push( AsyncLoader::DestroyStaticInstance );
 
+	// Async object deserialization.
+	AsyncDeserializer& asyncDeserializer = AsyncDeserializer::GetStaticInstance();
+	HELIUM_VERIFY( asyncDeserializer.Initialize() );
+	m_InitializerStack.Push( AsyncDeserializer::DestroyStaticInstance );
+
+	// Job worker threads.
+	JobManager& jobManager = JobManager::GetStaticInstance();
+	HELIUM_VERIFY( jobManager.Initialize() );
+	m_InitializerStack.Push( JobManager::DestroyStaticInstance );
+
+	// Asset load profiling (disabled until explicitly enabled).
+	m_InitializerStack.Push( AssetLoadProfiler::DestroyStaticInstance );
+
 	// Asset cache management.
 	FilePath baseDirectory;
 	if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
@@ -628,6 +645,10 @@ int Main( int argc, const char** argv )
 	success &= profileDumpCommand.Initialize( error );
 	success &= processor.RegisterCommand( &profileDumpCommand, error );
 
+	CacheCompactCommand cacheCompactCommand;
+	success &= cacheCompactCommand.Initialize( error );
+	success &= processor.RegisterCommand( &cacheCompactCommand, error );
+
 	Helium::CommandLine::HelpCommand helpCommand;
 	helpCommand.SetOwner( &processor );
 	success &= helpCommand.Initialize( error );
@@ -0,0 +1,73 @@
+#include "EditorPch.h"
+#include "CacheCompactCommand.h"
+
+#include "Foundation/Log.h"
+
+#include "Engine/AsyncLoader.h"
+#include "Engine/Cache.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+
+CacheCompactCommand::CacheCompactCommand()
+	: Command( TXT( "cache-compact" ), TXT( "<TOC> <CACHE>" ), TXT( "Rewrite a cache file without the unused space left behind by updated entries" ) )
+{
+
+}
+
+bool CacheCompactCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	std::string tocFileName;
+	std::string cacheFileName;
+
+	if ( argsBegin != argsEnd )
+	{
+		tocFileName = (*argsBegin);
+		++argsBegin;
+	}
+
+	if ( argsBegin != argsEnd )
+	{
+		cacheFileName = (*argsBegin);
+		++argsBegin;
+	}
+
+	if ( tocFileName.empty() || cacheFileName.empty() )
+	{
+		error = TXT( "Both a TOC file and a cache file must be specified" );
+		return false;
+	}
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	if ( !rLoader.Initialize() )
+	{
+		error = TXT( "Failed to initialize the async loader" );
+		return false;
+	}
+
+	bool success = false;
+
+	Cache cache;
+	if ( !cache.Initialize( Name( TXT( "Compact" ) ), Cache::PLATFORM_PC, tocFileName.c_str(), cacheFileName.c_str() ) )
+	{
+		error = TXT( "Failed to initialize cache " ) + cacheFileName;
+	}
+	else
+	{
+		cache.EnforceTocLoad();
+
+		Log::Print( TXT( "Compacting %u entries in %s\n" ), cache.GetEntryCount(), cacheFileName.c_str() );
+
+		success = cache.Compact();
+		if ( !success )
+		{
+			error = TXT( "Failed to compact cache " ) + cacheFileName;
+		}
+
+		cache.Shutdown();
+	}
+
+	AsyncLoader::DestroyStaticInstance();
+
+	return success;
+}
@@ -0,0 +1,633 @@
+#include "EnginePch.h"
+#include "Engine/AssetLoadProfiler.h"
+
+#include "Platform/Timer.h"
+#include "Foundation/FileStream.h"
+
+#include <algorithm>
+
+using namespace Helium;
+
+AssetLoadProfiler* AssetLoadProfiler::sm_pInstance = NULL;
+
+/// Trace event names for the span of time leading up to each load stage (indexed by stage).
+static const char* const STAGE_SPAN_NAMES[ AssetLoadProfiler::STAGE_MAX ] =
+{
+	TXT( "Queued" ),
+	TXT( "Wait for I/O" ),
+	TXT( "I/O" ),
+	TXT( "Wait for deserialize" ),
+	TXT( "Deserialize" ),
+	TXT( "Publish" ),
+	TXT( "Link" ),
+	TXT( "Precache" ),
+	TXT( "Finalize" ),
+};
+
+/// Record index comparison functor for sorting records by decreasing total load time.
+class RecordLoadTimeCompare
+{
+public:
+	/// Constructor.
+	///
+	/// @param[in] rRecords  Records being sorted.
+	explicit RecordLoadTimeCompare( const DynamicArray< AssetLoadProfiler::Record >& rRecords )
+		: m_rRecords( rRecords )
+	{
+	}
+
+	/// Compare two records by total load time.
+	bool operator()( size_t index0, size_t index1 ) const
+	{
+		return ( m_rRecords[ index0 ].GetStageMilliseconds(
+			AssetLoadProfiler::STAGE_QUEUED,
+			AssetLoadProfiler::STAGE_LOADED ) > m_rRecords[ index1 ].GetStageMilliseconds(
+			AssetLoadProfiler::STAGE_QUEUED,
+			AssetLoadProfiler::STAGE_LOADED ) );
+	}
+
+private:
+	/// Records being sorted.
+	const DynamicArray< AssetLoadProfiler::Record >& m_rRecords;
+};
+
+/// Record index comparison functor for sorting records by decreasing I/O size.
+class RecordIoSizeCompare
+{
+public:
+	/// Constructor.
+	///
+	/// @param[in] rRecords  Records being sorted.
+	explicit RecordIoSizeCompare( const DynamicArray< AssetLoadProfiler::Record >& rRecords )
+		: m_rRecords( rRecords )
+	{
+	}
+
+	/// Compare two records by I/O size.
+	bool operator()( size_t index0, size_t index1 ) const
+	{
+		return ( m_rRecords[ index0 ].ioByteCount > m_rRecords[ index1 ].ioByteCount );
+	}
+
+private:
+	/// Records being sorted.
+	const DynamicArray< AssetLoadProfiler::Record >& m_rRecords;
+};
+
+/// Record index comparison functor for sorting records by decreasing dependency chain depth.
+class RecordDepthCompare
+{
+public:
+	/// Constructor.
+	///
+	/// @param[in] rDepths  Dependency chain depth of each record.
+	explicit RecordDepthCompare( const DynamicArray< uint32_t >& rDepths )
+		: m_rDepths( rDepths )
+	{
+	}
+
+	/// Compare two records by dependency chain depth.
+	bool operator()( size_t index0, size_t index1 ) const
+	{
+		return ( m_rDepths[ index0 ] > m_rDepths[ index1 ] );
+	}
+
+private:
+	/// Dependency chain depth of each record.
+	const DynamicArray< uint32_t >& m_rDepths;
+};
+
+/// Convert a timer tick count to microseconds.
+///
+/// @param[in] ticks  Tick count.
+///
+/// @return  Equivalent number of microseconds.
+static float64_t TicksToMicroseconds( uint64_t ticks )
+{
+	return static_cast< float64_t >( ticks ) * Timer::GetSecondsPerTick() * 1000000.0;
+}
+
+/// Append a string to a JSON document as a quoted string value, escaping characters as necessary.
+///
+/// @param[inout] rOutput  JSON document text.
+/// @param[in]    rText    String to append.
+static void AppendJsonString( String& rOutput, const String& rText )
+{
+	rOutput += TXT( '\"' );
+
+	size_t length = rText.GetSize();
+	for( size_t characterIndex = 0; characterIndex < length; ++characterIndex )
+	{
+		char character = rText[ characterIndex ];
+		if( character == TXT( '\"' ) || character == TXT( '\\' ) )
+		{
+			rOutput += TXT( '\\' );
+		}
+
+		rOutput += character;
+	}
+
+	rOutput += TXT( '\"' );
+}
+
+/// Constructor.
+AssetLoadProfiler::AssetLoadProfiler()
+	: m_bEnabled( false )
+{
+}
+
+/// Destructor.
+AssetLoadProfiler::~AssetLoadProfiler()
+{
+}
+
+/// Enable or disable recording of load events.
+///
+/// Loads already in flight when recording is enabled are recorded from the next stage they reach.
+///
+/// @param[in] bEnabled  True to record load events, false to ignore them.
+///
+/// @see IsEnabled()
+void AssetLoadProfiler::SetEnabled( bool bEnabled )
+{
+	MutexScopeLock scopeLock( m_lock );
+	m_bEnabled = bEnabled;
+}
+
+/// Discard all recorded load information.
+void AssetLoadProfiler::Reset()
+{
+	MutexScopeLock scopeLock( m_lock );
+	m_records.Clear();
+	m_recordMap.Clear();
+}
+
+/// Start recording a new load of the given asset.
+///
+/// @param[in] path  Asset path.
+///
+/// @see MarkStage()
+void AssetLoadProfiler::BeginRecord( AssetPath path )
+{
+	if( !m_bEnabled )
+	{
+		return;
+	}
+
+	uint64_t tickCount = Timer::GetTickCount();
+
+	MutexScopeLock scopeLock( m_lock );
+	Record* pRecord = GetRecord( path, true );
+	HELIUM_ASSERT( pRecord );
+	pRecord->stageTimes[ STAGE_QUEUED ] = tickCount;
+}
+
+/// Record the time at which a load reached the given stage.
+///
+/// @param[in] path       Asset path.
+/// @param[in] stage      Stage reached.
+/// @param[in] tickCount  Timer tick count at which the stage was reached, or zero to use the current time.
+///
+/// @see BeginRecord()
+void AssetLoadProfiler::MarkStage( AssetPath path, EStage stage, uint64_t tickCount )
+{
+	HELIUM_ASSERT( static_cast< size_t >( stage ) < static_cast< size_t >( STAGE_MAX ) );
+
+	if( !m_bEnabled )
+	{
+		return;
+	}
+
+	if( tickCount == 0 )
+	{
+		tickCount = Timer::GetTickCount();
+	}
+
+	MutexScopeLock scopeLock( m_lock );
+	Record* pRecord = GetRecord( path, false );
+	HELIUM_ASSERT( pRecord );
+	pRecord->stageTimes[ stage ] = tickCount;
+}
+
+/// Add to the number of bytes read from disk for the current load of an asset.
+///
+/// @param[in] path       Asset path.
+/// @param[in] byteCount  Number of bytes read.
+void AssetLoadProfiler::AddIoBytes( AssetPath path, uint64_t byteCount )
+{
+	if( !m_bEnabled )
+	{
+		return;
+	}
+
+	MutexScopeLock scopeLock( m_lock );
+	Record* pRecord = GetRecord( path, false );
+	HELIUM_ASSERT( pRecord );
+	pRecord->ioByteCount += byteCount;
+}
+
+/// Record that the current load of an asset references another asset.
+///
+/// @param[in] path            Asset path.
+/// @param[in] dependencyPath  Path of the referenced asset.
+void AssetLoadProfiler::AddDependency( AssetPath path, AssetPath dependencyPath )
+{
+	if( !m_bEnabled )
+	{
+		return;
+	}
+
+	MutexScopeLock scopeLock( m_lock );
+	Record* pRecord = GetRecord( path, false );
+	HELIUM_ASSERT( pRecord );
+	pRecord->dependencies.Push( dependencyPath );
+}
+
+/// Write the recorded load information to a file in the Chrome trace event format.
+///
+/// Each asset is shown as its own track, with a span for the time spent in each load stage.  The file can be opened
+/// in chrome://tracing or in the Perfetto UI.
+///
+/// @param[in] rFileName  Name of the file to write.
+///
+/// @return  True if the file was written successfully, false if not.
+bool AssetLoadProfiler::WriteChromeTrace( const String& rFileName ) const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	// Report all times relative to the earliest recorded event.
+	uint64_t baseTime = UINT64_MAX;
+	size_t recordCount = m_records.GetSize();
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		const Record& rRecord = m_records[ recordIndex ];
+		for( size_t stageIndex = 0; stageIndex < STAGE_MAX; ++stageIndex )
+		{
+			uint64_t stageTime = rRecord.stageTimes[ stageIndex ];
+			if( stageTime != 0 && stageTime < baseTime )
+			{
+				baseTime = stageTime;
+			}
+		}
+	}
+
+	String trace;
+	String event;
+	String pathString;
+
+	trace += TXT( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+
+	bool bFirstEvent = true;
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		const Record& rRecord = m_records[ recordIndex ];
+		rRecord.path.ToString( pathString );
+
+		// Name the track after the asset.
+		event.Format(
+			TXT( "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" ) PRIuSZ TXT( ",\"args\":{\"name\":" ),
+			( bFirstEvent ? TXT( "" ) : TXT( ",\n" ) ),
+			recordIndex + 1 );
+		trace += event;
+		AppendJsonString( trace, pathString );
+		trace += TXT( "}}" );
+		bFirstEvent = false;
+
+		uint64_t spanStartTime = rRecord.stageTimes[ STAGE_FIRST ];
+		for( size_t stageIndex = STAGE_FIRST + 1; stageIndex < STAGE_MAX; ++stageIndex )
+		{
+			uint64_t stageTime = rRecord.stageTimes[ stageIndex ];
+			if( stageTime == 0 )
+			{
+				continue;
+			}
+
+			if( spanStartTime != 0 )
+			{
+				uint64_t duration = ( stageTime > spanStartTime ? stageTime - spanStartTime : 0 );
+				event.Format(
+					( TXT( ",\n{\"name\":\"%s\",\"cat\":\"asset\",\"ph\":\"X\",\"pid\":1,\"tid\":%" ) PRIuSZ
+					TXT( ",\"ts\":%.3f,\"dur\":%.3f" ) ),
+					STAGE_SPAN_NAMES[ stageIndex ],
+					recordIndex + 1,
+					TicksToMicroseconds( spanStartTime - baseTime ),
+					TicksToMicroseconds( duration ) );
+				trace += event;
+
+				if( stageIndex == STAGE_IO_END )
+				{
+					event.Format( TXT( ",\"args\":{\"bytes\":%" ) PRIu64 TXT( "}" ), rRecord.ioByteCount );
+					trace += event;
+				}
+
+				trace += TXT( "}" );
+			}
+
+			spanStartTime = stageTime;
+		}
+	}
+
+	trace += TXT( "\n]}\n" );
+
+	FileStream* pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_WRITE, true );
+	if( !pStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "AssetLoadProfiler::WriteChromeTrace(): Failed to open \"%s\" for writing.\n" ),
+			*rFileName );
+
+		return false;
+	}
+
+	size_t traceSize = trace.GetSize();
+	size_t writeSize = pStream->Write( *trace, sizeof( char ), traceSize );
+	delete pStream;
+
+	if( writeSize != traceSize )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "AssetLoadProfiler::WriteChromeTrace(): Failed to write trace data to \"%s\".\n" ),
+			*rFileName );
+
+		return false;
+	}
+
+	return true;
+}
+
+/// Build a text summary of the recorded load information.
+///
+/// The summary lists the total time spent in I/O, deserialization, and waiting on dependencies across all loads,
+/// followed by the slowest loads, the deepest chains of asset references, and the loads that read the most data.
+///
+/// @param[out] rSummary    Summary text.
+/// @param[in]  entryLimit  Maximum number of entries to list in each section.
+void AssetLoadProfiler::BuildSummary( String& rSummary, size_t entryLimit ) const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	rSummary.Clear();
+
+	size_t recordCount = m_records.GetSize();
+
+	String line;
+	String pathString;
+
+	// Totals for each class of work.
+	float32_t ioTime = 0.0f;
+	float32_t deserializeTime = 0.0f;
+	float32_t dependencyWaitTime = 0.0f;
+	uint64_t ioByteCount = 0;
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		const Record& rRecord = m_records[ recordIndex ];
+		ioTime += rRecord.GetStageMilliseconds( STAGE_IO_BEGIN, STAGE_IO_END );
+		deserializeTime += rRecord.GetStageMilliseconds( STAGE_DESERIALIZE_BEGIN, STAGE_DESERIALIZE_END );
+		dependencyWaitTime += rRecord.GetStageMilliseconds( STAGE_PRELOADED, STAGE_LINKED );
+		ioByteCount += rRecord.ioByteCount;
+	}
+
+	line.Format(
+		( TXT( "Asset loads: %" ) PRIuSZ TXT( "\nTotal I/O: %.3f ms (%" ) PRIu64 TXT( " bytes)\n" )
+		TXT( "Total deserialization: %.3f ms\nTotal dependency wait: %.3f ms\n" ) ),
+		recordCount,
+		ioTime,
+		ioByteCount,
+		deserializeTime,
+		dependencyWaitTime );
+	rSummary += line;
+
+	DynamicArray< size_t > sortedIndices;
+	sortedIndices.Reserve( recordCount );
+
+	// Slowest loads.
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		const Record& rRecord = m_records[ recordIndex ];
+		if( rRecord.stageTimes[ STAGE_QUEUED ] != 0 && rRecord.stageTimes[ STAGE_LOADED ] != 0 )
+		{
+			sortedIndices.Push( recordIndex );
+		}
+	}
+
+	std::sort( sortedIndices.GetData(), sortedIndices.GetData() + sortedIndices.GetSize(), RecordLoadTimeCompare( m_records ) );
+
+	rSummary += TXT( "\nSlowest assets:\n" );
+	size_t listCount = Min( sortedIndices.GetSize(), entryLimit );
+	for( size_t listIndex = 0; listIndex < listCount; ++listIndex )
+	{
+		const Record& rRecord = m_records[ sortedIndices[ listIndex ] ];
+		rRecord.path.ToString( pathString );
+		line.Format(
+			TXT( "  %10.3f ms  %s (I/O %.3f ms, deserialize %.3f ms, dependency wait %.3f ms)\n" ),
+			rRecord.GetStageMilliseconds( STAGE_QUEUED, STAGE_LOADED ),
+			*pathString,
+			rRecord.GetStageMilliseconds( STAGE_IO_BEGIN, STAGE_IO_END ),
+			rRecord.GetStageMilliseconds( STAGE_DESERIALIZE_BEGIN, STAGE_DESERIALIZE_END ),
+			rRecord.GetStageMilliseconds( STAGE_PRELOADED, STAGE_LINKED ) );
+		rSummary += line;
+	}
+
+	// Deepest dependency chains.
+	DynamicArray< uint32_t > depths;
+	DynamicArray< size_t > nextIndices;
+	depths.Resize( recordCount );
+	nextIndices.Resize( recordCount );
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		depths[ recordIndex ] = 0;
+		SetInvalid( nextIndices[ recordIndex ] );
+	}
+
+	sortedIndices.Resize( 0 );
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		ComputeChainDepth( recordIndex, depths, nextIndices );
+		sortedIndices.Push( recordIndex );
+	}
+
+	std::sort( sortedIndices.GetData(), sortedIndices.GetData() + sortedIndices.GetSize(), RecordDepthCompare( depths ) );
+
+	rSummary += TXT( "\nDeepest dependency chains:\n" );
+	listCount = Min( sortedIndices.GetSize(), entryLimit );
+	for( size_t listIndex = 0; listIndex < listCount; ++listIndex )
+	{
+		size_t recordIndex = sortedIndices[ listIndex ];
+		line.Format( TXT( "  %10" ) PRIu32 TXT( "  " ), depths[ recordIndex ] );
+		rSummary += line;
+
+		for( size_t chainIndex = recordIndex; IsValid( chainIndex ); chainIndex = nextIndices[ chainIndex ] )
+		{
+			if( chainIndex != recordIndex )
+			{
+				rSummary += TXT( " -> " );
+			}
+
+			m_records[ chainIndex ].path.ToString( pathString );
+			rSummary += pathString;
+		}
+
+		rSummary += TXT( '\n' );
+	}
+
+	// Largest I/O.
+	sortedIndices.Resize( 0 );
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		if( m_records[ recordIndex ].ioByteCount != 0 )
+		{
+			sortedIndices.Push( recordIndex );
+		}
+	}
+
+	std::sort( sortedIndices.GetData(), sortedIndices.GetData() + sortedIndices.GetSize(), RecordIoSizeCompare( m_records ) );
+
+	rSummary += TXT( "\nLargest I/O:\n" );
+	listCount = Min( sortedIndices.GetSize(), entryLimit );
+	for( size_t listIndex = 0; listIndex < listCount; ++listIndex )
+	{
+		const Record& rRecord = m_records[ sortedIndices[ listIndex ] ];
+		rRecord.path.ToString( pathString );
+		line.Format(
+			TXT( "  %10" ) PRIu64 TXT( " bytes  %s (%.3f ms)\n" ),
+			rRecord.ioByteCount,
+			*pathString,
+			rRecord.GetStageMilliseconds( STAGE_IO_BEGIN, STAGE_IO_END ) );
+		rSummary += line;
+	}
+}
+
+/// Get the singleton AssetLoadProfiler instance, creating it if necessary.
+///
+/// @return  Reference to the AssetLoadProfiler instance.
+///
+/// @see DestroyStaticInstance()
+AssetLoadProfiler& AssetLoadProfiler::GetStaticInstance()
+{
+	if( !sm_pInstance )
+	{
+		sm_pInstance = new AssetLoadProfiler;
+		HELIUM_ASSERT( sm_pInstance );
+	}
+
+	return *sm_pInstance;
+}
+
+/// Destroy the singleton AssetLoadProfiler instance.
+///
+/// @see GetStaticInstance()
+void AssetLoadProfiler::DestroyStaticInstance()
+{
+	delete sm_pInstance;
+	sm_pInstance = NULL;
+}
+
+/// Get the record for the current load of an asset.  This must be called with the record lock held.
+///
+/// @param[in] path       Asset path.
+/// @param[in] bNewLoad   True if a new load of the asset is starting, in which case a new record is created unless
+///                       the current record has not yet progressed past being queued.
+///
+/// @return  Record for the asset.
+AssetLoadProfiler::Record* AssetLoadProfiler::GetRecord( AssetPath path, bool bNewLoad )
+{
+	HashMap< AssetPath, size_t >::Iterator recordIterator = m_recordMap.Find( path );
+	if( recordIterator != m_recordMap.End() )
+	{
+		Record& rRecord = m_records[ recordIterator->Second() ];
+		if( !bNewLoad || rRecord.stageTimes[ STAGE_LOADED ] == 0 )
+		{
+			return &rRecord;
+		}
+	}
+
+	size_t recordIndex = m_records.GetSize();
+	Record* pRecord = m_records.New();
+	HELIUM_ASSERT( pRecord );
+	pRecord->path = path;
+	MemoryZero( pRecord->stageTimes, sizeof( pRecord->stageTimes ) );
+	pRecord->ioByteCount = 0;
+
+	if( recordIterator != m_recordMap.End() )
+	{
+		recordIterator->Second() = recordIndex;
+	}
+	else
+	{
+		HELIUM_VERIFY( m_recordMap.Insert( recordIterator, KeyValue< AssetPath, size_t >( path, recordIndex ) ) );
+	}
+
+	return pRecord;
+}
+
+/// Compute the length of the longest chain of asset references starting at a given record.
+///
+/// @param[in]    recordIndex   Index of the record at the start of the chain.
+/// @param[inout] rDepths       Chain depth of each record (zero if not yet computed, UINT32_MAX while being computed).
+/// @param[inout] rNextIndices  Index of the next record along the longest chain from each record.
+///
+/// @return  Number of assets in the longest chain.
+uint32_t AssetLoadProfiler::ComputeChainDepth(
+	size_t recordIndex,
+	DynamicArray< uint32_t >& rDepths,
+	DynamicArray< size_t >& rNextIndices ) const
+{
+	uint32_t depth = rDepths[ recordIndex ];
+	if( depth == UINT32_MAX )
+	{
+		// Reference cycle.
+		return 0;
+	}
+
+	if( depth != 0 )
+	{
+		return depth;
+	}
+
+	rDepths[ recordIndex ] = UINT32_MAX;
+
+	uint32_t maxDependencyDepth = 0;
+	const DynamicArray< AssetPath >& rDependencies = m_records[ recordIndex ].dependencies;
+	size_t dependencyCount = rDependencies.GetSize();
+	for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+	{
+		HashMap< AssetPath, size_t >::ConstIterator recordIterator = m_recordMap.Find( rDependencies[ dependencyIndex ] );
+		if( recordIterator == m_recordMap.End() )
+		{
+			continue;
+		}
+
+		size_t dependencyRecordIndex = recordIterator->Second();
+		uint32_t dependencyDepth = ComputeChainDepth( dependencyRecordIndex, rDepths, rNextIndices );
+		if( dependencyDepth > maxDependencyDepth )
+		{
+			maxDependencyDepth = dependencyDepth;
+			rNextIndices[ recordIndex ] = dependencyRecordIndex;
+		}
+	}
+
+	depth = maxDependencyDepth + 1;
+	rDepths[ recordIndex ] = depth;
+
+	return depth;
+}
+
+/// Get the time elapsed between two load stages.
+///
+/// @param[in] beginStage  Starting stage.
+/// @param[in] endStage    Ending stage.
+///
+/// @return  Milliseconds elapsed between the two stages, or zero if either stage was not reached.
+float32_t AssetLoadProfiler::Record::GetStageMilliseconds( EStage beginStage, EStage endStage ) const
+{
+	uint64_t beginTime = stageTimes[ beginStage ];
+	uint64_t endTime = stageTimes[ endStage ];
+	if( beginTime == 0 || endTime <= beginTime )
+	{
+		return 0.0f;
+	}
+
+	return static_cast< float32_t >( Timer::TicksToMilliseconds( endTime - beginTime ) );
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Platform/Locks.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Foundation/String.h"
+
+#include "Engine/Engine.h"
+#include "Engine/AssetPath.h"
+
+namespace Helium
+{
+	/// Asset load timing profiler.
+	///
+	/// Records the time at which each asset load reaches each stage of the load pipeline (queued in the AssetLoader,
+	/// file I/O serviced by the AsyncLoader, deserialization on an AsyncDeserializer worker, and the linking,
+	/// precaching, and finalization steps in the AssetLoader), along with the number of bytes read and the assets each
+	/// one references.  The recorded data can be written out as a Chrome trace (viewable in chrome://tracing or
+	/// Perfetto) or summarized to determine whether loading is bound by I/O, deserialization, or dependency chains.
+	///
+	/// Recording is disabled by default.  All recording functions are thread-safe.
+	class HELIUM_ENGINE_API AssetLoadProfiler : NonCopyable
+	{
+	public:
+		/// Default number of entries listed in each section of the summary.
+		static const size_t DEFAULT_SUMMARY_ENTRY_LIMIT = 10;
+
+		/// Load stages.
+		enum EStage
+		{
+			STAGE_FIRST   =  0,
+			STAGE_INVALID = -1,
+
+			/// Load request created in the AssetLoader.
+			STAGE_QUEUED,
+			/// File read started by an AsyncLoader worker.
+			STAGE_IO_BEGIN,
+			/// File read completed.
+			STAGE_IO_END,
+			/// Deserialization started on an AsyncDeserializer worker.
+			STAGE_DESERIALIZE_BEGIN,
+			/// Deserialization completed.
+			STAGE_DESERIALIZE_END,
+			/// Object published by its package loader (preloading complete).
+			STAGE_PRELOADED,
+			/// Object references linked.
+			STAGE_LINKED,
+			/// Resource data precached.
+			STAGE_PRECACHED,
+			/// Load finalized.
+			STAGE_LOADED,
+
+			STAGE_MAX,
+			STAGE_LAST = STAGE_MAX - 1
+		};
+
+		/// Load timing information for a single asset.
+		struct Record
+		{
+			/// Asset path.
+			AssetPath path;
+			/// Timer tick count at which each stage was reached (zero if the stage was not reached).
+			uint64_t stageTimes[ STAGE_MAX ];
+			/// Number of bytes read from disk for the asset.
+			uint64_t ioByteCount;
+			/// Paths of the assets referenced by the asset.
+			DynamicArray< AssetPath > dependencies;
+
+			/// @name Data Access
+			//@{
+			float32_t GetStageMilliseconds( EStage beginStage, EStage endStage ) const;
+			//@}
+		};
+
+		/// @name Profiling Control
+		//@{
+		void SetEnabled( bool bEnabled );
+		inline bool IsEnabled() const;
+
+		void Reset();
+		//@}
+
+		/// @name Recording
+		//@{
+		void BeginRecord( AssetPath path );
+		void MarkStage( AssetPath path, EStage stage, uint64_t tickCount = 0 );
+		void AddIoBytes( AssetPath path, uint64_t byteCount );
+		void AddDependency( AssetPath path, AssetPath dependencyPath );
+		//@}
+
+		/// @name Reporting
+		//@{
+		bool WriteChromeTrace( const String& rFileName ) const;
+		void BuildSummary( String& rSummary, size_t entryLimit = DEFAULT_SUMMARY_ENTRY_LIMIT ) const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static AssetLoadProfiler& GetStaticInstance();
+		static void DestroyStaticInstance();
+		//@}
+
+	private:
+		/// True if load events are being recorded.
+		bool m_bEnabled;
+
+		/// Recorded load timing information, in the order in which loads were started.
+		DynamicArray< Record > m_records;
+		/// Index of the most recent record for each asset path.
+		HashMap< AssetPath, size_t > m_recordMap;
+		/// Lock guarding the record data.
+		mutable Mutex m_lock;
+
+		/// Singleton instance.
+		static AssetLoadProfiler* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		AssetLoadProfiler();
+		~AssetLoadProfiler();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		Record* GetRecord( AssetPath path, bool bNewLoad );
+		uint32_t ComputeChainDepth(
+			size_t recordIndex, DynamicArray< uint32_t >& rDepths, DynamicArray< size_t >& rNextIndices ) const;
+		//@}
+	};
+}
+
+#include "Engine/AssetLoadProfiler.inl"
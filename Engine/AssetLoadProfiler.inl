@@ -0,0 +1,9 @@
+/// Get whether load events are being recorded.
+///
+/// @return  True if recording is enabled, false if not.
+///
+/// @see SetEnabled()
+bool Helium::AssetLoadProfiler::IsEnabled() const
+{
+	return m_bEnabled;
+}
@@ -2,7 +2,10 @@
 #include "Engine/AssetLoader.h"
 
 #include "Platform/Thread.h"
+#include "Platform/Timer.h"
 #include "Engine/Asset.h"
+#include "Engine/AssetLoadProfiler.h"
+#include "Engine/AsyncLoader.h"
 #include "Engine/PackageLoader.h"
 #include "Engine/FileLocations.h"
 
@@ -19,7 +22,14 @@ AssetTracker* AssetTracker::sm_pInstance = NULL;
 /// Constructor.
 AssetLoader::AssetLoader()
 : m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
+, m_pPrefetchRequest( NULL )
+, m_loadCompleteCounter( 0 )
+, m_publishTimeBudget( static_cast< float32_t >( DEFAULT_PUBLISH_TIME_BUDGET ) )
+, m_tickStartTime( 0 )
 {
+	m_precacheWaitList.pPackageLoader = NULL;
+	m_precacheWaitList.progressCounter = 0;
+	m_precacheWaitList.bDirty = false;
 }
 
 /// Destructor.
@@ -96,17 +106,29 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 	pRequest->stateFlags = pAsset ? 
 		(pAsset->GetFlags() & Asset::FLAG_BROKEN ? LOAD_FLAG_FULLY_LOADED | LOAD_FLAG_ERROR : LOAD_FLAG_FULLY_LOADED ) : 
 		0;
-	pRequest->requestCount = 1;
+	// One reference for the caller, and one held by the load scheduler until the load process has completed.
+	pRequest->requestCount = 2;
 	HELIUM_ASSERT( !pRequest->spObject );
 	pRequest->spObject = pAsset;
 	pRequest->forceReload = forceReload;
+	pRequest->waitReason = WAIT_REASON_NONE;
+	pRequest->pBlockingRequest = NULL;
+	pRequest->blockingFlags = 0;
+	HELIUM_ASSERT( pRequest->dependents.IsEmpty() );
+	HELIUM_ASSERT( pRequest->prefetchRequestIds.IsEmpty() );
 
 	ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor requestAccessor;
 	if( m_loadRequestMap.Insert( requestAccessor, KeyValue< AssetPath, LoadRequest* >( path, pRequest ) ) )
 	{
 		// New load request was created, so tick it once to get the load process running.
 		requestAccessor.Release();
-		TickLoadRequest( pRequest );
+
+		if( pPackageLoader )
+		{
+			AssetLoadProfiler::GetStaticInstance().BeginRecord( path );
+		}
+
+		UpdateLoadRequest( pRequest );
 	}
 	else
 	{
@@ -263,63 +285,104 @@ bool AssetLoader::CacheObject( Asset* /*pObject*/, bool /*bEvictPlatformPreproce
 #endif  // HELIUM_TOOLS
 
 /// Update object loading.
+///
+/// Only load requests whose blocking condition has been resolved since their last update are ticked.  Requests waiting
+/// on a package loader are woken once that package loader reports progress, requests waiting on resource precaching
+/// are woken once an async load or another object load completes, and requests waiting on a dependency are woken by
+/// the dependency itself as it advances.
+///
+/// Linking and publishing of loaded objects is limited to the publish time budget (see SetPublishTimeBudget()).  At
+/// least one ready request is always updated, and any requests left over once the budget runs out are deferred to the
+/// next tick.
 void AssetLoader::Tick()
 {
+	// Re-entrant ticks share the time budget of the outermost tick.
+	if( m_loadRequestTickArray.IsEmpty() )
+	{
+		m_tickStartTime = Timer::GetTickCount();
+	}
+
 	// Tick package loaders first.
 	TickPackageLoaders();
 
-	// Build the list of object load requests to update this tick, incrementing the request count on each to prevent
-	// them from being released while we don't have a lock on the request hash map.
-	//HELIUM_ASSERT( m_loadRequestTickArray.IsEmpty() );
-	/// List of load requests to update in the current tick.
-	DynamicArray< LoadRequest* > m_loadRequestTickArray;
+	WakeWaitingRequests();
 
-	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor loadRequestConstAccessor;
-	if( m_loadRequestMap.First( loadRequestConstAccessor ) )
-	{
-		do
-		{
-			LoadRequest* pRequest = loadRequestConstAccessor->Second();
-			HELIUM_ASSERT( pRequest );
-			AtomicIncrementUnsafe( pRequest->requestCount );
-			m_loadRequestTickArray.Add( pRequest );
+	// Gather the requests that can make progress.  Requests woken while these are being updated are deferred to the
+	// next tick.  Tick() can be re-entered while updating requests (i.e. through FinishLoad()), so each call only
+	// processes the range of the tick array that it appended.
+	size_t tickStartIndex = m_loadRequestTickArray.GetSize();
 
-			++loadRequestConstAccessor;
-		} while( loadRequestConstAccessor.IsValid() );
+	{
+		MutexScopeLock scopeLock( m_waitLock );
+		m_loadRequestTickArray.AddArray( m_readyRequests.GetData(), m_readyRequests.GetSize() );
+		m_readyRequests.Resize( 0 );
 	}
 
-	// Tick object load requests.
-	size_t loadRequestCount = m_loadRequestTickArray.GetSize();
-	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
+	size_t tickEndIndex = m_loadRequestTickArray.GetSize();
+	for( size_t requestIndex = tickStartIndex; requestIndex < tickEndIndex; ++requestIndex )
 	{
+		if( requestIndex != tickStartIndex && !HasPublishTimeRemaining() )
+		{
+			MutexScopeLock scopeLock( m_waitLock );
+			m_readyRequests.AddArray(
+				m_loadRequestTickArray.GetData() + requestIndex,
+				tickEndIndex - requestIndex );
+
+			break;
+		}
+
+		// Note that the tick array may be reallocated by re-entrant ticks, so don't hold onto pointers into it.
 		LoadRequest* pRequest = m_loadRequestTickArray[ requestIndex ];
 		HELIUM_ASSERT( pRequest );
 
-		TickLoadRequest( pRequest );
+		UpdateLoadRequest( pRequest );
+	}
 
-		int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
-		if( newRequestCount == 0 )
-		{
-			ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
-			if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
-			{
-				pRequest = loadRequestAccessor->Second();
-				HELIUM_ASSERT( pRequest );
-				if( pRequest->requestCount == 0 )
-				{
-					HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+	m_loadRequestTickArray.Resize( tickStartIndex );
+}
 
-					pRequest->spObject.Release();
-					pRequest->resolver.Clear();
+/// Set the time budget for linking and publishing loaded objects during each tick.
+///
+/// Package loaders deserialize objects on AsyncDeserializer worker threads, but linking the results into the object
+/// system and finalizing their loads has to happen on the thread calling Tick().  Limiting this work per tick keeps
+/// large streaming bursts from stalling a single frame.
+///
+/// @param[in] milliseconds  Time budget in milliseconds, or zero to process all pending work every tick.
+///
+/// @see GetPublishTimeBudget(), HasPublishTimeRemaining()
+void AssetLoader::SetPublishTimeBudget( float32_t milliseconds )
+{
+	m_publishTimeBudget = ( milliseconds > 0.0f ? milliseconds : 0.0f );
+}
 
-					m_loadRequestMap.Remove( loadRequestAccessor );
-					m_loadRequestPool.Release( pRequest );
-				}
-			}
-		}
+/// Get the time budget for linking and publishing loaded objects during each tick.
+///
+/// @return  Time budget in milliseconds, or zero if unlimited.
+///
+/// @see SetPublishTimeBudget()
+float32_t AssetLoader::GetPublishTimeBudget() const
+{
+	return m_publishTimeBudget;
+}
+
+/// Get whether time remains in the publish time budget of the current tick.
+///
+/// Package loaders should check this before publishing each deserialized object from their Tick() and defer the rest
+/// to the next tick once it returns false.
+///
+/// @return  True if more objects can be published during the current tick, false if the budget has been used up.
+///
+/// @see SetPublishTimeBudget()
+bool AssetLoader::HasPublishTimeRemaining() const
+{
+	if( m_publishTimeBudget <= 0.0f )
+	{
+		return true;
 	}
 
-	//m_loadRequestTickArray.Resize( 0 );
+	float32_t elapsed = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - m_tickStartTime ) );
+
+	return ( elapsed < m_publishTimeBudget );
 }
 
 /// Get the global object loader instance.
@@ -363,6 +426,369 @@ void AssetLoader::OnLoadComplete( const AssetPath & /*path*/, Asset* /*pObject*/
 {
 }
 
+/// Update the given load request, then either release the scheduler's reference to it if it has finished loading or
+/// place it on the list matching the condition that is blocking it.
+///
+/// @param[in] pRequest  Load request to update.  The caller must own the scheduler's reference to the request (the
+///                      request must not be on the ready list or any wait list).
+void AssetLoader::UpdateLoadRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	// Sample progress counters before ticking so that anything completing during the tick wakes the request again.
+	PackageLoader* pPackageLoader = pRequest->pPackageLoader;
+	pRequest->packageProgressCounter = ( pPackageLoader ? pPackageLoader->GetProgressCounter() : 0 );
+	pRequest->precacheProgressCounter = GetPrecacheProgressCounter();
+	pRequest->waitReason = WAIT_REASON_NONE;
+	pRequest->pBlockingRequest = NULL;
+
+	int32_t previousFlags = pRequest->stateFlags;
+	bool bFinished = TickLoadRequest( pRequest );
+	int32_t currentFlags = pRequest->stateFlags;
+
+	// Dependents wait on either preloading or the entire load process.
+	int32_t changedFlags = previousFlags ^ currentFlags;
+	if( changedFlags & ( LOAD_FLAG_PRELOADED | LOAD_FLAG_LOADED ) )
+	{
+		WakeDependents( pRequest );
+	}
+
+	AssetLoadProfiler& rProfiler = AssetLoadProfiler::GetStaticInstance();
+	if( rProfiler.IsEnabled() && pPackageLoader )
+	{
+		if( changedFlags & LOAD_FLAG_PRELOADED )
+		{
+			rProfiler.MarkStage( pRequest->path, AssetLoadProfiler::STAGE_PRELOADED );
+		}
+
+		if( changedFlags & LOAD_FLAG_LINKED )
+		{
+			rProfiler.MarkStage( pRequest->path, AssetLoadProfiler::STAGE_LINKED );
+		}
+
+		if( changedFlags & LOAD_FLAG_PRECACHED )
+		{
+			rProfiler.MarkStage( pRequest->path, AssetLoadProfiler::STAGE_PRECACHED );
+		}
+
+		if( changedFlags & LOAD_FLAG_LOADED )
+		{
+			rProfiler.MarkStage( pRequest->path, AssetLoadProfiler::STAGE_LOADED );
+		}
+	}
+
+	if( bFinished )
+	{
+		AtomicIncrementRelease( m_loadCompleteCounter );
+		ReleasePrefetchedDependencies( pRequest );
+		ReleaseSchedulerReference( pRequest );
+	}
+	else
+	{
+		ScheduleLoadRequest( pRequest );
+	}
+}
+
+/// Place a load request that could not finish on the list matching its blocking condition.
+///
+/// @param[in] pRequest  Load request to schedule.
+void AssetLoader::ScheduleLoadRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	MutexScopeLock scopeLock( m_waitLock );
+
+	switch( pRequest->waitReason )
+	{
+	case WAIT_REASON_PACKAGE:
+		{
+			PackageLoader* pPackageLoader = pRequest->pPackageLoader;
+			HELIUM_ASSERT( pPackageLoader );
+
+			WaitList* pWaitList = NULL;
+			size_t waitListCount = m_packageWaitLists.GetSize();
+			for( size_t waitListIndex = 0; waitListIndex < waitListCount; ++waitListIndex )
+			{
+				if( m_packageWaitLists[ waitListIndex ].pPackageLoader == pPackageLoader )
+				{
+					pWaitList = &m_packageWaitLists[ waitListIndex ];
+
+					break;
+				}
+			}
+
+			if( !pWaitList )
+			{
+				pWaitList = m_packageWaitLists.New();
+				HELIUM_ASSERT( pWaitList );
+				pWaitList->pPackageLoader = pPackageLoader;
+				pWaitList->progressCounter = pRequest->packageProgressCounter;
+				pWaitList->bDirty = false;
+			}
+			else if( pWaitList->progressCounter != pRequest->packageProgressCounter )
+			{
+				pWaitList->bDirty = true;
+			}
+
+			pWaitList->requests.Push( pRequest );
+
+			break;
+		}
+
+	case WAIT_REASON_DEPENDENCY:
+		{
+			// The dependency wakes its dependents after updating its state flags, so the flags must be tested while
+			// holding the wait lock to avoid missing the wake-up.
+			LoadRequest* pDependency = pRequest->pBlockingRequest;
+			HELIUM_ASSERT( pDependency );
+			if( ( pDependency->stateFlags & pRequest->blockingFlags ) != pRequest->blockingFlags )
+			{
+				pDependency->dependents.Push( pRequest );
+			}
+			else
+			{
+				m_readyRequests.Push( pRequest );
+			}
+
+			break;
+		}
+
+	case WAIT_REASON_PRECACHE:
+		{
+			if( m_precacheWaitList.requests.IsEmpty() )
+			{
+				m_precacheWaitList.progressCounter = pRequest->precacheProgressCounter;
+				m_precacheWaitList.bDirty = false;
+			}
+			else if( m_precacheWaitList.progressCounter != pRequest->precacheProgressCounter )
+			{
+				m_precacheWaitList.bDirty = true;
+			}
+
+			m_precacheWaitList.requests.Push( pRequest );
+
+			break;
+		}
+
+	default:
+		{
+			m_readyRequests.Push( pRequest );
+
+			break;
+		}
+	}
+}
+
+/// Move all load requests waiting on the given request onto the ready list.
+///
+/// @param[in] pRequest  Load request that has made progress.
+void AssetLoader::WakeDependents( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	MutexScopeLock scopeLock( m_waitLock );
+
+	m_readyRequests.AddArray( pRequest->dependents.GetData(), pRequest->dependents.GetSize() );
+	pRequest->dependents.Resize( 0 );
+}
+
+/// Move load requests waiting on package loader progress or resource precaching onto the ready list if the progress
+/// counter they are waiting on has changed.
+void AssetLoader::WakeWaitingRequests()
+{
+	int32_t precacheProgressCounter = GetPrecacheProgressCounter();
+
+	MutexScopeLock scopeLock( m_waitLock );
+
+	size_t waitListIndex = 0;
+	while( waitListIndex < m_packageWaitLists.GetSize() )
+	{
+		WaitList& rWaitList = m_packageWaitLists[ waitListIndex ];
+		HELIUM_ASSERT( rWaitList.pPackageLoader );
+		if( !rWaitList.bDirty && rWaitList.progressCounter == rWaitList.pPackageLoader->GetProgressCounter() )
+		{
+			++waitListIndex;
+
+			continue;
+		}
+
+		// Wait lists are dropped once emptied, as the package loader may be destroyed once no requests reference it.
+		m_readyRequests.AddArray( rWaitList.requests.GetData(), rWaitList.requests.GetSize() );
+		m_packageWaitLists.RemoveSwap( waitListIndex );
+	}
+
+	if( !m_precacheWaitList.requests.IsEmpty() &&
+		( m_precacheWaitList.bDirty || m_precacheWaitList.progressCounter != precacheProgressCounter ) )
+	{
+		m_readyRequests.AddArray( m_precacheWaitList.requests.GetData(), m_precacheWaitList.requests.GetSize() );
+		m_precacheWaitList.requests.Resize( 0 );
+	}
+}
+
+/// Release the load scheduler's reference to a request that has finished loading.
+///
+/// @param[in] pRequest  Completed load request.
+void AssetLoader::ReleaseSchedulerReference( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+
+	ReleaseRequestReference( pRequest );
+}
+
+/// Release a reference to a load request, freeing the request once no references to it remain.
+///
+/// @param[in] pRequest  Load request to release.
+void AssetLoader::ReleaseRequestReference( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
+	if( newRequestCount == 0 )
+	{
+		ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
+		if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
+		{
+			pRequest = loadRequestAccessor->Second();
+			HELIUM_ASSERT( pRequest );
+			if( pRequest->requestCount == 0 )
+			{
+				HELIUM_ASSERT( pRequest->dependents.IsEmpty() );
+				HELIUM_ASSERT( pRequest->prefetchRequestIds.IsEmpty() );
+
+				pRequest->spObject.Release();
+				pRequest->resolver.Clear();
+
+				m_loadRequestMap.Remove( loadRequestAccessor );
+				m_loadRequestPool.Release( pRequest );
+			}
+		}
+	}
+}
+
+/// Begin loading the transitive closure of the dependencies recorded for an object ahead of deserializing it.
+///
+/// Without this, references are only discovered as each object is deserialized, so a chain of N references takes N
+/// serial I/O round trips.  Dependencies are started in breadth-first order so that shallower objects are queued for
+/// loading first.  Dependencies already being loaded are skipped, as they are prefetching their own dependencies.
+///
+/// Starting a dependency load can re-enter this function (through BeginLoadObject()), in which case the dependencies
+/// found are appended to the queue drained by the outermost call.
+///
+/// @param[in] pRequest  Load request whose object is about to be loaded by its package loader.
+void AssetLoader::PrefetchDependencies( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	PackageLoader* pPackageLoader = pRequest->pPackageLoader;
+	HELIUM_ASSERT( pPackageLoader );
+	if( !pPackageLoader->GetAssetDependencies( pRequest->path, m_prefetchQueue ) || m_pPrefetchRequest )
+	{
+		return;
+	}
+
+	m_pPrefetchRequest = pRequest;
+
+	// Note that the queue may grow while it is being processed.
+	for( size_t prefetchIndex = 0; prefetchIndex < m_prefetchQueue.GetSize(); ++prefetchIndex )
+	{
+		AssetPath path = m_prefetchQueue[ prefetchIndex ];
+
+		ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor requestConstAccessor;
+		if( m_loadRequestMap.Find( requestConstAccessor, path ) )
+		{
+			continue;
+		}
+
+		Asset* pAsset = Asset::Find< Asset >( path );
+		if( pAsset && pAsset->GetAllFlagsSet( Asset::FLAG_LOADED ) )
+		{
+			continue;
+		}
+
+		HELIUM_TRACE(
+			TraceLevels::Debug,
+			TXT( "AssetLoader: Prefetching \"%s\" for \"%s\".\n" ),
+			*path.ToString(),
+			*pRequest->path.ToString() );
+
+		size_t loadRequestId = BeginLoadObject( path );
+		if( IsValid( loadRequestId ) )
+		{
+			pRequest->prefetchRequestIds.Push( loadRequestId );
+		}
+	}
+
+	m_prefetchQueue.Resize( 0 );
+	m_pPrefetchRequest = NULL;
+}
+
+/// Release the references held to dependency load requests started by PrefetchDependencies().
+///
+/// @param[in] pRequest  Load request that has finished loading.
+void AssetLoader::ReleasePrefetchedDependencies( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	size_t prefetchCount = pRequest->prefetchRequestIds.GetSize();
+	for( size_t prefetchIndex = 0; prefetchIndex < prefetchCount; ++prefetchIndex )
+	{
+		LoadRequest* pDependency = m_loadRequestPool.GetObject( pRequest->prefetchRequestIds[ prefetchIndex ] );
+		HELIUM_ASSERT( pDependency );
+		ReleaseRequestReference( pDependency );
+	}
+
+	pRequest->prefetchRequestIds.Resize( 0 );
+}
+
+/// Record the first dependency of a load request that has not yet reached the given load state as the condition
+/// blocking the request.
+///
+/// @param[in] pRequest  Load request that is blocked on its dependencies.
+/// @param[in] flags     Load flags that all dependencies must have set.
+void AssetLoader::SetDependencyWait( LoadRequest* pRequest, int32_t flags )
+{
+	HELIUM_ASSERT( pRequest );
+
+	const DynamicArray< AssetResolver::Fixup >& rFixups = pRequest->resolver.m_Fixups;
+	size_t fixupCount = rFixups.GetSize();
+	for( size_t fixupIndex = 0; fixupIndex < fixupCount; ++fixupIndex )
+	{
+		size_t loadRequestId = rFixups[ fixupIndex ].m_LoadRequestId;
+		if( IsInvalid( loadRequestId ) )
+		{
+			continue;
+		}
+
+		LoadRequest* pDependency = m_loadRequestPool.GetObject( loadRequestId );
+		HELIUM_ASSERT( pDependency );
+		if( ( pDependency->stateFlags & flags ) != flags )
+		{
+			pRequest->waitReason = WAIT_REASON_DEPENDENCY;
+			pRequest->pBlockingRequest = pDependency;
+			pRequest->blockingFlags = flags;
+
+			return;
+		}
+	}
+
+	// All dependencies finished since they were last tested, so the request can be updated again right away.
+	pRequest->waitReason = WAIT_REASON_NONE;
+}
+
+/// Get a counter that changes whenever resource precaching of any object may be able to make progress.
+///
+/// Precaching waits either on async loads or on the completion of other object loads (i.e. shader variants), so this
+/// combines the async loader's completed request counter with this loader's completed load counter.
+///
+/// @return  Current precache progress counter.
+int32_t AssetLoader::GetPrecacheProgressCounter() const
+{
+	return static_cast< int32_t >(
+		static_cast< uint32_t >( AsyncLoader::GetStaticInstance().GetCompletedCounter() ) +
+		static_cast< uint32_t >( m_loadCompleteCounter ) );
+}
+
 /// Update the given load request.
 ///
 /// @param[in] pRequest  Load request to update.
@@ -481,6 +907,8 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 		if( !pPackageLoader->TryFinishPreload() )
 		{
 			// Still waiting for package loader preload.
+			pRequest->waitReason = WAIT_REASON_PACKAGE;
+
 			return false;
 		}
 
@@ -516,6 +944,9 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 
 			return true;
 		}
+
+		// The object's own data is queued first, followed by everything it is known to reference.
+		PrefetchDependencies( pRequest );
 	}
 
 	HELIUM_ASSERT( IsValid( pRequest->packageLoadRequestId ) );
@@ -526,12 +957,31 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 	if( !bFinished )
 	{
 		// Still waiting for object to load.
+		pRequest->waitReason = WAIT_REASON_PACKAGE;
+
 		return false;
 	}
 
-	// Preload complete.
+	// Preload complete.  References recorded during deserialization (possibly on worker threads) can now be loaded.
 	SetInvalid( pRequest->packageLoadRequestId );
 
+	AssetLoadProfiler& rProfiler = AssetLoadProfiler::GetStaticInstance();
+	if( rProfiler.IsEnabled() )
+	{
+		const DynamicArray< AssetResolver::Fixup >& rFixups = pRequest->resolver.m_Fixups;
+		size_t fixupCount = rFixups.GetSize();
+		for( size_t fixupIndex = 0; fixupIndex < fixupCount; ++fixupIndex )
+		{
+			const AssetPath& rFixupPath = rFixups[ fixupIndex ].m_Path;
+			if( !rFixupPath.IsEmpty() )
+			{
+				rProfiler.AddDependency( pRequest->path, rFixupPath );
+			}
+		}
+	}
+
+	pRequest->resolver.BeginDeferredLoads();
+
 	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PRELOADED );
 
 	return true;
@@ -551,6 +1001,8 @@ bool AssetLoader::TickLink( LoadRequest* pRequest )
 	{
 		if( !pRequest->resolver.ReadyToApplyFixups() )
 		{
+			SetDependencyWait( pRequest, LOAD_FLAG_PRELOADED );
+
 			return false;
 		}
 		
@@ -581,6 +1033,8 @@ bool AssetLoader::TickPrecache( LoadRequest* pRequest )
 		// TODO: SHouldn't this be in the linking phase?
 		if ( !pRequest->resolver.TryFinishPrecachingDependencies() )
 		{
+			SetDependencyWait( pRequest, LOAD_FLAG_FULLY_LOADED );
+
 			return false;
 		}
 
@@ -614,6 +1068,8 @@ bool AssetLoader::TickPrecache( LoadRequest* pRequest )
 
 			if( !pAsset->TryFinishPrecacheResourceData() )
 			{
+				pRequest->waitReason = WAIT_REASON_PRECACHE;
+
 				return false;
 			}
 		}
@@ -668,12 +1124,40 @@ int64_t AssetLoader::GetAssetFileTimestamp( const AssetPath &path )
 
 #endif
 
+/// Constructor.
+///
+/// @param[in] pReferencedAssets  If not null, the path of each distinct asset identified is added to this array.
+Helium::AssetIdentifier::AssetIdentifier( DynamicArray< AssetPath >* pReferencedAssets )
+: m_pReferencedAssets( pReferencedAssets )
+{
+}
+
 bool Helium::AssetIdentifier::Identify( const Reflect::ObjectPtr& object, Name* identity )
 {
 	Asset *pAsset = Reflect::SafeCast<Asset>(object);
 
 	if ( pAsset )
 	{
+		if ( m_pReferencedAssets )
+		{
+			AssetPath path = pAsset->GetPath();
+
+			size_t referenceCount = m_pReferencedAssets->GetSize();
+			size_t referenceIndex;
+			for ( referenceIndex = 0; referenceIndex < referenceCount; ++referenceIndex )
+			{
+				if ( ( *m_pReferencedAssets )[ referenceIndex ] == path )
+				{
+					break;
+				}
+			}
+
+			if ( referenceIndex == referenceCount )
+			{
+				m_pReferencedAssets->Push( path );
+			}
+		}
+
 		if ( identity )
 		{
 			identity->Set(pAsset->GetPath().ToString());
@@ -700,8 +1184,8 @@ bool Helium::AssetResolver::Resolve( const Name& identity, Reflect::ObjectPtr& p
 		AssetPath p;
 		p.Set(*identity);
 
-		size_t loadRequestId = AssetLoader::GetStaticInstance()->BeginLoadObject(p);
-		m_Fixups.Push( Fixup( pointer, pointerClass, loadRequestId ) );
+		// This may be called from deserialization worker threads, so defer the load until BeginDeferredLoads().
+		m_Fixups.Push( Fixup( pointer, pointerClass, Invalid< size_t >(), p ) );
 
 		return true;
 	}
@@ -728,11 +1212,30 @@ bool Helium::AssetResolver::Resolve( const Name& identity, Reflect::ObjectPtr& p
 	return false;
 }
 
+void Helium::AssetResolver::BeginDeferredLoads()
+{
+	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
+		iter != m_Fixups.End(); ++iter)
+	{
+		if ( !iter->m_Path.IsEmpty() )
+		{
+			HELIUM_ASSERT( IsInvalid( iter->m_LoadRequestId ) );
+			iter->m_LoadRequestId = AssetLoader::GetStaticInstance()->BeginLoadObject( iter->m_Path );
+			iter->m_Path.Clear();
+		}
+	}
+}
+
 bool Helium::AssetResolver::ReadyToApplyFixups()
 {
 	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
 		iter != m_Fixups.End(); ++iter)
 	{
+		if ( IsInvalid( iter->m_LoadRequestId ) )
+		{
+			continue;
+		}
+
 		// Retrieve the load request and test whether it has completed.
 		AssetLoader::LoadRequest* pRequest = AssetLoader::GetStaticInstance()->m_loadRequestPool.GetObject( iter->m_LoadRequestId );
 
@@ -750,6 +1253,11 @@ void Helium::AssetResolver::ApplyFixups()
 	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
 		iter != m_Fixups.End(); ++iter)
 	{
+		if ( IsInvalid( iter->m_LoadRequestId ) )
+		{
+			continue;
+		}
+
 		// Retrieve the load request and test whether it has completed.
 		AssetLoader::LoadRequest* pRequest = AssetLoader::GetStaticInstance()->m_loadRequestPool.GetObject( iter->m_LoadRequestId );
 
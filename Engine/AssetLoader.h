@@ -2,6 +2,7 @@
 
 #include "Engine/Engine.h"
 
+#include "Platform/Locks.h"
 #include "Reflect/Translator.h"
 #include "Foundation/ConcurrentHashMap.h"
 #include "Foundation/ObjectPool.h"
@@ -18,7 +19,13 @@ namespace Helium
 	class HELIUM_ENGINE_API AssetIdentifier : public Reflect::ObjectIdentifier
 	{
 	public:
+		explicit AssetIdentifier( DynamicArray< AssetPath >* pReferencedAssets = NULL );
+
 		virtual bool Identify( const Reflect::ObjectPtr& object, Name* identity ) HELIUM_OVERRIDE;
+
+	private:
+		/// If not null, receives the path of each distinct asset identified.
+		DynamicArray< AssetPath >* m_pReferencedAssets;
 	};
 
 	class HELIUM_ENGINE_API AssetResolver : public Reflect::ObjectResolver
@@ -28,6 +35,7 @@ namespace Helium
 		virtual bool Resolve( const Name& identity, Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass );
 
 		// Called by AssetLoader
+		void BeginDeferredLoads();
 		bool ReadyToApplyFixups();
 		void ApplyFixups();
 		bool TryFinishPrecachingDependencies();
@@ -40,17 +48,20 @@ namespace Helium
 				: m_Pointer( rhs.m_Pointer )
 				, m_PointerClass( rhs.m_PointerClass )
 				, m_LoadRequestId( rhs.m_LoadRequestId )
+				, m_Path( rhs.m_Path )
 			{}
 
-			Fixup( Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass, size_t loadRequestId )
+			Fixup( Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass, size_t loadRequestId, const AssetPath& path )
 				: m_Pointer( pointer )
 				, m_PointerClass( pointerClass )
 				, m_LoadRequestId( loadRequestId )
+				, m_Path( path )
 			{}
 
 			Reflect::ObjectPtr&       m_Pointer;
 			const Reflect::MetaClass* m_PointerClass;
 			size_t                    m_LoadRequestId;
+			AssetPath                 m_Path;  // Path of an object whose load has not been started yet
 		};
 		DynamicArray< Fixup >  m_Fixups;
 	};
@@ -61,6 +72,8 @@ namespace Helium
 	public:
 		/// Number of request objects to allocate in each block of the request pool.
 		static const size_t LOAD_REQUEST_POOL_BLOCK_SIZE = 64;
+		/// Default time budget for linking and publishing loaded objects during each tick, in milliseconds.
+		static const uint32_t DEFAULT_PUBLISH_TIME_BUDGET = 4;
 
 		friend AssetIdentifier;
 		friend AssetResolver;
@@ -98,6 +111,13 @@ namespace Helium
 		virtual void Tick();
 		//@}
 
+		/// @name Publish Time Budget
+		//@{
+		void SetPublishTimeBudget( float32_t milliseconds );
+		float32_t GetPublishTimeBudget() const;
+		bool HasPublishTimeRemaining() const;
+		//@}
+
 		/// @name Static Access
 		//@{
 		static AssetLoader* GetStaticInstance();
@@ -134,6 +154,25 @@ namespace Helium
 			LOAD_FLAG_IN_TICK = 1 << 6,
 		};
 
+		/// Conditions on which a load request can be blocked.
+		enum EWaitReason
+		{
+			WAIT_REASON_FIRST   =  0,
+			WAIT_REASON_INVALID = -1,
+
+			/// Not blocked (ready to be updated on the next tick).
+			WAIT_REASON_NONE,
+			/// Waiting on its package loader to finish preloading the package or the object.
+			WAIT_REASON_PACKAGE,
+			/// Waiting on another load request to reach a given load state.
+			WAIT_REASON_DEPENDENCY,
+			/// Waiting on resource data precaching.
+			WAIT_REASON_PRECACHE,
+
+			WAIT_REASON_MAX,
+			WAIT_REASON_LAST = WAIT_REASON_MAX - 1
+		};
+
 		/// Asset load request information.
 		struct LoadRequest
 		{
@@ -156,6 +195,35 @@ namespace Helium
 			AssetResolver resolver;
 
 			bool forceReload;
+
+			/// Condition blocking this request as of its last update.
+			EWaitReason waitReason;
+			/// Load request blocking this request (if waiting on a dependency).
+			LoadRequest* pBlockingRequest;
+			/// Load flags the blocking request must reach before this request can make progress.
+			int32_t blockingFlags;
+			/// Package loader progress counter sampled before the last update.
+			int32_t packageProgressCounter;
+			/// Precache progress counter sampled before the last update.
+			int32_t precacheProgressCounter;
+			/// Load requests to wake once this request makes progress (guarded by the wait lock).
+			DynamicArray< LoadRequest* > dependents;
+			/// IDs of the dependency load requests started ahead of time on behalf of this request.  A reference to
+			/// each is held until this request has finished loading.
+			DynamicArray< size_t > prefetchRequestIds;
+		};
+
+		/// Load requests blocked until a progress counter changes.
+		struct WaitList
+		{
+			/// Package loader whose progress is being waited on (null for resource precaching).
+			PackageLoader* pPackageLoader;
+			/// Progress counter value sampled before the waiting requests were updated.
+			int32_t progressCounter;
+			/// True if the waiting requests were updated at different progress counter values.
+			bool bDirty;
+			/// Waiting load requests.
+			DynamicArray< LoadRequest* > requests;
 		};
 
 		/// Load request hash map.
@@ -163,6 +231,30 @@ namespace Helium
 		/// Load request pool.
 		ObjectPool< LoadRequest > m_loadRequestPool;
 
+		/// Load requests that can make progress on the next tick.
+		DynamicArray< LoadRequest* > m_readyRequests;
+		/// Load requests blocked on package loader progress, with one list per package loader.
+		DynamicArray< WaitList > m_packageWaitLists;
+		/// Load requests blocked on resource precaching.
+		WaitList m_precacheWaitList;
+		/// Lock guarding the ready list, the wait lists, and the dependent list of each load request.
+		Mutex m_waitLock;
+
+		/// Paths of dependencies waiting to be prefetched by the outermost PrefetchDependencies() call.
+		DynamicArray< AssetPath > m_prefetchQueue;
+		/// Load request holding the references to dependencies being prefetched (null if not prefetching).
+		LoadRequest* m_pPrefetchRequest;
+
+		/// Load requests being updated in the current tick (reused across ticks).
+		DynamicArray< LoadRequest* > m_loadRequestTickArray;
+		/// Number of load requests that have finished loading (wraps around).
+		volatile int32_t m_loadCompleteCounter;
+
+		/// Time budget for linking and publishing loaded objects during each tick, in milliseconds (zero if unlimited).
+		float32_t m_publishTimeBudget;
+		/// Timer tick count at the start of the current (outermost) tick.
+		uint64_t m_tickStartTime;
+
 		/// Singleton instance.
 		static AssetLoader* sm_pInstance;
 
@@ -179,6 +271,17 @@ namespace Helium
 
 		/// @name Load Process Updating
 		//@{
+		void UpdateLoadRequest( LoadRequest* pRequest );
+		void ScheduleLoadRequest( LoadRequest* pRequest );
+		void WakeDependents( LoadRequest* pRequest );
+		void WakeWaitingRequests();
+		void ReleaseSchedulerReference( LoadRequest* pRequest );
+		void ReleaseRequestReference( LoadRequest* pRequest );
+		void PrefetchDependencies( LoadRequest* pRequest );
+		void ReleasePrefetchedDependencies( LoadRequest* pRequest );
+		void SetDependencyWait( LoadRequest* pRequest, int32_t flags );
+		int32_t GetPrecacheProgressCounter() const;
+
 		bool TickLoadRequest( LoadRequest* pRequest );
 		bool TickPreload( LoadRequest* pRequest );
 		bool TickLink( LoadRequest* pRequest );
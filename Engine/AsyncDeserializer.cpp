@@ -0,0 +1,341 @@
+#include "EnginePch.h"
+#include "Engine/AsyncDeserializer.h"
+
+using namespace Helium;
+
+AsyncDeserializer* AsyncDeserializer::sm_pInstance = NULL;
+
+/// Constructor.
+AsyncDeserializer::AsyncDeserializer()
+	: m_requestPool( REQUEST_POOL_BLOCK_SIZE )
+{
+}
+
+/// Destructor.
+AsyncDeserializer::~AsyncDeserializer()
+{
+	Shutdown();
+}
+
+/// Initialize the async deserializer.
+///
+/// @param[in] workerCount  Number of worker threads to start.  This is clamped to the range [1, MAX_WORKER_COUNT].
+///
+/// @return  True if initialization was sucessful, false if not.
+///
+/// @see Shutdown()
+bool AsyncDeserializer::Initialize( size_t workerCount )
+{
+	Shutdown();
+
+	if( workerCount == 0 )
+	{
+		workerCount = 1;
+	}
+	else if( workerCount > MAX_WORKER_COUNT )
+	{
+		workerCount = MAX_WORKER_COUNT;
+	}
+
+	m_workers.Reserve( workerCount );
+	m_threads.Reserve( workerCount );
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		DeserializeWorker* pWorker = new DeserializeWorker( this );
+		HELIUM_ASSERT( pWorker );
+		m_workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		m_threads.Push( pThread );
+
+		HELIUM_VERIFY( pThread->Start( TXT( "AsyncDeserializer - object deserialization" ) ) );
+	}
+
+	return true;
+}
+
+/// Shut down the async deserializer.
+///
+/// Any requests still waiting in the queue are executed on the calling thread so that pending SyncRequest() calls
+/// return.
+///
+/// @see Initialize()
+void AsyncDeserializer::Shutdown()
+{
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workers[ workerIndex ]->Stop();
+	}
+
+	size_t threadCount = m_threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		RunnableThread* pThread = m_threads[ threadIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
+	}
+
+	m_threads.Clear();
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		delete m_workers[ workerIndex ];
+	}
+
+	m_workers.Clear();
+
+	for( ; ; )
+	{
+		Request* pRequest = DequeueRequest();
+		if( !pRequest )
+		{
+			break;
+		}
+
+		ProcessRequest( pRequest );
+	}
+}
+
+/// Queue a deserialization request.
+///
+/// The given data must remain valid until the request has been synced through SyncRequest() or TrySyncRequest().
+///
+/// @param[in] pFunction  Function to execute on a worker thread.
+/// @param[in] pData      User data to pass to the function.
+///
+/// @return  ID identifying the request.
+///
+/// @see SyncRequest(), TrySyncRequest()
+size_t AsyncDeserializer::QueueRequest( WORK_FUNCTION* pFunction, void* pData )
+{
+	HELIUM_ASSERT( pFunction );
+
+	Request* pRequest = m_requestPool.Allocate();
+	HELIUM_ASSERT( pRequest );
+	pRequest->pFunction = pFunction;
+	pRequest->pData = pData;
+	pRequest->pNext = NULL;
+	AtomicExchangeRelease( pRequest->processedCounter, 0 );
+
+	size_t requestIndex = m_requestPool.GetIndex( pRequest );
+	HELIUM_ASSERT( IsValid( requestIndex ) );
+
+	size_t workerCount = m_workers.GetSize();
+	if( workerCount == 0 )
+	{
+		// No workers are running, so deserialize in place.
+		ProcessRequest( pRequest );
+
+		return requestIndex;
+	}
+
+	{
+		Locker< RequestQueue, SpinLock >::Handle handle ( m_requestQueue );
+		handle->Push( pRequest );
+	}
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workers[ workerIndex ]->WakeUp();
+	}
+
+	return requestIndex;
+}
+
+/// Block the current thread until the request with the specified ID completes and release the request information.
+///
+/// After calling this function, the given ID will no longer be valid.
+///
+/// @param[in] id  Request ID.
+///
+/// @see QueueRequest(), TrySyncRequest()
+void AsyncDeserializer::SyncRequest( size_t id )
+{
+	HELIUM_ASSERT( IsValid( id ) );
+
+	Request* pRequest = m_requestPool.GetObject( id );
+	HELIUM_ASSERT( pRequest );
+
+	while( pRequest->processedCounter == 0 )
+	{
+		Thread::Yield();
+	}
+
+	m_requestPool.Release( pRequest );
+}
+
+/// Check whether the request with the specified ID has completed without blocking the current thread, releasing the
+/// request information if it has completed.
+///
+/// After this function returns true, the given ID will no longer be valid.
+///
+/// @param[in] id  Request ID.
+///
+/// @return  True if the request has completed and was released, false if is still pending or in progress.
+///
+/// @see QueueRequest(), SyncRequest()
+bool AsyncDeserializer::TrySyncRequest( size_t id )
+{
+	HELIUM_ASSERT( IsValid( id ) );
+
+	Request* pRequest = m_requestPool.GetObject( id );
+	HELIUM_ASSERT( pRequest );
+	if( pRequest->processedCounter == 0 )
+	{
+		return false;
+	}
+
+	m_requestPool.Release( pRequest );
+
+	return true;
+}
+
+/// Get the singleton AsyncDeserializer instance, creating it if necessary.
+///
+/// @return  Reference to the AsyncDeserializer instance.
+///
+/// @see DestroyStaticInstance()
+AsyncDeserializer& AsyncDeserializer::GetStaticInstance()
+{
+	if( !sm_pInstance )
+	{
+		sm_pInstance = new AsyncDeserializer;
+		HELIUM_ASSERT( sm_pInstance );
+	}
+
+	return *sm_pInstance;
+}
+
+/// Destroy the singleton AsyncDeserializer instance.
+///
+/// @see GetStaticInstance()
+void AsyncDeserializer::DestroyStaticInstance()
+{
+	if( sm_pInstance )
+	{
+		sm_pInstance->Shutdown();
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
+
+/// Pop the oldest pending request from the request queue.
+///
+/// @return  Request to process, or null if the queue is empty.
+AsyncDeserializer::Request* AsyncDeserializer::DequeueRequest()
+{
+	Locker< RequestQueue, SpinLock >::Handle handle ( m_requestQueue );
+
+	return handle->Pop();
+}
+
+/// Execute a request and mark it as processed.
+///
+/// @param[in] pRequest  Request to process.
+void AsyncDeserializer::ProcessRequest( Request* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->pFunction );
+
+	pRequest->pFunction( pRequest->pData );
+
+	AtomicExchangeRelease( pRequest->processedCounter, 1 );
+}
+
+/// Constructor.
+AsyncDeserializer::RequestQueue::RequestQueue()
+	: pHead( NULL )
+	, pTail( NULL )
+{
+}
+
+/// Append a request to the end of the queue.
+///
+/// @param[in] pRequest  Request to queue.
+void AsyncDeserializer::RequestQueue::Push( Request* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	pRequest->pNext = NULL;
+	if( pTail )
+	{
+		pTail->pNext = pRequest;
+	}
+	else
+	{
+		pHead = pRequest;
+	}
+
+	pTail = pRequest;
+}
+
+/// Remove and return the oldest request.
+///
+/// @return  Dequeued request, or null if the queue is empty.
+AsyncDeserializer::Request* AsyncDeserializer::RequestQueue::Pop()
+{
+	Request* pRequest = pHead;
+	if( pRequest )
+	{
+		pHead = pRequest->pNext;
+		if( !pHead )
+		{
+			pTail = NULL;
+		}
+
+		pRequest->pNext = NULL;
+	}
+
+	return pRequest;
+}
+
+/// Constructor.
+///
+/// @param[in] pDeserializer  Owning deserializer.
+AsyncDeserializer::DeserializeWorker::DeserializeWorker( AsyncDeserializer* pDeserializer )
+	: m_pDeserializer( pDeserializer )
+	, m_wakeUpCondition( false, false )
+	, m_stopCounter( 0 )
+{
+	HELIUM_ASSERT( pDeserializer );
+}
+
+/// Destructor.
+AsyncDeserializer::DeserializeWorker::~DeserializeWorker()
+{
+}
+
+/// Execute queued deserialization requests until stopped.
+void AsyncDeserializer::DeserializeWorker::Run()
+{
+	while( m_stopCounter == 0 )
+	{
+		Request* pRequest = m_pDeserializer->DequeueRequest();
+		if( !pRequest )
+		{
+			// Queue is empty, so sleep until notified.
+			m_wakeUpCondition.Wait();
+
+			continue;
+		}
+
+		ProcessRequest( pRequest );
+	}
+}
+
+/// Request the worker to stop processing and return at the next possible opportunity.
+void AsyncDeserializer::DeserializeWorker::Stop()
+{
+	AtomicExchangeRelease( m_stopCounter, 1 );
+	m_wakeUpCondition.Signal();
+}
+
+/// Wake up the worker if it is waiting for requests to be queued.
+void AsyncDeserializer::DeserializeWorker::WakeUp()
+{
+	m_wakeUpCondition.Signal();
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/ObjectPool.h"
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	/// Async deserialization manager.
+	///
+	/// Package loaders hand the thread-safe part of object loading (parsing serialized bytes into Reflect object graphs
+	/// and recording reference fixups) to a pool of worker threads, leaving only the final link and publish step on the
+	/// thread ticking the AssetLoader.  Requests are processed in the order in which they were queued.
+	///
+	/// If no workers are running (Initialize() has not been called), requests are executed immediately on the thread
+	/// that queues them.
+	class HELIUM_ENGINE_API AsyncDeserializer : NonCopyable
+	{
+	public:
+		/// Request pool block size.
+		static const size_t REQUEST_POOL_BLOCK_SIZE = 64;
+		/// Default number of deserialization worker threads.
+		static const size_t DEFAULT_WORKER_COUNT = 2;
+		/// Maximum number of deserialization worker threads.
+		static const size_t MAX_WORKER_COUNT = 16;
+
+		/// Function executed on a worker thread to service a request.
+		///
+		/// @param[in] pData  User data provided when the request was queued.
+		typedef void ( WORK_FUNCTION )( void* pData );
+
+		/// @name Initialization
+		//@{
+		bool Initialize( size_t workerCount = DEFAULT_WORKER_COUNT );
+		void Shutdown();
+
+		inline size_t GetWorkerCount() const;
+		//@}
+
+		/// @name Request Management
+		//@{
+		size_t QueueRequest( WORK_FUNCTION* pFunction, void* pData );
+		void SyncRequest( size_t id );
+		bool TrySyncRequest( size_t id );
+		//@}
+
+		/// @name Static Access
+		//@{
+		static AsyncDeserializer& GetStaticInstance();
+		static void DestroyStaticInstance();
+		//@}
+
+	private:
+		/// Deserialization request data.
+		struct Request
+		{
+			/// Function to execute.
+			WORK_FUNCTION* pFunction;
+			/// User data passed to the function.
+			void* pData;
+
+			/// Next request in the queue.
+			Request* pNext;
+
+			/// Set to a non-zero value once this request has been processed.
+			volatile int32_t processedCounter;
+		};
+
+		/// FIFO request queue.
+		struct RequestQueue
+		{
+			/// First (oldest) queued request.
+			Request* pHead;
+			/// Last (newest) queued request.
+			Request* pTail;
+
+			/// @name Construction/Destruction
+			//@{
+			RequestQueue();
+			//@}
+
+			/// @name Queue Operations
+			//@{
+			void Push( Request* pRequest );
+			Request* Pop();
+			//@}
+		};
+
+		/// Deserialization thread runnable.
+		class DeserializeWorker : public Runnable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			explicit DeserializeWorker( AsyncDeserializer* pDeserializer );
+			virtual ~DeserializeWorker();
+			//@}
+
+			/// @name Runnable Interface
+			//@{
+			virtual void Run();
+			//@}
+
+			/// @name External Thread Control
+			//@{
+			void Stop();
+			void WakeUp();
+			//@}
+
+		private:
+			/// Owning deserializer.
+			AsyncDeserializer* m_pDeserializer;
+			/// Condition used to wake up the worker thread when requests are queued (or when it should shut down).
+			Condition m_wakeUpCondition;
+
+			/// Non-zero if this thread should stop when next possible, zero if it should continue.
+			volatile int32_t m_stopCounter;
+		};
+
+		/// Pool of request objects.
+		ObjectPool< Request > m_requestPool;
+		/// Pending request queue.
+		Locker< RequestQueue, SpinLock > m_requestQueue;
+
+		/// Deserialization threads.
+		DynamicArray< RunnableThread* > m_threads;
+		/// Deserialization thread workers.
+		DynamicArray< DeserializeWorker* > m_workers;
+
+		/// Singleton instance.
+		static AsyncDeserializer* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		AsyncDeserializer();
+		~AsyncDeserializer();
+		//@}
+
+		/// @name Worker Support
+		//@{
+		Request* DequeueRequest();
+		static void ProcessRequest( Request* pRequest );
+		//@}
+	};
+}
+
+#include "Engine/AsyncDeserializer.inl"
@@ -0,0 +1,9 @@
+/// Get the number of worker threads servicing deserialization requests.
+///
+/// @return  Number of active worker threads.
+///
+/// @see Initialize()
+size_t Helium::AsyncDeserializer::GetWorkerCount() const
+{
+	return m_workers.GetSize();
+}
@@ -2,18 +2,33 @@
 #include "Engine/AsyncLoader.h"
 
 #include "Engine/FileLocations.h"
+#include "Platform/Timer.h"
 #include "Foundation/FileStream.h"
 
+#include <algorithm>
+
 using namespace Helium;
 
+/// Sort comparison for ordering requests within a batch by file offset.
+struct RequestOffsetCompare
+{
+	template< typename T >
+	bool operator()( const T* pRequest0, const T* pRequest1 ) const
+	{
+		return ( pRequest0->offset < pRequest1->offset );
+	}
+};
+
 AsyncLoader* AsyncLoader::sm_pInstance = NULL;
 
 /// Constructor.
 AsyncLoader::AsyncLoader()
 	: m_requestPool( REQUEST_POOL_BLOCK_SIZE )
-	, m_pThread( NULL )
-	, m_pWorker( NULL )
+	, m_pendingCount( 0 )
+	, m_completedCounter( 0 )
+	, m_fileStreamUseTime( 0 )
 {
+	ResetStatistics();
 }
 
 /// Destructor.
@@ -24,43 +39,91 @@ AsyncLoader::~AsyncLoader()
 
 /// Initialize the async loader.
 ///
+/// @param[in] workerCount  Number of I/O worker threads to start.  This is clamped to the range
+///                         [1, FILE_STREAM_LIMIT] so that each worker can always hold an open file stream.
+///
 /// @return  True if initialization was sucessful, false if not.
 ///
 /// @see Shutdown()
-bool AsyncLoader::Initialize()
+bool AsyncLoader::Initialize( size_t workerCount )
 {
 	Shutdown();
 
-	// Start up the async loading thread.
-	m_pWorker = new LoadWorker;
-	HELIUM_ASSERT( m_pWorker );
+	if( workerCount == 0 )
+	{
+		workerCount = 1;
+	}
+	else if( workerCount > FILE_STREAM_LIMIT )
+	{
+		workerCount = FILE_STREAM_LIMIT;
+	}
+
+	m_workers.Reserve( workerCount );
+	m_threads.Reserve( workerCount );
 
-	m_pThread = new RunnableThread( m_pWorker );
-	HELIUM_ASSERT( m_pThread );
-	HELIUM_VERIFY( m_pThread->Start( TXT( "AsyncLoader - file loading" ) ) );
+	// Start up the async loading threads.
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		LoadWorker* pWorker = new LoadWorker( this );
+		HELIUM_ASSERT( pWorker );
+		m_workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		m_threads.Push( pThread );
+
+		HELIUM_VERIFY( pThread->Start( TXT( "AsyncLoader - file loading" ) ) );
+	}
 
 	return true;
 }
 
 /// Shut down the async loader.
 ///
+/// Any requests still waiting in the queue are marked as failed so that pending SyncRequest() calls return.
+///
 /// @see Initialize()
 void AsyncLoader::Shutdown()
 {
-	if( m_pWorker )
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workers[ workerIndex ]->Stop();
+	}
+
+	size_t threadCount = m_threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		RunnableThread* pThread = m_threads[ threadIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
+	}
+
+	m_threads.Clear();
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
 	{
-		m_pWorker->Stop();
+		delete m_workers[ workerIndex ];
 	}
 
-	if( m_pThread )
+	m_workers.Clear();
+
+	// Fail any requests that never made it to a worker.
+	for( ; ; )
 	{
-		m_pThread->Join();
-		delete m_pThread;
-		m_pThread = NULL;
+		Request* pRequest = DequeueRequest();
+		if( !pRequest )
+		{
+			break;
+		}
+
+		SetInvalid( pRequest->bytesRead );
+		CompleteRequest( pRequest );
 	}
 
-	delete m_pWorker;
-	m_pWorker = NULL;
+	CloseIdleFileStreams();
+	HELIUM_ASSERT( m_fileStreams.IsEmpty() );
 }
 
 /// Queue an async load request.
@@ -69,23 +132,53 @@ void AsyncLoader::Shutdown()
 /// @param[in] rFileName  FilePath name of the file from which to load.
 /// @param[in] offset     Byte offset within the file from which to load.
 /// @param[in] size       Number of bytes to read.
-/// @param[in] priority   Load priority.
+/// @param[in] priority   Load priority.  Requests with a higher priority are always serviced before requests with a
+///                       lower priority, and requests with the same priority are serviced in the order queued.
 ///
 /// @return  ID identifying the load request if queued successfully, invalid index if the request queue failed.
 ///
-/// @see SyncRequest(), TrySyncRequest()
+/// @see QueueDecodeRequest(), SyncRequest(), TrySyncRequest(), CancelRequest()
 size_t AsyncLoader::QueueRequest(
 	void* pBuffer,
 	const String& rFileName,
 	uint64_t offset,
 	size_t size,
 	EPriority priority )
+{
+	return QueueDecodeRequest( pBuffer, size, rFileName, offset, size, NULL, priority );
+}
+
+/// Queue an async load request whose data is decoded on the worker thread once read.
+///
+/// The number of bytes reported once the request completes is the number of decoded bytes written to the buffer.
+///
+/// @param[in] pBuffer          Buffer in which to store the decoded data.
+/// @param[in] bufferSize       Size of the output buffer.
+/// @param[in] rFileName        FilePath name of the file from which to load.
+/// @param[in] offset           Byte offset within the file from which to load.
+/// @param[in] size             Number of (encoded) bytes to read from the file.
+/// @param[in] pDecodeFunction  Function with which to decode the data read, or null to read directly into the
+///                             output buffer (in which case @c bufferSize must be at least @c size).
+/// @param[in] priority         Load priority.
+///
+/// @return  ID identifying the load request if queued successfully, invalid index if the request queue failed.
+///
+/// @see QueueRequest(), SyncRequest(), TrySyncRequest(), CancelRequest()
+size_t AsyncLoader::QueueDecodeRequest(
+	void* pBuffer,
+	size_t bufferSize,
+	const String& rFileName,
+	uint64_t offset,
+	size_t size,
+	DECODE_FUNCTION* pDecodeFunction,
+	EPriority priority )
 {
 	HELIUM_ASSERT( pBuffer );
+	HELIUM_ASSERT( pDecodeFunction || bufferSize >= size );
 	HELIUM_ASSERT( static_cast< size_t >( priority ) < static_cast< size_t >( PRIORITY_MAX ) );
 
-	// Make sure the load worker is running.
-	if( !m_pWorker )
+	// Make sure the load workers are running.
+	if( m_workers.IsEmpty() )
 	{
 		return Invalid< size_t >();
 	}
@@ -97,16 +190,41 @@ size_t AsyncLoader::QueueRequest(
 	pRequest->fileName = rFileName;
 	pRequest->offset = offset;
 	pRequest->size = size;
+	pRequest->bufferSize = bufferSize;
+	pRequest->pDecodeFunction = pDecodeFunction;
 	pRequest->priority = priority;
+	pRequest->pPrevious = NULL;
+	pRequest->pNext = NULL;
+	pRequest->bQueued = false;
+
+	pRequest->timing.queueTime = Timer::GetTickCount();
+	pRequest->timing.startTime = 0;
+	pRequest->timing.endTime = 0;
 
 	pRequest->bytesRead = 0;
 	AtomicExchangeRelease( pRequest->processedCounter, 0 );
 
-	m_pWorker->QueueRequest( pRequest );
-
 	size_t requestIndex = m_requestPool.GetIndex( pRequest );
 	HELIUM_ASSERT( IsValid( requestIndex ) );
 
+	{
+		// Prevent access to the load queue while an exclusive write lock is held.
+		ScopeReadLock nonExclusiveLock( m_writeLock );
+
+		AtomicIncrementAcquire( m_pendingCount );
+
+		{
+			Locker< RequestQueue, SpinLock >::Handle handle ( m_requestQueue );
+			handle->Push( pRequest );
+		}
+	}
+
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workers[ workerIndex ]->WakeUp();
+	}
+
 	return requestIndex;
 }
 
@@ -115,13 +233,14 @@ size_t AsyncLoader::QueueRequest(
 ///
 /// After calling this function, the given ID will no longer be valid.
 ///
-/// @param[in] id  Request ID.
+/// @param[in]  id       Request ID.
+/// @param[out] pTiming  If not null, set to the timing information for the request.
 ///
 /// @return  Number of bytes read from the file, zero if the request offset was not within the range of the file, or
 ///          an invalid index if the file was not found or could not be opened.
 ///
 /// @see QueueRequest(), TrySyncRequest()
-size_t AsyncLoader::SyncRequest( size_t id )
+size_t AsyncLoader::SyncRequest( size_t id, RequestTiming* pTiming )
 {
 	HELIUM_ASSERT( IsValid( id ) );
 
@@ -134,6 +253,11 @@ size_t AsyncLoader::SyncRequest( size_t id )
 	}
 
 	size_t bytesRead = pRequest->bytesRead;
+	if( pTiming )
+	{
+		*pTiming = pRequest->timing;
+	}
+
 	m_requestPool.Release( pRequest );
 
 	return bytesRead;
@@ -148,11 +272,13 @@ size_t AsyncLoader::SyncRequest( size_t id )
 /// @param[out] rBytesRead  If the request has completed, this is set to the number of bytes read from the file,
 ///                         zero if the request offset was not within the range of the file, or an invalid index if
 ///                         the file was not found or could not be opened.
+/// @param[out] pTiming     If not null and the request has completed, this is set to the timing information for the
+///                         request.
 ///
 /// @return  True if the request has completed and was released, false if is still pending or in progress.
 ///
 /// @see QueueRequest(), SyncRequest()
-bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
+bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead, RequestTiming* pTiming )
 {
 	HELIUM_ASSERT( IsValid( id ) );
 
@@ -164,6 +290,45 @@ bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
 	}
 
 	rBytesRead = pRequest->bytesRead;
+	if( pTiming )
+	{
+		*pTiming = pRequest->timing;
+	}
+
+	m_requestPool.Release( pRequest );
+
+	return true;
+}
+
+/// Cancel a load request that has not yet been picked up by a worker thread.
+///
+/// If the request was cancelled, its information is released and the given ID will no longer be valid.  If a worker
+/// has already started (or finished) processing the request, nothing is done and the request must still be released
+/// using SyncRequest() or TrySyncRequest().
+///
+/// @param[in] id  Request ID.
+///
+/// @return  True if the request was removed from the queue and released, false if it is already being processed.
+///
+/// @see QueueRequest(), SyncRequest(), TrySyncRequest()
+bool AsyncLoader::CancelRequest( size_t id )
+{
+	HELIUM_ASSERT( IsValid( id ) );
+
+	Request* pRequest = m_requestPool.GetObject( id );
+	HELIUM_ASSERT( pRequest );
+
+	{
+		Locker< RequestQueue, SpinLock >::Handle handle ( m_requestQueue );
+		if( !pRequest->bQueued )
+		{
+			return false;
+		}
+
+		handle->Remove( pRequest );
+	}
+
+	AtomicDecrementRelease( m_pendingCount );
 	m_requestPool.Release( pRequest );
 
 	return true;
@@ -175,21 +340,24 @@ bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
 /// pending requests in order to free any associated resources.
 void AsyncLoader::Flush()
 {
-	if( m_pWorker )
+	while( m_pendingCount != 0 )
 	{
-		m_pWorker->Flush();
+		Thread::Yield();
 	}
 }
 
 /// Lock async loading for writing to files that may be in use.
 ///
+/// This flushes all pending requests and closes all cached file streams so that files can be safely rewritten.
+///
 /// @see Unlock()
 void AsyncLoader::Lock()
 {
-	if( m_pWorker )
-	{
-		m_pWorker->Lock();
-	}
+	// Prevent other threads from queueing requests or writing out data while we have a write lock.
+	m_writeLock.LockWrite();
+
+	Flush();
+	CloseIdleFileStreams();
 }
 
 /// Unlock a previous loader lock.
@@ -197,10 +365,27 @@ void AsyncLoader::Lock()
 /// @see Lock()
 void AsyncLoader::Unlock()
 {
-	if( m_pWorker )
-	{
-		m_pWorker->Unlock();
-	}
+	m_writeLock.UnlockWrite();
+}
+
+/// Get a snapshot of the I/O statistics accumulated since initialization or the last ResetStatistics() call.
+///
+/// @param[out] rStatistics  I/O statistics.
+///
+/// @see ResetStatistics()
+void AsyncLoader::GetStatistics( Statistics& rStatistics ) const
+{
+	Locker< Statistics, SpinLock >::Handle handle ( m_statistics );
+	rStatistics = *handle;
+}
+
+/// Reset all accumulated I/O statistics.
+///
+/// @see GetStatistics()
+void AsyncLoader::ResetStatistics()
+{
+	Locker< Statistics, SpinLock >::Handle handle ( m_statistics );
+	MemoryZero( &( *handle ), sizeof( Statistics ) );
 }
 
 /// Get the singleton AsyncLoader instance, creating it if necessary.
@@ -232,74 +417,370 @@ void AsyncLoader::DestroyStaticInstance()
 	}
 }
 
-/// Constructor.
-AsyncLoader::LoadWorker::LoadWorker()
-	: m_wakeUpCondition( false, false )
-	, m_stopCounter( 0 )
-	, m_processingCounter( 0 )
+/// Pop the highest priority pending request from the request queue.
+///
+/// @return  Request to process, or null if the queue is empty.
+AsyncLoader::Request* AsyncLoader::DequeueRequest()
 {
+	Locker< RequestQueue, SpinLock >::Handle handle ( m_requestQueue );
+
+	return handle->Pop();
 }
 
-/// Destructor.
-AsyncLoader::LoadWorker::~LoadWorker()
+/// Pop the highest priority pending request along with other pending requests against the same file.
+///
+/// @param[out] rBatch  Requests to process.  This is empty if the queue is empty.
+void AsyncLoader::DequeueBatch( DynamicArray< Request* >& rBatch )
 {
+	rBatch.Resize( 0 );
+
+	Locker< RequestQueue, SpinLock >::Handle handle ( m_requestQueue );
+
+	Request* pFirstRequest = handle->Pop();
+	if( !pFirstRequest )
+	{
+		return;
+	}
+
+	rBatch.Push( pFirstRequest );
+
+	// Lower priority requests are allowed to piggyback on the read as well, since they cost little extra once the
+	// file region is being read anyway.
+	size_t scanCount = 0;
+	for( size_t priorityIndex = PRIORITY_MAX; priorityIndex != 0; )
+	{
+		--priorityIndex;
+
+		Request* pRequest = handle->pHeads[ priorityIndex ];
+		while( pRequest && scanCount < COALESCE_SCAN_LIMIT && rBatch.GetSize() < COALESCE_REQUEST_LIMIT )
+		{
+			Request* pNextRequest = pRequest->pNext;
+			++scanCount;
+
+			if( pRequest->fileName == pFirstRequest->fileName )
+			{
+				handle->Remove( pRequest );
+				rBatch.Push( pRequest );
+			}
+
+			pRequest = pNextRequest;
+		}
+	}
 }
 
-/// Execute the async loading work.
-void AsyncLoader::LoadWorker::Run()
+/// Accumulate I/O statistics from a processed batch.
+///
+/// @param[in] rStatistics  Statistics to add.
+void AsyncLoader::AddStatistics( const Statistics& rStatistics )
 {
-	BufferedStream* pBufferedStream = new BufferedStream;
-	HELIUM_ASSERT( pBufferedStream );
+	Locker< Statistics, SpinLock >::Handle handle ( m_statistics );
+	handle->requestCount += rStatistics.requestCount;
+	handle->readCount += rStatistics.readCount;
+	handle->mergedRequestCount += rStatistics.mergedRequestCount;
+	handle->mergedByteCount += rStatistics.mergedByteCount;
+	handle->gapByteCount += rStatistics.gapByteCount;
+}
+
+/// Mark a request as processed once a worker has finished with it.
+///
+/// @param[in] pRequest  Processed request.
+void AsyncLoader::CompleteRequest( Request* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	// Requests failed without being serviced by a worker are treated as having started when they completed.
+	pRequest->timing.endTime = Timer::GetTickCount();
+	if( pRequest->timing.startTime == 0 )
+	{
+		pRequest->timing.startTime = pRequest->timing.endTime;
+	}
+
+	AtomicExchangeRelease( pRequest->processedCounter, 1 );
+	AtomicDecrementRelease( m_pendingCount );
+	AtomicIncrementRelease( m_completedCounter );
+}
+
+/// Acquire an open read stream for the given file, reusing a cached stream if one is idle.
+///
+/// If the cache is full, the least-recently-used idle stream is closed to make room.
+///
+/// @param[in] rFileName  File to open.
+///
+/// @return  Open file stream, or null if the file could not be opened.
+///
+/// @see ReleaseFileStream()
+FileStream* AsyncLoader::AcquireFileStream( const String& rFileName )
+{
+	FileStream* pEvictedStream = NULL;
 
-	while( m_stopCounter == 0 )
 	{
-		AtomicExchangeAcquire( m_processingCounter, 1 );
+		MutexScopeLock scopeLock( m_fileStreamLock );
+
+		size_t leastRecentIndex = Invalid< size_t >();
+		uint64_t leastRecentTime = UINT64_MAX;
 
-		Request* pRequest;
+		size_t streamCount = m_fileStreams.GetSize();
+		for( size_t streamIndex = 0; streamIndex < streamCount; ++streamIndex )
 		{
-			Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-			pRequest = handle->IsEmpty() ? NULL : handle->Pop();
+			FileStreamEntry& rEntry = m_fileStreams[ streamIndex ];
+			if( rEntry.bInUse )
+			{
+				continue;
+			}
+
+			if( rEntry.fileName == rFileName )
+			{
+				rEntry.bInUse = true;
+
+				return rEntry.pStream;
+			}
+
+			if( rEntry.lastUseTime < leastRecentTime )
+			{
+				leastRecentIndex = streamIndex;
+				leastRecentTime = rEntry.lastUseTime;
+			}
 		}
-		if( !pRequest )
+
+		if( streamCount >= FILE_STREAM_LIMIT && IsValid( leastRecentIndex ) )
 		{
-			// Queue is empty, so sleep until notified.
-			AtomicExchangeRelease( m_processingCounter, 0 );
-			m_wakeUpCondition.Wait();
+			pEvictedStream = m_fileStreams[ leastRecentIndex ].pStream;
+			m_fileStreams.RemoveSwap( leastRecentIndex );
+		}
+	}
 
-			continue;
+	// Perform the actual file operations outside the cache lock so other workers are not stalled by them.
+	delete pEvictedStream;
+
+	FileStream* pFileStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_READ );
+	if( !pFileStream )
+	{
+		return NULL;
+	}
+
+	MutexScopeLock scopeLock( m_fileStreamLock );
+
+	// Streams that don't fit in the cache are still handed out; they are simply closed once released.
+	if( m_fileStreams.GetSize() < FILE_STREAM_LIMIT )
+	{
+		FileStreamEntry entry;
+		entry.fileName = rFileName;
+		entry.pStream = pFileStream;
+		entry.lastUseTime = ++m_fileStreamUseTime;
+		entry.bInUse = true;
+		m_fileStreams.Push( entry );
+	}
+
+	return pFileStream;
+}
+
+/// Release a file stream previously acquired using AcquireFileStream().
+///
+/// @param[in] pStream    File stream to release.
+/// @param[in] bKeepOpen  True to keep the stream cached for later reuse, false to close it immediately (i.e. after
+///                       an I/O error).
+///
+/// @see AcquireFileStream()
+void AsyncLoader::ReleaseFileStream( FileStream* pStream, bool bKeepOpen )
+{
+	HELIUM_ASSERT( pStream );
+
+	{
+		MutexScopeLock scopeLock( m_fileStreamLock );
+
+		size_t streamCount = m_fileStreams.GetSize();
+		for( size_t streamIndex = 0; streamIndex < streamCount; ++streamIndex )
+		{
+			FileStreamEntry& rEntry = m_fileStreams[ streamIndex ];
+			if( rEntry.pStream == pStream )
+			{
+				HELIUM_ASSERT( rEntry.bInUse );
+
+				if( bKeepOpen )
+				{
+					rEntry.bInUse = false;
+					rEntry.lastUseTime = ++m_fileStreamUseTime;
+
+					return;
+				}
+
+				m_fileStreams.RemoveSwap( streamIndex );
+
+				break;
+			}
 		}
+	}
 
-		HELIUM_ASSERT( pRequest );
+	delete pStream;
+}
+
+/// Close all cached file streams that are not currently being read from.
+void AsyncLoader::CloseIdleFileStreams()
+{
+	MutexScopeLock scopeLock( m_fileStreamLock );
 
-		FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
-		if( !pFileStream )
+	size_t streamIndex = m_fileStreams.GetSize();
+	while( streamIndex != 0 )
+	{
+		--streamIndex;
+
+		FileStreamEntry& rEntry = m_fileStreams[ streamIndex ];
+		if( !rEntry.bInUse )
 		{
-			SetInvalid( pRequest->bytesRead );
+			delete rEntry.pStream;
+			m_fileStreams.RemoveSwap( streamIndex );
 		}
-		else
+	}
+}
+
+/// Constructor.
+AsyncLoader::RequestQueue::RequestQueue()
+{
+	MemoryZero( pHeads, sizeof( pHeads ) );
+	MemoryZero( pTails, sizeof( pTails ) );
+}
+
+/// Append a request to the end of the queue for its priority.
+///
+/// @param[in] pRequest  Request to queue.
+void AsyncLoader::RequestQueue::Push( Request* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !pRequest->bQueued );
+
+	size_t priorityIndex = static_cast< size_t >( pRequest->priority );
+	HELIUM_ASSERT( priorityIndex < static_cast< size_t >( PRIORITY_MAX ) );
+
+	pRequest->pPrevious = pTails[ priorityIndex ];
+	pRequest->pNext = NULL;
+	if( pTails[ priorityIndex ] )
+	{
+		pTails[ priorityIndex ]->pNext = pRequest;
+	}
+	else
+	{
+		pHeads[ priorityIndex ] = pRequest;
+	}
+
+	pTails[ priorityIndex ] = pRequest;
+	pRequest->bQueued = true;
+}
+
+/// Remove and return the oldest request with the highest priority.
+///
+/// @return  Dequeued request, or null if all queues are empty.
+AsyncLoader::Request* AsyncLoader::RequestQueue::Pop()
+{
+	for( size_t priorityIndex = PRIORITY_MAX; priorityIndex != 0; )
+	{
+		--priorityIndex;
+
+		Request* pRequest = pHeads[ priorityIndex ];
+		if( pRequest )
 		{
-			pRequest->bytesRead = 0;
+			Remove( pRequest );
 
-			pBufferedStream->Open( pFileStream );
-			int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::Begin );
-			if( static_cast< uint64_t >( offset ) == pRequest->offset )
-			{
-				pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
-			}
+			return pRequest;
+		}
+	}
 
-			pBufferedStream->Open( NULL );
+	return NULL;
+}
 
-			delete pFileStream;
+/// Unlink a request from its priority queue.
+///
+/// @param[in] pRequest  Queued request to remove.
+void AsyncLoader::RequestQueue::Remove( Request* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->bQueued );
+
+	size_t priorityIndex = static_cast< size_t >( pRequest->priority );
+
+	if( pRequest->pPrevious )
+	{
+		pRequest->pPrevious->pNext = pRequest->pNext;
+	}
+	else
+	{
+		HELIUM_ASSERT( pHeads[ priorityIndex ] == pRequest );
+		pHeads[ priorityIndex ] = pRequest->pNext;
+	}
+
+	if( pRequest->pNext )
+	{
+		pRequest->pNext->pPrevious = pRequest->pPrevious;
+	}
+	else
+	{
+		HELIUM_ASSERT( pTails[ priorityIndex ] == pRequest );
+		pTails[ priorityIndex ] = pRequest->pPrevious;
+	}
+
+	pRequest->pPrevious = NULL;
+	pRequest->pNext = NULL;
+	pRequest->bQueued = false;
+}
+
+/// Get whether all priority queues are empty.
+///
+/// @return  True if no requests are queued, false if not.
+bool AsyncLoader::RequestQueue::IsEmpty() const
+{
+	for( size_t priorityIndex = 0; priorityIndex < static_cast< size_t >( PRIORITY_MAX ); ++priorityIndex )
+	{
+		if( pHeads[ priorityIndex ] )
+		{
+			return false;
 		}
+	}
 
-		AtomicExchangeRelease( pRequest->processedCounter, 1 );
+	return true;
+}
 
-		Thread::Yield();
+/// Constructor.
+///
+/// @param[in] pLoader  Async loader from which requests are pulled.
+AsyncLoader::LoadWorker::LoadWorker( AsyncLoader* pLoader )
+	: m_pLoader( pLoader )
+	, m_pBufferedStream( NULL )
+	, m_wakeUpCondition( false, false )
+	, m_stopCounter( 0 )
+{
+	HELIUM_ASSERT( pLoader );
+}
+
+/// Destructor.
+AsyncLoader::LoadWorker::~LoadWorker()
+{
+	HELIUM_ASSERT( !m_pBufferedStream );
+}
+
+/// Execute the async loading work.
+void AsyncLoader::LoadWorker::Run()
+{
+	m_pBufferedStream = new BufferedStream;
+	HELIUM_ASSERT( m_pBufferedStream );
+
+	while( m_stopCounter == 0 )
+	{
+		m_pLoader->DequeueBatch( m_batch );
+		if( m_batch.IsEmpty() )
+		{
+			// Queue is empty, so sleep until notified.
+			m_wakeUpCondition.Wait();
+
+			continue;
+		}
+
+		ProcessBatch();
 	}
 
-	AtomicExchangeRelease( m_processingCounter, 0 );
+	delete m_pBufferedStream;
+	m_pBufferedStream = NULL;
 
-	delete pBufferedStream;
+	m_batch.Clear();
+	m_mergeBuffer.Clear();
 }
 
 /// Request the load worker to stop processing and return at the next possible opportunity.
@@ -309,61 +790,208 @@ void AsyncLoader::LoadWorker::Stop()
 	m_wakeUpCondition.Signal();
 }
 
-/// Queue an async load request.
-///
-/// @param[in] pRequest  Request to queue.  Note that the @c processedCounter value should be set to 0 prior to
-///                      calling this function (the worker thread will set it to 1 once the request has been
-///                      processed).
+/// Wake up the load worker if it is waiting for requests to be queued.
+void AsyncLoader::LoadWorker::WakeUp()
+{
+	m_wakeUpCondition.Signal();
+}
+
+/// Service the current batch of requests, all of which target the same file.
 ///
-/// @see Flush()
-void AsyncLoader::LoadWorker::QueueRequest( Request* pRequest )
+/// Requests are swept in offset order, and runs of requests separated by no more than COALESCE_GAP_LIMIT bytes are
+/// serviced with a single read.
+void AsyncLoader::LoadWorker::ProcessBatch()
 {
-	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( pRequest->processedCounter == 0 );
+	size_t requestCount = m_batch.GetSize();
+	HELIUM_ASSERT( requestCount != 0 );
 
-	// Prevent access to the load queue while an exclusive write lock is held.
-	ScopeReadLock nonExclusiveLock( m_writeLock );
+	Request** ppRequests = m_batch.GetData();
+	HELIUM_ASSERT( ppRequests );
 
+	if( requestCount > 1 )
 	{
-		Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-		handle->Push( pRequest );
+		std::sort( ppRequests, ppRequests + requestCount, RequestOffsetCompare() );
 	}
 
-	m_wakeUpCondition.Signal();
-}
+	uint64_t startTime = Timer::GetTickCount();
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		ppRequests[ requestIndex ]->timing.startTime = startTime;
+	}
 
-/// Block the current thread until all pending load requests have completed.
-///
-/// @see QueueRequest()
-void AsyncLoader::LoadWorker::Flush()
-{
-	bool isEmpty;
+	Statistics statistics;
+	MemoryZero( &statistics, sizeof( statistics ) );
+	statistics.requestCount = requestCount;
+
+	FileStream* pFileStream = m_pLoader->AcquireFileStream( ppRequests[ 0 ]->fileName );
+	bool bStreamValid = ( pFileStream != NULL );
+
+	size_t startIndex = 0;
+	while( startIndex < requestCount )
 	{
-		Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-		isEmpty = handle->IsEmpty();
+		Request* pStartRequest = ppRequests[ startIndex ];
+		uint64_t rangeBegin = pStartRequest->offset;
+		uint64_t rangeEnd = rangeBegin + pStartRequest->size;
+
+		size_t endIndex = startIndex + 1;
+		for( ; endIndex < requestCount; ++endIndex )
+		{
+			Request* pRequest = ppRequests[ endIndex ];
+			if( pRequest->offset > rangeEnd + COALESCE_GAP_LIMIT )
+			{
+				break;
+			}
+
+			uint64_t requestEnd = pRequest->offset + pRequest->size;
+			uint64_t mergedEnd = ( requestEnd > rangeEnd ? requestEnd : rangeEnd );
+			if( mergedEnd - rangeBegin > COALESCE_READ_SIZE_LIMIT )
+			{
+				break;
+			}
+
+			rangeEnd = mergedEnd;
+		}
+
+		ReadRange( pFileStream, startIndex, endIndex, rangeBegin, rangeEnd, statistics, bStreamValid );
+
+		startIndex = endIndex;
 	}
 
-	while( m_processingCounter != 0 && !isEmpty )
+	if( pFileStream )
 	{
-		Thread::Yield();
+		m_pLoader->ReleaseFileStream( pFileStream, bStreamValid );
+	}
+
+	m_pLoader->AddStatistics( statistics );
+
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		m_pLoader->CompleteRequest( ppRequests[ requestIndex ] );
 	}
 }
 
-/// Acquire an exclusive lock for writing to files and flush the async loader queue.
+/// Read a range of the file and scatter it into the buffers of the requests it covers.
 ///
-/// @see Unlock()
-void AsyncLoader::LoadWorker::Lock()
+/// @param[in]    pFileStream    Open file stream, or null if the file could not be opened.
+/// @param[in]    startIndex     Index of the first request in the current batch covered by the range.
+/// @param[in]    endIndex       One past the index of the last request covered by the range.
+/// @param[in]    rangeBegin     Starting file offset of the range.
+/// @param[in]    rangeEnd       Ending file offset of the range (exclusive).
+/// @param[inout] rStatistics    Statistics to update.
+/// @param[inout] rbStreamValid  Cleared if a seek fails, in which case the stream will not be reused.
+void AsyncLoader::LoadWorker::ReadRange(
+	FileStream* pFileStream,
+	size_t startIndex,
+	size_t endIndex,
+	uint64_t rangeBegin,
+	uint64_t rangeEnd,
+	Statistics& rStatistics,
+	bool& rbStreamValid )
 {
-	// Prevent other threads from queueing requests or writing out data while we have a write lock.
-	m_writeLock.LockWrite();
+	HELIUM_ASSERT( startIndex < endIndex );
+	HELIUM_ASSERT( rangeBegin <= rangeEnd );
 
-	Flush();
+	Request** ppRequests = m_batch.GetData() + startIndex;
+	size_t requestCount = endIndex - startIndex;
+
+	if( !pFileStream )
+	{
+		for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+		{
+			SetInvalid( ppRequests[ requestIndex ]->bytesRead );
+		}
+
+		return;
+	}
+
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		ppRequests[ requestIndex ]->bytesRead = 0;
+	}
+
+	++rStatistics.readCount;
+
+	m_pBufferedStream->Open( pFileStream );
+
+	int64_t offset = m_pBufferedStream->Seek( rangeBegin, SeekOrigins::Begin );
+	if( static_cast< uint64_t >( offset ) != rangeBegin )
+	{
+		rbStreamValid = false;
+	}
+	else if( requestCount == 1 && !ppRequests[ 0 ]->pDecodeFunction )
+	{
+		// Nothing to merge or decode, so read straight into the destination buffer.
+		Request* pRequest = ppRequests[ 0 ];
+		pRequest->bytesRead = m_pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
+	}
+	else
+	{
+		size_t rangeSize = static_cast< size_t >( rangeEnd - rangeBegin );
+		m_mergeBuffer.Resize( rangeSize );
+		uint8_t* pMergeBuffer = m_mergeBuffer.GetData();
+
+		size_t rangeBytesRead = m_pBufferedStream->Read( pMergeBuffer, 1, rangeSize );
+
+		size_t requestedByteCount = 0;
+		uint64_t coveredEnd = rangeBegin;
+		for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+		{
+			Request* pRequest = ppRequests[ requestIndex ];
+			size_t requestOffset = static_cast< size_t >( pRequest->offset - rangeBegin );
+			if( requestOffset < rangeBytesRead )
+			{
+				size_t availableSize = rangeBytesRead - requestOffset;
+				if( availableSize > pRequest->size )
+				{
+					availableSize = pRequest->size;
+				}
+
+				pRequest->bytesRead = DeliverRequest( pRequest, pMergeBuffer + requestOffset, availableSize );
+			}
+
+			requestedByteCount += pRequest->size;
+
+			// Only count bytes not covered by any request as gap bytes (requests may overlap).
+			uint64_t requestEnd = pRequest->offset + pRequest->size;
+			if( pRequest->offset > coveredEnd )
+			{
+				rStatistics.gapByteCount += pRequest->offset - coveredEnd;
+			}
+
+			if( requestEnd > coveredEnd )
+			{
+				coveredEnd = requestEnd;
+			}
+		}
+
+		if( requestCount > 1 )
+		{
+			rStatistics.mergedRequestCount += requestCount;
+			rStatistics.mergedByteCount += requestedByteCount;
+		}
+	}
+
+	m_pBufferedStream->Open( NULL );
 }
 
-/// Release an exclusive lock for writing to files.
+/// Copy or decode data read for a request into the request's output buffer.
 ///
-/// @see Lock()
-void AsyncLoader::LoadWorker::Unlock()
+/// @param[in] pRequest    Request being serviced.
+/// @param[in] pSource     Data read from the file for the request.
+/// @param[in] sourceSize  Number of bytes available in the source buffer.
+///
+/// @return  Number of bytes written to the request buffer, or an invalid index if decoding failed.
+size_t AsyncLoader::LoadWorker::DeliverRequest( Request* pRequest, const uint8_t* pSource, size_t sourceSize )
 {
-	m_writeLock.UnlockWrite();
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pSource || sourceSize == 0 );
+
+	if( pRequest->pDecodeFunction )
+	{
+		return pRequest->pDecodeFunction( pRequest->pBuffer, pRequest->bufferSize, pSource, sourceSize );
+	}
+
+	MemoryCopy( pRequest->pBuffer, pSource, sourceSize );
+
+	return sourceSize;
 }
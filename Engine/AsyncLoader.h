@@ -21,7 +21,22 @@
 
 namespace Helium
 {
+	class FileStream;
+	class BufferedStream;
+
 	/// Async loading manager.
+	///
+	/// Requests are serviced by a pool of I/O worker threads.  Higher priority requests are always dequeued before
+	/// lower priority requests, and requests of the same priority are serviced in the order in which they were queued.
+	/// Open file handles are kept in a small least-recently-used cache (bounded by FILE_STREAM_LIMIT) so that runs of
+	/// reads against the same file do not reopen the file for each request.
+	///
+	/// When a worker picks up a request, it also pulls other pending requests against the same file, sorts them by
+	/// offset, and merges adjacent or nearly adjacent ranges into a single read that is scattered into the individual
+	/// request buffers.
+	///
+	/// Requests queued with a decode function read their stored (compressed) bytes from the file and are decoded into
+	/// the request buffer on the worker thread, so decompression overlaps with other I/O instead of stalling the caller.
 	class HELIUM_ENGINE_API AsyncLoader : NonCopyable
 	{
 	public:
@@ -29,6 +44,17 @@ namespace Helium
 		static const size_t REQUEST_POOL_BLOCK_SIZE = 128;
 		/// Maximum number of open file streams.
 		static const size_t FILE_STREAM_LIMIT = 16;
+		/// Default number of I/O worker threads.
+		static const size_t DEFAULT_WORKER_COUNT = 2;
+
+		/// Maximum number of unrequested bytes between two requests that may still be merged into a single read.
+		static const size_t COALESCE_GAP_LIMIT = 64 * 1024;
+		/// Maximum size of a single merged read.
+		static const size_t COALESCE_READ_SIZE_LIMIT = 4 * 1024 * 1024;
+		/// Maximum number of requests that can be grouped into a single batch.
+		static const size_t COALESCE_REQUEST_LIMIT = 256;
+		/// Maximum number of queued requests inspected when gathering a batch.
+		static const size_t COALESCE_SCAN_LIMIT = 1024;
 
 		/// Load request priority.
 		enum EPriority
@@ -44,10 +70,55 @@ namespace Helium
 			PRIORITY_LAST = PRIORITY_MAX - 1
 		};
 
+		/// Function used to decode the data read for a request on a worker thread.
+		///
+		/// @param[out] pDestination     Buffer in which to store the decoded data.
+		/// @param[in]  destinationSize  Size of the destination buffer.  Decoding stops once it has been filled.
+		/// @param[in]  pSource          Data read from the file.
+		/// @param[in]  sourceSize       Number of bytes read from the file.
+		///
+		/// @return  Number of bytes written to the destination buffer, or an invalid index if the source data could not
+		///          be decoded.
+		typedef size_t ( DECODE_FUNCTION )(
+			void* pDestination, size_t destinationSize, const void* pSource, size_t sourceSize );
+
+		/// Load request timing information (timer tick counts).
+		struct RequestTiming
+		{
+			/// Time at which the request was queued.
+			uint64_t queueTime;
+			/// Time at which a worker started servicing the request.
+			uint64_t startTime;
+			/// Time at which the request finished processing.
+			uint64_t endTime;
+		};
+
+		/// I/O statistics.
+		struct Statistics
+		{
+			/// Number of requests serviced.
+			uint64_t requestCount;
+			/// Number of seek and read operations issued to service those requests.
+			uint64_t readCount;
+			/// Number of requests serviced as part of a merged read.
+			uint64_t mergedRequestCount;
+			/// Number of requested bytes delivered through merged reads.
+			uint64_t mergedByteCount;
+			/// Number of unrequested bytes read to bridge gaps between merged requests.
+			uint64_t gapByteCount;
+
+			/// @name Data Access
+			//@{
+			inline uint64_t GetSavedReadCount() const;
+			//@}
+		};
+
 		/// @name Initialization
 		//@{
-		bool Initialize();
+		bool Initialize( size_t workerCount = DEFAULT_WORKER_COUNT );
 		void Shutdown();
+
+		inline size_t GetWorkerCount() const;
 		//@}
 
 		/// @name Load Request Management
@@ -55,13 +126,25 @@ namespace Helium
 		size_t QueueRequest(
 			void* pBuffer, const String& rFileName, uint64_t offset, size_t size,
 			EPriority priority = PRIORITY_NORMAL );
-		size_t SyncRequest( size_t id );
-		bool TrySyncRequest( size_t id, size_t& rBytesRead );
+		size_t QueueDecodeRequest(
+			void* pBuffer, size_t bufferSize, const String& rFileName, uint64_t offset, size_t size,
+			DECODE_FUNCTION* pDecodeFunction, EPriority priority = PRIORITY_NORMAL );
+		size_t SyncRequest( size_t id, RequestTiming* pTiming = NULL );
+		bool TrySyncRequest( size_t id, size_t& rBytesRead, RequestTiming* pTiming = NULL );
+		bool CancelRequest( size_t id );
 
 		void Flush();
 
 		void Lock();
 		void Unlock();
+
+		inline int32_t GetCompletedCounter() const;
+		//@}
+
+		/// @name Statistics
+		//@{
+		void GetStatistics( Statistics& rStatistics ) const;
+		void ResetStatistics();
 		//@}
 
 		/// @name Static Access
@@ -82,22 +165,71 @@ namespace Helium
 			uint64_t offset;
 			/// Number of bytes to read.
 			size_t size;
+			/// Size of the output buffer (only used when decoding).
+			size_t bufferSize;
+			/// Function with which to decode the data read into the output buffer, or null to read directly.
+			DECODE_FUNCTION* pDecodeFunction;
 			/// Priority.
 			EPriority priority;
 
+			/// Previous request in the same priority queue.
+			Request* pPrevious;
+			/// Next request in the same priority queue.
+			Request* pNext;
+			/// True while this request is still waiting in a priority queue (guarded by the queue lock).
+			bool bQueued;
+
+			/// Request timing.
+			RequestTiming timing;
+
 			/// Number of bytes read.
 			volatile size_t bytesRead;
 			/// Set to a non-zero value once this request has been processed.
 			volatile int32_t processedCounter;
 		};
 
+		/// Per-priority FIFO request queues.
+		struct RequestQueue
+		{
+			/// First (oldest) request in each priority queue.
+			Request* pHeads[ PRIORITY_MAX ];
+			/// Last (newest) request in each priority queue.
+			Request* pTails[ PRIORITY_MAX ];
+
+			/// @name Construction/Destruction
+			//@{
+			RequestQueue();
+			//@}
+
+			/// @name Queue Operations
+			//@{
+			void Push( Request* pRequest );
+			Request* Pop();
+			void Remove( Request* pRequest );
+			bool IsEmpty() const;
+			//@}
+		};
+
+		/// Cached file stream information.
+		struct FileStreamEntry
+		{
+			/// File name.
+			String fileName;
+			/// Open file stream.
+			FileStream* pStream;
+			/// Last time (in file stream cache accesses) that this stream was released.
+			uint64_t lastUseTime;
+			/// True if a worker is currently reading from this stream.
+			bool bInUse;
+		};
+
 		/// Async loading thread runnable.
 		class LoadWorker : public Runnable
 		{
 		public:
 			/// @name Construction/Destruction
 			//@{
-			LoadWorker();
+			explicit LoadWorker( AsyncLoader* pLoader );
 			virtual ~LoadWorker();
 			//@}
 
@@ -109,39 +241,61 @@ namespace Helium
 			/// @name External Thread Control
 			//@{
 			void Stop();
-			//@}
-
-			/// @name External Request Queue Control
-			//@{
-			void QueueRequest( Request* pRequest );
-			void Flush();
-
-			void Lock();
-			void Unlock();
+			void WakeUp();
 			//@}
 
 		private:
-			/// Async load request queue.
-			Locker< DynamicArray< Request* >, SpinLock > m_requestQueue;
+			/// Owning async loader.
+			AsyncLoader* m_pLoader;
+
+			/// Buffered stream used for reading.
+			BufferedStream* m_pBufferedStream;
+			/// Requests currently being processed, sorted by offset.
+			DynamicArray< Request* > m_batch;
+			/// Scratch buffer for merged reads.
+			DynamicArray< uint8_t > m_mergeBuffer;
 			/// Condition used to wake up the worker thread when load requests are queued (or when it should shut down).
 			Condition m_wakeUpCondition;
 
-			/// Read-write lock used for synchronization of external file writes.
-			ReadWriteLock m_writeLock;
-
 			/// Non-zero if this thread should stop when next possible, zero if it should continue.
 			volatile int32_t m_stopCounter;
-			/// Non-zero if this thread is currently processing a load request.
-			volatile int32_t m_processingCounter;
+
+			/// @name Request Processing
+			//@{
+			void ProcessBatch();
+			void ReadRange( FileStream* pFileStream, size_t startIndex, size_t endIndex, uint64_t rangeBegin,
+				uint64_t rangeEnd, Statistics& rStatistics, bool& rbStreamValid );
+			static size_t DeliverRequest( Request* pRequest, const uint8_t* pSource, size_t sourceSize );
+			//@}
 		};
 
 		/// Pool of async load request objects.
 		ObjectPool< Request > m_requestPool;
 
-		/// Async loading thread.
-		RunnableThread* m_pThread;
-		/// Async loading thread worker.
-		LoadWorker* m_pWorker;
+		/// Pending load request queues.
+		Locker< RequestQueue, SpinLock > m_requestQueue;
+		/// Number of requests queued or in progress.
+		volatile int32_t m_pendingCount;
+		/// Number of requests that have finished processing (wraps around).
+		volatile int32_t m_completedCounter;
+
+		/// Read-write lock used for synchronization of external file writes.
+		ReadWriteLock m_writeLock;
+
+		/// Accumulated I/O statistics.
+		mutable Locker< Statistics, SpinLock > m_statistics;
+
+		/// Open file stream cache, ordered arbitrarily (LRU order is tracked through each entry's use time).
+		DynamicArray< FileStreamEntry > m_fileStreams;
+		/// File stream cache access counter.
+		uint64_t m_fileStreamUseTime;
+		/// File stream cache lock.
+		Mutex m_fileStreamLock;
+
+		/// Async loading threads.
+		DynamicArray< RunnableThread* > m_threads;
+		/// Async loading thread workers.
+		DynamicArray< LoadWorker* > m_workers;
 
 		/// Singleton instance.
 		static AsyncLoader* sm_pInstance;
@@ -151,5 +305,19 @@ namespace Helium
 		AsyncLoader();
 		~AsyncLoader();
 		//@}
+
+		/// @name Worker Support
+		//@{
+		Request* DequeueRequest();
+		void DequeueBatch( DynamicArray< Request* >& rBatch );
+		void AddStatistics( const Statistics& rStatistics );
+		void CompleteRequest( Request* pRequest );
+
+		FileStream* AcquireFileStream( const String& rFileName );
+		void ReleaseFileStream( FileStream* pStream, bool bKeepOpen );
+		void CloseIdleFileStreams();
+		//@}
 	};
 }
+
+#include "Engine/AsyncLoader.inl"
@@ -0,0 +1,28 @@
+/// Get the number of I/O worker threads servicing load requests.
+///
+/// @return  Number of active worker threads.
+///
+/// @see Initialize()
+size_t Helium::AsyncLoader::GetWorkerCount() const
+{
+	return m_workers.GetSize();
+}
+
+/// Get a counter that changes each time a load request finishes processing.
+///
+/// Callers waiting on async loads can compare this against a previously sampled value to skip polling their requests
+/// when no I/O has completed in the meantime.
+///
+/// @return  Current completed request counter.
+int32_t Helium::AsyncLoader::GetCompletedCounter() const
+{
+	return m_completedCounter;
+}
+
+/// Get the number of seek and read operations avoided by merging requests.
+///
+/// @return  Number of requests serviced minus the number of reads issued.
+uint64_t Helium::AsyncLoader::Statistics::GetSavedReadCount() const
+{
+	return ( requestCount > readCount ? requestCount - readCount : 0 );
+}
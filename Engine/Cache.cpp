@@ -1,6 +1,7 @@
 #include "EnginePch.h"
 #include "Engine/Cache.h"
 
+#include "Foundation/FilePath.h"
 #include "Foundation/FileStream.h"
 #include "Foundation/MemoryStream.h"
 #include "Foundation/StringConverter.h"
@@ -9,31 +10,130 @@
 #include "Engine/FileLocations.h"
 #include "Engine/AsyncLoader.h"
 
-#define USE_BSON_FOR_CACHE_FORMAT 0
-#define USE_JSON_FOR_CACHE_FORMAT 1
-
-#if USE_BSON_FOR_CACHE_FORMAT
-#include "Persist/ArchiveBson.h"
-typedef Helium::Persist::ArchiveWriterBson CacheArchiveWriter;
-typedef Helium::Persist::ArchiveReaderBson CacheArchiveReader;
-#elif USE_JSON_FOR_CACHE_FORMAT
 #include "Persist/ArchiveJson.h"
-typedef Helium::Persist::ArchiveWriterJson CacheArchiveWriter;
-typedef Helium::Persist::ArchiveReaderJson CacheArchiveReader;
-#else
 #include "Persist/ArchiveMessagePack.h"
-typedef Helium::Persist::ArchiveWriterMessagePack CacheArchiveWriter;
-typedef Helium::Persist::ArchiveReaderMessagePack CacheArchiveReader;
-#endif
+
+#include "zlib/zlib.h"
+
+#include <algorithm>
+
+/// Set to write cached objects as JSON text instead of the binary format (useful for inspecting cooked data).  Both
+/// formats can always be read, as each cached object is tagged with the format used to write it.
+#define USE_JSON_FOR_CACHE_FORMAT 0
 
 using namespace Helium;
 
+/// Sort comparison for ordering cache entries by file offset.
+struct EntryOffsetCompare
+{
+	template< typename T >
+	bool operator()( const T* pEntry0, const T* pEntry1 ) const
+	{
+		return ( pEntry0->offset < pEntry1->offset );
+	}
+};
+
 /// TOC header magic number.
 static const uint32_t TOC_MAGIC = 0xcac4e70c;
 /// TOC header magic number (byte-swapped).
 static const uint32_t TOC_MAGIC_SWAPPED = 0x0ce7c4ca;
 /// Cache format version number.
-const uint32_t Cache::sm_Version = 0;
+///
+/// Version history:
+/// - 0: Cached objects stored as untagged JSON text.
+/// - 1: Cached objects stored with a format-tagged header, binary (MessagePack) payloads by default.
+/// - 2: TOC entries record the compression method and uncompressed size of each entry.
+/// - 3: TOC entries record the paths of the assets referenced by each cached object.
+const uint32_t Cache::sm_Version = 3;
+
+/// Cached object header magic number ("HCOB" when stored little-endian).
+static const uint32_t CACHE_OBJECT_MAGIC = 0x424f4348;
+/// Size of the cached object header, in bytes (magic, format tag, three reserved bytes, payload size).
+static const size_t CACHE_OBJECT_HEADER_SIZE = 12;
+
+/// Cached object payload formats.
+enum ECacheObjectFormat
+{
+	/// MessagePack encoding, read field by field directly from the stream without building a DOM.  Fields are tagged
+	/// with their names, but maps and arrays only record element counts (not byte lengths), so skipping an unknown
+	/// field means parsing its whole value.  Multi-byte values are big-endian as MessagePack requires; only the
+	/// object header is little-endian.
+	CACHE_OBJECT_FORMAT_BINARY = 0,
+	/// JSON text encoding.
+	CACHE_OBJECT_FORMAT_JSON   = 1,
+};
+
+/// Write a 32-bit value in little-endian byte order.
+///
+/// @param[out] pDestination  Output buffer.
+/// @param[in]  value         Value to write.
+static void StoreLittleEndian32( uint8_t* pDestination, uint32_t value )
+{
+	pDestination[ 0 ] = static_cast< uint8_t >( value );
+	pDestination[ 1 ] = static_cast< uint8_t >( value >> 8 );
+	pDestination[ 2 ] = static_cast< uint8_t >( value >> 16 );
+	pDestination[ 3 ] = static_cast< uint8_t >( value >> 24 );
+}
+
+/// Read a 32-bit value stored in little-endian byte order.
+///
+/// @param[in] pSource  Input buffer.
+///
+/// @return  Value read.
+static uint32_t LoadLittleEndian32( const uint8_t* pSource )
+{
+	return
+		static_cast< uint32_t >( pSource[ 0 ] ) |
+		( static_cast< uint32_t >( pSource[ 1 ] ) << 8 ) |
+		( static_cast< uint32_t >( pSource[ 2 ] ) << 16 ) |
+		( static_cast< uint32_t >( pSource[ 3 ] ) << 24 );
+}
+
+/// Decode zlib-compressed entry data (AsyncLoader::DECODE_FUNCTION implementation).
+///
+/// Decoding stops once the destination buffer has been filled, so partial loads of the start of an entry are
+/// supported.
+///
+/// @param[out] pDestination     Buffer in which to store the decompressed data.
+/// @param[in]  destinationSize  Size of the destination buffer.
+/// @param[in]  pSource          Compressed data.
+/// @param[in]  sourceSize       Size of the compressed data.
+///
+/// @return  Number of bytes written to the destination buffer, or an invalid index if the data is corrupt.
+static size_t DecompressZlib( void* pDestination, size_t destinationSize, const void* pSource, size_t sourceSize )
+{
+	HELIUM_ASSERT( pDestination || destinationSize == 0 );
+	HELIUM_ASSERT( pSource || sourceSize == 0 );
+
+	z_stream stream;
+	MemoryZero( &stream, sizeof( stream ) );
+	stream.next_in = const_cast< Bytef* >( static_cast< const Bytef* >( pSource ) );
+	stream.avail_in = static_cast< uInt >( sourceSize );
+	stream.next_out = static_cast< Bytef* >( pDestination );
+	stream.avail_out = static_cast< uInt >( destinationSize );
+
+	if( inflateInit( &stream ) != Z_OK )
+	{
+		return Invalid< size_t >();
+	}
+
+	int result = inflate( &stream, Z_FINISH );
+	size_t bytesWritten = static_cast< size_t >( stream.total_out );
+	inflateEnd( &stream );
+
+	// Running out of output space before the end of the stream is expected for partial loads.
+	if( result != Z_STREAM_END && !( result == Z_BUF_ERROR && stream.avail_out == 0 ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache: Failed to decompress entry data (zlib error %d).\n" ),
+			result );
+
+		return Invalid< size_t >();
+	}
+
+	return bytesWritten;
+}
 
 /// Constructor.
 Cache::Cache()
@@ -43,6 +143,11 @@ Cache::Cache()
 , m_asyncLoadId( Invalid< size_t >() )
 , m_pTocBuffer( NULL )
 , m_tocSize( Invalid< uint32_t >() )
+, m_bMemoryMappingEnabled( false )
+, m_writeDepth( 0 )
+, m_writeOffset( 0 )
+, m_pWriteStream( NULL )
+, m_bTocDirty( false )
 , m_pEntryPool( NULL )
 {
 }
@@ -110,6 +215,8 @@ bool Cache::Initialize( Name name, EPlatform platform, const char* pTocFileName,
 /// @see Initialize()
 void Cache::Shutdown()
 {
+	HELIUM_ASSERT( !IsWriting() );
+
 	m_name = NULL_NAME;
 	m_platform = PLATFORM_INVALID;
 
@@ -126,6 +233,8 @@ void Cache::Shutdown()
 	m_pTocBuffer = NULL;
 	SetInvalid( m_tocSize );
 
+	m_cacheMapping.Close();
+
 	m_bTocLoaded = false;
 
 	m_entries.Clear();
@@ -171,6 +280,12 @@ bool Cache::BeginLoadToc()
 		return false;
 	}
 
+	// Parse the TOC in place if memory mapping is enabled, falling back to an async load if the mapping fails.
+	if( m_bMemoryMappingEnabled && LoadMappedToc() )
+	{
+		return true;
+	}
+
 	HELIUM_ASSERT( !m_pTocBuffer );
 	DefaultAllocator allocator;
 	m_pTocBuffer = static_cast< uint8_t* >( allocator.Allocate( m_tocSize ) );
@@ -254,25 +369,14 @@ bool Cache::TryFinishLoadToc()
 			m_tocSize = static_cast< uint32_t >( bytesRead );
 		}
 
-		bool bFinalizeResult = FinalizeTocLoad();
+		bool bFinalizeResult = FinalizeTocLoad( m_pTocBuffer, m_tocSize );
 
 		DefaultAllocator().Free( m_pTocBuffer );
 		m_pTocBuffer = NULL;
 
 		if( !bFinalizeResult )
 		{
-			HELIUM_ASSERT( m_pEntryPool );
-
-			size_t entryCount = m_entries.GetSize();
-			for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
-			{
-				Entry* pEntry = m_entries[ entryIndex ];
-				HELIUM_ASSERT( pEntry );
-				m_pEntryPool->Release( pEntry );
-			}
-
-			m_entries.Clear();
-			m_entryMap.Clear();
+			ReleaseEntries();
 		}
 	}
 
@@ -292,7 +396,7 @@ void Cache::EnforceTocLoad()
 
 		if( BeginLoadToc() )
 		{
-			while( !TryFinishLoadToc() )
+			while( !IsTocLoaded() && !TryFinishLoadToc() )
 			{
 				Thread::Yield();
 			}
@@ -324,28 +428,313 @@ const Cache::Entry* Cache::FindEntry( AssetPath path, uint32_t subDataIndex ) co
 	return pEntry;
 }
 
+/// Get a pointer to the data for a cache entry within the memory-mapped cache file.
+///
+/// The returned pointer remains valid until the cache is shut down or modified using CacheEntry().
+///
+/// @param[in] rEntry  Cache entry.
+///
+/// @return  Pointer to the entry data if the cache file is memory-mapped and the entry lies within the mapped file,
+///          null if the entry data must be loaded asynchronously instead.
+///
+/// @see IsMemoryMapped(), SetMemoryMappingEnabled()
+const uint8_t* Cache::GetMappedEntryData( const Entry& rEntry ) const
+{
+	const uint8_t* pCacheData = m_cacheMapping.GetData();
+	if( !pCacheData )
+	{
+		return NULL;
+	}
+
+	// Compressed entries cannot be used in place.
+	if( rEntry.compression != COMPRESSION_NONE )
+	{
+		return NULL;
+	}
+
+	uint64_t mappedSize = m_cacheMapping.GetSize();
+	if( rEntry.offset > mappedSize || rEntry.size > mappedSize - rEntry.offset )
+	{
+		return NULL;
+	}
+
+	return pCacheData + rEntry.offset;
+}
+
+/// Begin asynchronous loading of the data for a cache entry.
+///
+/// Compressed entries are decompressed into the given buffer on the AsyncLoader worker thread, so the number of bytes
+/// reported once the request completes is always in terms of the uncompressed entry data.  The buffer may be smaller
+/// than the uncompressed entry size, in which case only the start of the entry is loaded.
+///
+/// @param[in] rEntry      Cache entry to load.
+/// @param[in] pBuffer     Buffer in which to store the (uncompressed) entry data.
+/// @param[in] bufferSize  Size of the buffer.
+/// @param[in] priority    Load priority.
+///
+/// @return  AsyncLoader request ID if the load was queued successfully, invalid index if not.
+///
+/// @see AsyncLoader::SyncRequest(), AsyncLoader::TrySyncRequest()
+size_t Cache::BeginLoadEntry(
+							 const Entry& rEntry,
+							 void* pBuffer,
+							 size_t bufferSize,
+							 AsyncLoader::EPriority priority ) const
+{
+	HELIUM_ASSERT( pBuffer );
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+
+	switch( rEntry.compression )
+	{
+	case COMPRESSION_NONE:
+		{
+			size_t loadSize = Min< size_t >( rEntry.size, bufferSize );
+
+			return rLoader.QueueRequest( pBuffer, m_cacheFileName, rEntry.offset, loadSize, priority );
+		}
+
+	case COMPRESSION_ZLIB:
+		{
+			return rLoader.QueueDecodeRequest(
+				pBuffer,
+				bufferSize,
+				m_cacheFileName,
+				rEntry.offset,
+				rEntry.size,
+				DecompressZlib,
+				priority );
+		}
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Error,
+		TXT( "Cache::BeginLoadEntry(): Entry \"%s\" uses an unknown compression method (%" ) PRIu32 TXT( ").\n" ),
+		*rEntry.path.ToString(),
+		static_cast< uint32_t >( rEntry.compression ) );
+
+	return Invalid< size_t >();
+}
+
+/// Compress data for storage in a cache.
+///
+/// @param[in]  compression   Compression method to use.
+/// @param[in]  pSource       Data to compress.
+/// @param[in]  sourceSize    Size of the data to compress.
+/// @param[out] rDestination  Compressed data.
+///
+/// @return  True if compression was successful, false if not.
+///
+/// @see DecompressData()
+bool Cache::CompressData(
+						 ECompression compression,
+						 const void* pSource,
+						 size_t sourceSize,
+						 DynamicArray< uint8_t >& rDestination )
+{
+	HELIUM_ASSERT( pSource || sourceSize == 0 );
+
+	rDestination.Resize( 0 );
+
+	switch( compression )
+	{
+	case COMPRESSION_NONE:
+		{
+			rDestination.Resize( sourceSize );
+			MemoryCopy( rDestination.GetData(), pSource, sourceSize );
+
+			return true;
+		}
+
+	case COMPRESSION_ZLIB:
+		{
+			uLongf compressedSize = compressBound( static_cast< uLong >( sourceSize ) );
+			rDestination.Resize( compressedSize );
+
+			int result = compress2(
+				rDestination.GetData(),
+				&compressedSize,
+				static_cast< const Bytef* >( pSource ),
+				static_cast< uLong >( sourceSize ),
+				Z_BEST_COMPRESSION );
+			if( result != Z_OK )
+			{
+				HELIUM_TRACE( TraceLevels::Error, TXT( "Cache::CompressData(): zlib compression failed (%d).\n" ), result );
+
+				rDestination.Resize( 0 );
+
+				return false;
+			}
+
+			rDestination.Resize( compressedSize );
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// Decompress cache entry data.
+///
+/// @param[in]  compression      Compression method used for the data.
+/// @param[out] pDestination     Buffer in which to store the decompressed data.
+/// @param[in]  destinationSize  Size of the destination buffer.  If this is smaller than the uncompressed size of the
+///                              data, only the start of the data is decompressed.
+/// @param[in]  pSource          Compressed data.
+/// @param[in]  sourceSize       Size of the compressed data.
+///
+/// @return  Number of bytes written to the destination buffer, or an invalid index if decompression failed.
+///
+/// @see CompressData(), BeginLoadEntry()
+size_t Cache::DecompressData(
+							 ECompression compression,
+							 void* pDestination,
+							 size_t destinationSize,
+							 const void* pSource,
+							 size_t sourceSize )
+{
+	switch( compression )
+	{
+	case COMPRESSION_NONE:
+		{
+			size_t copySize = Min( destinationSize, sourceSize );
+			MemoryCopy( pDestination, pSource, copySize );
+
+			return copySize;
+		}
+
+	case COMPRESSION_ZLIB:
+		{
+			return DecompressZlib( pDestination, destinationSize, pSource, sourceSize );
+		}
+	}
+
+	return Invalid< size_t >();
+}
+
+/// Begin a write transaction.
+///
+/// Entries added using CacheEntry() while a transaction is active are appended to the cache file immediately (and
+/// are visible through FindEntry() right away), but the TOC file is only rewritten once the outermost transaction is
+/// committed.  Transactions may be nested.  Since entry data is only ever appended, the TOC file on disk remains
+/// consistent with the cache file contents at all times, even if a transaction is never committed.
+///
+/// The cache file is opened for writing once by the outermost transaction and shared by all entries written until it
+/// is committed, so the AsyncLoader only needs to be locked (flushing all pending requests) when the transaction
+/// begins and when the TOC file is rewritten.
+///
+/// @see CommitWrite(), IsWriting(), CacheEntry()
+void Cache::BeginWrite()
+{
+	if( m_writeDepth++ != 0 )
+	{
+		return;
+	}
+
+	Status status;
+	status.Read( m_cacheFileName.GetData() );
+	int64_t cacheFileSize = status.m_Size;
+	m_writeOffset = ( cacheFileSize == -1 ? 0 : static_cast< uint64_t >( cacheFileSize ) );
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+
+	rLoader.Lock();
+
+	// Cache file contents are about to change, so any mapped view of the file can no longer be trusted.
+	m_cacheMapping.Close();
+
+	HELIUM_ASSERT( !m_pWriteStream );
+	m_pWriteStream = FileStream::OpenFileStream( m_cacheFileName, FileStream::MODE_WRITE, false );
+	if( !m_pWriteStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open cache \"%s\" for writing.\n" ), *m_cacheFileName );
+	}
+
+	rLoader.Unlock();
+}
+
+/// Commit a write transaction, rewriting the TOC file if this is the outermost transaction and any entries were
+/// modified.
+///
+/// @return  True if the transaction was committed successfully (or is still nested within another transaction),
+///          false if the TOC file could not be written.
+///
+/// @see BeginWrite(), IsWriting()
+bool Cache::CommitWrite()
+{
+	HELIUM_ASSERT( m_writeDepth != 0 );
+	if( --m_writeDepth != 0 )
+	{
+		return true;
+	}
+
+	delete m_pWriteStream;
+	m_pWriteStream = NULL;
+
+	if( !m_bTocDirty )
+	{
+		return true;
+	}
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+
+	rLoader.Lock();
+	bool bWriteSuccess = WriteToc( m_tocFileName );
+	rLoader.Unlock();
+
+	m_bTocDirty = !bWriteSuccess;
+
+	return bWriteSuccess;
+}
+
 /// Add or update an entry in the cache.
 ///
+/// Entry data is always appended to the end of the cache file.  Updating an existing entry leaves its previous data
+/// behind as unused space, which can be reclaimed using Compact().  If no write transaction is active, the entry is
+/// written within its own transaction (rewriting the TOC file immediately).
+///
 /// @param[in] path          Asset path.
 /// @param[in] subDataIndex  Sub-data index associated with the cached data.
 /// @param[in] pData         Data to cache.
 /// @param[in] timestamp     Timestamp value to associate with the entry in the cache.
 /// @param[in] size          Number of bytes to cache.
+/// @param[in] compression   Compression method with which to store the data.  Data is stored uncompressed instead if
+///                          compression fails or does not reduce its size.
+/// @param[in] pDependencies  Paths of the assets referenced by the cached data, or null if it has no dependencies.
 ///
 /// @return  True if the cache was updated successfully, false if not.
+///
+/// @see BeginWrite(), CommitWrite(), Compact()
 bool Cache::CacheEntry(
 					   AssetPath path,
 					   uint32_t subDataIndex,
 					   const void* pData,
 					   int64_t timestamp,
-					   uint32_t size )
+					   uint32_t size,
+					   ECompression compression,
+					   const DynamicArray< AssetPath >* pDependencies )
 {
 	HELIUM_ASSERT( pData || size == 0 );
+	HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( COMPRESSION_MAX ) );
 
-	Status status;
-	status.Read( m_cacheFileName.GetData() );
-	int64_t cacheFileSize = status.m_Size;
-	uint64_t entryOffset = ( cacheFileSize == -1 ? 0 : static_cast< uint64_t >( cacheFileSize ) );
+	// Compress the data up front, keeping it only if it actually saves space.
+	const void* pStoreData = pData;
+	uint32_t storeSize = size;
+	ECompression storeCompression = COMPRESSION_NONE;
+
+	DynamicArray< uint8_t > compressedData;
+	if( compression != COMPRESSION_NONE && size != 0 &&
+		CompressData( compression, pData, size, compressedData ) && compressedData.GetSize() < size )
+	{
+		pStoreData = compressedData.GetData();
+		storeSize = static_cast< uint32_t >( compressedData.GetSize() );
+		storeCompression = compression;
+	}
+
+	BeginWrite();
+
+	uint64_t entryOffset = m_writeOffset;
 
 	HELIUM_ASSERT( m_pEntryPool );
 	Entry* pEntryUpdate = m_pEntryPool->Allocate();
@@ -354,11 +743,16 @@ bool Cache::CacheEntry(
 	pEntryUpdate->timestamp = timestamp;
 	pEntryUpdate->path = path;
 	pEntryUpdate->subDataIndex = subDataIndex;
-	pEntryUpdate->size = size;
+	pEntryUpdate->size = storeSize;
+	pEntryUpdate->uncompressedSize = size;
+	pEntryUpdate->compression = static_cast< uint8_t >( storeCompression );
+	pEntryUpdate->dependencies.Resize( 0 );
+	if( pDependencies )
+	{
+		pEntryUpdate->dependencies.AddArray( pDependencies->GetData(), pDependencies->GetSize() );
+	}
 
-	uint64_t originalOffset = 0;
-	int64_t originalTimestamp = 0;
-	uint32_t originalSize = 0;
+	Entry originalEntry = *pEntryUpdate;
 
 	EntryKey key;
 	key.path = path;
@@ -381,43 +775,32 @@ bool Cache::CacheEntry(
 		pEntryUpdate = entryAccessor->Second();
 		HELIUM_ASSERT( pEntryUpdate );
 
-		originalOffset = pEntryUpdate->offset;
-		originalTimestamp = pEntryUpdate->timestamp;
-		originalSize = pEntryUpdate->size;
+		originalEntry = *pEntryUpdate;
 
-		if( originalSize < size )
-		{
-			pEntryUpdate->offset = entryOffset;
-		}
-		else
+		pEntryUpdate->offset = entryOffset;
+		pEntryUpdate->timestamp = timestamp;
+		pEntryUpdate->size = storeSize;
+		pEntryUpdate->uncompressedSize = size;
+		pEntryUpdate->compression = static_cast< uint8_t >( storeCompression );
+		pEntryUpdate->dependencies.Resize( 0 );
+		if( pDependencies )
 		{
-			entryOffset = originalOffset;
+			pEntryUpdate->dependencies.AddArray( pDependencies->GetData(), pDependencies->GetSize() );
 		}
-
-		pEntryUpdate->timestamp = timestamp;
-		pEntryUpdate->size = size;
 	}
 
-	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
-
-	rLoader.Lock();
-
-	bool bCacheSuccess = true;
-
-	FileStream* pCacheStream = FileStream::OpenFileStream( m_cacheFileName, FileStream::MODE_WRITE, false );
-	if( !pCacheStream )
-	{
-		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open cache \"%s\" for writing.\n" ), *m_cacheFileName );
+	bool bCacheSuccess = false;
 
-		bCacheSuccess = false;
-	}
-	else
+	FileStream* pCacheStream = m_pWriteStream;
+	if( pCacheStream )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Info,
-			TXT( "Cache: Caching \"%s\" to \"%s\" (%" ) PRIu32 TXT( " bytes @ offset %" ) PRIu64 TXT( ").\n" ),
+			( TXT( "Cache: Caching \"%s\" to \"%s\" (%" ) PRIu32 TXT( " bytes, %" ) PRIu32
+			TXT( " uncompressed @ offset %" ) PRIu64 TXT( ").\n" ) ),
 			*path.ToString(),
 			*m_cacheFileName,
+			storeSize,
 			size,
 			entryOffset );
 
@@ -427,116 +810,350 @@ bool Cache::CacheEntry(
 		if( seekOffset != entryOffset )
 		{
 			HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Cache file offset seek failed.\n" ) );
-
-			if( bNewEntry )
-			{
-				m_entries.Pop();
-				m_entryMap.Remove( entryAccessor );
-				m_pEntryPool->Release( pEntryUpdate );
-			}
-			else
-			{
-				pEntryUpdate->offset = originalOffset;
-				pEntryUpdate->timestamp = originalTimestamp;
-				pEntryUpdate->size = originalSize;
-			}
-
-			bCacheSuccess = false;
 		}
 		else
 		{
-			size_t writeSize = pCacheStream->Write( pData, 1, size );
-			if( writeSize != size )
+			size_t writeSize = pCacheStream->Write( pStoreData, 1, storeSize );
+			if( writeSize != storeSize )
 			{
 				HELIUM_TRACE(
 					TraceLevels::Error,
 					( TXT( "Cache: Failed to write %" ) PRIu32 TXT( " bytes to cache \"%s\" (%" ) PRIuSZ
 					TXT( " bytes written).\n" ) ),
-					size,
+					storeSize,
 					*m_cacheFileName,
 					writeSize );
-
-				if( bNewEntry )
-				{
-					m_entries.Pop();
-					m_entryMap.Remove( entryAccessor );
-					m_pEntryPool->Release( pEntryUpdate );
-				}
-				else
-				{
-					pEntryUpdate->offset = originalOffset;
-					pEntryUpdate->timestamp = originalTimestamp;
-					pEntryUpdate->size = originalSize;
-				}
-
-				bCacheSuccess = false;
 			}
 			else
 			{
-				HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *m_tocFileName );
+				// The entry is visible through FindEntry() right away, so make sure its data can be read back before
+				// the transaction is committed.
+				pCacheStream->Flush();
 
-				FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, true );
-				if( !pTocStream )
-				{
-					HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
-				}
-				else
-				{
-					BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
-					HELIUM_ASSERT( pBufferedStream );
+				bCacheSuccess = true;
+			}
+		}
+	}
+
+	if( bCacheSuccess )
+	{
+		m_writeOffset += storeSize;
+		m_bTocDirty = true;
+	}
+	else if( bNewEntry )
+	{
+		m_entries.Pop();
+		m_entryMap.Remove( entryAccessor );
+		m_pEntryPool->Release( pEntryUpdate );
+	}
+	else
+	{
+		*pEntryUpdate = originalEntry;
+	}
+
+	bool bCommitSuccess = CommitWrite();
+
+	return ( bCacheSuccess && bCommitSuccess );
+}
+
+/// Rewrite the cache file without any unused space left behind by updated entries.
+///
+/// This is intended to be run offline (i.e. from a tool, or between cooks), as it rewrites the entire cache file and
+/// all entry offsets change.  The compacted data and its TOC are first written to temporary files next to the cache
+/// and TOC files.  The original TOC is then deleted before the temporary files are renamed over the originals, so
+/// that an interruption leaves a cache without a TOC (which is rebuilt) rather than a TOC pointing at the wrong data.
+/// If compaction fails, the original cache file and in-memory entries are left untouched, and the original TOC is
+/// written back if it had already been deleted.
+///
+/// @return  True if the cache was compacted successfully, false if not.
+bool Cache::Compact()
+{
+	HELIUM_ASSERT( !IsWriting() );
+
+	EnforceTocLoad();
+
+	// Copy entries in file offset order so that both files are read and written sequentially.
+	size_t entryCount = m_entries.GetSize();
+
+	DynamicArray< Entry* > sortedEntries;
+	sortedEntries.Reserve( entryCount );
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		sortedEntries.Push( m_entries[ entryIndex ] );
+	}
+
+	std::sort( sortedEntries.GetData(), sortedEntries.GetData() + entryCount, EntryOffsetCompare() );
+
+	String compactFileName = m_cacheFileName;
+	compactFileName += TXT( ".compact" );
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+
+	rLoader.Lock();
+
+	m_cacheMapping.Close();
+
+	DynamicArray< uint64_t > compactOffsets;
+	compactOffsets.Reserve( entryCount );
+
+	DynamicArray< uint8_t > copyBuffer;
+
+	bool bCompactSuccess = true;
+
+	FileStream* pSourceStream = FileStream::OpenFileStream( m_cacheFileName, FileStream::MODE_READ );
+	FileStream* pCompactStream = FileStream::OpenFileStream( compactFileName, FileStream::MODE_WRITE, true );
+	if( !pSourceStream || !pCompactStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Compact(): Failed to open cache \"%s\" or temporary file \"%s\".\n" ),
+			*m_cacheFileName,
+			*compactFileName );
+
+		bCompactSuccess = false;
+	}
+	else
+	{
+		uint64_t compactOffset = 0;
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			const Entry* pEntry = sortedEntries[ entryIndex ];
+			HELIUM_ASSERT( pEntry );
+
+			copyBuffer.Resize( pEntry->size );
+
+			int64_t seekOffset = pSourceStream->Seek( static_cast< int64_t >( pEntry->offset ), SeekOrigins::Begin );
+			if( static_cast< uint64_t >( seekOffset ) != pEntry->offset ||
+				pSourceStream->Read( copyBuffer.GetData(), 1, pEntry->size ) != pEntry->size ||
+				pCompactStream->Write( copyBuffer.GetData(), 1, pEntry->size ) != pEntry->size )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					TXT( "Cache::Compact(): Failed to copy the data for \"%s\" (sub-data %" ) PRIu32 TXT( ").\n" ),
+					*pEntry->path.ToString(),
+					pEntry->subDataIndex );
+
+				bCompactSuccess = false;
+
+				break;
+			}
+
+			compactOffsets.Push( compactOffset );
+			compactOffset += pEntry->size;
+		}
+	}
+
+	delete pCompactStream;
+	delete pSourceStream;
 
-					pBufferedStream->Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 );
-					pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 );
+	String compactTocFileName = m_tocFileName;
+	compactTocFileName += TXT( ".compact" );
 
-					uint32_t entryCount = static_cast< uint32_t >( m_entries.GetSize() );
-					pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 );
+	// Write a TOC for the compacted file alongside it, restoring the original entry offsets if anything fails so
+	// that the in-memory TOC keeps matching the cache file on disk.
+	uint64_t originalSize = 0;
+	uint64_t compactSize = 0;
 
-					String entryPath;
-					uint_fast32_t entryCountFast = entryCount;
-					for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
-					{
-						Entry* pEntry = m_entries[ entryIndex ];
-						HELIUM_ASSERT( pEntry );
+	DynamicArray< uint64_t > originalOffsets;
+	if( bCompactSuccess )
+	{
+		originalOffsets.Reserve( entryCount );
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			Entry* pEntry = sortedEntries[ entryIndex ];
+			HELIUM_ASSERT( pEntry );
+
+			if( pEntry->offset + pEntry->size > originalSize )
+			{
+				originalSize = pEntry->offset + pEntry->size;
+			}
+
+			originalOffsets.Push( pEntry->offset );
+			pEntry->offset = compactOffsets[ entryIndex ];
+			compactSize += pEntry->size;
+		}
 
-						pEntry->path.ToString( entryPath );
-						HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
-						uint16_t pathSize = static_cast< uint16_t >( entryPath.GetSize() );
-						pBufferedStream->Write( &pathSize, sizeof( pathSize ), 1 );
+		bCompactSuccess = WriteToc( compactTocFileName );
 
-						pBufferedStream->Write( *entryPath, sizeof( char ), pathSize );
+		// Remove the original TOC before replacing the cache file, as its offsets would point at the wrong data in the
+		// compacted file.  If we stop between the two moves, the cache is left without a TOC and gets rebuilt rather
+		// than loading the wrong bytes.
+		bool bTocRemoved = false;
+		if( bCompactSuccess )
+		{
+			FilePath tocPath( m_tocFileName.GetData() );
+			bTocRemoved = ( !tocPath.Exists() || tocPath.Delete() );
+			bCompactSuccess = bTocRemoved;
+			if( !bCompactSuccess )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					TXT( "Cache::Compact(): Failed to remove TOC \"%s\" before replacing cache \"%s\".\n" ),
+					*m_tocFileName,
+					*m_cacheFileName );
+			}
+		}
 
-						pBufferedStream->Write( &pEntry->subDataIndex, sizeof( pEntry->subDataIndex ), 1 );
+		if( bCompactSuccess )
+		{
+			// Replace the original cache file in a single step, so that it is never left partially written.
+			bCompactSuccess = FilePath( compactFileName.GetData() ).Move( FilePath( m_cacheFileName.GetData() ) );
+			if( !bCompactSuccess )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					TXT( "Cache::Compact(): Failed to replace cache \"%s\" with compacted file \"%s\".\n" ),
+					*m_cacheFileName,
+					*compactFileName );
+			}
+		}
 
-						pBufferedStream->Write( &pEntry->offset, sizeof( pEntry->offset ), 1 );
-						pBufferedStream->Write( &pEntry->timestamp, sizeof( pEntry->timestamp ), 1 );
-						pBufferedStream->Write( &pEntry->size, sizeof( pEntry->size ), 1 );
-					}
+		if( !bCompactSuccess )
+		{
+			for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+			{
+				sortedEntries[ entryIndex ]->offset = originalOffsets[ entryIndex ];
+			}
 
-					delete pBufferedStream;
-					delete pTocStream;
+			// The original cache file is still in place, so put back a TOC matching it.
+			if( bTocRemoved )
+			{
+				m_bTocDirty = !WriteToc( m_tocFileName );
+				if( m_bTocDirty )
+				{
+					HELIUM_TRACE(
+						TraceLevels::Error,
+						TXT( "Cache::Compact(): Failed to restore TOC \"%s\" for cache \"%s\".\n" ),
+						*m_tocFileName,
+						*m_cacheFileName );
 				}
 			}
 		}
+	}
+
+	if( !bCompactSuccess )
+	{
+		FilePath( compactFileName.GetData() ).Delete();
+		FilePath( compactTocFileName.GetData() ).Delete();
+	}
+	else
+	{
+		m_writeOffset = compactSize;
+
+		// The cache file now holds the compacted data, so the TOC must follow regardless.  If the compacted TOC cannot
+		// be moved into place, fall back to writing it directly (or leave it dirty for the next commit).
+		if( !FilePath( compactTocFileName.GetData() ).Move( FilePath( m_tocFileName.GetData() ) ) )
+		{
+			FilePath( compactTocFileName.GetData() ).Delete();
+
+			m_bTocDirty = !WriteToc( m_tocFileName );
+			if( m_bTocDirty )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					TXT( "Cache::Compact(): Failed to update TOC \"%s\" for compacted cache \"%s\".\n" ),
+					*m_tocFileName,
+					*m_cacheFileName );
+			}
+		}
 
-		delete pCacheStream;
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "Cache::Compact(): Compacted cache \"%s\" from %" ) PRIu64 TXT( " to %" ) PRIu64
+			TXT( " bytes.\n" ) ),
+			*m_cacheFileName,
+			originalSize,
+			compactSize );
 	}
 
 	rLoader.Unlock();
 
-	return bCacheSuccess;
+	return bCompactSuccess;
+}
+
+/// Write out the table of contents for all current entries.
+///
+/// @param[in] rTocFileName  TOC file path name.
+///
+/// @return  True if the TOC file was written successfully, false if not.
+bool Cache::WriteToc( const String& rTocFileName ) const
+{
+	HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *rTocFileName );
+
+	FileStream* pTocStream = FileStream::OpenFileStream( rTocFileName, FileStream::MODE_WRITE, true );
+	if( !pTocStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *rTocFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	pBufferedStream->Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 );
+	pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 );
+
+	uint32_t entryCount = static_cast< uint32_t >( m_entries.GetSize() );
+	pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 );
+
+	String entryPath;
+	uint_fast32_t entryCountFast = entryCount;
+	for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
+	{
+		Entry* pEntry = m_entries[ entryIndex ];
+		HELIUM_ASSERT( pEntry );
+
+		pEntry->path.ToString( entryPath );
+		HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
+		uint16_t pathSize = static_cast< uint16_t >( entryPath.GetSize() );
+		pBufferedStream->Write( &pathSize, sizeof( pathSize ), 1 );
+
+		pBufferedStream->Write( *entryPath, sizeof( char ), pathSize );
+
+		pBufferedStream->Write( &pEntry->subDataIndex, sizeof( pEntry->subDataIndex ), 1 );
+
+		pBufferedStream->Write( &pEntry->offset, sizeof( pEntry->offset ), 1 );
+		pBufferedStream->Write( &pEntry->timestamp, sizeof( pEntry->timestamp ), 1 );
+		pBufferedStream->Write( &pEntry->size, sizeof( pEntry->size ), 1 );
+		pBufferedStream->Write( &pEntry->uncompressedSize, sizeof( pEntry->uncompressedSize ), 1 );
+		pBufferedStream->Write( &pEntry->compression, sizeof( pEntry->compression ), 1 );
+
+		HELIUM_ASSERT( pEntry->dependencies.GetSize() < UINT16_MAX );
+		uint16_t dependencyCount = static_cast< uint16_t >( pEntry->dependencies.GetSize() );
+		pBufferedStream->Write( &dependencyCount, sizeof( dependencyCount ), 1 );
+
+		for( uint_fast16_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+		{
+			pEntry->dependencies[ dependencyIndex ].ToString( entryPath );
+			HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
+			pathSize = static_cast< uint16_t >( entryPath.GetSize() );
+			pBufferedStream->Write( &pathSize, sizeof( pathSize ), 1 );
+
+			pBufferedStream->Write( *entryPath, sizeof( char ), pathSize );
+		}
+	}
+
+	delete pBufferedStream;
+	delete pTocStream;
+
+	return true;
 }
 
 /// Finalize the TOC loading process.
 ///
 /// Note that this does not free any resources on a failed load (the caller is responsible for such clean-up work).
 ///
+/// @param[in] pTocData  TOC file contents.
+/// @param[in] tocSize   Size of the TOC file contents, in bytes.
+///
 /// @return  True if the TOC load was successful, false if not.
-bool Cache::FinalizeTocLoad()
+bool Cache::FinalizeTocLoad( const uint8_t* pTocData, uint32_t tocSize )
 {
-	HELIUM_ASSERT( m_pTocBuffer );
+	HELIUM_ASSERT( pTocData );
 
-	const uint8_t* pTocCurrent = m_pTocBuffer;
-	const uint8_t* pTocMax = pTocCurrent + m_tocSize;
+	const uint8_t* pTocCurrent = pTocData;
+	const uint8_t* pTocMax = pTocCurrent + tocSize;
 
 	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
 
@@ -587,13 +1204,14 @@ bool Cache::FinalizeTocLoad()
 		return false;
 	}
 
-	if( version > sm_Version )
+	if( version != sm_Version )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
-			( TXT( "Cache::FinalizeTocLoad(): Cache version number (%" ) PRIu32 TXT( ") exceeds the maximum " )
-			TXT( "supported version (%" ) PRIu32 TXT( ").\n" ) ),
+			( TXT( "Cache::FinalizeTocLoad(): Cache version number (%" ) PRIu32 TXT( ") of TOC \"%s\" does not " )
+			TXT( "match the supported version (%" ) PRIu32 TXT( ").  The cache must be rebuilt.\n" ) ),
 			version,
+			*m_tocFileName,
 			sm_Version );
 
 		return false;
@@ -710,15 +1328,87 @@ bool Cache::FinalizeTocLoad()
 			return false;
 		}
 
+		uint32_t entryUncompressedSize;
+		bReadResult = CheckedTocRead(
+			pLoadFunction,
+			entryUncompressedSize,
+			TXT( "entry uncompressed size" ),
+			pTocCurrent,
+			pTocMax );
+		if( !bReadResult )
+		{
+			return false;
+		}
+
+		uint8_t entryCompression;
+		bReadResult = CheckedTocRead(
+			pLoadFunction,
+			entryCompression,
+			TXT( "entry compression method" ),
+			pTocCurrent,
+			pTocMax );
+		if( !bReadResult )
+		{
+			return false;
+		}
+
+		if( entryCompression >= static_cast< uint8_t >( COMPRESSION_MAX ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				( TXT( "Cache::FinalizeTocLoad(): Entry for AssetPath \"%s\", sub-data %" ) PRIu32 TXT( " uses an " )
+				TXT( "unknown compression method (%" ) PRIu32 TXT( ").\n" ) ),
+				pPathString,
+				entrySubDataIndex,
+				static_cast< uint32_t >( entryCompression ) );
+
+			return false;
+		}
+
+		uint16_t entryDependencyCount;
+		bReadResult = CheckedTocRead(
+			pLoadFunction,
+			entryDependencyCount,
+			TXT( "entry dependency count" ),
+			pTocCurrent,
+			pTocMax );
+		if( !bReadResult )
+		{
+			return false;
+		}
+
 		Entry* pEntry = m_pEntryPool->Allocate();
 		HELIUM_ASSERT( pEntry );
+
+		// Add the entry before reading its dependencies so that it is released along with the other entries if the
+		// TOC turns out to be invalid.
+		m_entries.Add( pEntry );
+
+		pEntry->dependencies.Resize( 0 );
+		pEntry->dependencies.Reserve( entryDependencyCount );
+		for( uint_fast16_t dependencyIndex = 0; dependencyIndex < entryDependencyCount; ++dependencyIndex )
+		{
+			AssetPath* pDependencyPath = pEntry->dependencies.New();
+			HELIUM_ASSERT( pDependencyPath );
+			bReadResult = ReadTocPath(
+				pLoadFunction,
+				*pDependencyPath,
+				TXT( "entry dependency AssetPath" ),
+				pTocCurrent,
+				pTocMax );
+			if( !bReadResult )
+			{
+				return false;
+			}
+		}
+
 		pEntry->path = entryPath;
 		pEntry->subDataIndex = entrySubDataIndex;
 		pEntry->offset = entryOffset;
 		pEntry->timestamp = entryTimestamp;
 		pEntry->size = entrySize;
-
-		m_entries.Add( pEntry );
+		pEntry->uncompressedSize = entryUncompressedSize;
+		pEntry->compression = entryCompression;
 
 		HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
 	}
@@ -726,6 +1416,61 @@ bool Cache::FinalizeTocLoad()
 	return true;
 }
 
+/// Load the cache table of contents by parsing a memory-mapped view of the TOC file, and map the cache file for
+/// in-place access to entry data.
+///
+/// @return  True if the TOC was handled (successfully parsed or found to be invalid), false if the TOC could not be
+///          mapped and an asynchronous load should be used instead.
+bool Cache::LoadMappedToc()
+{
+	MappedFile tocMapping;
+	if( !tocMapping.Open( *m_tocFileName ) || tocMapping.GetSize() >= UINT32_MAX )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Cache::LoadMappedToc(): Failed to map TOC file \"%s\".  Falling back to async loading.\n" ),
+			*m_tocFileName );
+
+		return false;
+	}
+
+	m_tocSize = static_cast< uint32_t >( tocMapping.GetSize() );
+
+	if( !FinalizeTocLoad( tocMapping.GetData(), m_tocSize ) )
+	{
+		ReleaseEntries();
+	}
+	else if( !m_cacheMapping.Open( *m_cacheFileName ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			( TXT( "Cache::LoadMappedToc(): Failed to map cache file \"%s\".  Entry data will be loaded " )
+			TXT( "asynchronously.\n" ) ),
+			*m_cacheFileName );
+	}
+
+	m_bTocLoaded = true;
+
+	return true;
+}
+
+/// Release all loaded entry information.
+void Cache::ReleaseEntries()
+{
+	HELIUM_ASSERT( m_pEntryPool );
+
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		Entry* pEntry = m_entries[ entryIndex ];
+		HELIUM_ASSERT( pEntry );
+		m_pEntryPool->Release( pEntry );
+	}
+
+	m_entries.Clear();
+	m_entryMap.Clear();
+}
+
 /// Read a value from the cache TOC, check the TOC bounds in the process.
 ///
 /// @param[in]  pLoadFunction  Function to use for reading the value.
@@ -766,6 +1511,60 @@ bool Cache::CheckedTocRead(
 	return true;
 }
 
+/// Read a length-prefixed asset path string from the cache TOC, checking the TOC bounds in the process.
+///
+/// @param[in]  pLoadFunction  Function to use for reading values.
+/// @param[out] rPath          Read asset path.
+/// @param[in]  pDescription   Description of the path to read (for logging).
+/// @param[in]  rpTocCurrent   Pointer to the current offset within the TOC file buffer.
+/// @param[in]  pTocMax        Pointer to the end of the TOC file buffer.
+///
+/// @return  True if the path was read successfully, false if not.
+bool Cache::ReadTocPath(
+						LOAD_VALUE_CALLBACK* pLoadFunction,
+						AssetPath& rPath,
+						const char* pDescription,
+						const uint8_t*& rpTocCurrent,
+						const uint8_t* pTocMax )
+{
+	HELIUM_UNREF( pDescription );  // Used for logging only (unused in release builds).
+
+	uint16_t pathSize;
+	if( !CheckedTocRead( pLoadFunction, pathSize, pDescription, rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
+
+	uint_fast16_t pathSizeFast = pathSize;
+
+	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+	StackMemoryHeap<>::Marker stackMarker( rStackHeap );
+	char* pPathString = static_cast< char* >( rStackHeap.Allocate( sizeof( char ) * ( pathSizeFast + 1 ) ) );
+	HELIUM_ASSERT( pPathString );
+	pPathString[ pathSizeFast ] = TXT( '\0' );
+
+	for( uint_fast16_t characterIndex = 0; characterIndex < pathSizeFast; ++characterIndex )
+	{
+		if( !CheckedTocRead( pLoadFunction, pPathString[ characterIndex ], pDescription, rpTocCurrent, pTocMax ) )
+		{
+			return false;
+		}
+	}
+
+	if( !rPath.Set( pPathString ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::FinalizeTocLoad(): Failed to set %s \"%s\".\n" ),
+			pDescription,
+			pPathString );
+
+		return false;
+	}
+
+	return true;
+}
+
 /// Equality comparison.
 ///
 /// @param[in] rOther  Entry key with which to compare.
@@ -791,12 +1590,67 @@ size_t Cache::EntryKeyHash::operator()( const EntryKey& rKey ) const
 }
 
 #if HELIUM_TOOLS
-void Helium::Cache::WriteCacheObjectToBuffer( Reflect::Object* _object, DynamicArray< uint8_t > &_buffer )
+/// Serialize an object into the cached object format.
+///
+/// The object is written with a small header identifying the payload format and size, followed by the payload.
+///
+/// @param[in]  _object        Object to serialize.
+/// @param[out] _buffer        Buffer to which the serialized data is written.
+/// @param[out] pDependencies  If not null, filled with the paths of the assets referenced by the object.
+void Helium::Cache::WriteCacheObjectToBuffer(
+	Reflect::Object* _object,
+	DynamicArray< uint8_t > &_buffer,
+	DynamicArray< AssetPath >* pDependencies )
 {
-	AssetIdentifier identifier;
+	if( pDependencies )
+	{
+		pDependencies->Resize( 0 );
+	}
+
+	AssetIdentifier identifier ( pDependencies );
+
+	DynamicArray< uint8_t > payload;
+	DynamicMemoryStream archiveStream ( &payload );
+#if USE_JSON_FOR_CACHE_FORMAT
+	const uint8_t format = CACHE_OBJECT_FORMAT_JSON;
+	Persist::ArchiveWriterJson::WriteToStream( _object, archiveStream, &identifier );
+#else
+	const uint8_t format = CACHE_OBJECT_FORMAT_BINARY;
+	Persist::ArchiveWriterMessagePack::WriteToStream( _object, archiveStream, &identifier );
+#endif
 
-	DynamicMemoryStream archiveStream ( &_buffer );
-	CacheArchiveWriter::WriteToStream( _object, archiveStream, &identifier );
+	size_t payloadSize = payload.GetSize();
+	HELIUM_ASSERT( payloadSize <= UINT32_MAX );
+
+	_buffer.Resize( CACHE_OBJECT_HEADER_SIZE + payloadSize );
+	uint8_t* pHeader = _buffer.GetData();
+	StoreLittleEndian32( pHeader, CACHE_OBJECT_MAGIC );
+	pHeader[ 4 ] = format;
+	pHeader[ 5 ] = 0;
+	pHeader[ 6 ] = 0;
+	pHeader[ 7 ] = 0;
+	StoreLittleEndian32( pHeader + 8, static_cast< uint32_t >( payloadSize ) );
+
+	if( payloadSize != 0 )
+	{
+		MemoryCopy( pHeader + CACHE_OBJECT_HEADER_SIZE, payload.GetData(), payloadSize );
+	}
+
+	// An asset does not depend on itself.
+	Asset* pAsset = Reflect::SafeCast< Asset >( _object );
+	if( pDependencies && pAsset )
+	{
+		size_t dependencyCount = pDependencies->GetSize();
+		for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+		{
+			if( ( *pDependencies )[ dependencyIndex ] == pAsset->GetPath() )
+			{
+				pDependencies->RemoveSwap( dependencyIndex );
+
+				break;
+			}
+		}
+	}
 }
 #endif
 
@@ -811,16 +1665,67 @@ Reflect::ObjectPtr Helium::Cache::ReadCacheObjectFromBuffer( const DynamicArray<
 	return ReadCacheObjectFromBuffer(_buffer.GetData(), 0, _buffer.GetSize(), _resolver);
 }
 
+/// Deserialize an object written using WriteCacheObjectToBuffer().
+///
+/// Any bytes following the payload (such as a null terminator appended by the cooker) are ignored.
+///
+/// @param[in] _buffer    Buffer containing the serialized object.
+/// @param[in] _offset    Byte offset of the serialized object within the buffer.
+/// @param[in] _count     Number of bytes available starting at the given offset.
+/// @param[in] _resolver  Resolver for object references.
+///
+/// @return  Deserialized object, or null if the data is empty or invalid.
 Reflect::ObjectPtr Helium::Cache::ReadCacheObjectFromBuffer( const uint8_t *_buffer, const size_t _offset, const size_t _count, Reflect::ObjectResolver *_resolver )
 {
+	Reflect::ObjectPtr cached_object;
 	if (_count == 0)
 	{
-		Reflect::ObjectPtr null_object;
-		return null_object;
+		return cached_object;
+	}
+
+	const uint8_t* pHeader = _buffer + _offset;
+	if( _count < CACHE_OBJECT_HEADER_SIZE || LoadLittleEndian32( pHeader ) != CACHE_OBJECT_MAGIC )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			( TXT( "Cache::ReadCacheObjectFromBuffer(): Cached object data is missing its header (the cache may " )
+			TXT( "be out of date).\n" ) ) );
+
+		return cached_object;
+	}
+
+	uint8_t format = pHeader[ 4 ];
+	uint32_t payloadSize = LoadLittleEndian32( pHeader + 8 );
+	if( payloadSize > _count - CACHE_OBJECT_HEADER_SIZE )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			( TXT( "Cache::ReadCacheObjectFromBuffer(): Cached object payload size (%" ) PRIu32 TXT( " bytes) " )
+			TXT( "exceeds the amount of data available (%" ) PRIuSZ TXT( " bytes).\n" ) ),
+			payloadSize,
+			_count - CACHE_OBJECT_HEADER_SIZE );
+
+		return cached_object;
+	}
+
+	StaticMemoryStream archiveStream( (char *)(pHeader + CACHE_OBJECT_HEADER_SIZE), payloadSize );
+	switch( format )
+	{
+	case CACHE_OBJECT_FORMAT_BINARY:
+		Persist::ArchiveReaderMessagePack::ReadFromStream( archiveStream, cached_object, _resolver );
+		break;
+
+	case CACHE_OBJECT_FORMAT_JSON:
+		Persist::ArchiveReaderJson::ReadFromStream( archiveStream, cached_object, _resolver );
+		break;
+
+	default:
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::ReadCacheObjectFromBuffer(): Unknown cached object format %" ) PRIu32 TXT( ".\n" ),
+			static_cast< uint32_t >( format ) );
+		break;
 	}
 
-	Reflect::ObjectPtr cached_object;
-	StaticMemoryStream archiveStream( (char *)(_buffer + _offset), _count );
-	CacheArchiveReader::ReadFromStream( archiveStream, cached_object, _resolver );
 	return cached_object;
-}
\ No newline at end of file
+}
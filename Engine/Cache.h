@@ -6,10 +6,14 @@
 #include "Foundation/ConcurrentHashMap.h"
 #include "Foundation/ObjectPool.h"
 #include "Engine/AssetPath.h"
+#include "Engine/AsyncLoader.h"
+#include "Engine/MappedFile.h"
 #include "Reflect/Object.h"
 
 namespace Helium
 {
+	class FileStream;
+
 	/// Serialization cache interface.
 	class HELIUM_ENGINE_API Cache : NonCopyable
 	{
@@ -33,6 +37,21 @@ namespace Helium
 			PLATFORM_LAST = PLATFORM_MAX - 1
 		};
 
+		/// Cache entry compression methods.
+		enum ECompression
+		{
+			COMPRESSION_FIRST   =  0,
+			COMPRESSION_INVALID = -1,
+
+			/// Entry data is stored as-is.
+			COMPRESSION_NONE,
+			/// Entry data is stored as a zlib (deflate) stream.
+			COMPRESSION_ZLIB,
+
+			COMPRESSION_MAX,
+			COMPRESSION_LAST = COMPRESSION_MAX - 1
+		};
+
 		/// Cache entry information.  Note that the members of this struct are organized as such so as to reduce memory
 		/// overhead from padding each value.
 		struct Entry
@@ -47,8 +66,15 @@ namespace Helium
 			/// Sub-data index.
 			uint32_t subDataIndex;
 
-			/// Entry size.
+			/// Entry size, as stored in the cache file.
 			uint32_t size;
+			/// Entry size once decompressed (equal to the stored size for uncompressed entries).
+			uint32_t uncompressedSize;
+			/// Compression method used to store the entry data (ECompression value).
+			uint8_t compression;
+
+			/// Paths of the assets directly referenced by the cached object (recorded by the cooker).
+			DynamicArray< AssetPath > dependencies;
 		};
 
 		/// @name Construction/Destruction
@@ -70,6 +96,10 @@ namespace Helium
 		inline bool IsTocLoaded() const;
 
 		void EnforceTocLoad();
+
+		inline void SetMemoryMappingEnabled( bool bEnabled );
+		inline bool IsMemoryMappingEnabled() const;
+		inline bool IsMemoryMapped() const;
 		//@}
 
 		/// @name Data Access
@@ -83,12 +113,39 @@ namespace Helium
 		inline uint32_t GetEntryCount() const;
 		inline const Entry& GetEntry( uint32_t index ) const;
 		const Entry* FindEntry( AssetPath path, uint32_t subDataIndex ) const;
+		const uint8_t* GetMappedEntryData( const Entry& rEntry ) const;
 
-		bool CacheEntry( AssetPath path, uint32_t subDataIndex, const void* pData, int64_t timestamp, uint32_t size );
+		size_t BeginLoadEntry(
+			const Entry& rEntry, void* pBuffer, size_t bufferSize,
+			AsyncLoader::EPriority priority = AsyncLoader::PRIORITY_NORMAL ) const;
+		//@}
+
+		/// @name Writing
+		//@{
+		void BeginWrite();
+		bool CommitWrite();
+		inline bool IsWriting() const;
+
+		bool CacheEntry(
+			AssetPath path, uint32_t subDataIndex, const void* pData, int64_t timestamp, uint32_t size,
+			ECompression compression = COMPRESSION_NONE, const DynamicArray< AssetPath >* pDependencies = NULL );
+
+		bool Compact();
+		//@}
+
+		/// @name Compression
+		//@{
+		static bool CompressData(
+			ECompression compression, const void* pSource, size_t sourceSize, DynamicArray< uint8_t >& rDestination );
+		static size_t DecompressData(
+			ECompression compression, void* pDestination, size_t destinationSize, const void* pSource,
+			size_t sourceSize );
 		//@}
 
 #if HELIUM_TOOLS
-		static void WriteCacheObjectToBuffer( Helium::Reflect::Object* _object, DynamicArray< uint8_t > &_buffer );
+		static void WriteCacheObjectToBuffer(
+			Helium::Reflect::Object* _object, DynamicArray< uint8_t > &_buffer,
+			DynamicArray< AssetPath >* pDependencies = NULL );
 #endif
 		static Reflect::ObjectPtr ReadCacheObjectFromBuffer( const DynamicArray< uint8_t > &_buffer, Reflect::ObjectResolver *pResolver = 0 );
 		static Reflect::ObjectPtr ReadCacheObjectFromBuffer( const uint8_t *_buffer, const size_t _offset, const size_t _count, Reflect::ObjectResolver *pResolver = 0 );
@@ -145,6 +202,20 @@ namespace Helium
 		/// Size of the TOC, in bytes.
 		uint32_t m_tocSize;
 
+		/// True if the TOC and cache files should be memory-mapped instead of read through the AsyncLoader.
+		bool m_bMemoryMappingEnabled;
+		/// Read-only mapping of the cache file (only open when memory mapping is enabled and mapping succeeded).
+		MappedFile m_cacheMapping;
+
+		/// Number of active (possibly nested) write transactions.
+		uint32_t m_writeDepth;
+		/// Cache file offset at which the next entry will be appended during a write transaction.
+		uint64_t m_writeOffset;
+		/// Cache file stream shared by all entries written during the outermost write transaction.
+		FileStream* m_pWriteStream;
+		/// True if entries have been modified since the TOC file was last written.
+		bool m_bTocDirty;
+
 		/// Cache entry pool.
 		ObjectPool< Entry >* m_pEntryPool;
 		/// Cache entry information.
@@ -154,7 +225,14 @@ namespace Helium
 
 		/// @name Loading Utility Functions
 		//@{
-		bool FinalizeTocLoad();
+		bool FinalizeTocLoad( const uint8_t* pTocData, uint32_t tocSize );
+		bool LoadMappedToc();
+		void ReleaseEntries();
+		//@}
+
+		/// @name Writing Utility Functions
+		//@{
+		bool WriteToc( const String& rTocFileName ) const;
 		//@}
 
 		/// @name Private Static Utility Functions
@@ -162,6 +240,9 @@ namespace Helium
 		template< typename T > static bool CheckedTocRead(
 			LOAD_VALUE_CALLBACK* pLoadFunction, T& rValue, const char* pDescription, const uint8_t*& rpTocCurrent,
 			const uint8_t* pTocMax );
+		static bool ReadTocPath(
+			LOAD_VALUE_CALLBACK* pLoadFunction, AssetPath& rPath, const char* pDescription,
+			const uint8_t*& rpTocCurrent, const uint8_t* pTocMax );
 		//@}
 	};
 }
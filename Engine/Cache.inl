@@ -8,6 +8,50 @@ bool Helium::Cache::IsTocLoaded() const
     return m_bTocLoaded;
 }
 
+/// Set whether the TOC and cache files should be memory-mapped for reading.
+///
+/// When enabled, the TOC is parsed directly from the mapped file and cached object data can be accessed in place
+/// through GetMappedEntryData() instead of being staged through the AsyncLoader.  If mapping a file fails, loading
+/// falls back to the asynchronous path.  This must be set prior to loading the TOC in order to take effect.
+///
+/// @param[in] bEnabled  True to enable memory mapping, false to disable it.
+///
+/// @see IsMemoryMappingEnabled(), IsMemoryMapped()
+void Helium::Cache::SetMemoryMappingEnabled( bool bEnabled )
+{
+    m_bMemoryMappingEnabled = bEnabled;
+}
+
+/// Get whether memory mapping of the cache files has been requested.
+///
+/// @return  True if memory mapping is enabled, false if not.
+///
+/// @see SetMemoryMappingEnabled(), IsMemoryMapped()
+bool Helium::Cache::IsMemoryMappingEnabled() const
+{
+    return m_bMemoryMappingEnabled;
+}
+
+/// Get whether the cache file is currently memory-mapped.
+///
+/// @return  True if cached data can be accessed using GetMappedEntryData(), false if not.
+///
+/// @see SetMemoryMappingEnabled(), GetMappedEntryData()
+bool Helium::Cache::IsMemoryMapped() const
+{
+    return m_cacheMapping.IsOpen();
+}
+
+/// Get whether a write transaction is currently active.
+///
+/// @return  True if BeginWrite() has been called without a matching CommitWrite(), false if not.
+///
+/// @see BeginWrite(), CommitWrite()
+bool Helium::Cache::IsWriting() const
+{
+    return ( m_writeDepth != 0 );
+}
+
 /// Get the name used to identify this cache.
 ///
 /// @return  Cache name.
@@ -13,6 +13,11 @@ CacheManager* CacheManager::sm_pInstance = NULL;
 /// Constructor.
 CacheManager::CacheManager( const FilePath& rBaseDirectory )
 	: m_cachePool( CACHE_POOL_BLOCK_SIZE )
+#if HELIUM_TOOLS
+	, m_bMemoryMappingEnabled( false )
+#else
+	, m_bMemoryMappingEnabled( true )
+#endif
 {
 	m_platformDataDirectories[ Cache::PLATFORM_PC ] = rBaseDirectory.c_str();
 	m_platformDataDirectories[ Cache::PLATFORM_PC ] += TXT( "DataPC/" );
@@ -79,6 +84,8 @@ Cache* CacheManager::GetCache( Name name, Cache::EPlatform platform )
 		return NULL;
 	}
 
+	pCache->SetMemoryMappingEnabled( m_bMemoryMappingEnabled );
+
 	if( !m_cacheMaps[ platform ].Insert( cacheAccessor, KeyValue< Name, Cache* >( name, pCache ) ) )
 	{
 		// Cache instance was added while we were trying to create a new one, so release the one we allocated and
@@ -21,6 +21,9 @@ namespace Helium
 		/// @name Cache Access
 		//@{
 		Cache* GetCache( Name name, Cache::EPlatform platform = Cache::PLATFORM_INVALID );
+
+		inline void SetMemoryMappingEnabled( bool bEnabled );
+		inline bool IsMemoryMappingEnabled() const;
 		//@}
 
 		/// @name Filesystem Information
@@ -49,6 +52,9 @@ namespace Helium
 		/// Cache lookup tables.
 		ConcurrentHashMap< Name, Cache* > m_cacheMaps[ Cache::PLATFORM_MAX ];
 
+		/// True if newly created caches should memory-map their files.
+		bool m_bMemoryMappingEnabled;
+
 		/// Singleton instance.
 		static CacheManager* sm_pInstance;
 
@@ -59,3 +65,5 @@ namespace Helium
 		//@}
 	};
 }
+
+#include "Engine/CacheManager.inl"
@@ -0,0 +1,22 @@
+/// Set whether caches created from this point on should memory-map their TOC and cache files.
+///
+/// Memory mapping is enabled by default in runtime builds and disabled by default in tools builds (where caches are
+/// frequently rewritten).
+///
+/// @param[in] bEnabled  True to enable memory mapping, false to disable it.
+///
+/// @see IsMemoryMappingEnabled(), Cache::SetMemoryMappingEnabled()
+void Helium::CacheManager::SetMemoryMappingEnabled( bool bEnabled )
+{
+	m_bMemoryMappingEnabled = bEnabled;
+}
+
+/// Get whether caches created from this point on will memory-map their TOC and cache files.
+///
+/// @return  True if memory mapping is enabled, false if not.
+///
+/// @see SetMemoryMappingEnabled()
+bool Helium::CacheManager::IsMemoryMappingEnabled() const
+{
+	return m_bMemoryMappingEnabled;
+}
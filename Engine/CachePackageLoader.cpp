@@ -3,6 +3,8 @@
 
 #include "Engine/Asset.h"
 #include "Engine/AssetLoader.h"
+#include "Engine/AssetLoadProfiler.h"
+#include "Engine/AsyncDeserializer.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/CacheManager.h"
 #include "Engine/Resource.h"
@@ -74,6 +76,14 @@ void CachePackageLoader::Shutdown()
 				rAsyncLoader.SyncRequest( pRequest->asyncLoadId );
 			}
 
+			if( IsValid( pRequest->deserializeId ) )
+			{
+				AsyncDeserializer::GetStaticInstance().SyncRequest( pRequest->deserializeId );
+			}
+
+			pRequest->spCachedObject.Release();
+			pRequest->spCachedPersistentResourceData.Release();
+
 			allocator.Free( pRequest->pAsyncLoadBuffer );
 
 			m_loadRequestPool.Release( pRequest );
@@ -118,6 +128,10 @@ bool CachePackageLoader::TryFinishPreload()
 	{
 		bResult = ( m_pCache->IsTocLoaded() || m_pCache->TryFinishLoadToc() );
 		m_bFinishedCacheTocLoad = bResult;
+		if( bResult )
+		{
+			NotifyProgress();
+		}
 	}
 
 	return bResult;
@@ -147,10 +161,14 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 
 		SetInvalid( pRequest->asyncLoadId );
 		pRequest->pAsyncLoadBuffer = NULL;
+		pRequest->pCacheData = NULL;
 		pRequest->pPropertyDataBegin = NULL;
 		pRequest->pPropertyDataEnd = NULL;
 		pRequest->pPersistentResourceDataBegin = NULL;
 		pRequest->pPersistentResourceDataEnd = NULL;
+		SetInvalid( pRequest->deserializeId );
+		HELIUM_ASSERT( !pRequest->spCachedObject );
+		HELIUM_ASSERT( !pRequest->spCachedPersistentResourceData );
 		SetInvalid( pRequest->ownerLoadIndex );
 		HELIUM_ASSERT( !pRequest->spOwner );
 		pRequest->forceReload = forceReload;
@@ -206,10 +224,14 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	HELIUM_ASSERT( !pRequest->spObject );
 	SetInvalid( pRequest->asyncLoadId );
 	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->pCacheData = NULL;
 	pRequest->pPropertyDataBegin = NULL;
 	pRequest->pPropertyDataEnd = NULL;
 	pRequest->pPersistentResourceDataBegin = NULL;
 	pRequest->pPersistentResourceDataEnd = NULL;
+	SetInvalid( pRequest->deserializeId );
+	HELIUM_ASSERT( !pRequest->spCachedObject );
+	HELIUM_ASSERT( !pRequest->spCachedPersistentResourceData );
 	SetInvalid( pRequest->ownerLoadIndex );
 	HELIUM_ASSERT( !pRequest->spOwner );
 	pRequest->forceReload = forceReload;
@@ -235,22 +257,32 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	{
 		HELIUM_ASSERT( !pObject || !pObject->GetAnyFlagSet( Asset::FLAG_LOADED | Asset::FLAG_LINKED ) );
 
-		HELIUM_TRACE(
-			TraceLevels::Debug,
-			TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
-			*path.ToString() );
+		// Read directly from the memory-mapped cache file if possible, otherwise stage the data through the async
+		// loader.
+		pRequest->pCacheData = m_pCache->GetMappedEntryData( *pEntry );
+		if( pRequest->pCacheData )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				TXT( "CachePackageLoader::BeginLoadObject(): Using memory-mapped property data for \"%s\".\n" ),
+				*path.ToString() );
+		}
+		else
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
+				*path.ToString() );
 
-		size_t entrySize = pEntry->size;
-		pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
-		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+			// Compressed entries are decompressed into the buffer by the async loader worker threads.
+			size_t entrySize = pEntry->uncompressedSize;
+			pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
+			HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+			pRequest->pCacheData = pRequest->pAsyncLoadBuffer;
 
-		AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
-		pRequest->asyncLoadId = rLoader.QueueRequest(
-			pRequest->pAsyncLoadBuffer,
-			m_pCache->GetCacheFileName(),
-			pEntry->offset,
-			entrySize );
-		HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+			pRequest->asyncLoadId = m_pCache->BeginLoadEntry( *pEntry, pRequest->pAsyncLoadBuffer, entrySize );
+			HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+		}
 	}
 
 	size_t requestId = m_loadRequests.Add( pRequest );
@@ -332,8 +364,14 @@ bool CachePackageLoader::TryFinishLoadObject( size_t requestId, AssetPtr& rspObj
 }
 
 /// Update this package loader.
+///
+/// Publishing of deserialized objects is limited to the asset loader's publish time budget, which is shared with the
+/// other package loaders ticked in the same asset loader tick.  At least one object is always published, so that this
+/// loader still makes progress when ticked after the budget has run out.
 void CachePackageLoader::Tick()
 {
+	bool bPublishedObject = false;
+
 	// Process pending load requests.
 	size_t loadRequestSize = m_loadRequests.GetSize();
 	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestSize; ++loadRequestIndex )
@@ -348,7 +386,7 @@ void CachePackageLoader::Tick()
 
 		if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
 		{
-			if( IsValid( pRequest->asyncLoadId ) )
+			if( !pRequest->pPropertyDataBegin )
 			{
 				if( !TickCacheLoad( pRequest ) )
 				{
@@ -359,11 +397,15 @@ void CachePackageLoader::Tick()
 			// Preloaded flag may be set if the cache load step failed.
 			if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
 			{
-				if( !TickDeserialize( pRequest ) )
+				if( !TickDeserialize( pRequest, !bPublishedObject ) )
 				{
 					continue;
 				}
+
+				bPublishedObject = true;
 			}
+
+			NotifyProgress();
 		}
 
 		HELIUM_ASSERT( IsInvalid( pRequest->asyncLoadId ) );
@@ -371,7 +413,29 @@ void CachePackageLoader::Tick()
 	}
 }
 
-/// @copydoc PackageLoader::GetObjectCount()
+/// @copydoc PackageLoader::GetAssetDependencies()
+bool CachePackageLoader::GetAssetDependencies( AssetPath path, DynamicArray< AssetPath >& rDependencies ) const
+{
+	HELIUM_ASSERT( m_pCache );
+
+	// Dependencies are only known once the TOC has been loaded.
+	if( !m_pCache->IsTocLoaded() )
+	{
+		return false;
+	}
+
+	const Cache::Entry* pEntry = m_pCache->FindEntry( path, 0 );
+	if( !pEntry )
+	{
+		return false;
+	}
+
+	rDependencies.AddArray( pEntry->dependencies.GetData(), pEntry->dependencies.GetSize() );
+
+	return true;
+}
+
+
 size_t CachePackageLoader::GetObjectCount() const
 {
 	HELIUM_ASSERT( m_pCache );
@@ -400,15 +464,36 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
 
-	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+	HELIUM_ASSERT( pRequest->pEntry );
+
+	AssetLoadProfiler& rProfiler = AssetLoadProfiler::GetStaticInstance();
 
 	size_t bytesRead = 0;
-	if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+	if( IsValid( pRequest->asyncLoadId ) )
 	{
-		return false;
+		AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+		AsyncLoader::RequestTiming timing;
+		if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead, &timing ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->asyncLoadId );
+
+		rProfiler.MarkStage( pRequest->pEntry->path, AssetLoadProfiler::STAGE_IO_BEGIN, timing.startTime );
+		rProfiler.MarkStage( pRequest->pEntry->path, AssetLoadProfiler::STAGE_IO_END, timing.endTime );
 	}
+	else
+	{
+		// Data is read in place from the memory-mapped cache file.
+		HELIUM_ASSERT( pRequest->pCacheData );
+		bytesRead = pRequest->pEntry->uncompressedSize;
 
-	SetInvalid( pRequest->asyncLoadId );
+		rProfiler.MarkStage( pRequest->pEntry->path, AssetLoadProfiler::STAGE_IO_BEGIN );
+		rProfiler.MarkStage( pRequest->pEntry->path, AssetLoadProfiler::STAGE_IO_END );
+	}
+
+	rProfiler.AddIoBytes( pRequest->pEntry->path, pRequest->pEntry->size );
 
 	if( bytesRead == 0 || IsInvalid( bytesRead ) )
 	{
@@ -421,7 +506,7 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 	}
 	else
 	{
-		uint8_t* pBufferEnd = pRequest->pAsyncLoadBuffer + bytesRead;
+		const uint8_t* pBufferEnd = pRequest->pCacheData + bytesRead;
 		pRequest->pPropertyDataEnd = pBufferEnd;
 		pRequest->pPersistentResourceDataEnd = pBufferEnd;
 
@@ -435,6 +520,7 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 	// else will be done with the object itself from here on out).
 	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
 	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->pCacheData = NULL;
 
 	Asset* pObject = pRequest->spObject;
 	if( pObject )
@@ -450,10 +536,11 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 
 /// Tick the object deserialization process for the given object load request.
 ///
-/// @param[in] pRequest  Load request.
+/// @param[in] pRequest        Load request.
+/// @param[in] bIgnoreBudget  True to publish the object even if the publish time budget has run out.
 ///
 /// @return  True if the deserialization process has completed, false if it still needs time to process.
-bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
+bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest, bool bIgnoreBudget )
 {
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
@@ -486,6 +573,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 
 			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
 			pRequest->pAsyncLoadBuffer = NULL;
+			pRequest->pCacheData = NULL;
 
 			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 
@@ -496,12 +584,34 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	Asset* pOwner = pRequest->spOwner;
 
 	HELIUM_ASSERT( !pOwner || pOwner->IsFullyLoaded() );
-	
-	Reflect::ObjectPtr cached_object = Cache::ReadCacheObjectFromBuffer(
-		pRequest->pPropertyDataBegin, 
-		0, 
-		pRequest->pPropertyDataEnd - pRequest->pPropertyDataBegin, 
-		pRequest->pResolver);
+
+	// Parse the cached data on a deserialization worker thread.
+	if( !( pRequest->flags & LOAD_FLAG_DESERIALIZED ) )
+	{
+		AsyncDeserializer& rAsyncDeserializer = AsyncDeserializer::GetStaticInstance();
+		if( IsInvalid( pRequest->deserializeId ) )
+		{
+			pRequest->deserializeId = rAsyncDeserializer.QueueRequest( DeserializeCacheData, pRequest );
+			HELIUM_ASSERT( IsValid( pRequest->deserializeId ) );
+		}
+
+		if( !rAsyncDeserializer.TrySyncRequest( pRequest->deserializeId ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->deserializeId );
+		pRequest->flags |= LOAD_FLAG_DESERIALIZED;
+	}
+
+	// Publishing the object must happen on this thread, so only do so while the current tick has time left.
+	if( !bIgnoreBudget && !pAssetLoader->HasPublishTimeRemaining() )
+	{
+		return false;
+	}
+
+	Reflect::ObjectPtr cached_object = pRequest->spCachedObject;
+	pRequest->spCachedObject.Release();
 
 	AssetPtr assetPtr = Reflect::AssertCast<Asset>(cached_object);
 
@@ -538,11 +648,7 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 			Resource* pResource = Reflect::SafeCast< Resource >( pObject );
 			if( pResource )
 			{
-				Reflect::ObjectPtr cached_prd = Cache::ReadCacheObjectFromBuffer(
-					pRequest->pPersistentResourceDataBegin, 
-					0, 
-					(pRequest->pPersistentResourceDataEnd - pRequest->pPersistentResourceDataBegin),
-					pRequest->pResolver);
+				Reflect::ObjectPtr cached_prd = pRequest->spCachedPersistentResourceData;
 
 				if (!cached_prd.ReferencesObject())
 				{
@@ -560,8 +666,11 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 		}
 	}
 
+	pRequest->spCachedPersistentResourceData.Release();
+
 	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
 	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->pCacheData = NULL;
 
 	pObject->SetFlags( Asset::FLAG_PRELOADED );
 
@@ -571,6 +680,40 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	return true;
 }
 
+/// Deserialize the cached property and persistent resource data for a load request.
+///
+/// This is run on an AsyncDeserializer worker thread.  It must not touch the object system itself (i.e. naming or
+/// registering the object), which is left to TickDeserialize() once the request has been synced.
+///
+/// @param[in] pData  Load request.
+void CachePackageLoader::DeserializeCacheData( void* pData )
+{
+	LoadRequest* pRequest = static_cast< LoadRequest* >( pData );
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->pEntry );
+
+	AssetLoadProfiler& rProfiler = AssetLoadProfiler::GetStaticInstance();
+	rProfiler.MarkStage( pRequest->pEntry->path, AssetLoadProfiler::STAGE_DESERIALIZE_BEGIN );
+
+	pRequest->spCachedObject = Cache::ReadCacheObjectFromBuffer(
+		pRequest->pPropertyDataBegin,
+		0,
+		pRequest->pPropertyDataEnd - pRequest->pPropertyDataBegin,
+		pRequest->pResolver );
+
+	Asset* pObject = Reflect::SafeCast< Asset >( pRequest->spCachedObject.Get() );
+	if( pObject && !pObject->IsDefaultTemplate() && Reflect::SafeCast< Resource >( pObject ) )
+	{
+		pRequest->spCachedPersistentResourceData = Cache::ReadCacheObjectFromBuffer(
+			pRequest->pPersistentResourceDataBegin,
+			0,
+			pRequest->pPersistentResourceDataEnd - pRequest->pPersistentResourceDataBegin,
+			pRequest->pResolver );
+	}
+
+	rProfiler.MarkStage( pRequest->pEntry->path, AssetLoadProfiler::STAGE_DESERIALIZE_END );
+}
+
 /// Recursive function for resolving a package request.
 ///
 /// @param[out] rspPackage   Resolved package.
@@ -609,8 +752,8 @@ bool CachePackageLoader::ReadCacheData( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
 
-	uint8_t* pBufferCurrent = pRequest->pAsyncLoadBuffer;
-	uint8_t* pPropertyDataEnd = pRequest->pPropertyDataEnd;
+	const uint8_t* pBufferCurrent = pRequest->pCacheData;
+	const uint8_t* pPropertyDataEnd = pRequest->pPropertyDataEnd;
 	HELIUM_ASSERT( pBufferCurrent );
 	HELIUM_ASSERT( pPropertyDataEnd );
 	HELIUM_ASSERT( pBufferCurrent <= pPropertyDataEnd );
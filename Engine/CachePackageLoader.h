@@ -35,6 +35,8 @@ namespace Helium
 		virtual bool TryFinishLoadObject( size_t requestId, AssetPtr& rspObject );
 
 		virtual void Tick();
+
+		virtual bool GetAssetDependencies( AssetPath path, DynamicArray< AssetPath >& rDependencies ) const;
 		//@}
 
 		/// @name Data Access
@@ -52,7 +54,9 @@ namespace Helium
 			/// Set once object preloading has completed.
 			LOAD_FLAG_PRELOADED = 1 << 0,
 			/// Set when an error has occurred in the load process.
-			LOAD_FLAG_ERROR = 1 << 1
+			LOAD_FLAG_ERROR = 1 << 1,
+			/// Set once the cached data has been deserialized on a worker thread.
+			LOAD_FLAG_DESERIALIZED = 1 << 2
 		};
 
 		/// Asset load request data.
@@ -69,15 +73,24 @@ namespace Helium
 			size_t asyncLoadId;
 			/// Async load buffer.
 			uint8_t* pAsyncLoadBuffer;
+			/// Cached object data (either pAsyncLoadBuffer or a pointer into the memory-mapped cache file).
+			const uint8_t* pCacheData;
 
-			/// Pointer to where the property data begins within the pAsyncLoadBuffer
-			uint8_t* pPropertyDataBegin;
+			/// Pointer to where the property data begins within pCacheData
+			const uint8_t* pPropertyDataBegin;
 			/// End of the property data
-			uint8_t* pPropertyDataEnd;
-			/// Pointer to where the persistent resource data begins within the pAsyncLoadBuffer
-			uint8_t* pPersistentResourceDataBegin;
+			const uint8_t* pPropertyDataEnd;
+			/// Pointer to where the persistent resource data begins within pCacheData
+			const uint8_t* pPersistentResourceDataBegin;
 			/// End of the persistent resource data.
-			uint8_t* pPersistentResourceDataEnd;
+			const uint8_t* pPersistentResourceDataEnd;
+
+			/// Async deserialization request ID.
+			size_t deserializeId;
+			/// Object deserialized from the property data.
+			Reflect::ObjectPtr spCachedObject;
+			/// Object deserialized from the persistent resource data.
+			Reflect::ObjectPtr spCachedPersistentResourceData;
 
 			// Load index for the owning asset
 			size_t ownerLoadIndex;
@@ -104,13 +117,14 @@ namespace Helium
 		/// @name Load Ticking Functions
 		//@{
 		bool TickCacheLoad( LoadRequest* pRequest );
-		bool TickDeserialize( LoadRequest* pRequest );
+		bool TickDeserialize( LoadRequest* pRequest, bool bIgnoreBudget );
 		//@}
 
 		/// @name Static Private Utility Functions
 		//@{
 		static void ResolvePackage( AssetPtr& spPackage, AssetPath packagePath );
 		static bool ReadCacheData( LoadRequest* pRequest );
+		static void DeserializeCacheData( void* pData );
 		//@}
 	};
 }
@@ -0,0 +1,85 @@
+#include "EnginePch.h"
+#include "Engine/JobContext.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] pManager          Owning job manager.
+/// @param[in] pJob              Job instance.
+/// @param[in] pRunFunction      Function to call to run the job.
+/// @param[in] pDestroyFunction  Function to call to destroy the job once it has completed, or null if the job is not
+///                              owned by this context.
+JobContext::JobContext(
+	JobManager* pManager,
+	void* pJob,
+	RUN_FUNCTION* pRunFunction,
+	DESTROY_FUNCTION* pDestroyFunction )
+	: m_pManager( pManager )
+	, m_pJob( pJob )
+	, m_pRunFunction( pRunFunction )
+	, m_pDestroyFunction( pDestroyFunction )
+	, m_pParent( NULL )
+	, m_pCompletionCounter( NULL )
+	, m_pendingCount( 1 )
+	, m_pFirstChild( NULL )
+	, m_pLastChild( NULL )
+	, m_pNextSibling( NULL )
+	, m_pContinuation( NULL )
+	, m_bExecuted( false )
+{
+	HELIUM_ASSERT( pManager );
+	HELIUM_ASSERT( pJob );
+	HELIUM_ASSERT( pRunFunction );
+}
+
+/// Destructor.
+JobContext::~JobContext()
+{
+	if( m_pDestroyFunction )
+	{
+		m_pDestroyFunction( m_pJob );
+	}
+}
+
+/// Add a child job to spawn once the currently running job returns.
+///
+/// @param[in] pJob              Job instance.
+/// @param[in] pRunFunction      Function to call to run the job.
+/// @param[in] pDestroyFunction  Function to call to destroy the job once it has completed.
+///
+/// @see Create()
+void JobContext::AddChild( void* pJob, RUN_FUNCTION* pRunFunction, DESTROY_FUNCTION* pDestroyFunction )
+{
+	HELIUM_ASSERT( !m_bExecuted );
+
+	JobContext* pChild = new JobContext( m_pManager, pJob, pRunFunction, pDestroyFunction );
+	HELIUM_ASSERT( pChild );
+
+	if( m_pLastChild )
+	{
+		m_pLastChild->m_pNextSibling = pChild;
+	}
+	else
+	{
+		m_pFirstChild = pChild;
+	}
+
+	m_pLastChild = pChild;
+}
+
+/// Set the continuation job to run once all child jobs of the currently running job have completed.
+///
+/// @param[in] pJob              Job instance.
+/// @param[in] pRunFunction      Function to call to run the job.
+/// @param[in] pDestroyFunction  Function to call to destroy the job once it has completed.
+///
+/// @see CreateContinuation()
+void JobContext::SetContinuation( void* pJob, RUN_FUNCTION* pRunFunction, DESTROY_FUNCTION* pDestroyFunction )
+{
+	HELIUM_ASSERT( !m_bExecuted );
+	HELIUM_ASSERT( !m_pContinuation );
+
+	m_pContinuation = new JobContext( m_pManager, pJob, pRunFunction, pDestroyFunction );
+	HELIUM_ASSERT( m_pContinuation );
+}
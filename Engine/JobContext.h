@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	class JobManager;
+
+	/// Context in which a job instance is run.
+	///
+	/// Each job scheduled through the JobManager is given a context when it runs.  A running job can use its context to
+	/// create child jobs, which are spawned on the current worker's queue (and are available to be stolen by idle
+	/// workers) once the job returns, and a continuation job, which is run once all child jobs (and their children)
+	/// have completed.  A job is not considered complete until all of its children have completed, or, if it created a
+	/// continuation, until the continuation has completed.
+	class HELIUM_ENGINE_API JobContext : NonCopyable
+	{
+		friend class JobManager;
+
+	public:
+		/// Function called to run a job.
+		///
+		/// @param[in] pJob      Job to run.
+		/// @param[in] pContext  Context associated with the running job instance.
+		typedef void ( RUN_FUNCTION )( void* pJob, JobContext* pContext );
+
+		/// Function called to destroy a job created through a JobContext once it has run.
+		///
+		/// @param[in] pJob  Job to destroy.
+		typedef void ( DESTROY_FUNCTION )( void* pJob );
+
+		/// @name Job Creation
+		//@{
+		template< typename JobType > JobType* Create();
+		template< typename JobType > JobType* CreateContinuation();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline JobManager* GetManager() const;
+		//@}
+
+	private:
+		/// Owning job manager.
+		JobManager* m_pManager;
+
+		/// Job instance.
+		void* m_pJob;
+		/// Function to call to run the job.
+		RUN_FUNCTION* m_pRunFunction;
+		/// Function to call to destroy the job once it has completed (null if the job is not owned by the context).
+		DESTROY_FUNCTION* m_pDestroyFunction;
+
+		/// Context to notify when this job and all of its children have completed.
+		JobContext* m_pParent;
+		/// Counter to set once this job and all of its children have completed (only set for root jobs).
+		volatile int32_t* m_pCompletionCounter;
+		/// Number of outstanding references keeping this job from completing (the job itself and its children).
+		volatile int32_t m_pendingCount;
+
+		/// First child job created while running this job (spawned once the job returns).
+		JobContext* m_pFirstChild;
+		/// Last child job created while running this job.
+		JobContext* m_pLastChild;
+		/// Next sibling in the parent's list of child jobs to spawn.
+		JobContext* m_pNextSibling;
+		/// Continuation job created while running this job.
+		JobContext* m_pContinuation;
+
+		/// True once the job has been run.
+		bool m_bExecuted;
+
+		/// @name Construction/Destruction
+		//@{
+		JobContext( JobManager* pManager, void* pJob, RUN_FUNCTION* pRunFunction, DESTROY_FUNCTION* pDestroyFunction );
+		~JobContext();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		void AddChild( void* pJob, RUN_FUNCTION* pRunFunction, DESTROY_FUNCTION* pDestroyFunction );
+		void SetContinuation( void* pJob, RUN_FUNCTION* pRunFunction, DESTROY_FUNCTION* pDestroyFunction );
+
+		template< typename JobType > static void DestroyJobCallback( void* pJob );
+		//@}
+	};
+}
+
+#include "Engine/JobContext.inl"
@@ -0,0 +1,52 @@
+/// Create a child job.
+///
+/// The job is spawned once the currently running job returns, so its parameters can be set up using the returned
+/// pointer until then.  The job is destroyed automatically after it has run.
+///
+/// @return  Pointer to the newly created job.
+///
+/// @see CreateContinuation()
+template< typename JobType >
+JobType* Helium::JobContext::Create()
+{
+	JobType* pJob = new JobType;
+	HELIUM_ASSERT( pJob );
+	AddChild( pJob, JobType::RunCallback, DestroyJobCallback< JobType > );
+
+	return pJob;
+}
+
+/// Create a continuation job to run once all child jobs of the currently running job have completed.
+///
+/// Only one continuation can be created for each job.  Completion of the currently running job is deferred until the
+/// continuation (and any children it creates) has completed.  The job is destroyed automatically after it has run.
+///
+/// @return  Pointer to the newly created continuation job.
+///
+/// @see Create()
+template< typename JobType >
+JobType* Helium::JobContext::CreateContinuation()
+{
+	JobType* pJob = new JobType;
+	HELIUM_ASSERT( pJob );
+	SetContinuation( pJob, JobType::RunCallback, DestroyJobCallback< JobType > );
+
+	return pJob;
+}
+
+/// Get the job manager running this job.
+///
+/// @return  Owning job manager.
+Helium::JobManager* Helium::JobContext::GetManager() const
+{
+	return m_pManager;
+}
+
+/// Destroy a job created through Create() or CreateContinuation().
+///
+/// @param[in] pJob  Job to destroy.
+template< typename JobType >
+void Helium::JobContext::DestroyJobCallback( void* pJob )
+{
+	delete static_cast< JobType* >( pJob );
+}
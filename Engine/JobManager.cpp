@@ -0,0 +1,606 @@
+#include "EnginePch.h"
+#include "Engine/JobManager.h"
+
+#include <thread>
+
+using namespace Helium;
+
+JobManager* JobManager::sm_pInstance = NULL;
+
+/// Compute the number of jobs between two queue indices, accounting for index wrap-around.
+///
+/// @param[in] top     Index of the oldest job in the queue.
+/// @param[in] bottom  Index one past the newest job in the queue.
+///
+/// @return  Number of jobs between the two indices (negative if the bottom index is before the top index).
+static int32_t QueueDistance( int32_t top, int32_t bottom )
+{
+	return static_cast< int32_t >( static_cast< uint32_t >( bottom ) - static_cast< uint32_t >( top ) );
+}
+
+/// Offset a queue index, allowing the index to wrap around.
+///
+/// @param[in] index   Queue index.
+/// @param[in] offset  Offset to apply.
+///
+/// @return  Offset queue index.
+static int32_t QueueOffset( int32_t index, int32_t offset )
+{
+	return static_cast< int32_t >( static_cast< uint32_t >( index ) + static_cast< uint32_t >( offset ) );
+}
+
+/// Constructor.
+JobManager::JobManager()
+	: m_sleepingWorkerCount( 0 )
+{
+	// The queue for the thread calling RunJob() always exists so that jobs can be run even if no workers are started.
+	JobQueue* pExternalQueue = new JobQueue;
+	HELIUM_ASSERT( pExternalQueue );
+	m_queues.Push( pExternalQueue );
+}
+
+/// Destructor.
+JobManager::~JobManager()
+{
+	Shutdown();
+
+	size_t queueCount = m_queues.GetSize();
+	for( size_t queueIndex = 0; queueIndex < queueCount; ++queueIndex )
+	{
+		delete m_queues[ queueIndex ];
+	}
+}
+
+/// Initialize the job manager.
+///
+/// @param[in] workerCount  Number of worker threads to start.  If this is invalid, one worker will be started for each
+///                         hardware thread other than the one calling RunJob().  This is clamped to MAX_WORKER_COUNT.
+///
+/// @return  True if initialization was sucessful, false if not.
+///
+/// @see Shutdown()
+bool JobManager::Initialize( size_t workerCount )
+{
+	Shutdown();
+
+	if( IsInvalid( workerCount ) )
+	{
+		size_t hardwareThreadCount = std::thread::hardware_concurrency();
+		workerCount = ( hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 1 );
+	}
+
+	if( workerCount > MAX_WORKER_COUNT )
+	{
+		workerCount = MAX_WORKER_COUNT;
+	}
+
+	m_queues.Reserve( workerCount + 1 );
+	m_workers.Reserve( workerCount );
+	m_threads.Reserve( workerCount );
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		JobQueue* pQueue = new JobQueue;
+		HELIUM_ASSERT( pQueue );
+		m_queues.Push( pQueue );
+	}
+
+	// All queues need to exist before any worker starts looking for jobs to steal.
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		JobWorker* pWorker = new JobWorker( this, workerIndex + 1 );
+		HELIUM_ASSERT( pWorker );
+		m_workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		m_threads.Push( pThread );
+
+		HELIUM_VERIFY( pThread->Start( TXT( "JobManager - job worker" ) ) );
+	}
+
+	return true;
+}
+
+/// Shut down the job manager, stopping all worker threads.
+///
+/// This must not be called while a RunJob() call is in progress.
+///
+/// @see Initialize()
+void JobManager::Shutdown()
+{
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workers[ workerIndex ]->Stop();
+	}
+
+	size_t threadCount = m_threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		RunnableThread* pThread = m_threads[ threadIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
+	}
+
+	m_threads.Clear();
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		delete m_workers[ workerIndex ];
+	}
+
+	m_workers.Clear();
+
+	size_t queueCount = m_queues.GetSize();
+	for( size_t queueIndex = EXTERNAL_QUEUE_INDEX + 1; queueIndex < queueCount; ++queueIndex )
+	{
+		delete m_queues[ queueIndex ];
+	}
+
+	m_queues.Resize( EXTERNAL_QUEUE_INDEX + 1 );
+}
+
+/// Run a job, blocking the calling thread until it and all jobs it spawns have completed.
+///
+/// The calling thread executes jobs from the job queues while it waits.  If called from within a running job, the job
+/// is run on the calling thread's own queue, allowing jobs (and functions called from them) to run nested parallel
+/// work.  Otherwise, only one thread may run jobs at a time, so calls from other threads block until it is done.
+///
+/// @param[in] pJob          Job to run.
+/// @param[in] pRunFunction  Function to call to run the job.
+void JobManager::RunJob( void* pJob, JobContext::RUN_FUNCTION* pRunFunction )
+{
+	HELIUM_ASSERT( pJob );
+	HELIUM_ASSERT( pRunFunction );
+
+	JobContext* pContext = new JobContext( this, pJob, pRunFunction, NULL );
+	HELIUM_ASSERT( pContext );
+
+	size_t currentQueue = reinterpret_cast< uintptr_t >( m_currentQueue.GetPointer() );
+	if( currentQueue != 0 )
+	{
+		RunAndWait( pContext, currentQueue - 1 );
+
+		return;
+	}
+
+	MutexScopeLock scopeLock( m_runLock );
+
+	m_currentQueue.SetPointer( reinterpret_cast< void* >( static_cast< uintptr_t >( EXTERNAL_QUEUE_INDEX + 1 ) ) );
+	RunAndWait( pContext, EXTERNAL_QUEUE_INDEX );
+	m_currentQueue.SetPointer( NULL );
+}
+
+/// Get the index of the calling thread within the job manager.
+///
+/// Each thread running jobs has its own index, so this can be used to select per-thread data from within jobs without
+/// any locking.  Threads that are not running jobs have no index, as any number of them may be running at once.
+///
+/// @return  Index from 1 to GetWorkerCount() if called from a worker thread, 0 if called from the thread inside
+///          RunJob(), or an invalid index if called from any other thread.
+size_t JobManager::GetCurrentThreadIndex() const
+{
+	size_t currentQueue = reinterpret_cast< uintptr_t >( m_currentQueue.GetPointer() );
+
+	return ( currentQueue != 0 ? currentQueue - 1 : Invalid< size_t >() );
+}
+
+/// Get the singleton JobManager instance, creating it if necessary.
+///
+/// @return  Reference to the JobManager instance.
+///
+/// @see DestroyStaticInstance()
+JobManager& JobManager::GetStaticInstance()
+{
+	if( !sm_pInstance )
+	{
+		sm_pInstance = new JobManager;
+		HELIUM_ASSERT( sm_pInstance );
+	}
+
+	return *sm_pInstance;
+}
+
+/// Destroy the singleton JobManager instance.
+///
+/// @see GetStaticInstance()
+void JobManager::DestroyStaticInstance()
+{
+	if( sm_pInstance )
+	{
+		sm_pInstance->Shutdown();
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
+
+/// Get the next job to run on a given thread, popping it from the thread's own queue or stealing it from another.
+///
+/// @param[in]    queueIndex  Index of the queue owned by the calling thread.
+/// @param[inout] rStealSeed  Random seed used to select the first queue from which to attempt to steal work.
+///
+/// @return  Job to run, or null if no jobs are available.
+JobContext* JobManager::FindJob( size_t queueIndex, uint32_t& rStealSeed )
+{
+	JobContext* pContext = m_queues[ queueIndex ]->Pop();
+	if( pContext )
+	{
+		return pContext;
+	}
+
+	size_t queueCount = m_queues.GetSize();
+	if( queueCount <= 1 )
+	{
+		return NULL;
+	}
+
+	// Start with a random queue so that idle threads don't all contend over the same victim.
+	rStealSeed = rStealSeed * 1103515245 + 12345;
+	size_t startIndex = ( rStealSeed >> 16 ) % queueCount;
+	for( size_t queueOffset = 0; queueOffset < queueCount; ++queueOffset )
+	{
+		size_t victimIndex = ( startIndex + queueOffset ) % queueCount;
+		if( victimIndex != queueIndex )
+		{
+			pContext = m_queues[ victimIndex ]->Steal();
+			if( pContext )
+			{
+				return pContext;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/// Run a job and spawn the child jobs and continuation it creates.
+///
+/// @param[in] pContext    Context of the job to run.
+/// @param[in] queueIndex  Index of the queue owned by the calling thread.
+void JobManager::Execute( JobContext* pContext, size_t queueIndex )
+{
+	HELIUM_ASSERT( pContext );
+	HELIUM_ASSERT( !pContext->m_bExecuted );
+
+	pContext->m_pRunFunction( pContext->m_pJob, pContext );
+	pContext->m_bExecuted = true;
+
+	JobContext* pFirstChild = pContext->m_pFirstChild;
+	pContext->m_pFirstChild = NULL;
+	pContext->m_pLastChild = NULL;
+
+	int32_t childCount = 0;
+	for( JobContext* pChild = pFirstChild; pChild; pChild = pChild->m_pNextSibling )
+	{
+		++childCount;
+	}
+
+	JobContext* pContinuation = pContext->m_pContinuation;
+	JobContext* pChildParent = pContext;
+	if( pContinuation )
+	{
+		// The continuation takes this job's place in the job tree, and is spawned once all of the children created by
+		// this job have completed.
+		pContinuation->m_pParent = pContext->m_pParent;
+		pContinuation->m_pCompletionCounter = pContext->m_pCompletionCounter;
+		pContinuation->m_pendingCount = ( childCount != 0 ? childCount : 1 );
+
+		delete pContext;
+		pContext = NULL;
+
+		if( childCount == 0 )
+		{
+			Spawn( pContinuation, queueIndex );
+			WakeUpWorkers();
+
+			return;
+		}
+
+		pChildParent = pContinuation;
+	}
+	else if( childCount != 0 )
+	{
+		// Keep the job from completing until all of its children have completed.
+		AtomicExchangeRelease( pContext->m_pendingCount, childCount + 1 );
+	}
+
+	JobContext* pChild = pFirstChild;
+	while( pChild )
+	{
+		// Read the next sibling first, as the child may be stolen and run as soon as it is spawned.
+		JobContext* pNextChild = pChild->m_pNextSibling;
+		pChild->m_pNextSibling = NULL;
+		pChild->m_pParent = pChildParent;
+		Spawn( pChild, queueIndex );
+
+		pChild = pNextChild;
+	}
+
+	if( childCount != 0 )
+	{
+		WakeUpWorkers();
+	}
+
+	if( pContext )
+	{
+		Finish( pContext, queueIndex );
+	}
+}
+
+/// Push a job onto the given thread's queue.
+///
+/// @param[in] pContext    Context of the job to spawn.
+/// @param[in] queueIndex  Index of the queue owned by the calling thread.
+void JobManager::Spawn( JobContext* pContext, size_t queueIndex )
+{
+	HELIUM_ASSERT( pContext );
+
+	if( !m_queues[ queueIndex ]->Push( pContext ) )
+	{
+		// Queue is full, so run the job immediately.
+		Execute( pContext, queueIndex );
+	}
+}
+
+/// Release a reference keeping a job from completing, completing the job (and notifying its parent) or spawning a
+/// pending continuation if it was the last reference.
+///
+/// @param[in] pContext    Context of the job to release.
+/// @param[in] queueIndex  Index of the queue owned by the calling thread.
+void JobManager::Finish( JobContext* pContext, size_t queueIndex )
+{
+	while( pContext )
+	{
+		if( AtomicDecrement( pContext->m_pendingCount ) != 0 )
+		{
+			return;
+		}
+
+		if( !pContext->m_bExecuted )
+		{
+			// Continuation whose children have all completed.
+			pContext->m_pendingCount = 1;
+			Spawn( pContext, queueIndex );
+			WakeUpWorkers();
+
+			return;
+		}
+
+		JobContext* pParent = pContext->m_pParent;
+		volatile int32_t* pCompletionCounter = pContext->m_pCompletionCounter;
+		delete pContext;
+
+		if( !pParent && pCompletionCounter )
+		{
+			AtomicExchangeRelease( *pCompletionCounter, 1 );
+		}
+
+		pContext = pParent;
+	}
+}
+
+/// Run a job on the calling thread, executing jobs from the given queue (or stolen from others) until it and all jobs
+/// it spawns have completed.
+///
+/// @param[in] pContext    Context of the job to run.
+/// @param[in] queueIndex  Index of the queue owned by the calling thread.
+void JobManager::RunAndWait( JobContext* pContext, size_t queueIndex )
+{
+	HELIUM_ASSERT( pContext );
+
+	volatile int32_t completionCounter = 0;
+	pContext->m_pCompletionCounter = &completionCounter;
+
+	Execute( pContext, queueIndex );
+
+	uint32_t stealSeed = static_cast< uint32_t >( queueIndex );
+	while( completionCounter == 0 )
+	{
+		JobContext* pNextContext = FindJob( queueIndex, stealSeed );
+		if( pNextContext )
+		{
+			Execute( pNextContext, queueIndex );
+		}
+		else
+		{
+			Thread::Yield();
+		}
+	}
+}
+
+/// Wake up any workers sleeping while waiting for jobs.
+void JobManager::WakeUpWorkers()
+{
+	if( m_sleepingWorkerCount == 0 )
+	{
+		return;
+	}
+
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workers[ workerIndex ]->WakeUp();
+	}
+}
+
+/// Constructor.
+JobManager::JobQueue::JobQueue()
+	: m_top( 0 )
+	, m_bottom( 0 )
+{
+	HELIUM_ASSERT( ( QUEUE_CAPACITY & ( QUEUE_CAPACITY - 1 ) ) == 0 );
+	MemoryZero( const_cast< JobContext** >( m_jobs ), sizeof( m_jobs ) );
+}
+
+/// Destructor.
+JobManager::JobQueue::~JobQueue()
+{
+	HELIUM_ASSERT( QueueDistance( m_top, m_bottom ) <= 0 );
+}
+
+/// Push a job onto the bottom of the queue.
+///
+/// This may only be called by the thread owning the queue.
+///
+/// @param[in] pContext  Context of the job to push.
+///
+/// @return  True if the job was pushed, false if the queue is full.
+bool JobManager::JobQueue::Push( JobContext* pContext )
+{
+	HELIUM_ASSERT( pContext );
+
+	int32_t bottom = m_bottom;
+	int32_t top = m_top;
+	if( QueueDistance( top, bottom ) >= static_cast< int32_t >( QUEUE_CAPACITY ) )
+	{
+		return false;
+	}
+
+	m_jobs[ static_cast< uint32_t >( bottom ) & ( QUEUE_CAPACITY - 1 ) ] = pContext;
+
+	// Full barrier so that the job is visible before the new bottom index, and so that the sleeping worker count is
+	// read after the job is published (see WakeUpWorkers()).
+	AtomicExchange( m_bottom, QueueOffset( bottom, 1 ) );
+
+	return true;
+}
+
+/// Pop the newest job from the bottom of the queue.
+///
+/// This may only be called by the thread owning the queue.
+///
+/// @return  Context of the popped job, or null if the queue is empty.
+JobContext* JobManager::JobQueue::Pop()
+{
+	int32_t bottom = QueueOffset( m_bottom, -1 );
+
+	// Full barrier so that the new bottom index is visible to stealing threads before reading the top index.
+	AtomicExchange( m_bottom, bottom );
+
+	int32_t top = m_top;
+	int32_t size = QueueDistance( top, bottom );
+	if( size < 0 )
+	{
+		// Queue is empty.
+		AtomicExchangeRelease( m_bottom, top );
+
+		return NULL;
+	}
+
+	JobContext* pContext = m_jobs[ static_cast< uint32_t >( bottom ) & ( QUEUE_CAPACITY - 1 ) ];
+	if( size > 0 )
+	{
+		return pContext;
+	}
+
+	// This is the last job in the queue, so race any stealing threads for it.
+	if( AtomicCompareExchange( m_top, QueueOffset( top, 1 ), top ) != top )
+	{
+		pContext = NULL;
+	}
+
+	AtomicExchangeRelease( m_bottom, QueueOffset( top, 1 ) );
+
+	return pContext;
+}
+
+/// Steal the oldest job from the top of the queue.
+///
+/// This may be called from any thread.
+///
+/// @return  Context of the stolen job, or null if the queue is empty or another thread took the job first.
+JobContext* JobManager::JobQueue::Steal()
+{
+	// Read the top index using a full barrier so that it is read before the bottom index.
+	int32_t top = AtomicOr( m_top, 0 );
+	int32_t bottom = m_bottom;
+	if( QueueDistance( top, bottom ) <= 0 )
+	{
+		return NULL;
+	}
+
+	JobContext* pContext = m_jobs[ static_cast< uint32_t >( top ) & ( QUEUE_CAPACITY - 1 ) ];
+	if( AtomicCompareExchange( m_top, QueueOffset( top, 1 ), top ) != top )
+	{
+		return NULL;
+	}
+
+	return pContext;
+}
+
+/// Constructor.
+///
+/// @param[in] pManager    Owning job manager.
+/// @param[in] queueIndex  Index of the queue owned by this worker.
+JobManager::JobWorker::JobWorker( JobManager* pManager, size_t queueIndex )
+	: m_pManager( pManager )
+	, m_queueIndex( queueIndex )
+	, m_wakeUpCondition( false, false )
+	, m_stopCounter( 0 )
+{
+	HELIUM_ASSERT( pManager );
+}
+
+/// Destructor.
+JobManager::JobWorker::~JobWorker()
+{
+}
+
+/// Execute jobs from this worker's queue, stealing from other queues when empty, until stopped.
+void JobManager::JobWorker::Run()
+{
+	uint32_t stealSeed = static_cast< uint32_t >( m_queueIndex );
+	size_t idleCount = 0;
+
+	m_pManager->m_currentQueue.SetPointer( reinterpret_cast< void* >( static_cast< uintptr_t >( m_queueIndex + 1 ) ) );
+
+	while( m_stopCounter == 0 )
+	{
+		JobContext* pContext = m_pManager->FindJob( m_queueIndex, stealSeed );
+		if( !pContext )
+		{
+			if( ++idleCount < IDLE_SPIN_COUNT )
+			{
+				Thread::Yield();
+
+				continue;
+			}
+
+			idleCount = 0;
+
+			// Register as sleeping before checking for jobs one last time so that jobs spawned in between still wake
+			// up this worker.
+			AtomicIncrement( m_pManager->m_sleepingWorkerCount );
+			pContext = m_pManager->FindJob( m_queueIndex, stealSeed );
+			if( !pContext )
+			{
+				m_wakeUpCondition.Wait();
+			}
+
+			AtomicDecrement( m_pManager->m_sleepingWorkerCount );
+
+			if( !pContext )
+			{
+				continue;
+			}
+		}
+
+		idleCount = 0;
+		m_pManager->Execute( pContext, m_queueIndex );
+	}
+}
+
+/// Request the worker to stop processing and return at the next possible opportunity.
+void JobManager::JobWorker::Stop()
+{
+	AtomicExchangeRelease( m_stopCounter, 1 );
+	m_wakeUpCondition.Signal();
+}
+
+/// Wake up the worker if it is waiting for jobs to be spawned.
+void JobManager::JobWorker::WakeUp()
+{
+	m_wakeUpCondition.Signal();
+}
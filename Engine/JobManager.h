@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
+
+#include "Foundation/DynamicArray.h"
+
+#include "Engine/Engine.h"
+#include "Engine/JobContext.h"
+
+namespace Helium
+{
+	/// Work-stealing job scheduler.
+	///
+	/// Jobs are run on a pool of worker threads (one per hardware thread by default, with the thread calling RunJob()
+	/// also executing jobs while it waits).  Each thread owns a fixed-size work-stealing deque: jobs spawned from a
+	/// running job are pushed onto the bottom of the deque of the thread running it and popped back off the bottom in
+	/// LIFO order, while idle threads steal the oldest jobs from the top of other threads' deques.
+	///
+	/// If no workers are running (Initialize() has not been called), jobs are executed on the thread calling RunJob().
+	///
+	/// RunJob() may also be called from within a running job, in which case the calling thread keeps executing jobs
+	/// from its own queue (and stealing from others) until the nested job has completed.
+	class HELIUM_ENGINE_API JobManager : NonCopyable
+	{
+	public:
+		/// Maximum number of worker threads.
+		static const size_t MAX_WORKER_COUNT = 63;
+		/// Number of jobs each worker queue can hold (must be a power of two).  Jobs spawned while a queue is full are
+		/// run immediately on the spawning thread.
+		static const size_t QUEUE_CAPACITY = 4096;
+		/// Number of times an idle worker will yield while looking for work before going to sleep.
+		static const size_t IDLE_SPIN_COUNT = 64;
+
+		/// @name Initialization
+		//@{
+		bool Initialize( size_t workerCount = Invalid< size_t >() );
+		void Shutdown();
+
+		inline size_t GetWorkerCount() const;
+		//@}
+
+		/// @name Job Execution
+		//@{
+		template< typename JobType > void RunJob( JobType& rJob );
+		void RunJob( void* pJob, JobContext::RUN_FUNCTION* pRunFunction );
+
+		size_t GetCurrentThreadIndex() const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static JobManager& GetStaticInstance();
+		static void DestroyStaticInstance();
+		//@}
+
+	private:
+		/// Index of the queue used by the thread calling RunJob().
+		static const size_t EXTERNAL_QUEUE_INDEX = 0;
+
+		/// Fixed-capacity Chase-Lev work-stealing deque.
+		///
+		/// Push() and Pop() may only be called by the thread owning the queue, while Steal() may be called from any
+		/// thread.
+		class JobQueue : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			JobQueue();
+			~JobQueue();
+			//@}
+
+			/// @name Queue Operations
+			//@{
+			bool Push( JobContext* pContext );
+			JobContext* Pop();
+			JobContext* Steal();
+			//@}
+
+		private:
+			/// Index of the next job to steal (only ever incremented).
+			volatile int32_t m_top;
+			/// Index at which to push the next job.
+			volatile int32_t m_bottom;
+			/// Circular job buffer.
+			JobContext* volatile m_jobs[ QUEUE_CAPACITY ];
+		};
+
+		/// Job worker thread runnable.
+		class JobWorker : public Runnable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			JobWorker( JobManager* pManager, size_t queueIndex );
+			virtual ~JobWorker();
+			//@}
+
+			/// @name Runnable Interface
+			//@{
+			virtual void Run();
+			//@}
+
+			/// @name External Thread Control
+			//@{
+			void Stop();
+			void WakeUp();
+			//@}
+
+		private:
+			/// Owning job manager.
+			JobManager* m_pManager;
+			/// Index of the queue owned by this worker.
+			size_t m_queueIndex;
+			/// Condition used to wake up the worker thread when jobs are spawned (or when it should shut down).
+			Condition m_wakeUpCondition;
+
+			/// Non-zero if this thread should stop when next possible, zero if it should continue.
+			volatile int32_t m_stopCounter;
+		};
+
+		/// Job queues (the first queue is used by the thread calling RunJob(), with one queue for each worker after).
+		DynamicArray< JobQueue* > m_queues;
+
+		/// Worker threads.
+		DynamicArray< RunnableThread* > m_threads;
+		/// Worker thread runnables.
+		DynamicArray< JobWorker* > m_workers;
+		/// Number of workers currently sleeping while waiting for jobs.
+		volatile int32_t m_sleepingWorkerCount;
+
+		/// Lock preventing multiple threads from calling RunJob() at once.
+		Mutex m_runLock;
+		/// One plus the index of the queue owned by the current thread while it is running jobs, or zero otherwise.
+		ThreadLocalPointer m_currentQueue;
+
+		/// Singleton instance.
+		static JobManager* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		JobManager();
+		~JobManager();
+		//@}
+
+		/// @name Worker Support
+		//@{
+		JobContext* FindJob( size_t queueIndex, uint32_t& rStealSeed );
+		void Execute( JobContext* pContext, size_t queueIndex );
+		void Spawn( JobContext* pContext, size_t queueIndex );
+		void Finish( JobContext* pContext, size_t queueIndex );
+		void WakeUpWorkers();
+		void RunAndWait( JobContext* pContext, size_t queueIndex );
+		//@}
+	};
+}
+
+#include "Engine/JobManager.inl"
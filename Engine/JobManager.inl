@@ -0,0 +1,21 @@
+/// Get the number of worker threads running jobs.
+///
+/// @return  Number of active worker threads (not including the thread calling RunJob()).
+///
+/// @see Initialize()
+size_t Helium::JobManager::GetWorkerCount() const
+{
+	return m_workers.GetSize();
+}
+
+/// Run a job, blocking the calling thread until it and all jobs it spawns have completed.
+///
+/// The calling thread executes jobs from the job queues while it waits.  Jobs that only need to spawn work should
+/// use JobContext::Create() instead, but this may be called from within a running job to wait on nested work.
+///
+/// @param[in] rJob  Job to run.  The job must provide a static RunCallback( void*, JobContext* ) function.
+template< typename JobType >
+void Helium::JobManager::RunJob( JobType& rJob )
+{
+	RunJob( &rJob, JobType::RunCallback );
+}
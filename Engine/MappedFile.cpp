@@ -0,0 +1,146 @@
+#include "EnginePch.h"
+#include "Engine/MappedFile.h"
+
+#include "Foundation/DynamicArray.h"
+
+#if HELIUM_OS_WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Helium;
+
+/// Constructor.
+MappedFile::MappedFile()
+: m_pData( NULL )
+, m_size( 0 )
+{
+}
+
+/// Destructor.
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+/// Map the contents of a file into memory for reading.
+///
+/// Empty files cannot be mapped.
+///
+/// @param[in] pFileName  Path name of the file to map.
+///
+/// @return  True if the file was mapped successfully, false if not.
+///
+/// @see Close()
+bool MappedFile::Open( const char* pFileName )
+{
+	HELIUM_ASSERT( pFileName );
+
+	Close();
+
+#if HELIUM_OS_WIN
+	int wideLength = MultiByteToWideChar( CP_UTF8, 0, pFileName, -1, NULL, 0 );
+	if( wideLength <= 0 )
+	{
+		return false;
+	}
+
+	DynamicArray< wchar_t > wideFileName;
+	wideFileName.Resize( static_cast< size_t >( wideLength ) );
+	MultiByteToWideChar( CP_UTF8, 0, pFileName, -1, wideFileName.GetData(), wideLength );
+
+	HANDLE hFile = CreateFileW(
+		wideFileName.GetData(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		NULL,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		NULL );
+	if( hFile == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if( !GetFileSizeEx( hFile, &fileSize ) || fileSize.QuadPart <= 0 ||
+		static_cast< uint64_t >( fileSize.QuadPart ) > static_cast< uint64_t >( SIZE_MAX ) )
+	{
+		CloseHandle( hFile );
+
+		return false;
+	}
+
+	HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+	CloseHandle( hFile );
+	if( !hMapping )
+	{
+		return false;
+	}
+
+	// The view keeps the mapping object alive, so the handle can be closed immediately.
+	void* pView = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+	CloseHandle( hMapping );
+	if( !pView )
+	{
+		return false;
+	}
+
+	m_pData = static_cast< const uint8_t* >( pView );
+	m_size = static_cast< size_t >( fileSize.QuadPart );
+#else
+	int fileDescriptor = open( pFileName, O_RDONLY );
+	if( fileDescriptor < 0 )
+	{
+		return false;
+	}
+
+	struct stat fileStatus;
+	if( fstat( fileDescriptor, &fileStatus ) != 0 || fileStatus.st_size <= 0 ||
+		static_cast< uint64_t >( fileStatus.st_size ) > static_cast< uint64_t >( SIZE_MAX ) )
+	{
+		close( fileDescriptor );
+
+		return false;
+	}
+
+	size_t fileSize = static_cast< size_t >( fileStatus.st_size );
+
+	// The mapping remains valid after the file descriptor is closed.
+	void* pView = mmap( NULL, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+	close( fileDescriptor );
+	if( pView == MAP_FAILED )
+	{
+		return false;
+	}
+
+	m_pData = static_cast< const uint8_t* >( pView );
+	m_size = fileSize;
+#endif
+
+	return true;
+}
+
+/// Unmap the currently mapped file, if any.
+///
+/// @see Open()
+void MappedFile::Close()
+{
+	if( !m_pData )
+	{
+		return;
+	}
+
+#if HELIUM_OS_WIN
+	UnmapViewOfFile( m_pData );
+#else
+	munmap( const_cast< uint8_t* >( m_pData ), m_size );
+#endif
+
+	m_pData = NULL;
+	m_size = 0;
+}
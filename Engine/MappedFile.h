@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Platform/Utility.h"
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	/// Read-only memory mapping of an entire file.
+	class HELIUM_ENGINE_API MappedFile : NonCopyable
+	{
+	public:
+		/// @name Construction/Destruction
+		//@{
+		MappedFile();
+		~MappedFile();
+		//@}
+
+		/// @name Mapping
+		//@{
+		bool Open( const char* pFileName );
+		void Close();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline bool IsOpen() const;
+		inline const uint8_t* GetData() const;
+		inline size_t GetSize() const;
+		//@}
+
+	private:
+		/// Base address of the mapped view.
+		const uint8_t* m_pData;
+		/// Size of the mapped view, in bytes.
+		size_t m_size;
+	};
+}
+
+#include "Engine/MappedFile.inl"
@@ -0,0 +1,27 @@
+/// Get whether a file is currently mapped.
+///
+/// @return  True if a file is mapped, false if not.
+bool Helium::MappedFile::IsOpen() const
+{
+	return ( m_pData != NULL );
+}
+
+/// Get the base address of the mapped file contents.
+///
+/// @return  Mapped file contents, or null if no file is mapped.
+///
+/// @see GetSize()
+const uint8_t* Helium::MappedFile::GetData() const
+{
+	return m_pData;
+}
+
+/// Get the size of the mapped file contents.
+///
+/// @return  Number of bytes mapped.
+///
+/// @see GetData()
+size_t Helium::MappedFile::GetSize() const
+{
+	return m_size;
+}
@@ -3,11 +3,42 @@
 
 using namespace Helium;
 
+/// Constructor.
+PackageLoader::PackageLoader()
+: m_progressCounter( 0 )
+{
+}
+
 /// Destructor.
 PackageLoader::~PackageLoader()
 {
 }
 
+/// Get the paths of the assets directly referenced by an object, if known ahead of loading the object.
+///
+/// This is used by the AssetLoader to prefetch dependencies of an object before the object itself has been
+/// deserialized.  The default implementation has no dependency information.
+///
+/// @param[in]  path           Asset path.
+/// @param[out] rDependencies  Array to which the dependency paths are appended.
+///
+/// @return  True if dependency information was available for the object, false if not.
+bool PackageLoader::GetAssetDependencies( AssetPath /*path*/, DynamicArray< AssetPath >& /*rDependencies*/ ) const
+{
+	return false;
+}
+
+/// Signal that package preloading or an object preload has completed.
+///
+/// Subclasses must call this after the state reported by TryFinishPreload() or TryFinishLoadObject() has been
+/// updated, so that any asset load requests waiting on this package loader are updated on the next tick.
+///
+/// @see GetProgressCounter()
+void PackageLoader::NotifyProgress()
+{
+	AtomicIncrementRelease( m_progressCounter );
+}
+
 #if HELIUM_TOOLS
 
 bool PackageLoader::HasAssetFileState() const
@@ -10,6 +10,7 @@ namespace Helium
 	public:
 		/// @name Construction/Destruction
 		//@{
+		PackageLoader();
 		virtual ~PackageLoader();
 		//@}
 
@@ -21,6 +22,10 @@ namespace Helium
 		virtual bool TryFinishLoadObject( size_t requestId, AssetPtr& rspObject ) = 0;
 
 		virtual void Tick() = 0;
+
+		virtual bool GetAssetDependencies( AssetPath path, DynamicArray< AssetPath >& rDependencies ) const;
+
+		inline int32_t GetProgressCounter() const;
 		//@}
 
 		/// @name Data Access
@@ -41,5 +46,17 @@ namespace Helium
 
 		virtual bool SaveAsset( Asset *pAsset ) const;
 #endif // #if HELIUM_TOOLS
+
+	protected:
+		/// @name Loading Implementation
+		//@{
+		void NotifyProgress();
+		//@}
+
+	private:
+		/// Counter incremented each time package preloading or an object preload completes (wraps around).
+		volatile int32_t m_progressCounter;
 	};
 }
+
+#include "Engine/PackageLoader.inl"
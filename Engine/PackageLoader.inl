@@ -0,0 +1,12 @@
+/// Get a counter that changes each time package preloading or an object preload completes.
+///
+/// The asset loader samples this before updating load requests that are waiting on this package loader, and only
+/// updates them again once the counter has changed.
+///
+/// @return  Current progress counter.
+///
+/// @see NotifyProgress()
+int32_t Helium::PackageLoader::GetProgressCounter() const
+{
+	return m_progressCounter;
+}
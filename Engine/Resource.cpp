@@ -72,7 +72,7 @@ size_t Resource::GetSubDataSize( uint32_t subDataIndex ) const
 	AssetPath resourcePath = GetPath();
 	const Cache::Entry* pCacheEntry = pCache->FindEntry( resourcePath, subDataIndex );
 
-	return ( pCacheEntry ? pCacheEntry->size : Invalid< size_t >() );
+	return ( pCacheEntry ? pCacheEntry->uncompressedSize : Invalid< size_t >() );
 }
 
 /// Begin asynchronous loading of the specified resource sub-data.
@@ -131,12 +131,11 @@ size_t Resource::BeginLoadSubData( void* pBuffer, uint32_t subDataIndex, size_t
 		return Invalid< size_t >();
 	}
 
-	// Begin an asynchronous load.
-	size_t subDataSize = pCacheEntry->size;
+	// Begin an asynchronous load (compressed sub-data is decompressed on the async loader worker threads).
+	size_t subDataSize = pCacheEntry->uncompressedSize;
 	size_t loadSize = Min( subDataSize, loadSizeMax );
 
-	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
-	size_t loadId = rAsyncLoader.QueueRequest( pBuffer, pCache->GetCacheFileName(), pCacheEntry->offset, loadSize );
+	size_t loadId = pCache->BeginLoadEntry( *pCacheEntry, pBuffer, loadSize );
 
 	return loadId;
 }
@@ -4,6 +4,7 @@
 #include "Foundation/Functions.h"
 #include "EngineJobs/EngineJobs.h"
 #include "EngineJobs/EngineJobsTypes.h"
+#include "Engine/JobContext.h"
 
 namespace Helium
 {
@@ -46,8 +47,8 @@ public:
 
     /// @name Job Execution
     //@{
-    void Run();
-    inline static void RunCallback( void* pJob );
+    void Run( JobContext* pContext );
+    inline static void RunCallback( void* pJob, JobContext* pContext );
     //@}
 
 private:
@@ -51,10 +51,11 @@ namespace Helium
 	/// @param[in] pJob      Job to run.
 	/// @param[in] pContext  Context associated with the running job instance.
 	template< typename T, typename CompareFunction >
-	void SortJob< T, CompareFunction >::RunCallback( void* pJob )
+	void SortJob< T, CompareFunction >::RunCallback( void* pJob, JobContext* pContext )
 	{
 		HELIUM_ASSERT( pJob );
-		static_cast< SortJob* >( pJob )->Run();
+		HELIUM_ASSERT( pContext );
+		static_cast< SortJob* >( pJob )->Run( pContext );
 	}
 
 	/// Constructor.
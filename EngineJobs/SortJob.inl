@@ -68,8 +68,10 @@ namespace Helium
     ///
     /// @param[in] pContext  Context in which this job is running.
     template< typename T, typename CompareFunction >
-    void SortJob< T, CompareFunction >::Run()
+    void SortJob< T, CompareFunction >::Run( JobContext* pContext )
     {
+        HELIUM_ASSERT( pContext );
+
 		size_t count = m_parameters.count;
         if( count <= 1 )
         {
@@ -80,7 +82,42 @@ namespace Helium
         HELIUM_ASSERT( pBase );
 
         CompareFunction& rCompare = m_parameters.compare;
-        
-		_Quicksort( pBase, count, rCompare );
+
+        size_t singleJobCount = m_parameters.singleJobCount;
+        if( count <= 2 || count <= singleJobCount )
+        {
+			_Quicksort( pBase, count, rCompare );
+
+            return;
+        }
+
+        // Partition the array and sort each partition in a separate child job.
+        size_t pivotIndex = _Partition( pBase, count, rCompare );
+        if( pivotIndex > 1 )
+        {
+            SortJob* pJob = pContext->Create< SortJob >();
+            HELIUM_ASSERT( pJob );
+
+            Parameters& rParameters = pJob->GetParameters();
+            rParameters.pBase = pBase;
+            rParameters.count = pivotIndex;
+            rParameters.compare = rCompare;
+            rParameters.singleJobCount = singleJobCount;
+        }
+
+        size_t startIndex = pivotIndex + 1;
+        HELIUM_ASSERT( startIndex <= count );
+        size_t partitionSize = count - startIndex;
+        if( partitionSize > 1 )
+        {
+            SortJob* pJob = pContext->Create< SortJob >();
+            HELIUM_ASSERT( pJob );
+
+            Parameters& rParameters = pJob->GetParameters();
+            rParameters.pBase = pBase + startIndex;
+            rParameters.count = partitionSize;
+            rParameters.compare = rCompare;
+            rParameters.singleJobCount = singleJobCount;
+        }
     }
 }
@@ -94,7 +94,8 @@ void ProcessAI( World *pWorld )
 		}
 	}
 
-	QueryComponents< AIComponentChasePlayer, AvatarControllerComponent, UpdateAI_ChasePlayer >( pWorld );
+	// The player list is only read from here on, so each AI can pick its target in parallel
+	ParallelQueryComponents< AIComponentChasePlayer, AvatarControllerComponent, UpdateAI_ChasePlayer >( pWorld );
 }
 
 HELIUM_DEFINE_TASK( TaskProcessAI, ( ForEachWorld< ProcessAI > ), TickTypes::Gameplay )
@@ -103,4 +104,8 @@ void TaskProcessAI::DefineContract( Helium::TaskContract &rContract )
 {
 	rContract.ExecuteAfter<Helium::StandardDependencies::ReceiveInput>();
 	rContract.ExecuteBefore<Helium::StandardDependencies::ProcessPhysics>();
+	rContract.ReadsComponents<AIComponentChasePlayer>();
+	rContract.ReadsComponents<PlayerComponent>();
+	rContract.ReadsComponents<TransformComponent>();
+	rContract.WritesComponents<AvatarControllerComponent>();
 }
@@ -49,7 +49,7 @@ void AvatarControllerComponentDefinition::PopulateMetaType( Reflect::MetaStruct&
 
 //////////////////////////////////////////////////////////////////////////
 
-void ApplyPlayerInputToAvatar( PlayerInputComponent *pPlayerInput, AvatarControllerComponent *pController )
+void ApplyPlayerInputToAvatar( const PlayerInputComponent *pPlayerInput, AvatarControllerComponent *pController )
 {
 	if (pPlayerInput->m_bHasWorldSpaceFocus)
 	{
@@ -62,11 +62,14 @@ void ApplyPlayerInputToAvatar( PlayerInputComponent *pPlayerInput, AvatarControl
 	pController->m_bShoot = pPlayerInput->m_bFirePrimary;
 }
 
-HELIUM_DEFINE_TASK( ApplyPlayerInputToAvatarTask, (ForEachWorld< QueryComponents< PlayerInputComponent, AvatarControllerComponent, ApplyPlayerInputToAvatar > >), TickTypes::Gameplay )
+HELIUM_DEFINE_TASK( ApplyPlayerInputToAvatarTask, (ForEachWorld< QueryComponents< const PlayerInputComponent, AvatarControllerComponent, ApplyPlayerInputToAvatar > >), TickTypes::Gameplay )
 
 void ExampleGame::ApplyPlayerInputToAvatarTask::DefineContract( Helium::TaskContract &rContract )
 {
 	rContract.ExecuteAfter<ExampleGame::GatherInputForPlayers>();
+	rContract.QueriesComponents<const PlayerInputComponent, AvatarControllerComponent>();
+	rContract.ReadsComponents<TransformComponent>();
+	rContract.RunsPerWorld();
 }
 
 //////////////////////////////////////////////////////////////////////////
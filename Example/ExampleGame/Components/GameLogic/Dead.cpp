@@ -2,27 +2,13 @@
 
 #include "Dead.h"
 #include "Framework/WorldManager.h"
+#include "Framework/TagQuery.h"
 #include "ExampleGame/Components/GameLogic/Health.h"
 
 
 using namespace Helium;
 using namespace ExampleGame;
 
-//////////////////////////////////////////////////////////////////////////
-// DeadComponent
-
-HELIUM_DEFINE_COMPONENT(ExampleGame::DeadComponent, 128);
-
-void DeadComponent::PopulateMetaType( Reflect::MetaStruct& comp )
-{
-
-}
-
-void DeadComponent::Initialize( float damageAmount )
-{
-	m_DamageAmount = damageAmount;
-}
-
 //////////////////////////////////////////////////////////////////////////
 // DespawnOnDeathComponent
 
@@ -33,9 +19,19 @@ void DespawnOnDeathComponent::PopulateMetaType( Reflect::MetaStruct& comp )
 
 }
 
-void DespawnOnDeathComponent::Initialize( const DespawnOnDeathComponentDefinition &definition )
+DespawnOnDeathComponent::~DespawnOnDeathComponent()
 {
+	// The component may be removed from an entity that stays alive, so don't leave the entity despawning on death
+	Entity *pEntity = GetEntity();
+	if ( pEntity && pEntity->GetSlice().Get() )
+	{
+		pEntity->ClearTag<DespawnOnDeathTag>();
+	}
+}
 
+void DespawnOnDeathComponent::Initialize( const DespawnOnDeathComponentDefinition &definition )
+{
+	GetEntity()->SetTag<DespawnOnDeathTag>();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -51,12 +47,17 @@ void DespawnOnDeathComponentDefinition::PopulateMetaType( Reflect::MetaStruct& c
 //////////////////////////////////////////////////////////////////////////
 // TaskDestroyAllDead
 
-void DoDestroyAllDead( DespawnOnDeathComponent *pDespawnOnDeathComponent, DeadComponent *pHealthComponent )
+void DoDestroyAllDead( Entity *pEntity )
+{
+	pEntity->DeferredDestroy();
+}
+
+void DestroyAllDead( World *pWorld )
 {
-	pDespawnOnDeathComponent->GetEntity()->DeferredDestroy();
+	QueryTags< DeadTag, DespawnOnDeathTag >( pWorld, DoDestroyAllDead );
 }
 
-HELIUM_DEFINE_TASK( TaskDestroyAllDead, ( ForEachWorld< QueryComponents< DespawnOnDeathComponent, DeadComponent, DoDestroyAllDead > > ), TickTypes::Gameplay )
+HELIUM_DEFINE_TASK( TaskDestroyAllDead, ( ForEachWorld< DestroyAllDead > ), TickTypes::Gameplay )
 
 void TaskDestroyAllDead::DefineContract( Helium::TaskContract &rContract )
 {
@@ -6,6 +6,7 @@
 #include "Foundation/DynamicArray.h"
 #include "Framework/TaskScheduler.h"
 #include "Framework/Entity.h"
+#include "Framework/EntityTags.h"
 #include "Components/TransformComponent.h"
 #include "Bullet/BulletBodyComponent.h"
 
@@ -13,20 +14,11 @@
 
 namespace ExampleGame
 {
-	class DeadComponentDefinition;
+	// Set on entities whose health has run out
+	HELIUM_DECLARE_TAG( DeadTag );
 
-	typedef Helium::StrongPtr<DeadComponentDefinition> DeadComponentDefinitionPtr;	
-	typedef Helium::StrongPtr<const DeadComponentDefinition> ConstDeadComponentDefinitionPtr;
-
-	struct EXAMPLE_GAME_API DeadComponent : public Helium::Component
-	{
-		HELIUM_DECLARE_COMPONENT( ExampleGame::DeadComponent, Helium::Component );
-		static void PopulateMetaType( Helium::Reflect::MetaStruct& comp );
-
-		void Initialize( float damageAmount );
-
-		float m_DamageAmount;
-	};
+	// Set on entities with a DespawnOnDeathComponent, so that dead ones can be found with a tag query
+	HELIUM_DECLARE_TAG( DespawnOnDeathTag );
 
 	class DespawnOnDeathComponentDefinition;
 
@@ -35,6 +27,8 @@ namespace ExampleGame
 		HELIUM_DECLARE_COMPONENT( ExampleGame::DespawnOnDeathComponent, Helium::EntityComponent );
 		static void PopulateMetaType( Helium::Reflect::MetaStruct& comp );
 
+		~DespawnOnDeathComponent();
+
 		void Initialize(const DespawnOnDeathComponentDefinition &definition);
 	};
 
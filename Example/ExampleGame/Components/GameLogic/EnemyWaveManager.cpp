@@ -153,12 +153,19 @@ void EnemyWaveManager::SpawnWave( EnemyWaveDefinition *pWave, ParameterSet_Actio
 {
 	HELIUM_ASSERT(pParameters);
 
-	WaveState *pWaveState = m_ActiveWaves.New();
-	pWaveState->m_Entities.Reserve(pParameters->m_Count);
+	HELIUM_ASSERT( pWave->m_Formation );
+	HELIUM_ASSERT( pWave->m_Entity );
+
+	const size_t count = pParameters->m_Count > 0 ? static_cast< size_t >( pParameters->m_Count ) : 0;
+
+	// Build every enemy's parameters first so the whole wave can be spawned in one batch
+	DynamicArray< ParameterSetPtr > parameterSets;
+	DynamicArray< ParameterSet * > parameterSetPointers;
+	parameterSets.Reserve( count );
+	parameterSetPointers.Reserve( count );
 
 	for (int i = 0; i < pParameters->m_Count; ++i)
 	{
-		HELIUM_ASSERT(pWave->m_Formation);
 		Helium::Simd::Vector3 location = pWave->m_Formation->GetSpawnLocation( pParameters, i );
 		HELIUM_TRACE(
 			TraceLevels::Info,
@@ -170,11 +177,21 @@ void EnemyWaveManager::SpawnWave( EnemyWaveDefinition *pWave, ParameterSet_Actio
 		ParameterSet_InitLocated *pInitLocated = builder.AddParameterSet<ParameterSet_InitLocated>();
 		pInitLocated->m_Position = location;
 
-		HELIUM_ASSERT( pWave->m_Entity );
-		Entity *pEntity = m_pWorld->GetRootSlice()->CreateEntity(pWave->m_Entity, builder.GetSet());
+		parameterSets.Push( ParameterSetPtr( builder.GetSet() ) );
+		parameterSetPointers.Push( builder.GetSet() );
+	}
+
+	DynamicArray< Entity * > entities;
+	entities.Resize( count );
+	m_pWorld->GetRootSlice()->SpawnN( pWave->m_Entity, count, parameterSetPointers.GetData(), entities.GetData() );
+
+	WaveState *pWaveState = m_ActiveWaves.New();
+	pWaveState->m_Entities.Reserve( count );
 
+	for (size_t i = 0; i < count; ++i)
+	{
 		WaveEntityState *pEntityState = pWaveState->m_Entities.New();
-		pEntityState->m_Entity = pEntity;
+		pEntityState->m_Entity = entities[ i ];
 	}
 }
 
@@ -32,7 +32,6 @@ void HealthComponent::Initialize( const HealthComponentDefinition &definition )
 {
 	m_Health = ( definition.m_InitialHealth < 0.0f) ? definition.m_MaxHealth : definition.m_InitialHealth;
 	m_MaxHealth = definition.m_MaxHealth;
-	m_CreatedDeadComponent = false;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -62,12 +61,7 @@ void DoKillAllWithZeroHealth( HealthComponent *pHealthComponent )
 {
 	if ( pHealthComponent->m_Health < HELIUM_EPSILON )
 	{
-		if (!pHealthComponent->m_CreatedDeadComponent && !pHealthComponent->GetComponentCollection()->GetFirst<DeadComponent>())
-		{
-			pHealthComponent->AllocateSiblingComponent<DeadComponent>();
-		}
-
-		pHealthComponent->m_CreatedDeadComponent = true;
+		pHealthComponent->GetEntity()->SetTag<DeadTag>();
 	}
 }
 
@@ -77,4 +71,9 @@ void ExampleGame::KillAllWithZeroHealth::DefineContract( Helium::TaskContract &r
 {
 	rContract.ExecuteAfter<ExampleGame::DoDamage>();
 	rContract.ExecuteBefore<Helium::StandardDependencies::Render>();
+	rContract.WritesComponents<HealthComponent>();
+
+	// Sets DeadTag, which writes tag words shared by every entity in a slice
+	rContract.RequiresExclusiveAccess();
+	rContract.RunsPerWorld();
 }
@@ -0,0 +1,373 @@
+#include "FrameworkPch.h"
+#include "Framework/ComponentArchetype.h"
+
+using namespace Helium;
+using namespace Helium::Components;
+
+////////////////////////////////////////////////////////////////////////
+//       Archetype
+////////////////////////////////////////////////////////////////////////
+
+Archetype::Archetype( const Signature &rSignature )
+	: m_Signature( rSignature )
+	, m_RowCount( 0 )
+	, m_ChunkCapacity( 0 )
+	, m_OrphanedRowCount( 0 )
+{
+	for ( size_t typeId = 0; typeId < MAX_SIGNATURE_TYPE_COUNT; ++typeId )
+	{
+		if ( m_Signature.Test( static_cast< TypeId >( typeId ) ) )
+		{
+			m_TypeIds.Push( static_cast< TypeId >( typeId ) );
+		}
+	}
+
+	// Size chunks so that a chunk's columns fit in roughly ARCHETYPE_CHUNK_SIZE bytes
+	const size_t rowSize = sizeof( ComponentCollection * ) + m_TypeIds.GetSize() * sizeof( Component * ) + sizeof( bool );
+	m_ChunkCapacity = static_cast< uint32_t >( Max< size_t >( ARCHETYPE_CHUNK_SIZE / rowSize, 16 ) );
+}
+
+Archetype::~Archetype()
+{
+	for ( DynamicArray< ArchetypeChunk >::Iterator iter = m_Chunks.Begin(); iter != m_Chunks.End(); ++iter )
+	{
+		g_ComponentAllocator.Free( iter->m_pCollections );
+	}
+}
+
+size_t Archetype::FindImplementingColumn( TypeId typeId ) const
+{
+	const DynamicArray< TypeId > &implementingTypes = GetTypeData( typeId )->m_ImplementingTypes;
+	for ( DynamicArray< TypeId >::ConstIterator typeIter = implementingTypes.Begin(); typeIter != implementingTypes.End(); ++typeIter )
+	{
+		if ( *typeIter >= MAX_SIGNATURE_TYPE_COUNT || !m_Signature.Test( *typeIter ) )
+		{
+			continue;
+		}
+
+		for ( size_t column = 0; column < m_TypeIds.GetSize(); ++column )
+		{
+			if ( m_TypeIds[ column ] == *typeIter )
+			{
+				return column;
+			}
+		}
+	}
+
+	return Invalid< size_t >();
+}
+
+uint32_t Archetype::AddRow( ComponentCollection *pCollection )
+{
+	HELIUM_ASSERT( pCollection );
+
+	if ( m_RowCount == m_Chunks.GetSize() * m_ChunkCapacity )
+	{
+		const size_t columnCount = m_TypeIds.GetSize();
+		const size_t chunkSize = m_ChunkCapacity * ( sizeof( ComponentCollection * ) + columnCount * sizeof( Component * ) + sizeof( bool ) );
+
+		ArchetypeChunk &rChunk = *m_Chunks.New();
+		rChunk.m_pCollections = static_cast< ComponentCollection ** >( g_ComponentAllocator.Allocate( chunkSize ) );
+		HELIUM_ASSERT( rChunk.m_pCollections );
+		rChunk.m_pComponents = reinterpret_cast< Component ** >( rChunk.m_pCollections + m_ChunkCapacity );
+		rChunk.m_pDirty = reinterpret_cast< bool * >( rChunk.m_pComponents + columnCount * m_ChunkCapacity );
+		rChunk.m_RowCount = 0;
+		rChunk.m_Capacity = m_ChunkCapacity;
+	}
+
+	uint32_t row = m_RowCount++;
+
+	ArchetypeChunk &rChunk = m_Chunks[ row / m_ChunkCapacity ];
+	uint32_t chunkRow = rChunk.m_RowCount++;
+	HELIUM_ASSERT( chunkRow == row % m_ChunkCapacity );
+
+	rChunk.m_pCollections[ chunkRow ] = pCollection;
+	rChunk.m_pDirty[ chunkRow ] = false;
+	for ( size_t column = 0; column < m_TypeIds.GetSize(); ++column )
+	{
+		rChunk.m_pComponents[ column * m_ChunkCapacity + chunkRow ] = NULL;
+	}
+
+	return row;
+}
+
+void Archetype::RemoveRow( uint32_t row )
+{
+	HELIUM_ASSERT( row < m_RowCount );
+
+	uint32_t lastRow = m_RowCount - 1;
+	ArchetypeChunk &rLastChunk = m_Chunks[ lastRow / m_ChunkCapacity ];
+	uint32_t lastChunkRow = lastRow % m_ChunkCapacity;
+
+	// Keep rows packed by moving the last row into the removed one
+	if ( row != lastRow )
+	{
+		ArchetypeChunk &rChunk = m_Chunks[ row / m_ChunkCapacity ];
+		uint32_t chunkRow = row % m_ChunkCapacity;
+
+		ComponentCollection *pMovedCollection = rLastChunk.m_pCollections[ lastChunkRow ];
+		rChunk.m_pCollections[ chunkRow ] = pMovedCollection;
+		rChunk.m_pDirty[ chunkRow ] = rLastChunk.m_pDirty[ lastChunkRow ];
+		for ( size_t column = 0; column < m_TypeIds.GetSize(); ++column )
+		{
+			rChunk.m_pComponents[ column * m_ChunkCapacity + chunkRow ] = rLastChunk.m_pComponents[ column * m_ChunkCapacity + lastChunkRow ];
+		}
+
+		if ( pMovedCollection )
+		{
+			pMovedCollection->m_ArchetypeRow = row;
+		}
+	}
+
+	--m_RowCount;
+	if ( --rLastChunk.m_RowCount == 0 )
+	{
+		g_ComponentAllocator.Free( rLastChunk.m_pCollections );
+		m_Chunks.Pop();
+	}
+}
+
+void Archetype::OrphanRow( uint32_t row )
+{
+	HELIUM_ASSERT( row < m_RowCount );
+
+	ArchetypeChunk &rChunk = m_Chunks[ row / m_ChunkCapacity ];
+	uint32_t chunkRow = row % m_ChunkCapacity;
+	rChunk.m_pCollections[ chunkRow ] = NULL;
+	rChunk.m_pDirty[ chunkRow ] = true;
+
+	++m_OrphanedRowCount;
+}
+
+void Archetype::SetRowDirty( uint32_t row )
+{
+	HELIUM_ASSERT( row < m_RowCount );
+
+	m_Chunks[ row / m_ChunkCapacity ].m_pDirty[ row % m_ChunkCapacity ] = true;
+}
+
+void Archetype::WriteRow( uint32_t row, ComponentCollection &rCollection )
+{
+	HELIUM_ASSERT( row < m_RowCount );
+
+	ArchetypeChunk &rChunk = m_Chunks[ row / m_ChunkCapacity ];
+	uint32_t chunkRow = row % m_ChunkCapacity;
+
+	rChunk.m_pCollections[ chunkRow ] = &rCollection;
+	rChunk.m_pDirty[ chunkRow ] = false;
+	for ( size_t column = 0; column < m_TypeIds.GetSize(); ++column )
+	{
+		Component *pComponent = rCollection.GetFirst( m_TypeIds[ column ] );
+		HELIUM_ASSERT( pComponent );
+		rChunk.m_pComponents[ column * m_ChunkCapacity + chunkRow ] = pComponent;
+	}
+}
+
+void Archetype::RemoveOrphanedRows()
+{
+	if ( !m_OrphanedRowCount )
+	{
+		return;
+	}
+
+	// Walk backwards so that rows moved into removed slots have already been checked
+	for ( uint32_t row = m_RowCount; row != 0; )
+	{
+		--row;
+
+		if ( !m_Chunks[ row / m_ChunkCapacity ].m_pCollections[ row % m_ChunkCapacity ] )
+		{
+			RemoveRow( row );
+		}
+	}
+
+	m_OrphanedRowCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////
+//       ArchetypeStorage
+////////////////////////////////////////////////////////////////////////
+
+ArchetypeStorage::ArchetypeStorage()
+	: m_QueryDepth( 0 )
+{
+
+}
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+	HELIUM_ASSERT( !m_QueryDepth );
+
+	// Collections may outlive their component manager, so make sure they no longer reference us
+	for ( DynamicArray< Archetype * >::Iterator archetypeIter = m_Archetypes.Begin(); archetypeIter != m_Archetypes.End(); ++archetypeIter )
+	{
+		Archetype *pArchetype = *archetypeIter;
+		for ( DynamicArray< ArchetypeChunk >::Iterator chunkIter = pArchetype->m_Chunks.Begin(); chunkIter != pArchetype->m_Chunks.End(); ++chunkIter )
+		{
+			for ( uint32_t chunkRow = 0; chunkRow < chunkIter->m_RowCount; ++chunkRow )
+			{
+				ComponentCollection *pCollection = chunkIter->m_pCollections[ chunkRow ];
+				if ( pCollection )
+				{
+					pCollection->m_pArchetypeStorage = NULL;
+					pCollection->m_pArchetype = NULL;
+				}
+			}
+		}
+
+		delete pArchetype;
+	}
+
+	for ( DynamicArray< ComponentCollection * >::Iterator iter = m_PendingCollections.Begin(); iter != m_PendingCollections.End(); ++iter )
+	{
+		(*iter)->m_pArchetypeStorage = NULL;
+		(*iter)->m_pArchetype = NULL;
+		(*iter)->m_bArchetypePending = false;
+	}
+}
+
+void ArchetypeStorage::OnCollectionChanged( ComponentCollection &rCollection )
+{
+	HELIUM_ASSERT( !rCollection.m_pArchetypeStorage || rCollection.m_pArchetypeStorage == this );
+	rCollection.m_pArchetypeStorage = this;
+
+	MutexScopeLock scopeLock( m_QueryLock );
+
+	if ( !m_QueryDepth )
+	{
+		UpdateCollection( rCollection );
+		return;
+	}
+
+	// Leave the row in place until the query is done, but make sure queries don't trust its contents
+	if ( rCollection.m_pArchetype )
+	{
+		rCollection.m_pArchetype->SetRowDirty( rCollection.m_ArchetypeRow );
+	}
+
+	if ( !rCollection.m_bArchetypePending )
+	{
+		rCollection.m_bArchetypePending = true;
+		m_PendingCollections.Push( &rCollection );
+	}
+}
+
+void ArchetypeStorage::OnCollectionDestroyed( ComponentCollection &rCollection )
+{
+	HELIUM_ASSERT( rCollection.m_pArchetypeStorage == this );
+
+	MutexScopeLock scopeLock( m_QueryLock );
+
+	if ( rCollection.m_bArchetypePending )
+	{
+		for ( size_t pendingIndex = 0; pendingIndex < m_PendingCollections.GetSize(); ++pendingIndex )
+		{
+			if ( m_PendingCollections[ pendingIndex ] == &rCollection )
+			{
+				m_PendingCollections.RemoveSwap( pendingIndex );
+				break;
+			}
+		}
+
+		rCollection.m_bArchetypePending = false;
+	}
+
+	if ( rCollection.m_pArchetype )
+	{
+		if ( m_QueryDepth )
+		{
+			rCollection.m_pArchetype->OrphanRow( rCollection.m_ArchetypeRow );
+		}
+		else
+		{
+			rCollection.m_pArchetype->RemoveRow( rCollection.m_ArchetypeRow );
+		}
+	}
+
+	rCollection.m_pArchetypeStorage = NULL;
+	rCollection.m_pArchetype = NULL;
+}
+
+void ArchetypeStorage::BeginQuery()
+{
+	MutexScopeLock scopeLock( m_QueryLock );
+	++m_QueryDepth;
+}
+
+void ArchetypeStorage::EndQuery()
+{
+	MutexScopeLock scopeLock( m_QueryLock );
+	HELIUM_ASSERT( m_QueryDepth );
+
+	// Queries on other threads may still be reading rows, so only the last one to end moves them
+	if ( --m_QueryDepth == 0 )
+	{
+		Flush();
+	}
+}
+
+Archetype* ArchetypeStorage::FindOrCreateArchetype( const Signature &rSignature )
+{
+	for ( DynamicArray< Archetype * >::Iterator iter = m_Archetypes.Begin(); iter != m_Archetypes.End(); ++iter )
+	{
+		if ( (*iter)->m_Signature == rSignature )
+		{
+			return *iter;
+		}
+	}
+
+	Archetype *pArchetype = new Archetype( rSignature );
+	m_Archetypes.Push( pArchetype );
+
+	return pArchetype;
+}
+
+void ArchetypeStorage::UpdateCollection( ComponentCollection &rCollection )
+{
+	Signature signature;
+	for ( Map< TypeId, Component * >::ConstIterator iter = rCollection.m_Components.Begin(); iter != rCollection.m_Components.End(); ++iter )
+	{
+		signature.Set( iter->First() );
+	}
+
+	Archetype *pArchetype = rCollection.m_pArchetype;
+	if ( !pArchetype || pArchetype->m_Signature != signature )
+	{
+		if ( pArchetype )
+		{
+			pArchetype->RemoveRow( rCollection.m_ArchetypeRow );
+			rCollection.m_pArchetype = NULL;
+		}
+
+		// Collections without any components don't need a row
+		if ( signature.IsEmpty() )
+		{
+			return;
+		}
+
+		pArchetype = FindOrCreateArchetype( signature );
+		rCollection.m_pArchetype = pArchetype;
+		rCollection.m_ArchetypeRow = pArchetype->AddRow( &rCollection );
+	}
+
+	pArchetype->WriteRow( rCollection.m_ArchetypeRow, rCollection );
+}
+
+void ArchetypeStorage::Flush()
+{
+	HELIUM_ASSERT( !m_QueryDepth );
+
+	for ( DynamicArray< Archetype * >::Iterator iter = m_Archetypes.Begin(); iter != m_Archetypes.End(); ++iter )
+	{
+		(*iter)->RemoveOrphanedRows();
+	}
+
+	for ( DynamicArray< ComponentCollection * >::Iterator iter = m_PendingCollections.Begin(); iter != m_PendingCollections.End(); ++iter )
+	{
+		ComponentCollection *pCollection = *iter;
+		pCollection->m_bArchetypePending = false;
+		UpdateCollection( *pCollection );
+	}
+
+	m_PendingCollections.Resize( 0 );
+}
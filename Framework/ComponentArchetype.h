@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Framework/Framework.h"
+#include "Framework/Components.h"
+
+namespace Helium
+{
+	namespace Components
+	{
+		//! Number of component types that can be represented in an archetype signature
+		const static size_t MAX_SIGNATURE_TYPE_COUNT = 256;
+
+		//! Target size in bytes of the component columns in a single archetype chunk
+		const static size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+
+		//! Set of component types owned by a component collection
+		struct HELIUM_FRAMEWORK_API Signature
+		{
+			inline Signature();
+
+			inline void Set( TypeId typeId );
+			inline bool Test( TypeId typeId ) const;
+			inline bool IsEmpty() const;
+
+			inline bool operator==( const Signature &rOther ) const;
+			inline bool operator!=( const Signature &rOther ) const;
+
+			uint32_t m_Bits[ MAX_SIGNATURE_TYPE_COUNT / 32 ];
+		};
+
+		//! Fixed-capacity block of rows in an archetype, stored as one array per column
+		struct HELIUM_FRAMEWORK_API ArchetypeChunk
+		{
+			inline Component * const * GetComponents( size_t column ) const;
+
+			ComponentCollection**  m_pCollections;  //< Owning collection of each row (null for rows of destroyed collections)
+			Component**            m_pComponents;   //< First component of each column's type, one column after another
+			bool*                  m_pDirty;        //< Rows whose collections changed during a query and need to be looked up
+			uint32_t               m_RowCount;
+			uint32_t               m_Capacity;
+		};
+
+		//! All component collections owning exactly the same set of component types.
+		//
+		// Each row holds a pointer to the first component of every type in the signature, so queries can stream through
+		// the columns of the matching archetypes instead of looking up each type in each collection.  Component data
+		// itself stays in its pool, so Component pointers, ComponentPtr and generation checks behave as before.
+		class HELIUM_FRAMEWORK_API Archetype : NonCopyable
+		{
+		public:
+			inline const Signature&        GetSignature() const;
+			inline size_t                  GetColumnCount() const;
+			inline TypeId                  GetColumnTypeId( size_t column ) const;
+			size_t                         FindImplementingColumn( TypeId typeId ) const;
+
+			inline size_t                  GetRowCount() const;
+			inline size_t                  GetChunkCount() const;
+			inline const ArchetypeChunk&   GetChunk( size_t index ) const;
+
+		private:
+			friend class ArchetypeStorage;
+
+			Archetype( const Signature &rSignature );
+			~Archetype();
+
+			uint32_t                       AddRow( ComponentCollection *pCollection );
+			void                           RemoveRow( uint32_t row );
+			void                           OrphanRow( uint32_t row );
+			void                           SetRowDirty( uint32_t row );
+			void                           WriteRow( uint32_t row, ComponentCollection &rCollection );
+			void                           RemoveOrphanedRows();
+
+			Signature                      m_Signature;
+			DynamicArray< TypeId >         m_TypeIds;
+			DynamicArray< ArchetypeChunk > m_Chunks;
+			uint32_t                       m_RowCount;
+			uint32_t                       m_ChunkCapacity;
+			uint32_t                       m_OrphanedRowCount;
+		};
+
+		//! Per component manager index of component collections grouped by archetype.
+		//
+		// Collections are moved between archetypes as components are allocated and freed.  While a query is walking the
+		// archetypes, moves are deferred until the outermost query ends so that rows stay in place; rows changed in the
+		// meantime are flagged dirty so that queries look their components up directly instead.
+		//
+		// Read-only tasks may query the same storage from several threads at once, so the query depth and pending moves
+		// are guarded by a lock, and only the last query to end applies the pending moves.
+		class HELIUM_FRAMEWORK_API ArchetypeStorage : NonCopyable
+		{
+		public:
+			ArchetypeStorage();
+			~ArchetypeStorage();
+
+			inline size_t                  GetArchetypeCount() const;
+			inline const Archetype*        GetArchetype( size_t index ) const;
+
+			void                           OnCollectionChanged( ComponentCollection &rCollection );
+			void                           OnCollectionDestroyed( ComponentCollection &rCollection );
+
+			void                           BeginQuery();
+			void                           EndQuery();
+
+		private:
+			Archetype*                     FindOrCreateArchetype( const Signature &rSignature );
+			void                           UpdateCollection( ComponentCollection &rCollection );
+			void                           Flush();
+
+			DynamicArray< Archetype * >            m_Archetypes;
+			DynamicArray< ComponentCollection * >  m_PendingCollections;
+			uint32_t                               m_QueryDepth;  // Guarded by m_QueryLock
+			Mutex                                  m_QueryLock;
+		};
+	}
+}
+
+#include "Framework/ComponentArchetype.inl"
@@ -0,0 +1,98 @@
+namespace Helium
+{
+	namespace Components
+	{
+		Signature::Signature()
+		{
+			MemoryZero( m_Bits, sizeof( m_Bits ) );
+		}
+
+		void Signature::Set( TypeId typeId )
+		{
+			HELIUM_ASSERT( typeId < MAX_SIGNATURE_TYPE_COUNT );
+			m_Bits[ typeId / 32 ] |= ( 1U << ( typeId % 32 ) );
+		}
+
+		bool Signature::Test( TypeId typeId ) const
+		{
+			HELIUM_ASSERT( typeId < MAX_SIGNATURE_TYPE_COUNT );
+			return ( m_Bits[ typeId / 32 ] & ( 1U << ( typeId % 32 ) ) ) != 0;
+		}
+
+		bool Signature::IsEmpty() const
+		{
+			for ( size_t wordIndex = 0; wordIndex < HELIUM_ARRAY_COUNT( m_Bits ); ++wordIndex )
+			{
+				if ( m_Bits[ wordIndex ] )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool Signature::operator==( const Signature &rOther ) const
+		{
+			for ( size_t wordIndex = 0; wordIndex < HELIUM_ARRAY_COUNT( m_Bits ); ++wordIndex )
+			{
+				if ( m_Bits[ wordIndex ] != rOther.m_Bits[ wordIndex ] )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool Signature::operator!=( const Signature &rOther ) const
+		{
+			return !( *this == rOther );
+		}
+
+		Component * const * ArchetypeChunk::GetComponents( size_t column ) const
+		{
+			return m_pComponents + column * m_Capacity;
+		}
+
+		const Signature& Archetype::GetSignature() const
+		{
+			return m_Signature;
+		}
+
+		size_t Archetype::GetColumnCount() const
+		{
+			return m_TypeIds.GetSize();
+		}
+
+		TypeId Archetype::GetColumnTypeId( size_t column ) const
+		{
+			return m_TypeIds[ column ];
+		}
+
+		size_t Archetype::GetRowCount() const
+		{
+			return m_RowCount;
+		}
+
+		size_t Archetype::GetChunkCount() const
+		{
+			return m_Chunks.GetSize();
+		}
+
+		const ArchetypeChunk& Archetype::GetChunk( size_t index ) const
+		{
+			return m_Chunks[ index ];
+		}
+
+		size_t ArchetypeStorage::GetArchetypeCount() const
+		{
+			return m_Archetypes.GetSize();
+		}
+
+		const Archetype* ArchetypeStorage::GetArchetype( size_t index ) const
+		{
+			return m_Archetypes[ index ];
+		}
+	}
+}
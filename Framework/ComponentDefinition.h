@@ -24,8 +24,12 @@ namespace Helium
 		// Implemented by child classes to allocate a component of the appropriate type and return it
 		inline virtual Helium::Component *CreateComponentInternal(struct Components::IHasComponents &rHasComponents) const;
 
-		// Implemented by child classes to finish setting up the component.
-		inline virtual void FinalizeComponent() const;
+		// Finishes setting up the component created by the last call to CreateComponent()
+		inline void FinalizeComponent() const;
+
+		// Implemented by child classes to finish setting up a component this definition allocated. Definitions are
+		// shared between deploys, so any per-deploy state must come from the component rather than the definition
+		inline virtual void FinalizeComponentInternal(Helium::Component *pComponent) const;
 
 		// Gets the component that this definition generated previously
 		inline Helium::Component *GetCreatedComponent() const;
@@ -50,7 +54,7 @@ namespace Helium
 			return c;
 		}
 
-		virtual void FinalizeComponent() const
+		virtual void FinalizeComponentInternal(Helium::Component *pComponent) const
 		{
 
 		}
@@ -69,9 +73,8 @@ namespace Helium
 			return c;
 		}
 
-		virtual void FinalizeComponent() const
+		virtual void FinalizeComponentInternal(Helium::Component *c) const
 		{
-			Component *c = GetCreatedComponent();
 			ComponentT *pComponent = static_cast<ComponentT *>(c);
 			pComponent->Finalize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
 		}
@@ -89,9 +92,8 @@ namespace Helium
 			return c;
 		}
 
-		virtual void FinalizeComponent() const
+		virtual void FinalizeComponentInternal(Helium::Component *c) const
 		{
-			Component *c = GetCreatedComponent();
 			ComponentT *pComponent = static_cast<ComponentT *>(c);
 			pComponent->Finalize( *Reflect::AssertCast<ComponentDefinitionT>(this) );
 		}
@@ -14,6 +14,11 @@ namespace Helium
     }
     
     void ComponentDefinition::FinalizeComponent() const 
+    { 
+        FinalizeComponentInternal(GetCreatedComponent());
+    }
+
+    void ComponentDefinition::FinalizeComponentInternal(Helium::Component *pComponent) const 
     { 
     }
         
@@ -1,103 +1,52 @@
-
 #include "FrameworkPch.h"
 #include "Framework/ComponentQuery.h"
-#include <limits>
-#include <vector>
 
 using namespace Helium;
 
-struct FoundComponentList
-{
-	Component *m_Component;
-	size_t m_TypeIndex;
-	size_t m_Count;
-	Components::TypeId m_TypeId;
-};
-
-bool SortFoundComponentList(const FoundComponentList &lhs, const FoundComponentList &rhs)
-{
-	return lhs.m_Count < rhs.m_Count;
-}
-
-void EmitTuples(DynamicArray<Component *> &tuple, std::vector<FoundComponentList> &found_components, size_t type_index, ComponentTupleCallback emit_tuple_callback)
+/// Order the types of a component query from the type with the fewest allocated components to the most.
+///
+/// @param[in]  rManager   Component manager owning the components to query.
+/// @param[in]  pTypes     Component types to query.
+/// @param[in]  typeCount  Number of types in pTypes.
+/// @param[out] pOrder     Indices into pTypes, sorted by component count (must hold typeCount entries).
+///
+/// @return  True if the query can emit components, false if there are no types or no components of one of the types.
+bool ComponentQuery::SortTypesByCount( ComponentManager &rManager, const Components::TypeId *pTypes, size_t typeCount, size_t *pOrder )
 {
-	Component *c = found_components[ type_index ].m_Component;
-	HELIUM_ASSERT( c );
-	do
-	{
-		tuple[found_components[type_index].m_TypeIndex] = c;
-		
-		if (type_index < found_components.size() - 1)
-		{
-			EmitTuples(tuple, found_components, ++type_index, emit_tuple_callback);
-		}
-		else
-		{
-			emit_tuple_callback(tuple);
-		}
-	} 
-	while ( ( c = c->GetNextComponent() ) );
-}
+	HELIUM_ASSERT( pTypes || !typeCount );
+	HELIUM_ASSERT( pOrder || !typeCount );
 
-void Helium::QueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback emit_tuple_callback)
-{
 	// If no types to query, do nothing
-	if (!typesCount)
-	{
-		return;
-	}
-	
-	// Prepare the structure that will help us emit all permutations of found components
-	std::vector<FoundComponentList> found_components;
-	found_components.resize(typesCount);
-	
-	// Find the component with the least instances
-	for (size_t index = 0; index < typesCount; ++index)
+	if ( !typeCount )
 	{
-		found_components[index].m_TypeIndex = index;
-		found_components[index].m_TypeId = types[index];
-		found_components[index].m_Count = rManager.CountAllocatedComponentsThatImplement(types[index]);
-		
-		// Bail if any component type doesn't exist
-		if (!found_components[index].m_Count)
-		{
-			return;
-		}
+		return false;
 	}
 
-	// Sort the types by commonality
-	std::sort(found_components.begin(), found_components.end(), SortFoundComponentList);
-	
-	const DynamicArray< Components::TypeId > &implementing_types = Components::GetTypeData( found_components[0].m_TypeId )->m_ImplementingTypes;
-	
-	// For every component
-	for ( ComponentIteratorBase iterator(rManager, implementing_types); iterator.GetBaseComponent(); iterator.Advance() )
-	{
-		Component *outer_component = iterator.GetBaseComponent();
+	// Queries only have a handful of types, so an insertion sort on the stack is plenty
+	size_t counts[ 64 ];
+	HELIUM_ASSERT( typeCount <= HELIUM_ARRAY_COUNT( counts ) );
 
-		found_components[0].m_Component = outer_component;
+	for ( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		const size_t count = rManager.CountAllocatedComponentsThatImplement( pTypes[ typeIndex ] );
 
-		ComponentCollection *collection = outer_component->GetComponentCollection();
-		HELIUM_ASSERT(collection);
-		
-		// Walk the other types we need components of
-		bool emit_tuples = true;
-		for (size_t type_index = 1; type_index < found_components.size(); ++type_index)
+		// Bail if any component type doesn't exist
+		if ( !count )
 		{
-			found_components[type_index].m_Component = collection->GetFirst( found_components[type_index].m_TypeId );
-			if ( !found_components[type_index].m_Component )
-			{
-				emit_tuples = false;
-				break;
-			}
+			return false;
 		}
-		
-		if (emit_tuples)
+
+		size_t insertIndex = typeIndex;
+		while ( insertIndex > 0 && counts[ insertIndex - 1 ] > count )
 		{
-			DynamicArray<Component *> tuple;
-			tuple.Resize(typesCount);
-			tuple[found_components[0].m_TypeIndex] = outer_component;
-			EmitTuples(tuple, found_components, 1, emit_tuple_callback);
+			counts[ insertIndex ] = counts[ insertIndex - 1 ];
+			pOrder[ insertIndex ] = pOrder[ insertIndex - 1 ];
+			--insertIndex;
 		}
+
+		counts[ insertIndex ] = count;
+		pOrder[ insertIndex ] = typeIndex;
 	}
+
+	return true;
 }
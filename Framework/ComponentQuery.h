@@ -1,30 +1,501 @@
-
 #pragma once
 
 #include "Framework/Framework.h"
 #include "Foundation/DynamicArray.h"
 #include "Framework/Components.h"
+#include "Framework/ComponentArchetype.h"
+#include "Engine/JobManager.h"
+
+#include <type_traits>
 
 namespace Helium
 {
-	typedef void (*ComponentTupleCallback)(DynamicArray<Component *> &tuple);
-	
-	void HELIUM_FRAMEWORK_API QueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback callback);
-	
-	template <class A, class B, void (*F)(A *, B *)>
-	void TupleHandler(DynamicArray<Component *> &components)
+	namespace ComponentQuery
+	{
+		bool HELIUM_FRAMEWORK_API SortTypesByCount( ComponentManager &rManager, const Components::TypeId *pTypes, size_t typeCount, size_t *pOrder );
+
+		/// Component types to query (const types are only read by the query).
+		template < class... Ts >
+		struct TypeList
+		{
+			/// Get the component type IDs of the listed types, resolved the first time the list is used.
+			static const Components::TypeId *GetTypeIds()
+			{
+				static const Components::TypeId typeIds[] = { Components::GetType< typename std::remove_const< Ts >::type >()... };
+				return typeIds;
+			}
+		};
+
+		/// Compile-time list of indices, used to expand the components of a tuple into function arguments.
+		template < size_t... Indices >
+		struct IndexList
+		{
+		};
+
+		template < size_t Count, size_t... Indices >
+		struct MakeIndexList : MakeIndexList< Count - 1, Count - 1, Indices... >
+		{
+		};
+
+		template < size_t... Indices >
+		struct MakeIndexList< 0, Indices... >
+		{
+			typedef IndexList< Indices... > Type;
+		};
+
+		/// Calls a query function with each component of a tuple cast to its queried type.
+		template < class Types, class Indices >
+		struct TupleInvoker;
+
+		template < class... Ts, size_t... Indices >
+		struct TupleInvoker< TypeList< Ts... >, IndexList< Indices... > >
+		{
+			template < class Function >
+			inline static void Invoke( Function &rFunction, Component * const *ppComponents )
+			{
+				rFunction( static_cast< Ts * >( ppComponents[ Indices ] )... );
+			}
+		};
+
+		/// Function object calling a function known at compile time, so queries declared with a function template
+		/// parameter call it directly rather than through a function pointer.
+		template < class Signature, Signature F >
+		struct StaticFunction;
+
+		template < class... Args, void (*F)( Args... ) >
+		struct StaticFunction< void (*)( Args... ), F >
+		{
+			inline void operator()( Args... args ) const
+			{
+				F( args... );
+			}
+		};
+
+		/// Call a query function for every combination of the components chained from the first component of each
+		/// type in a tuple.  Types before firstVaryingIndex (in pOrder) are not advanced.
+		template < class Invoker, class Function >
+		void EmitTuples(
+			Function &rFunction,
+			Component **ppTuple,
+			Component * const *ppFirstComponents,
+			const size_t *pOrder,
+			size_t firstVaryingIndex,
+			size_t typeCount )
+		{
+			for ( ;; )
+			{
+				Invoker::Invoke( rFunction, ppTuple );
+
+				// Advance the last type first, rewinding each type that runs out of components
+				bool bAdvanced = false;
+				for ( size_t typeIndex = typeCount; typeIndex > firstVaryingIndex && !bAdvanced; )
+				{
+					--typeIndex;
+
+					Component *pNext = ppTuple[ pOrder[ typeIndex ] ]->GetNextComponent();
+					if ( pNext )
+					{
+						ppTuple[ pOrder[ typeIndex ] ] = pNext;
+						bAdvanced = true;
+					}
+					else
+					{
+						ppTuple[ pOrder[ typeIndex ] ] = ppFirstComponents[ typeIndex ];
+					}
+				}
+
+				if ( !bAdvanced )
+				{
+					return;
+				}
+			}
+		}
+
+		/// Find the columns of an archetype implementing each queried type.
+		///
+		/// @return  True if the archetype has all of the queried types, false if not.
+		inline bool FindArchetypeColumns( const Components::Archetype &rArchetype, const Components::TypeId *pTypeIds, size_t typeCount, size_t *pColumns )
+		{
+			for ( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+			{
+				pColumns[ typeIndex ] = rArchetype.FindImplementingColumn( pTypeIds[ typeIndex ] );
+				if ( IsInvalid( pColumns[ typeIndex ] ) )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/// Call a query function for every tuple of components in the rows of an archetype chunk.
+		template < class Invoker, size_t TypeCount, class Function >
+		void QueryArchetypeChunk( Function &rFunction, const Components::Archetype &rArchetype, const Components::ArchetypeChunk &rChunk, const size_t *pColumns )
+		{
+			size_t order[ TypeCount ];
+			Component * const *componentColumns[ TypeCount ];
+			for ( size_t typeIndex = 0; typeIndex < TypeCount; ++typeIndex )
+			{
+				order[ typeIndex ] = typeIndex;
+				componentColumns[ typeIndex ] = rChunk.GetComponents( pColumns[ typeIndex ] );
+			}
+
+			Component *tuple[ TypeCount ];
+			Component *firstComponents[ TypeCount ];
+
+			for ( uint32_t row = 0; row < rChunk.m_RowCount; ++row )
+			{
+				bool bFoundAll = true;
+				if ( !rChunk.m_pDirty[ row ] )
+				{
+					for ( size_t typeIndex = 0; typeIndex < TypeCount; ++typeIndex )
+					{
+						tuple[ typeIndex ] = componentColumns[ typeIndex ][ row ];
+					}
+				}
+				else
+				{
+					// The collection changed earlier in this query, so look its components up directly
+					ComponentCollection *pCollection = rChunk.m_pCollections[ row ];
+					for ( size_t typeIndex = 0; typeIndex < TypeCount && bFoundAll; ++typeIndex )
+					{
+						tuple[ typeIndex ] = pCollection ? pCollection->GetFirst( rArchetype.GetColumnTypeId( pColumns[ typeIndex ] ) ) : NULL;
+						bFoundAll = ( tuple[ typeIndex ] != NULL );
+					}
+				}
+
+				if ( bFoundAll )
+				{
+					for ( size_t typeIndex = 0; typeIndex < TypeCount; ++typeIndex )
+					{
+						firstComponents[ typeIndex ] = tuple[ typeIndex ];
+					}
+
+					EmitTuples< Invoker >( rFunction, tuple, firstComponents, order, 0, TypeCount );
+				}
+			}
+		}
+
+		/// Call a query function for every tuple of components owned by the owners of a range of a pool's allocated
+		/// components.  The pool holds components of the first type in pOrder (or of a type derived from it).
+		///
+		/// Each queried type is matched the same way archetype queries match it: through the first type implementing
+		/// it that the owner has any components of (see ComponentCollection::GetFirstThatImplements()).  Components of
+		/// other types implementing the leading type are skipped, so each owner's tuples are only emitted once.
+		template < class Invoker, size_t TypeCount, class Function >
+		void QueryPoolRange(
+			Function &rFunction,
+			const Components::Pool &rPool,
+			const Components::TypeId *pTypeIds,
+			const size_t *pOrder,
+			size_t begin,
+			size_t end )
+		{
+			Component * const *ppAllocatedComponents = rPool.GetAllocatedComponents();
+
+			Component *tuple[ TypeCount ];
+			Component *firstComponents[ TypeCount ];
+
+			const bool bExactLeadingType = ( rPool.GetTypeId() == pTypeIds[ pOrder[ 0 ] ] );
+
+			// Serial queries may free components as they go, so stop if the pool shrinks past the end of the range
+			for ( size_t rosterIndex = begin; rosterIndex < end && rosterIndex < rPool.GetAllocatedCount(); ++rosterIndex )
+			{
+				Component *pOuterComponent = ppAllocatedComponents[ rosterIndex ];
+				tuple[ pOrder[ 0 ] ] = pOuterComponent;
+
+				ComponentCollection *pCollection = rPool.GetComponentCollection( pOuterComponent );
+				HELIUM_ASSERT( pCollection );
+
+				// Skip owners that also have components of a type implementing the leading type that takes precedence
+				if ( !bExactLeadingType )
+				{
+					Component *pLeadingComponent = pCollection->GetFirstThatImplements( pTypeIds[ pOrder[ 0 ] ] );
+					if ( !pLeadingComponent || Components::Pool::GetPool( pLeadingComponent ) != &rPool )
+					{
+						continue;
+					}
+				}
+
+				// Look the other types up through the owner's collection
+				bool bFoundAll = true;
+				if ( TypeCount > 1 )
+				{
+					for ( size_t typeIndex = 1; typeIndex < TypeCount && bFoundAll; ++typeIndex )
+					{
+						Component *pComponent = pCollection->GetFirstThatImplements( pTypeIds[ pOrder[ typeIndex ] ] );
+						firstComponents[ typeIndex ] = pComponent;
+						tuple[ pOrder[ typeIndex ] ] = pComponent;
+						bFoundAll = ( pComponent != NULL );
+					}
+				}
+
+				if ( bFoundAll )
+				{
+					// Emit every combination of the owner's components
+					EmitTuples< Invoker >( rFunction, tuple, firstComponents, pOrder, 1, TypeCount );
+				}
+			}
+		}
+
+		/// Run a query by streaming through the rows of each archetype that has all of the queried types.
+		template < class Types, class Invoker, size_t TypeCount, class Function >
+		void QueryArchetypes( Components::ArchetypeStorage &rStorage, Function &rFunction )
+		{
+			const Components::TypeId *pTypeIds = Types::GetTypeIds();
+
+			size_t columns[ TypeCount ];
+
+			// Structural changes made by the query function are applied once the query is done
+			rStorage.BeginQuery();
+
+			const size_t archetypeCount = rStorage.GetArchetypeCount();
+			for ( size_t archetypeIndex = 0; archetypeIndex < archetypeCount; ++archetypeIndex )
+			{
+				const Components::Archetype &rArchetype = *rStorage.GetArchetype( archetypeIndex );
+				if ( !FindArchetypeColumns( rArchetype, pTypeIds, TypeCount, columns ) )
+				{
+					continue;
+				}
+
+				const size_t chunkCount = rArchetype.GetChunkCount();
+				for ( size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex )
+				{
+					QueryArchetypeChunk< Invoker, TypeCount >( rFunction, rArchetype, rArchetype.GetChunk( chunkIndex ), columns );
+				}
+			}
+
+			rStorage.EndQuery();
+		}
+
+		//! Minimum number of components of the outer query type processed by a single parallel query job
+		const static size_t PARALLEL_QUERY_MIN_RANGE_SIZE = 64;
+
+		//! Number of jobs to split each pool into per job thread, so that threads finishing early can steal work
+		const static size_t PARALLEL_QUERY_JOBS_PER_THREAD = 4;
+
+		/// Job running part of a parallel component query.
+		///
+		/// The root job (with neither a pool nor a chunk set) spawns one child job per archetype chunk, or per range of
+		/// each pool implementing the outer type, which then call the query function for their share of the tuples.
+		template < class Types, class Invoker, size_t TypeCount, class Function >
+		class ParallelQueryJob : NonCopyable
+		{
+		public:
+			ParallelQueryJob()
+				: m_pManager( NULL )
+				, m_pFunction( NULL )
+				, m_pPool( NULL )
+				, m_pArchetype( NULL )
+				, m_pChunk( NULL )
+				, m_Begin( 0 )
+				, m_End( 0 )
+			{
+			}
+
+			void Run( JobContext *pContext )
+			{
+				HELIUM_ASSERT( pContext );
+				HELIUM_ASSERT( m_pManager );
+				HELIUM_ASSERT( m_pFunction );
+
+				if ( m_pChunk )
+				{
+					QueryArchetypeChunk< Invoker, TypeCount >( *m_pFunction, *m_pArchetype, *m_pChunk, m_Columns );
+				}
+				else if ( m_pPool )
+				{
+					QueryPoolRange< Invoker, TypeCount >( *m_pFunction, *m_pPool, Types::GetTypeIds(), m_Order, m_Begin, m_End );
+				}
+				else if ( m_pManager->GetArchetypeStorage() )
+				{
+					SpawnChunkJobs( pContext );
+				}
+				else
+				{
+					SpawnPoolJobs( pContext );
+				}
+			}
+
+			static void RunCallback( void *pJob, JobContext *pContext )
+			{
+				HELIUM_ASSERT( pJob );
+				static_cast< ParallelQueryJob * >( pJob )->Run( pContext );
+			}
+
+			ComponentManager*                  m_pManager;
+			Function*                          m_pFunction;
+			size_t                             m_Order[ TypeCount ];   //< Query types sorted by count (pool queries only)
+			size_t                             m_Columns[ TypeCount ]; //< Column of each query type in m_pArchetype
+			const Components::Pool*            m_pPool;
+			const Components::Archetype*       m_pArchetype;
+			const Components::ArchetypeChunk*  m_pChunk;
+			size_t                             m_Begin;
+			size_t                             m_End;
+
+		private:
+			ParallelQueryJob *CreateChild( JobContext *pContext ) const
+			{
+				ParallelQueryJob *pJob = pContext->Create< ParallelQueryJob >();
+				HELIUM_ASSERT( pJob );
+				pJob->m_pManager = m_pManager;
+				pJob->m_pFunction = m_pFunction;
+				return pJob;
+			}
+
+			void SpawnChunkJobs( JobContext *pContext ) const
+			{
+				Components::ArchetypeStorage &rStorage = *m_pManager->GetArchetypeStorage();
+				const Components::TypeId *pTypeIds = Types::GetTypeIds();
+
+				size_t columns[ TypeCount ];
+
+				const size_t archetypeCount = rStorage.GetArchetypeCount();
+				for ( size_t archetypeIndex = 0; archetypeIndex < archetypeCount; ++archetypeIndex )
+				{
+					const Components::Archetype *pArchetype = rStorage.GetArchetype( archetypeIndex );
+					if ( !FindArchetypeColumns( *pArchetype, pTypeIds, TypeCount, columns ) )
+					{
+						continue;
+					}
+
+					const size_t chunkCount = pArchetype->GetChunkCount();
+					for ( size_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex )
+					{
+						ParallelQueryJob *pJob = CreateChild( pContext );
+						pJob->m_pArchetype = pArchetype;
+						pJob->m_pChunk = &pArchetype->GetChunk( chunkIndex );
+						MemoryCopy( pJob->m_Columns, columns, sizeof( columns ) );
+					}
+				}
+			}
+
+			void SpawnPoolJobs( JobContext *pContext ) const
+			{
+				const size_t threadCount = pContext->GetManager()->GetWorkerCount() + 1;
+
+				const DynamicArray< Components::TypeId > &implementingTypes = Components::GetTypeData( Types::GetTypeIds()[ m_Order[ 0 ] ] )->m_ImplementingTypes;
+				for ( DynamicArray< Components::TypeId >::ConstIterator typeIter = implementingTypes.Begin(); typeIter != implementingTypes.End(); ++typeIter )
+				{
+					const Components::Pool *pPool = m_pManager->GetPool( *typeIter );
+					const size_t componentCount = pPool ? pPool->GetAllocatedCount() : 0;
+					if ( !componentCount )
+					{
+						continue;
+					}
+
+					const size_t rangeSize = Max( componentCount / ( threadCount * PARALLEL_QUERY_JOBS_PER_THREAD ), PARALLEL_QUERY_MIN_RANGE_SIZE );
+					for ( size_t begin = 0; begin < componentCount; begin += rangeSize )
+					{
+						ParallelQueryJob *pJob = CreateChild( pContext );
+						pJob->m_pPool = pPool;
+						pJob->m_Begin = begin;
+						pJob->m_End = Min( begin + rangeSize, componentCount );
+						MemoryCopy( pJob->m_Order, m_Order, sizeof( m_Order ) );
+					}
+				}
+			}
+		};
+	}
+
+	/// Call a function for every combination of components of the given types owned by the same object.
+	///
+	/// Type IDs are resolved once per query type list and the query does not allocate any memory.  The function is
+	/// called with a typed pointer to each component, in the order the types are listed, so it can take any callable
+	/// object (including lambdas) accepting those pointers.  Types may be const-qualified to pass const pointers.
+	///
+	/// If the manager has archetype storage enabled, the query streams through the chunks of each matching archetype.
+	/// Otherwise it walks the pool of the rarest type and looks the other types up in each owner's collection.  Both
+	/// match each queried type through the first type implementing it that an owner has (the type itself, then derived
+	/// types in the order they were registered) and emit every combination of the components of those types.
+	///
+	/// @param[in] rManager  Component manager owning the components to query.
+	/// @param[in] function  Function to call for each tuple of components.
+	template < class... Ts, class Function >
+	void QueryComponents( ComponentManager &rManager, Function function )
 	{
-		F(
-			static_cast<A *>(components[0]), 
-			static_cast<B *>(components[1]));
+		typedef ComponentQuery::TypeList< Ts... > Types;
+		typedef ComponentQuery::TupleInvoker< Types, typename ComponentQuery::MakeIndexList< sizeof...( Ts ) >::Type > Invoker;
+
+		const size_t typeCount = sizeof...( Ts );
+
+		Components::ArchetypeStorage *pArchetypeStorage = rManager.GetArchetypeStorage();
+		if ( pArchetypeStorage )
+		{
+			ComponentQuery::QueryArchetypes< Types, Invoker, typeCount >( *pArchetypeStorage, function );
+			return;
+		}
+
+		const Components::TypeId *pTypeIds = Types::GetTypeIds();
+
+		// Walk the components of the rarest type, looking up the others through each owner's collection
+		size_t order[ typeCount ];
+		if ( !ComponentQuery::SortTypesByCount( rManager, pTypeIds, typeCount, order ) )
+		{
+			return;
+		}
+
+		const DynamicArray< Components::TypeId > &implementingTypes = Components::GetTypeData( pTypeIds[ order[ 0 ] ] )->m_ImplementingTypes;
+		for ( DynamicArray< Components::TypeId >::ConstIterator typeIter = implementingTypes.Begin(); typeIter != implementingTypes.End(); ++typeIter )
+		{
+			const Components::Pool *pPool = rManager.GetPool( *typeIter );
+			if ( pPool )
+			{
+				ComponentQuery::QueryPoolRange< Invoker, typeCount >( function, *pPool, pTypeIds, order, 0, pPool->GetAllocatedCount() );
+			}
+		}
 	}
-	
-	template <class A, class B, class C, void (*F)(A *, B *, C *)>
-	void TupleHandler(DynamicArray<Component *> &components)
+
+	/// Call a function for every combination of components of the given types owned by the same object, splitting the
+	/// work across the job manager's worker threads.
+	///
+	/// The components are divided into ranges of each pool's allocated components (or into archetype chunks if the
+	/// manager has archetype storage enabled), which are processed in parallel.  The calling thread helps run the jobs
+	/// and this returns once all tuples have been processed.  If no job workers are running, the query runs serially.
+	///
+	/// The function is called concurrently for different objects, so it must only modify the components of the tuple
+	/// it was called with and may only read other data that nothing modifies during the query.  It must not allocate
+	/// or free components directly; use ComponentManager::AllocateDeferred() and Component::FreeComponentDeferred()
+	/// instead, which buffer the change on the calling thread until ComponentManager::ApplyDeferredChanges() is called
+	/// (which WorldManager does once per frame, after all tasks have run).
+	///
+	/// @param[in] rManager  Component manager owning the components to query.
+	/// @param[in] function  Function to call for each tuple of components.
+	///
+	/// @see QueryComponents()
+	template < class... Ts, class Function >
+	void ParallelQueryComponents( ComponentManager &rManager, Function function )
 	{
-		F(
-			static_cast<A *>(components[0]), 
-			static_cast<B *>(components[1]), 
-			static_cast<C *>(components[2]));
+		typedef ComponentQuery::TypeList< Ts... > Types;
+		typedef ComponentQuery::TupleInvoker< Types, typename ComponentQuery::MakeIndexList< sizeof...( Ts ) >::Type > Invoker;
+		typedef ComponentQuery::ParallelQueryJob< Types, Invoker, sizeof...( Ts ), Function > Job;
+
+		JobManager &rJobManager = JobManager::GetStaticInstance();
+		if ( rJobManager.GetWorkerCount() == 0 )
+		{
+			QueryComponents< Ts... >( rManager, function );
+			return;
+		}
+
+		Job job;
+		job.m_pManager = &rManager;
+		job.m_pFunction = &function;
+
+		Components::ArchetypeStorage *pArchetypeStorage = rManager.GetArchetypeStorage();
+		if ( pArchetypeStorage )
+		{
+			// Keeps archetype rows in place while the jobs are streaming through them
+			pArchetypeStorage->BeginQuery();
+			rJobManager.RunJob( job );
+			pArchetypeStorage->EndQuery();
+			return;
+		}
+
+		if ( !ComponentQuery::SortTypesByCount( rManager, Types::GetTypeIds(), sizeof...( Ts ), job.m_Order ) )
+		{
+			return;
+		}
+
+		rJobManager.RunJob( job );
 	}
 }
@@ -201,29 +201,276 @@ void Helium::Components::DeployComponents(
 
 void HELIUM_FRAMEWORK_API Helium::Components::DeployComponents( IHasComponents &rHasComponents, const DynamicArray<ComponentDefinitionPtr> &components )
 {
+	// The definitions may be shared with other deploys, so keep the created components here rather than in them
+	DynamicArray<Component *> createdComponents;
+	createdComponents.Reserve(components.GetSize());
+
 	for (DynamicArray<ComponentDefinitionPtr>::ConstIterator iter = components.Begin();
 		iter != components.End(); ++iter)
 	{
 		if (*iter)
 		{
-			(*iter)->CreateComponent(rHasComponents);
+			createdComponents.Push((*iter)->CreateComponentInternal(rHasComponents));
 		}
 		else
 		{
+			createdComponents.Push(NULL);
 			HELIUM_TRACE( 
 				TraceLevels::Warning, 
 				TXT( "DeployComponents - A ComponentDefinitionPtr in the supplied list was null - ignoring.\n"));
 		}
 	}
 
-	for (DynamicArray<ComponentDefinitionPtr>::ConstIterator iter = components.Begin();
-		iter != components.End(); ++iter)
+	for (size_t i = 0; i < components.GetSize(); ++i)
 	{
-		if (*iter)
+		if (components[i])
+		{
+			components[i]->FinalizeComponentInternal(createdComponents[i]);
+		}
+	}
+}
+
+namespace
+{
+	Helium::Parameter *FindParameter( Helium::DynamicArray<Helium::Parameter> &parameters, Helium::Name name )
+	{
+		for (size_t i = 0; i < parameters.GetSize(); ++i)
+		{
+			if (parameters[i].GetName() == name)
+			{
+				return &parameters[i];
+			}
+		}
+
+		return NULL;
+	}
+}
+
+Helium::CompiledComponentSet::CompiledComponentSet()
+	: m_bCompiled(false)
+{
+
+}
+
+Helium::CompiledComponentSet::~CompiledComponentSet()
+{
+
+}
+
+void Helium::CompiledComponentSet::Compile( const ComponentSet &rComponentSet )
+{
+	Clear();
+
+	HELIUM_TRACE(
+		TraceLevels::Debug,
+		"Helium::CompiledComponentSet::Compile() - Compiling component set %x\n", &rComponentSet);
+
+	//////////////////////////////////////////////////////////////////////////
+	// 1. Clone all component descriptors, in name order like DeployComponents()
+	//////////////////////////////////////////////////////////////////////////
+	typedef Map<Name, ComponentDefinitionPtr> M_Definitions;
+	M_Definitions definitions;
+
+	for (size_t i = 0; i < rComponentSet.m_Components.GetSize(); ++i)
+	{
+		const ComponentSet::NameDefinitionPair &component_to_clone = rComponentSet.m_Components[i];
+		M_Definitions::Iterator iter = definitions.Find(component_to_clone.m_Name);
+
+		if (iter != definitions.End())
 		{
-			(*iter)->FinalizeComponent();
+			HELIUM_TRACE( 
+				TraceLevels::Warning, 
+				TXT( "  Multiple components named '%s'\n"), 
+				*component_to_clone.m_Name);
+			continue;
 		}
+
+		if ( !component_to_clone.m_Definition.ReferencesObject() )
+		{
+			HELIUM_TRACE( 
+				TraceLevels::Warning, 
+				TXT( "  Cannot clone null component named '%s'\n"), 
+				*component_to_clone.m_Name);
+			continue;
+		}
+
+		Reflect::ObjectPtr object_ptr = component_to_clone.m_Definition->Clone();
+		ComponentDefinitionPtr new_descriptor = Reflect::AssertCast<Helium::ComponentDefinition>(object_ptr.Get());
+
+		definitions.Insert(iter, M_Definitions::ValueType(component_to_clone.m_Name, new_descriptor));
+	}
+
+	m_Names.Reserve(definitions.GetSize());
+	m_Definitions.Reserve(definitions.GetSize());
+
+	for (M_Definitions::Iterator iter = definitions.Begin(); iter != definitions.End(); ++iter)
+	{
+		m_Names.Push(iter->First());
+		m_Definitions.Push(iter->Second());
 	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// 2. Resolve exposed parameters to fields
+	//////////////////////////////////////////////////////////////////////////
+	for (size_t parameter_index = 0; parameter_index < rComponentSet.m_Parameters.GetSize(); ++parameter_index)
+	{
+		const ComponentSet::Parameter &parameter = rComponentSet.m_Parameters[parameter_index];
+
+		size_t target_index = FindDefinition(parameter.m_ComponentName);
+		if (IsInvalid(target_index))
+		{
+			HELIUM_TRACE( 
+				TraceLevels::Warning, 
+				TXT( "  Parameter '%s' refers to a component '%s' that cannot be found - ignored.\n"), 
+				*parameter.m_ParameterName,
+				*parameter.m_ComponentName);
+
+			continue;
+		}
+
+		uint32_t fieldNameCrc = Crc32( parameter.m_ComponentFieldName.Get() );
+		const Reflect::Field *field = m_Definitions[target_index]->GetMetaClass()->FindFieldByName(fieldNameCrc);
+
+		if (!field)
+		{
+			HELIUM_TRACE( 
+				TraceLevels::Warning, 
+				TXT( "  Parameter '%s' cannot find field named '%s' on component '%s' - ignored.\n"), 
+				*parameter.m_ParameterName,
+				*parameter.m_ComponentFieldName,
+				*parameter.m_ComponentName);
+
+			continue;
+		}
+
+		Binding *pBinding = m_Bindings.New();
+		pBinding->m_ParameterName = parameter.m_ParameterName;
+		pBinding->m_Field = field;
+		pBinding->m_TargetIndex = target_index;
+		pBinding->m_SourceIndex = FindDefinition(parameter.m_ParameterName);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// 3. Wire components to each other once, rather than for every deploy
+	//////////////////////////////////////////////////////////////////////////
+	for (DynamicArray<Binding>::Iterator iter = m_Bindings.Begin(); iter != m_Bindings.End(); ++iter)
+	{
+		if (IsValid(iter->m_SourceIndex))
+		{
+			iter->m_Field->m_Translator->Copy( 
+				Reflect::Pointer( m_Definitions[iter->m_SourceIndex] ),
+				Reflect::Pointer( iter->m_Field, m_Definitions[iter->m_TargetIndex].Get() ),
+				Reflect::CopyFlags::Shallow );
+		}
+	}
+
+	m_bCompiled = true;
+}
+
+void Helium::CompiledComponentSet::Clear()
+{
+	m_Names.Clear();
+	m_Definitions.Clear();
+	m_Bindings.Clear();
+	m_bCompiled = false;
+}
+
+void Helium::CompiledComponentSet::Deploy( Components::IHasComponents &rHasComponents, const ParameterSet *pParameterSet )
+{
+	HELIUM_ASSERT( m_bCompiled );
+
+	DynamicArray<Parameter> parameters;
+	if (pParameterSet)
+	{
+		pParameterSet->EnumerateParameters(parameters);
+	}
+
+	// 1. Patch supplied parameter values (these take precedence over components of the same name) into per-deploy
+	//    copies of their definitions. The compiled definitions are never modified, so the set can be deployed from
+	//    several threads at once, or again while its components are being created.
+	DynamicArray<ComponentDefinitionPtr> patchedDefinitions;
+	for (DynamicArray<Binding>::Iterator iter = m_Bindings.Begin(); iter != m_Bindings.End(); ++iter)
+	{
+		Parameter *pParameter = FindParameter(parameters, iter->m_ParameterName);
+		if (!pParameter)
+		{
+			if (IsInvalid(iter->m_SourceIndex))
+			{
+				HELIUM_TRACE( 
+					TraceLevels::Warning, 
+					TXT( "  Unsupplied parameter value '%s' - ignored.\n"), 
+					*iter->m_ParameterName);
+			}
+
+			continue;
+		}
+
+		if (patchedDefinitions.IsEmpty())
+		{
+			patchedDefinitions.Resize(m_Definitions.GetSize());
+		}
+
+		ComponentDefinitionPtr &rPatched = patchedDefinitions[iter->m_TargetIndex];
+		if (!rPatched)
+		{
+			Reflect::ObjectPtr object_ptr = m_Definitions[iter->m_TargetIndex]->Clone();
+			rPatched = Reflect::AssertCast<Helium::ComponentDefinition>(object_ptr.Get());
+
+			// Keep the copy wired to the same definitions as the original
+			for (DynamicArray<Binding>::Iterator wire_iter = m_Bindings.Begin(); wire_iter != m_Bindings.End(); ++wire_iter)
+			{
+				if (wire_iter->m_TargetIndex == iter->m_TargetIndex && IsValid(wire_iter->m_SourceIndex))
+				{
+					wire_iter->m_Field->m_Translator->Copy( 
+						Reflect::Pointer( m_Definitions[wire_iter->m_SourceIndex] ),
+						Reflect::Pointer( wire_iter->m_Field, rPatched.Get() ),
+						Reflect::CopyFlags::Shallow );
+				}
+			}
+		}
+
+		iter->m_Field->m_Translator->Copy( 
+			pParameter->GetPointer(),
+			Reflect::Pointer( iter->m_Field, rPatched.Get() ),
+			Reflect::CopyFlags::Shallow );
+	}
+
+	// 2. Create components, then let them get references to each other. The created components are tracked here
+	//    rather than in the definitions, which may be deploying elsewhere at the same time.
+	size_t definitionCount = m_Definitions.GetSize();
+
+	DynamicArray<const ComponentDefinition *> deployDefinitions;
+	deployDefinitions.Reserve(definitionCount);
+	for (size_t i = 0; i < definitionCount; ++i)
+	{
+		const ComponentDefinition *pPatched = patchedDefinitions.IsEmpty() ? NULL : patchedDefinitions[i].Get();
+		deployDefinitions.Push(pPatched ? pPatched : m_Definitions[i].Get());
+	}
+
+	DynamicArray<Component *> components;
+	components.Reserve(definitionCount);
+	for (size_t i = 0; i < definitionCount; ++i)
+	{
+		components.Push(deployDefinitions[i]->CreateComponentInternal(rHasComponents));
+	}
+
+	for (size_t i = 0; i < definitionCount; ++i)
+	{
+		deployDefinitions[i]->FinalizeComponentInternal(components[i]);
+	}
+}
+
+size_t Helium::CompiledComponentSet::FindDefinition( Name name ) const
+{
+	for (size_t i = 0; i < m_Names.GetSize(); ++i)
+	{
+		if (m_Names[i] == name)
+		{
+			return i;
+		}
+	}
+
+	return Invalid<size_t>();
 }
 
 HELIUM_DEFINE_BASE_STRUCT(Helium::ComponentSet);
@@ -39,6 +39,7 @@ namespace Helium
 			Components::IHasComponents &rHasComponents, 
 			const Helium::ComponentSet &components, 
 			const ParameterSet *parameters);
+		friend class CompiledComponentSet;
 
 	private:
 
@@ -71,4 +72,40 @@ namespace Helium
 		DynamicArray<NameDefinitionPair> m_Components;
 		DynamicArray<Parameter> m_Parameters;
 	};
+
+	// A component set flattened once so that it can be deployed many times cheaply. The definitions are cloned and
+	// wired to each other a single time, and exposed parameters are resolved to fields up front. Deploying then creates
+	// the components straight from the compiled definitions, only copying the definitions whose parameters the caller
+	// supplies.
+	//
+	// Deploying never modifies the compiled set, so it may be deployed from several threads at once, and components
+	// may deploy the same set while being created or finalized.
+	class HELIUM_FRAMEWORK_API CompiledComponentSet
+	{
+	public:
+		CompiledComponentSet();
+		~CompiledComponentSet();
+
+		void Compile( const ComponentSet &rComponentSet );
+		void Clear();
+		inline bool IsCompiled() const { return m_bCompiled; }
+
+		void Deploy( Components::IHasComponents &rHasComponents, const ParameterSet *pParameterSet );
+
+	private:
+		struct Binding
+		{
+			Name                     m_ParameterName;
+			const Reflect::Field*    m_Field;
+			size_t                   m_TargetIndex;  // Definition owning the field
+			size_t                   m_SourceIndex;  // Definition wired in by default, or invalid if none
+		};
+
+		size_t FindDefinition( Name name ) const;
+
+		DynamicArray<Name>                   m_Names;
+		DynamicArray<ComponentDefinitionPtr> m_Definitions;
+		DynamicArray<Binding>                m_Bindings;
+		bool                                 m_bCompiled;
+	};
 }
@@ -1,11 +1,15 @@
 
 #include "FrameworkPch.h"
 #include "Framework/Components.h"
+#include "Framework/ComponentArchetype.h"
 #include "Framework/SystemDefinition.h"
 
 #include "Foundation/Numeric.h"
 #include "Reflect/TranslatorDeduction.h"
 #include "Engine/Asset.h"
+#include "Engine/JobManager.h"
+
+#include <algorithm>
 
 HELIUM_DEFINE_BASE_STRUCT(Helium::Component);
 
@@ -25,8 +29,7 @@ namespace
 	int32_t                    g_ComponentsInitCount = 0;
 	int32_t                    g_ComponentManagerInstanceCount = 0;
 	DynamicArray<TypeData *>   g_ComponentTypes;
-	ComponentPtrBase*          g_ComponentPtrRegistry[COMPONENT_PTR_CHECK_FREQUENCY];
-	uint16_t                   g_ComponentProcessPendingDeletesCallCount = 0;
+	bool                       g_UseArchetypeStorage = false;
 }
 
 ComponentRegistrar<Helium::Component, void> Helium::Component::s_ComponentRegistrar("Helium::Component");
@@ -36,8 +39,12 @@ void Components::Initialize( SystemDefinition *pSystemDefinition )
 	// Register base component with reflect
 	if ( !g_ComponentsInitCount )
 	{
+		g_UseArchetypeStorage = false;
+
 		if ( pSystemDefinition )
 		{
+			g_UseArchetypeStorage = pSystemDefinition->m_UseArchetypeStorage;
+
 			DynamicArray< ComponentTypeConfig > &rTypeConfigs = pSystemDefinition->m_ComponentTypeConfigs;
 			for (DynamicArray< ComponentTypeConfig >::Iterator configIter = rTypeConfigs.Begin(); 
 				configIter != rTypeConfigs.End(); ++configIter)
@@ -94,6 +101,14 @@ void Components::Cleanup()
 	}
 }
 
+// Overrides the storage used by component managers created from now on, which Initialize() otherwise takes from the
+// SystemDefinition (used by tools and tests that compare both storage modes)
+void Components::SetUseArchetypeStorage( bool bUseArchetypeStorage )
+{
+	HELIUM_ASSERT( g_ComponentsInitCount );
+	g_UseArchetypeStorage = bUseArchetypeStorage;
+}
+
 TypeId Components::RegisterType( 
 	const Reflect::MetaStruct *pStructure, 
 	TypeData &rTypeData, 
@@ -209,9 +224,9 @@ Pool* Pool::CreatePool( ComponentManager *pComponentManager, const TypeData &rTy
 		component->m_InlineData.m_Next = Invalid<ComponentIndex>();
 		component->m_InlineData.m_Previous = Invalid<ComponentIndex>();
 		component->m_InlineData.m_Delete = false;
-		component->m_InlineData.m_Generation = 0;
 		pool->m_ParallelData[i].m_Collection = NULL;
 		pool->m_ParallelData[i].m_RosterIndex = i;
+		pool->m_ParallelData[i].m_Generation = 0;
 
 		HELIUM_ASSERT( Pool::GetPool( component ) == pool );
 		HELIUM_ASSERT( Pool::GetPool( component )->GetComponentIndex( component ) == i );
@@ -349,6 +364,13 @@ Component* Pool::Allocate( IHasComponents *owner, ComponentCollection &collectio
 	m_Type->Construct( component );
 	HELIUM_ASSERT( component->m_InlineData.m_OffsetToPoolStart);
 
+	// The component is now the first of its type in the collection
+	ArchetypeStorage *pArchetypeStorage = m_ComponentManager->GetArchetypeStorage();
+	if ( pArchetypeStorage )
+	{
+		pArchetypeStorage->OnCollectionChanged( collection );
+	}
+
 	return component;
 }
 
@@ -357,13 +379,17 @@ void Pool::Free( Component *component )
 	ComponentIndex index = GetComponentIndex( component );
 	
 	// Component is already freed or component doesn't have a good handle for some reason
-	HELIUM_ASSERT( m_ParallelData[ index ].m_Collection );
+	ComponentCollection *pCollection = m_ParallelData[ index ].m_Collection;
+	HELIUM_ASSERT( pCollection );
+
+	// Archetype rows only reference the first component of each type in a collection
+	bool bWasFirstOfType = IsInvalid( GetPreviousIndex( index ) );
 
 	m_Type->Destruct( component );
 	RemoveFromChain( component, index );
 	
 	// Increment generation to invalidate old handles
-	++component->m_InlineData.m_Generation;
+	++m_ParallelData[ index ].m_Generation;
 	component->m_InlineData.m_Delete = false;
 	component->m_InlineData.m_Owner = NULL;
 
@@ -396,6 +422,12 @@ void Pool::Free( Component *component )
 		m_ParallelData[ index ].m_RosterIndex = freed_roster_index;
 		m_ParallelData[ GetComponentIndex( other_component_index ) ].m_RosterIndex = used_roster_index;
 	}
+
+	ArchetypeStorage *pArchetypeStorage = m_ComponentManager->GetArchetypeStorage();
+	if ( pArchetypeStorage && bWasFirstOfType )
+	{
+		pArchetypeStorage->OnCollectionChanged( *pCollection );
+	}
 }
 
 #if HELIUM_TOOLS
@@ -422,7 +454,24 @@ void Helium::Components::Pool::SpewRosterToTty()
 
 Helium::ComponentManager::ComponentManager(World *pWorld)
 	: m_World(pWorld)
+	, m_pArchetypeStorage(NULL)
 {
+	if ( g_UseArchetypeStorage )
+	{
+		if ( g_ComponentTypes.GetSize() <= MAX_SIGNATURE_TYPE_COUNT )
+		{
+			m_pArchetypeStorage = new ArchetypeStorage();
+		}
+		else
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				"ComponentManager - Archetype storage supports at most %d component types, but %d are registered. Falling back to pool storage.\n",
+				MAX_SIGNATURE_TYPE_COUNT,
+				g_ComponentTypes.GetSize());
+		}
+	}
+
 	for (DynamicArray<TypeData *>::Iterator iter = g_ComponentTypes.Begin();
 		iter != g_ComponentTypes.End(); ++iter)
 	{
@@ -430,12 +479,14 @@ Helium::ComponentManager::ComponentManager(World *pWorld)
 
 		m_Pools.New( Pool::CreatePool( this, type_data, type_data.m_DefaultCount ) );
 	}
+
+	// One buffer per thread that can run jobs, including the thread calling JobManager::RunJob()
+	m_DeferredChanges.Resize( JobManager::MAX_WORKER_COUNT + 1 );
+	MemoryZero( m_DeferredChanges.GetData(), m_DeferredChanges.GetSize() * sizeof( DeferredChanges * ) );
 }
 
 Helium::ComponentManager::~ComponentManager()
 {
-	Tick(); // Process pending deletes if necessary
-
 	for (DynamicArray<Pool *>::Iterator iter = m_Pools.Begin();
 		iter != m_Pools.End(); ++iter)
 	{
@@ -455,51 +506,199 @@ Helium::ComponentManager::~ComponentManager()
 	}
 
 	m_Pools.Clear();
+
+	// Any changes still pending refer to components that no longer exist. Collections with allocations pending are
+	// still alive (destroying them cancels their requests), so make sure they no longer refer back to this manager.
+	for (size_t bufferIndex = 0; bufferIndex <= m_DeferredChanges.GetSize(); ++bufferIndex)
+	{
+		DeferredChanges *pChanges = ( bufferIndex < m_DeferredChanges.GetSize() ? m_DeferredChanges[ bufferIndex ] : &m_ExternalDeferredChanges );
+		if ( !pChanges )
+		{
+			continue;
+		}
+
+		for (DynamicArray<DeferredChanges::AllocateRequest>::Iterator request = pChanges->m_Allocations.Begin();
+			request != pChanges->m_Allocations.End(); ++request)
+		{
+			if ( request->m_pCollection )
+			{
+				request->m_pCollection->m_pDeferredManager = NULL;
+				request->m_pCollection->m_PendingAllocationCount = 0;
+			}
+		}
+	}
+
+	for (DynamicArray<DeferredChanges *>::Iterator iter = m_DeferredChanges.Begin();
+		iter != m_DeferredChanges.End(); ++iter)
+	{
+		delete *iter;
+	}
+
+	m_DeferredChanges.Clear();
+
+	delete m_pArchetypeStorage;
+	m_pArchetypeStorage = NULL;
 }
 
-void Helium::Components::Tick()
+DeferredChanges &Helium::ComponentManager::GetDeferredChanges( size_t threadIndex )
 {
-	++g_ComponentProcessPendingDeletesCallCount;
+	HELIUM_ASSERT( threadIndex < m_DeferredChanges.GetSize() );
 
-	// Look at our registry of component ptrs, we may need to force some of them to invalidate (a ptr must be checked
-	// at least once every 256 frames in case the generation counter overlaps)
-	uint32_t registry_index = g_ComponentProcessPendingDeletesCallCount % COMPONENT_PTR_CHECK_FREQUENCY;
-	ComponentPtrBase *component_ptr = g_ComponentPtrRegistry[registry_index];
+	// Only the thread owning a buffer ever touches it outside of ApplyDeferredChanges(), so no locking is needed
+	DeferredChanges *pChanges = m_DeferredChanges[ threadIndex ];
+	if ( !pChanges )
+	{
+		pChanges = new DeferredChanges;
+		m_DeferredChanges[ threadIndex ] = pChanges;
+	}
 
-	// Double-check that the component head index is set
-	HELIUM_ASSERT(!component_ptr || component_ptr->m_ComponentPtrRegistryHeadIndex == registry_index);
+	return *pChanges;
+}
 
-	while (component_ptr)
+void Helium::ComponentManager::AllocateDeferred( Components::TypeId type, Components::IHasComponents *pOwner, ComponentCollection &rCollection )
+{
+	DeferredChanges::AllocateRequest request;
+	request.m_TypeId = type;
+	request.m_pOwner = pOwner;
+	request.m_pCollection = &rCollection;
+
+	// Let the collection cancel the request if it is destroyed before the request is applied
+	HELIUM_ASSERT( !rCollection.m_pDeferredManager || rCollection.m_pDeferredManager == this );
+	rCollection.m_pDeferredManager = this;
+	AtomicIncrement( rCollection.m_PendingAllocationCount );
+
+	// Threads that are not running jobs have no buffer of their own and may run alongside each other
+	size_t threadIndex = JobManager::GetStaticInstance().GetCurrentThreadIndex();
+	if ( IsInvalid( threadIndex ) )
 	{
-		// Don't do the check until we get our next pointer, as a failed check will splice out the ptr from our doubly
-		// linked list.
-		ComponentPtrBase *component_ptr_to_check = component_ptr;
-		component_ptr = component_ptr->GetNextComponetPtr();
-		component_ptr_to_check->Check();
+		MutexScopeLock scopeLock( m_ExternalDeferredChangesLock );
+		m_ExternalDeferredChanges.m_Allocations.Push( request );
+
+		return;
 	}
-	
-	// Even after we evict components, we still need to verify that we either have no component or the head component
-	// has a properly set index
-	HELIUM_ASSERT(
-		!g_ComponentPtrRegistry[registry_index] || 
-		g_ComponentPtrRegistry[registry_index]->m_ComponentPtrRegistryHeadIndex == registry_index);
+
+	GetDeferredChanges( threadIndex ).m_Allocations.Push( request );
 }
 
-void Helium::ComponentManager::RegisterComponentPtr( ComponentPtrBase &pPtr )
+void Helium::ComponentManager::FreeDeferred( Component *pComponent )
 {
-	uint16_t registry_index = g_ComponentProcessPendingDeletesCallCount % COMPONENT_PTR_CHECK_FREQUENCY;
-	pPtr.m_Next = g_ComponentPtrRegistry[registry_index];
-	
-	if (pPtr.m_Next)
+	HELIUM_ASSERT( pComponent );
+	HELIUM_ASSERT( pComponent->GetComponentManager() == this );
+
+	DeferredChanges::FreeRequest request;
+	request.m_pComponent = pComponent;
+	Pool *pPool = Pool::GetPool( pComponent );
+	request.m_Generation = pPool->GetGeneration( pPool->GetComponentIndex( pComponent ) );
+
+	size_t threadIndex = JobManager::GetStaticInstance().GetCurrentThreadIndex();
+	if ( IsInvalid( threadIndex ) )
+	{
+		MutexScopeLock scopeLock( m_ExternalDeferredChangesLock );
+		m_ExternalDeferredChanges.m_Frees.Push( request );
+
+		return;
+	}
+
+	GetDeferredChanges( threadIndex ).m_Frees.Push( request );
+}
+
+void Helium::ComponentManager::ApplyDeferredChanges()
+{
+	// Take the changes requested from threads that are not running jobs, which may still be adding more
+	DeferredChanges externalChanges;
+	{
+		MutexScopeLock scopeLock( m_ExternalDeferredChangesLock );
+		externalChanges.m_Allocations.Swap( m_ExternalDeferredChanges.m_Allocations );
+		externalChanges.m_Frees.Swap( m_ExternalDeferredChanges.m_Frees );
+	}
+
+	for (size_t bufferIndex = 0; bufferIndex <= m_DeferredChanges.GetSize(); ++bufferIndex)
+	{
+		DeferredChanges *pChanges = ( bufferIndex < m_DeferredChanges.GetSize() ? m_DeferredChanges[ bufferIndex ] : &externalChanges );
+		if ( !pChanges )
+		{
+			continue;
+		}
+
+		// Allocate first so that components added to an object being torn down this frame are released with it
+		for (DynamicArray<DeferredChanges::AllocateRequest>::Iterator request = pChanges->m_Allocations.Begin();
+			request != pChanges->m_Allocations.End(); ++request)
+		{
+			// Skip requests cancelled by their collection being destroyed
+			ComponentCollection *pCollection = request->m_pCollection;
+			if ( !pCollection )
+			{
+				continue;
+			}
+
+			if ( AtomicDecrement( pCollection->m_PendingAllocationCount ) == 0 )
+			{
+				pCollection->m_pDeferredManager = NULL;
+			}
+
+			Allocate( request->m_TypeId, request->m_pOwner, *pCollection );
+		}
+
+		for (DynamicArray<DeferredChanges::FreeRequest>::Iterator request = pChanges->m_Frees.Begin();
+			request != pChanges->m_Frees.End(); ++request)
+		{
+			// Skip components that were freed directly after the request was made
+			Component *pComponent = request->m_pComponent;
+			Pool *pPool = Pool::GetPool( pComponent );
+			if ( pPool->GetGeneration( pPool->GetComponentIndex( pComponent ) ) == request->m_Generation &&
+				pComponent->GetInlineData().m_Delete )
+			{
+				pComponent->FreeComponent();
+			}
+		}
+
+		pChanges->m_Allocations.Resize( 0 );
+		pChanges->m_Frees.Resize( 0 );
+	}
+}
+
+// Drops the deferred allocations requested for a collection that is being destroyed. This must not run while
+// components are being processed, just like ApplyDeferredChanges().
+void Helium::ComponentManager::CancelDeferredAllocations( ComponentCollection &rCollection )
+{
+	MutexScopeLock scopeLock( m_ExternalDeferredChangesLock );
+
+	for (size_t bufferIndex = 0; bufferIndex <= m_DeferredChanges.GetSize(); ++bufferIndex)
+	{
+		DeferredChanges *pChanges = ( bufferIndex < m_DeferredChanges.GetSize() ? m_DeferredChanges[ bufferIndex ] : &m_ExternalDeferredChanges );
+		if ( !pChanges )
+		{
+			continue;
+		}
+
+		for (DynamicArray<DeferredChanges::AllocateRequest>::Iterator request = pChanges->m_Allocations.Begin();
+			request != pChanges->m_Allocations.End(); ++request)
+		{
+			if ( request->m_pCollection == &rCollection )
+			{
+				request->m_pCollection = NULL;
+			}
+		}
+	}
+
+	rCollection.m_pDeferredManager = NULL;
+	rCollection.m_PendingAllocationCount = 0;
+}
+
+Helium::ComponentCollection::~ComponentCollection()
+{
+	if ( m_PendingAllocationCount != 0 )
 	{
-		// Make the current head component's previous pointer point to the new component, and clear the head component index
-		HELIUM_ASSERT(pPtr.m_Next->m_ComponentPtrRegistryHeadIndex == registry_index);
-		pPtr.m_Next->m_Previous = &pPtr;
-		pPtr.m_Next->m_ComponentPtrRegistryHeadIndex = Helium::Invalid<uint16_t>();
+		HELIUM_ASSERT( m_pDeferredManager );
+		m_pDeferredManager->CancelDeferredAllocations( *this );
 	}
 
-	pPtr.m_ComponentPtrRegistryHeadIndex = registry_index;
-	g_ComponentPtrRegistry[registry_index] = &pPtr;
+	ReleaseAll();
+
+	if ( m_pArchetypeStorage )
+	{
+		m_pArchetypeStorage->OnCollectionDestroyed( *this );
+	}
 }
 
 size_t Helium::ComponentManager::CountAllocatedComponentsThatImplement( Components::TypeId typeId ) const
@@ -516,45 +715,37 @@ size_t Helium::ComponentManager::CountAllocatedComponentsThatImplement( Componen
 	return count;
 }
 
-void Helium::ComponentPtrBase::Unlink() const
+namespace
 {
-	// If we are the head node in the component ptr registry, we need to point it to the new head
-	if (m_ComponentPtrRegistryHeadIndex != Helium::Invalid<uint16_t>())
+	bool ComparePools( const Component *pLeft, const Component *pRight )
 	{
-		ComponentPtrBase *current_head = g_ComponentPtrRegistry[m_ComponentPtrRegistryHeadIndex];
-		HELIUM_ASSERT(current_head == this);
-		HELIUM_ASSERT(!m_Previous);
+		return Pool::GetPool( pLeft ) < Pool::GetPool( pRight );
+	}
+}
 
-		// If this new node is legit, mark it as a head node
-		if (m_Next)
-		{
-			g_ComponentPtrRegistry[m_ComponentPtrRegistryHeadIndex] = m_Next;
-			m_Next->m_ComponentPtrRegistryHeadIndex = m_ComponentPtrRegistryHeadIndex;
-			m_Next->m_Previous = NULL;
-		}
-		else
-		{
-			g_ComponentPtrRegistry[m_ComponentPtrRegistryHeadIndex] = NULL;
-		}
+// Frees a batch of components (such as those of many entities being destroyed at once), one pool at a time. The
+// array is sorted in place.
+void Helium::ComponentManager::FreeComponents( DynamicArray<Component *> &rComponents )
+{
+	std::sort( rComponents.GetData(), rComponents.GetData() + rComponents.GetSize(), ComparePools );
 
-		// Unmark ourself as a head node
-		m_ComponentPtrRegistryHeadIndex = Helium::Invalid<uint16_t>();
-	} 
-	// Unlink ourself from doubly linked list of component ptrs
-	else if (m_Previous)
+	Pool *pPool = NULL;
+	for (DynamicArray<Component *>::Iterator iter = rComponents.Begin();
+		iter != rComponents.End(); ++iter)
 	{
-		m_Previous->m_Next = m_Next;
-	}
+		Component *pComponent = *iter;
+		if ( !pPool || Pool::GetPool( pComponent ) != pPool )
+		{
+			pPool = Pool::GetPool( pComponent );
+			HELIUM_ASSERT( pPool );
+			HELIUM_ASSERT( pPool->GetComponentManager() == this );
+		}
 
-	if (m_Next)
-	{
-		m_Next->m_Previous = m_Previous;
+		pPool->Free( pComponent );
 	}
-
-	m_Previous = 0;
-	m_Next = 0;
 }
 
+
 #if HELIUM_TOOLS
 void Helium::ComponentCollection::SpewToTty()
 {
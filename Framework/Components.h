@@ -7,6 +7,7 @@
 #include "Reflect/Object.h"
 #include "Foundation/Map.h"
 #include "Foundation/SmartPtr.h"
+#include "Platform/Locks.h"
 #include "Framework/Framework.h"
 
 
@@ -55,7 +56,6 @@
 	Helium::Components::ComponentRegistrar<__Type, __Type::ComponentBase> __Type::s_ComponentRegistrar(#__Type, __Count); \
 	HELIUM_DEFINE_DERIVED_STRUCT( __Type )
 
-#define HELIUM_COMPONENT_PTR_CHECK_FREQUENCY (256)
 #define HELIUM_COMPONENT_POOL_ALIGN_SIZE (32)
 #define HELIUM_COMPONENT_POOL_ALIGN_SIZE_MASK (~(POOL_ALIGN_SIZE-1))
 
@@ -65,11 +65,14 @@ namespace Helium
 	class ComponentCollection;
 	class Component;
 	class World;
-	class ComponentPtrBase;
+	class ComponentHandle;
 	class SystemDefinition;
 
 	namespace Components
 	{
+		class Archetype;
+		class ArchetypeStorage;
+
 		template <class T>
 		struct ComponentListT
 		{
@@ -89,9 +92,8 @@ namespace Helium
 		typedef uint16_t TypeId;
 		typedef uint16_t ComponentIndex;
 		typedef uint16_t ComponentSizeType;
-		typedef uint8_t GenerationIndex;
+		typedef uint32_t GenerationIndex;
 
-		const static uint32_t COMPONENT_PTR_CHECK_FREQUENCY = 256;
 		const static uintptr_t POOL_ALIGN_SIZE = 32;
 		const static uintptr_t POOL_ALIGN_SIZE_MASK = ~(POOL_ALIGN_SIZE-1);
 		
@@ -158,7 +160,6 @@ namespace Helium
 			uint16_t         m_OffsetToPoolStart;
 			ComponentIndex   m_Next;
 			ComponentIndex   m_Previous;
-			GenerationIndex  m_Generation;
 			bool             m_Delete;
 		};
 		
@@ -166,6 +167,7 @@ namespace Helium
 		{
 			ComponentCollection*  m_Collection;
 			ComponentIndex        m_RosterIndex;
+			GenerationIndex       m_Generation;   //< Incremented when the component is freed to invalidate handles
 		};
 		
 		struct HELIUM_FRAMEWORK_API Pool
@@ -221,9 +223,30 @@ namespace Helium
 			ComponentIndex             m_FirstUnallocatedIndex;
 		};
 		
+		//! Component allocations and frees requested by one thread while components may be processed in parallel.
+		//! They are applied by ComponentManager::ApplyDeferredChanges() once no other thread is using the components.
+		struct HELIUM_FRAMEWORK_API DeferredChanges
+		{
+			struct AllocateRequest
+			{
+				TypeId                m_TypeId;
+				IHasComponents*       m_pOwner;
+				ComponentCollection*  m_pCollection;
+			};
+
+			struct FreeRequest
+			{
+				Component*       m_pComponent;
+				GenerationIndex  m_Generation;
+			};
+
+			DynamicArray< AllocateRequest > m_Allocations;
+			DynamicArray< FreeRequest >     m_Frees;
+		};
+		
 		HELIUM_FRAMEWORK_API void                Initialize( SystemDefinition *pSystemDefinition );
 		HELIUM_FRAMEWORK_API void                Cleanup();
-		HELIUM_FRAMEWORK_API void                Tick();
+		HELIUM_FRAMEWORK_API void                SetUseArchetypeStorage( bool bUseArchetypeStorage );
 		
 		HELIUM_FRAMEWORK_API TypeId              RegisterType(
 			const Reflect::MetaStruct *_structure, 
@@ -242,24 +265,43 @@ namespace Helium
 	public:
 		virtual                  ~ComponentManager();
 
-		void                     RegisterComponentPtr( ComponentPtrBase &pPtr );
 		inline World*            GetWorld() const;
 		inline const Components::Pool*  GetPool( Components::TypeId typeId );
 
 		inline Component*        Allocate(Components::TypeId type, Components::IHasComponents *pOwner, ComponentCollection &rCollection);
 		inline size_t            CountAllocatedComponents( Components::TypeId typeId ) const;
 		size_t                   CountAllocatedComponentsThatImplement( Components::TypeId typeId ) const;
+		void                     FreeComponents( DynamicArray<Component *> &rComponents );
+
+		//! Archetype index of this manager's component collections, or null if archetype storage is disabled
+		inline Components::ArchetypeStorage* GetArchetypeStorage() const;
+
+		//! Deferred changes are buffered per job thread, so they may be requested from parallel queries.  Threads that
+		//! are not running jobs share a single locked buffer.  They take effect when ApplyDeferredChanges() is called,
+		//! which must not happen while components are being processed.
+		void                     AllocateDeferred(Components::TypeId type, Components::IHasComponents *pOwner, ComponentCollection &rCollection);
+		void                     FreeDeferred(Component *pComponent);
+		void                     ApplyDeferredChanges();
 
 		template < class T > T*        Allocate( Components::IHasComponents *pOwner, ComponentCollection &rCollection );
+		template < class T > void      AllocateDeferred( Components::IHasComponents *pOwner, ComponentCollection &rCollection );
 		template < class T > size_t    CountAllocatedComponents();
 		template < class T > size_t    CountAllocatedComponentsThatImplement();
 
 	private:
 		friend ComponentManager* Helium::Components::CreateManager( World *pWorld );
+		friend ComponentCollection;
 		ComponentManager(World *pWorld);
 
+		Components::DeferredChanges &GetDeferredChanges( size_t threadIndex );
+		void                         CancelDeferredAllocations( ComponentCollection &rCollection );
+
 		World *m_World;
 		DynamicArray<Components::Pool *> m_Pools;
+		Components::ArchetypeStorage *m_pArchetypeStorage;
+		DynamicArray<Components::DeferredChanges *> m_DeferredChanges; // Indexed by JobManager thread index, created on first use
+		Components::DeferredChanges m_ExternalDeferredChanges; // Requested from threads that are not running jobs
+		Mutex m_ExternalDeferredChangesLock;
 	};
 
 
@@ -319,10 +361,12 @@ namespace Helium
 	{
 	public:
 		inline ComponentCollection();
-		inline ~ComponentCollection();
+		~ComponentCollection();
 
 		inline Component *GetFirst( Components::TypeId type );
+		inline Component *GetFirstThatImplements( Components::TypeId type );
 		inline void       GetAll( Components::TypeId type, DynamicArray<Component *> &m_Components );
+		inline void       GetAll( DynamicArray<Component *> &m_Components );
 		inline void       GetAllThatImplement( Components::TypeId type, DynamicArray<Component *> &m_Components );
 		inline void       ReleaseEach( Components::TypeId type );
 		inline void       ReleaseAll();
@@ -336,7 +380,20 @@ namespace Helium
 
 	private:
 		friend Components::Pool;
+		friend Components::Archetype;
+		friend Components::ArchetypeStorage;
+		friend ComponentManager;
 		Map< Components::TypeId, Component * > m_Components;
+
+		// Archetype bookkeeping, only used if the owning component manager has archetype storage enabled
+		Components::ArchetypeStorage* m_pArchetypeStorage;
+		Components::Archetype*        m_pArchetype;
+		uint32_t                      m_ArchetypeRow;
+		bool                          m_bArchetypePending;
+
+		// Deferred allocations still pending for this collection, cancelled if it is destroyed before they are applied
+		ComponentManager*             m_pDeferredManager;
+		volatile int32_t              m_PendingAllocationCount;
 	};
 
 	//! All components have some data for bookkeeping
@@ -356,75 +413,54 @@ namespace Helium
 		inline const Components::DataInline& GetInlineData() const;
 
 		template <class T> T* AllocateSiblingComponent();
+		template <class T> void AllocateSiblingComponentDeferred();
 		
 		static Components::ComponentRegistrar<Component, void> s_ComponentRegistrar;
 
 	private:
 		friend Components::Pool;
-		friend ComponentPtrBase;
 		Components::DataInline m_InlineData;
 	};
 
 	
-	// Code that need not be template aware goes here
-	class HELIUM_FRAMEWORK_API ComponentPtrBase
+	//! Generational reference to a component: the pool holding it, its slot in the pool and the generation of that
+	//! slot when the handle was set.  Freeing a component bumps the generation of its slot, so a stale handle resolves
+	//! to null in O(1) without tracking live handles anywhere.  Resolving never modifies the handle, so handles may be
+	//! copied and resolved from any thread as long as the component is not being freed at the same time.
+	class HELIUM_FRAMEWORK_API ComponentHandle
 	{
 	public:
-		inline void Check() const;
-		inline bool IsGood() const;
-		inline void Reset(Component *_component = 0);
+		inline ComponentHandle();
+		inline explicit ComponentHandle( Component *pComponent );
 
-		ComponentPtrBase *GetNextComponetPtr() { return m_Next; }
-		friend ComponentManager;
-		friend void Helium::Components::Tick();
+		inline void Reset( Component *pComponent = NULL );
+		inline void Check();
+		inline bool IsGood() const;
+		inline Component *Resolve() const;
 
 	protected:
-		inline ComponentPtrBase();
-		inline ~ComponentPtrBase();
-
-		inline void Reset(Component *_component) const;
-		void Unlink() const;
-			
-		// Component we point to. NOTE: This will ALWAYS be a type T component because 
-		// this class never sets m_Component to anything but NULL. Our non-base template
-		// class is the only way to construct this class or assign a pointer
-		mutable Component *m_Component; 
-
-	private:
-		// Doubly linked list lets us unsplice ourself easily from list of "allocated" ComponentPtrs
-		mutable ComponentPtrBase *m_Next;
-		mutable ComponentPtrBase *m_Previous;
-			
-		// We set this generation when a component is assigned
-		mutable Components::GenerationIndex m_Generation;
-
-		// If not assigned to Helium::Invalid<uint16_t>(), this node is head of
-		// linked list and is pointed to by g_ComponentPtrRegistry. Destruction of this
-		// Ptr will automatically fix that reference.
-		mutable uint16_t m_ComponentPtrRegistryHeadIndex;
+		Components::Pool*            m_pPool;
+		Components::ComponentIndex   m_Index;
+		Components::GenerationIndex  m_Generation;
 	};
 
-	// Code that uses T goes here
+	//! Typed component handle
 	template <class T>
-	class ComponentPtr : public Helium::ComponentPtrBase
+	class ComponentPtr : public Helium::ComponentHandle
 	{
 	public:
 		ComponentPtr();
 		explicit ComponentPtr(T *_component);
-		ComponentPtr( const ComponentPtr& _rhs );
 
 		void operator=(T *_component);
 
-		// Only safe to call this if you know the component was not deallocated since Check() was called
+		// Only safe to call this if you know the component was not deallocated since the handle was last checked
 		T *UncheckedGet() const;
 		
-		T *Get();
-		const T *Get() const;
+		T *Get() const;
 
-		T &operator*();
-		T *operator->();
-
-	private:
+		T &operator*() const;
+		T *operator->() const;
 	};
 }
 
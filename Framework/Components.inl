@@ -178,7 +178,7 @@ namespace Helium
 
 		GenerationIndex Pool::GetGeneration( ComponentIndex index ) const
 		{
-			return GetComponent( index )->m_InlineData.m_Generation;
+			return m_ParallelData[ index ].m_Generation;
 		}
 		
 		ComponentIndex Pool::GetAllocatedCount() const
@@ -352,6 +352,11 @@ namespace Helium
 		return m_World;
 	}
 
+	Components::ArchetypeStorage * ComponentManager::GetArchetypeStorage() const
+	{
+		return m_pArchetypeStorage;
+	}
+
 	template < class T >
 	size_t Helium::ComponentManager::CountAllocatedComponentsThatImplement()
 	{
@@ -363,6 +368,12 @@ namespace Helium
 		return static_cast< T* >( Allocate( Components::GetType<T>(), pOwner, rCollection ) );
 	}
 
+	template < class T >
+	void Helium::ComponentManager::AllocateDeferred( Components::IHasComponents *pOwner, ComponentCollection &rCollection )
+	{
+		AllocateDeferred( Components::GetType<T>(), pOwner, rCollection );
+	}
+
 	template < class T >
 	size_t Helium::ComponentManager::CountAllocatedComponents()
 	{
@@ -375,15 +386,16 @@ namespace Helium
 	}
 	
 	Helium::ComponentCollection::ComponentCollection()
+		: m_pArchetypeStorage( NULL )
+		, m_pArchetype( NULL )
+		, m_ArchetypeRow( 0 )
+		, m_bArchetypePending( false )
+		, m_pDeferredManager( NULL )
+		, m_PendingAllocationCount( 0 )
 	{
 
 	}
 
-	Helium::ComponentCollection::~ComponentCollection()
-	{
-		ReleaseAll();
-	}
-
 	Component * Helium::ComponentCollection::GetFirst( Components::TypeId type )
 	{
 		Map< Components::TypeId, Component * >::Iterator iter = m_Components.Find( type );
@@ -395,6 +407,25 @@ namespace Helium
 		return NULL;
 	}
 
+	// Returns the first component of the first type implementing the given type (in the order types implementing it
+	// were registered, starting with the type itself), which is the same component archetype queries match
+	Component * Helium::ComponentCollection::GetFirstThatImplements( Components::TypeId type )
+	{
+		const DynamicArray< Components::TypeId > &implementing_types = Components::GetTypeData( type )->m_ImplementingTypes;
+
+		for (DynamicArray< Components::TypeId >::ConstIterator iter = implementing_types.Begin();
+			iter != implementing_types.End(); ++iter)
+		{
+			Component *c = GetFirst( *iter );
+			if ( c )
+			{
+				return c;
+			}
+		}
+
+		return NULL;
+	}
+
 	void ComponentCollection::GetAll( Components::TypeId type, DynamicArray<Component *> &components )
 	{
 		Component *c = GetFirst( type );
@@ -406,6 +437,18 @@ namespace Helium
 		}
 	}
 
+	void ComponentCollection::GetAll( DynamicArray<Component *> &components )
+	{
+		for (Map< Components::TypeId, Component * >::Iterator iter = m_Components.Begin();
+			iter != m_Components.End(); ++iter)
+		{
+			for ( Component *c = iter->Second(); c; c = c->GetNextComponent() )
+			{
+				components.New( c );
+			}
+		}
+	}
+
 	void ComponentCollection::GetAllThatImplement( Components::TypeId type, DynamicArray<Component *> &components )
 	{
 		const DynamicArray< Components::TypeId > &implementing_types = Components::GetTypeData( type )->m_ImplementingTypes;
@@ -495,7 +538,11 @@ namespace Helium
 
 	void Component::FreeComponentDeferred()
 	{
-		m_InlineData.m_Delete = true;
+		if ( !m_InlineData.m_Delete )
+		{
+			m_InlineData.m_Delete = true;
+			GetComponentManager()->FreeDeferred( this );
+		}
 	}
 	
 	const Components::DataInline &Component::GetInlineData() const
@@ -510,85 +557,77 @@ namespace Helium
 		return GetComponentManager()->Allocate<T>( GetOwner(), *GetComponentCollection() );
 	}
 
-	void ComponentPtrBase::Check() const
+	template <class T>
+	void Helium::Component::AllocateSiblingComponentDeferred()
 	{
-		// If no component, we're done
-		if (!m_Component)
-		{
-			return;
-		}
-
-		// If generation doesn't match
-		if (m_Component->m_InlineData.m_Generation != m_Generation)
-		{
-			// Drop the component
-			Reset(NULL);
-		}
+		GetComponentManager()->AllocateDeferred<T>( GetOwner(), *GetComponentCollection() );
 	}
 
-	bool ComponentPtrBase::IsGood() const
+	ComponentHandle::ComponentHandle()
+		: m_pPool( NULL )
+		, m_Index( Invalid< Components::ComponentIndex >() )
+		, m_Generation( 0 )
 	{
-		Check();
-		return (m_Component != NULL);
+
 	}
 
-	void ComponentPtrBase::Reset( Component *_component )
+	ComponentHandle::ComponentHandle( Component *pComponent )
 	{
-		const ComponentPtrBase *ptr = this;
-		ptr->Reset(_component);
+		Reset( pComponent );
 	}
 
-	void ComponentPtrBase::Reset( Component *_component ) const
+	void ComponentHandle::Reset( Component *pComponent )
 	{
-		if (m_Component == _component)
+		if ( pComponent )
 		{
-			// Is also desired case for assigning null to null ptr
-			return;
+			m_pPool = Components::Pool::GetPool( pComponent );
+			m_Index = m_pPool->GetComponentIndex( pComponent );
+			m_Generation = m_pPool->GetGeneration( m_Index );
 		}
-
-		Unlink();
-		HELIUM_ASSERT(m_ComponentPtrRegistryHeadIndex == Helium::Invalid<uint16_t>());
-		m_Component = _component;
-
-		if (m_Component)
+		else
 		{
-			m_Generation = m_Component->m_InlineData.m_Generation;
-			m_Component->GetComponentManager()->RegisterComponentPtr( *const_cast<ComponentPtrBase *>(this) );
-			HELIUM_ASSERT( m_ComponentPtrRegistryHeadIndex != Helium::Invalid<uint16_t>() );
-			HELIUM_ASSERT( !m_Next || m_Next->m_ComponentPtrRegistryHeadIndex == Helium::Invalid<uint16_t>() );
+			m_pPool = NULL;
+			m_Index = Invalid< Components::ComponentIndex >();
+			m_Generation = 0;
 		}
 	}
 
-	ComponentPtrBase::ComponentPtrBase() 
-		: m_Next(0)
-		, m_Previous(0)
-		, m_Component(0)
-		, m_ComponentPtrRegistryHeadIndex(Helium::Invalid<uint16_t>())
+	/// Clear the handle if the component it refers to has been freed.
+	void ComponentHandle::Check()
 	{
+		if ( m_pPool && m_pPool->GetGeneration( m_Index ) != m_Generation )
+		{
+			Reset( NULL );
+		}
+	}
 
+	bool ComponentHandle::IsGood() const
+	{
+		return Resolve() != NULL;
 	}
 
-	ComponentPtrBase::~ComponentPtrBase()
+	/// @return  Component referred to by this handle, or null if the handle is not set or the component was freed.
+	Component *ComponentHandle::Resolve() const
 	{
-		Unlink();
+		if ( !m_pPool || m_pPool->GetGeneration( m_Index ) != m_Generation )
+		{
+			return NULL;
+		}
+
+		return m_pPool->GetComponent( m_Index );
 	}
-		
+
 	template <class T>
 	ComponentPtr<T>::ComponentPtr()
 	{
-		Reset(0);
+
 	}
 
 	template <class T>
 	ComponentPtr<T>::ComponentPtr( T *_component )
+		: ComponentHandle( _component )
 	{
-		Reset(_component);
-	}
 
-	template <class T>
-	ComponentPtr<T>::ComponentPtr( const ComponentPtr& _rhs )
-	{
-		Reset(_rhs.m_Component);
 	}
 
 	template <class T>
@@ -600,31 +639,23 @@ namespace Helium
 	template <class T>
 	T * ComponentPtr<T>::UncheckedGet() const
 	{
-		return static_cast<T*>(m_Component);
-	}
-
-	template <class T>
-	T * ComponentPtr<T>::Get()
-	{
-		Check();
-		return UncheckedGet();
+		return m_pPool ? static_cast<T*>( m_pPool->GetComponent( m_Index ) ) : NULL;
 	}
 
 	template <class T>
-	const T * ComponentPtr<T>::Get() const
+	T * ComponentPtr<T>::Get() const
 	{
-		Check();
-		return UncheckedGet();
+		return static_cast<T*>( Resolve() );
 	}
 
 	template <class T>
-	T & ComponentPtr<T>::operator*()
+	T & ComponentPtr<T>::operator*() const
 	{
 		return *Get();
 	}
 
 	template <class T>
-	T * ComponentPtr<T>::operator->()
+	T * ComponentPtr<T>::operator->() const
 	{
 		return Get();
 	}
@@ -61,6 +61,19 @@ void Entity::ClearSliceInfo()
 	SetInvalid( m_sliceIndex );
 }
 
+void Helium::Entity::DeferredDestroy()
+{
+	World *pWorld = GetWorld();
+	if ( pWorld )
+	{
+		pWorld->DeferredDestroyEntity( this );
+	}
+	else
+	{
+		m_DeferredDestroy = true;
+	}
+}
+
 ComponentCollection& Helium::Entity::VirtualGetComponents()
 {
 	return GetComponents();
@@ -56,10 +56,20 @@ namespace Helium
 		void ClearSliceInfo();
 		//@}
 
-		void DeferredDestroy() { m_DeferredDestroy = true; }
+		/// @name Tags
+		//@{
+		template <class T>  inline void SetTag();
+		template <class T>  inline void ClearTag();
+		template <class T>  inline bool HasTag() const;
+		//@}
+
+		// Destroyed once the current frame's tasks are done, see World::DeferredDestroyEntity()
+		void DeferredDestroy();
 		bool IsDeferredDestroySet() { return m_DeferredDestroy; }
 		
 	private:
+		friend class World;
+
 		// Avoid using these vfuncs if you can! Use GetComponents() and GetWorld
 		virtual ComponentManager* VirtualGetComponentManager();
 		virtual ComponentCollection& VirtualGetComponents();
@@ -34,6 +34,40 @@ namespace Helium
 		return this->VirtualGetComponentManager()->Allocate<T>(this, m_Components);
 	}
 
+	/// Set a tag declared with HELIUM_DECLARE_TAG on this entity.
+	///
+	/// Tags are stored in the entity's slice, so the entity must be bound to a slice.  Tags are not thread safe; tasks
+	/// that set or clear them should require exclusive access.
+	///
+	/// @see ClearTag(), HasTag(), QueryTags()
+	template <class T>
+	void Entity::SetTag()
+	{
+		HELIUM_ASSERT( m_spSlice );
+		m_spSlice->GetTagBits().Set( Tags::GetTagId< T >(), m_sliceIndex );
+	}
+
+	/// Clear a tag declared with HELIUM_DECLARE_TAG on this entity.
+	///
+	/// @see SetTag(), HasTag()
+	template <class T>
+	void Entity::ClearTag()
+	{
+		HELIUM_ASSERT( m_spSlice );
+		m_spSlice->GetTagBits().Clear( Tags::GetTagId< T >(), m_sliceIndex );
+	}
+
+	/// Check whether a tag declared with HELIUM_DECLARE_TAG is set on this entity.
+	///
+	/// @return  True if the tag is set, false if not or if the entity is not bound to a slice.
+	///
+	/// @see SetTag(), ClearTag()
+	template <class T>
+	bool Entity::HasTag() const
+	{
+		return m_spSlice && m_spSlice->GetTagBits().Test( Tags::GetTagId< T >(), m_sliceIndex );
+	}
+
 	/// Get the slice to which this entity is currently bound.
 	///
 	/// @return  EntityDefinition slice.
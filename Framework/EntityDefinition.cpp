@@ -25,9 +25,27 @@ EntityDefinition::~EntityDefinition()
 {
 }
 
+/// @copydoc Asset::FinalizeLoad()
+void Helium::EntityDefinition::FinalizeLoad()
+{
+	Base::FinalizeLoad();
+
+	ScopeWriteLock writeLock( m_CompiledComponentSetLock );
+	m_CompiledComponentSet.Compile(m_ComponentSet);
+}
+
 void Helium::EntityDefinition::AddComponentDefinition( Helium::Name name, Helium::ComponentDefinition *pComponentDefinition )
 {
+	ScopeWriteLock writeLock( m_CompiledComponentSetLock );
 	m_ComponentSet.AddComponentDefinition(name, pComponentDefinition);
+	m_CompiledComponentSet.Clear();
+}
+
+void Helium::EntityDefinition::ExposeParameter( Helium::Name paramName, Helium::Name componentName, Helium::Name fieldName )
+{
+	ScopeWriteLock writeLock( m_CompiledComponentSetLock );
+	m_ComponentSet.ExposeParameter(paramName, componentName, fieldName);
+	m_CompiledComponentSet.Clear();
 }
 
 Helium::EntityPtr Helium::EntityDefinition::CreateEntity()
@@ -40,5 +58,26 @@ void Helium::EntityDefinition::FinalizeEntity( Entity *pEntity, const ParameterS
 	HELIUM_ASSERT(pEntity);
 	
 	pEntity->DeployComponents(m_Components);
-	pEntity->DeployComponents(m_ComponentSet, pParameterSet);
+
+	// Worlds may spawn the same definition concurrently, so only one of them gets to compile it, and the compiled set
+	// can't be cleared by an edit until every deploy using it is done
+	for (;;)
+	{
+		m_CompiledComponentSetLock.LockRead();
+		if (m_CompiledComponentSet.IsCompiled())
+		{
+			break;
+		}
+
+		m_CompiledComponentSetLock.UnlockRead();
+
+		ScopeWriteLock writeLock( m_CompiledComponentSetLock );
+		if (!m_CompiledComponentSet.IsCompiled())
+		{
+			m_CompiledComponentSet.Compile(m_ComponentSet);
+		}
+	}
+
+	m_CompiledComponentSet.Deploy(*pEntity, pParameterSet);
+	m_CompiledComponentSetLock.UnlockRead();
 }
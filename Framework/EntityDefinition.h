@@ -4,6 +4,7 @@
 #include "Framework/ComponentDefinition.h"
 #include "Framework/ComponentSet.h"
 #include "Framework/Entity.h"
+#include "Platform/Locks.h"
 
 namespace Helium
 {
@@ -29,10 +30,17 @@ namespace Helium
 		EntityDefinition();
 		virtual ~EntityDefinition();
 		//@}
+
+		/// @name Serialization
+		//@{
+		virtual void FinalizeLoad();
+		//@}
 		
+		// Changes to the component set are picked up by the next entity created
 		void AddComponentDefinition( Helium::Name name, Helium::ComponentDefinition *pComponentDefinition );
+		void ExposeParameter( Helium::Name paramName, Helium::Name componentName, Helium::Name fieldName );
 
-		ComponentSet &GetComponentDefinitions() { return m_ComponentSet; }
+		const ComponentSet &GetComponentDefinitions() const { return m_ComponentSet; }
 
 		// Two phase construction to allow the entity to be set up before components get finalized
 		EntityPtr CreateEntity();
@@ -42,6 +50,11 @@ namespace Helium
 
 		ComponentSet m_ComponentSet;
 		DynamicArray<ComponentDefinitionPtr> m_Components;
+
+		// m_ComponentSet compiled for spawning, built on load (or on first use for definitions built in code). Entities
+		// deploy it under a read lock, while edits to m_ComponentSet and compiling take the write lock
+		CompiledComponentSet m_CompiledComponentSet;
+		ReadWriteLock m_CompiledComponentSetLock;
 	};
 	typedef Helium::StrongPtr<EntityDefinition> EntityDefinitionPtr;
 }
@@ -0,0 +1,192 @@
+#include "FrameworkPch.h"
+#include "Framework/EntityTags.h"
+
+#include "Platform/Locks.h"
+
+using namespace Helium;
+using namespace Helium::Tags;
+
+namespace
+{
+	Name                       g_TagNames[ MAX_TAG_COUNT ];
+	size_t                     g_TagCount = 0;
+	Mutex                      g_TagRegistryLock; // Tags register themselves the first time they are used, from any thread
+}
+
+/// Register a tag by name.
+///
+/// Registering the same name more than once (such as from different modules) returns the same ID.
+///
+/// @param[in] pName  Name of the tag.
+///
+/// @return  ID of the tag, or an invalid ID if there are too many tags (invalid tags are ignored by TagBits).
+TagId Tags::RegisterTag( const char *pName )
+{
+	HELIUM_ASSERT( pName );
+
+	MutexScopeLock lock( g_TagRegistryLock );
+
+	const Name name( pName );
+	for ( size_t tagIndex = 0; tagIndex < g_TagCount; ++tagIndex )
+	{
+		if ( g_TagNames[ tagIndex ] == name )
+		{
+			return static_cast< TagId >( tagIndex );
+		}
+	}
+
+	if ( g_TagCount >= MAX_TAG_COUNT )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			"Tags::RegisterTag - Could not register tag '%s', the limit of %" PRIuSZ " tags has been reached\n",
+			pName,
+			MAX_TAG_COUNT);
+
+		HELIUM_ASSERT( false );
+		return Invalid< TagId >();
+	}
+
+	g_TagNames[ g_TagCount ] = name;
+	return static_cast< TagId >( g_TagCount++ );
+}
+
+TagBits::TagBits()
+{
+}
+
+/// Set a tag on an entity.
+///
+/// @param[in] tagId  Tag to set.
+/// @param[in] index  Slice index of the entity.
+void TagBits::Set( TagId tagId, size_t index )
+{
+	// Registering the tag failed and has already been reported
+	if ( tagId >= MAX_TAG_COUNT )
+	{
+		return;
+	}
+
+	DynamicArray< uint64_t > &rWords = m_Words[ tagId ];
+	const size_t wordIndex = index / TAG_WORD_BIT_COUNT;
+	const size_t wordCount = rWords.GetSize();
+	if ( wordIndex >= wordCount )
+	{
+		rWords.Resize( wordIndex + 1 );
+		MemoryZero( rWords.GetData() + wordCount, ( wordIndex + 1 - wordCount ) * sizeof( uint64_t ) );
+	}
+
+	rWords[ wordIndex ] |= ( static_cast< uint64_t >( 1 ) << ( index % TAG_WORD_BIT_COUNT ) );
+	m_UsedTags.Set( tagId );
+}
+
+/// Clear every tag on an entity.
+///
+/// @param[in] index  Slice index of the entity.
+void TagBits::ClearAll( size_t index )
+{
+	uint64_t usedTags = m_UsedTags.m_Bits;
+	while ( usedTags )
+	{
+		const TagId tagId = static_cast< TagId >( FindFirstSetBit( usedTags ) );
+		usedTags &= usedTags - 1;
+
+		Clear( tagId, index );
+	}
+}
+
+/// Move the tags of an entity to a different slice index, clearing the tags at its old index.
+///
+/// This matches removing an entity from a slice by swapping the last entity into its place.
+///
+/// @param[in] fromIndex  Slice index the entity is moving from.
+/// @param[in] toIndex    Slice index the entity is moving to.
+void TagBits::Move( size_t fromIndex, size_t toIndex )
+{
+	HELIUM_ASSERT( fromIndex != toIndex );
+
+	uint64_t usedTags = m_UsedTags.m_Bits;
+	while ( usedTags )
+	{
+		const TagId tagId = static_cast< TagId >( FindFirstSetBit( usedTags ) );
+		usedTags &= usedTags - 1;
+
+		if ( Test( tagId, fromIndex ) )
+		{
+			Set( tagId, toIndex );
+			Clear( tagId, fromIndex );
+		}
+		else
+		{
+			Clear( tagId, toIndex );
+		}
+	}
+}
+
+/// Find the entities in a range of tag words that have all of one set of tags and none of another.
+///
+/// Each pass is a straight AND or ANDNOT over contiguous words, so the compiler can vectorize it.
+///
+/// @param[in]  rBits      Tag bits of the slice to match.
+/// @param[in]  rWith      Tags that matching entities must have (must not be empty).
+/// @param[in]  rWithout   Tags that matching entities must not have.
+/// @param[in]  firstWord  Index of the first word to match.
+/// @param[in]  wordCount  Number of words to match.
+/// @param[out] pMatches   One bit per entity in the range, set if the entity matches (must hold wordCount words).
+void Tags::MatchWords(
+	const TagBits &rBits,
+	const TagMask &rWith,
+	const TagMask &rWithout,
+	size_t firstWord,
+	size_t wordCount,
+	uint64_t *pMatches )
+{
+	HELIUM_ASSERT( !rWith.IsEmpty() );
+	HELIUM_ASSERT( pMatches || !wordCount );
+
+	// Tags that could not be registered are never set, so nothing can have them
+	const uint64_t initialMatch = rWith.m_bHasInvalidTag ? 0 : ~static_cast< uint64_t >( 0 );
+	for ( size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex )
+	{
+		pMatches[ wordIndex ] = initialMatch;
+	}
+
+	uint64_t withTags = rWith.m_Bits;
+	while ( withTags )
+	{
+		const TagId tagId = static_cast< TagId >( FindFirstSetBit( withTags ) );
+		withTags &= withTags - 1;
+
+		// Words past the end of the tag's array are clear, so nothing there can match
+		const size_t tagWordCount = rBits.GetWordCount( tagId );
+		const size_t andCount = firstWord < tagWordCount ? Min( wordCount, tagWordCount - firstWord ) : 0;
+		const uint64_t *pWords = rBits.GetWords( tagId ) + ( andCount ? firstWord : 0 );
+
+		for ( size_t wordIndex = 0; wordIndex < andCount; ++wordIndex )
+		{
+			pMatches[ wordIndex ] &= pWords[ wordIndex ];
+		}
+
+		for ( size_t wordIndex = andCount; wordIndex < wordCount; ++wordIndex )
+		{
+			pMatches[ wordIndex ] = 0;
+		}
+	}
+
+	// Only tags set somewhere in the slice can exclude anything
+	uint64_t withoutTags = rWithout.m_Bits & rBits.GetUsedTags().m_Bits;
+	while ( withoutTags )
+	{
+		const TagId tagId = static_cast< TagId >( FindFirstSetBit( withoutTags ) );
+		withoutTags &= withoutTags - 1;
+
+		const size_t tagWordCount = rBits.GetWordCount( tagId );
+		const size_t andNotCount = firstWord < tagWordCount ? Min( wordCount, tagWordCount - firstWord ) : 0;
+		const uint64_t *pWords = rBits.GetWords( tagId ) + ( andNotCount ? firstWord : 0 );
+
+		for ( size_t wordIndex = 0; wordIndex < andNotCount; ++wordIndex )
+		{
+			pMatches[ wordIndex ] &= ~pWords[ wordIndex ];
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Framework/Framework.h"
+
+#include "Foundation/DynamicArray.h"
+
+/// Declare a tag: a data-less marker that can be set on entities and queried with QueryTags().
+///
+/// Tags are stored as one bit per entity in the entity's slice rather than as pooled components, so they cost nothing
+/// to add or remove and matching them is a handful of word-wide AND/ANDNOT operations.
+#define HELIUM_DECLARE_TAG( __Type )                                                  \
+	struct __Type                                                                     \
+	{                                                                                 \
+		static Helium::Tags::TagId GetStaticTagId()                                   \
+		{                                                                             \
+			static const Helium::Tags::TagId s_TagId = Helium::Tags::RegisterTag( #__Type ); \
+			return s_TagId;                                                           \
+		}                                                                             \
+	};
+
+namespace Helium
+{
+	namespace Tags
+	{
+		typedef uint16_t TagId;
+
+		//! Number of distinct tags that can be registered
+		const static size_t MAX_TAG_COUNT = 64;
+
+		//! Number of bits in a word of tag bits
+		const static size_t TAG_WORD_BIT_COUNT = 64;
+
+		HELIUM_FRAMEWORK_API TagId RegisterTag( const char *pName );
+
+		template <class T>
+		inline TagId GetTagId();
+
+		//! Set of tags, used to describe which tags an entity must or must not have in a query
+		//
+		// Tags that could not be registered are never set on any entity, so a mask built with one can't be matched by
+		// an entity that must have all of its tags.
+		struct HELIUM_FRAMEWORK_API TagMask
+		{
+			inline TagMask();
+
+			inline void Set( TagId tagId );
+			inline bool Test( TagId tagId ) const;
+			inline bool IsEmpty() const;
+
+			uint64_t m_Bits;
+			bool     m_bHasInvalidTag;
+		};
+
+		template <class... Ts>
+		inline TagMask MakeTagMask();
+
+		//! Tag bits for every entity in a slice, stored as one bit array per tag indexed by the entity's slice index.
+		//
+		// Bits past the end of a tag's array are implicitly clear, so tags that are never set in a slice take no space.
+		// Setting and clearing bits is not thread safe; tasks that change tags should require exclusive access.  Tags
+		// that could not be registered are ignored: setting or clearing them does nothing and testing them fails.
+		class HELIUM_FRAMEWORK_API TagBits : NonCopyable
+		{
+		public:
+			TagBits();
+
+			void                 Set( TagId tagId, size_t index );
+			inline void          Clear( TagId tagId, size_t index );
+			inline bool          Test( TagId tagId, size_t index ) const;
+
+			void                 ClearAll( size_t index );
+			void                 Move( size_t fromIndex, size_t toIndex );
+
+			inline const uint64_t *GetWords( TagId tagId ) const;
+			inline size_t        GetWordCount( TagId tagId ) const;
+			inline const TagMask &GetUsedTags() const;
+
+		private:
+			DynamicArray< uint64_t > m_Words[ MAX_TAG_COUNT ];
+			TagMask                  m_UsedTags;
+		};
+
+		HELIUM_FRAMEWORK_API void MatchWords(
+			const TagBits &rBits,
+			const TagMask &rWith,
+			const TagMask &rWithout,
+			size_t firstWord,
+			size_t wordCount,
+			uint64_t *pMatches );
+
+		inline uint32_t FindFirstSetBit( uint64_t word );
+	}
+}
+
+#include "Framework/EntityTags.inl"
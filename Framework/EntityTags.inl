@@ -0,0 +1,127 @@
+namespace Helium
+{
+	namespace Tags
+	{
+		/// Get the ID of a tag declared with HELIUM_DECLARE_TAG.
+		///
+		/// @return  Tag ID.
+		template <class T>
+		TagId GetTagId()
+		{
+			return T::GetStaticTagId();
+		}
+
+		TagMask::TagMask()
+			: m_Bits( 0 )
+			, m_bHasInvalidTag( false )
+		{
+		}
+
+		void TagMask::Set( TagId tagId )
+		{
+			if ( tagId >= MAX_TAG_COUNT )
+			{
+				m_bHasInvalidTag = true;
+				return;
+			}
+
+			m_Bits |= ( static_cast< uint64_t >( 1 ) << tagId );
+		}
+
+		bool TagMask::Test( TagId tagId ) const
+		{
+			return tagId < MAX_TAG_COUNT && ( m_Bits & ( static_cast< uint64_t >( 1 ) << tagId ) ) != 0;
+		}
+
+		bool TagMask::IsEmpty() const
+		{
+			return m_Bits == 0 && !m_bHasInvalidTag;
+		}
+
+		/// Build a tag mask from a list of tags declared with HELIUM_DECLARE_TAG.
+		///
+		/// @return  Mask with each of the given tags set.
+		template <class... Ts>
+		TagMask MakeTagMask()
+		{
+			TagMask mask;
+			const TagId tagIds[] = { 0, GetTagId< Ts >()... };
+			for ( size_t tagIndex = 1; tagIndex < HELIUM_ARRAY_COUNT( tagIds ); ++tagIndex )
+			{
+				mask.Set( tagIds[ tagIndex ] );
+			}
+
+			return mask;
+		}
+
+		void TagBits::Clear( TagId tagId, size_t index )
+		{
+			if ( tagId >= MAX_TAG_COUNT )
+			{
+				return;
+			}
+
+			DynamicArray< uint64_t > &rWords = m_Words[ tagId ];
+			const size_t wordIndex = index / TAG_WORD_BIT_COUNT;
+			if ( wordIndex < rWords.GetSize() )
+			{
+				rWords[ wordIndex ] &= ~( static_cast< uint64_t >( 1 ) << ( index % TAG_WORD_BIT_COUNT ) );
+			}
+		}
+
+		bool TagBits::Test( TagId tagId, size_t index ) const
+		{
+			if ( tagId >= MAX_TAG_COUNT )
+			{
+				return false;
+			}
+
+			const DynamicArray< uint64_t > &rWords = m_Words[ tagId ];
+			const size_t wordIndex = index / TAG_WORD_BIT_COUNT;
+			return wordIndex < rWords.GetSize() &&
+				( rWords[ wordIndex ] & ( static_cast< uint64_t >( 1 ) << ( index % TAG_WORD_BIT_COUNT ) ) ) != 0;
+		}
+
+		/// @return  Bits of the given tag, one per entity, or null if the tag has never been set in this slice.
+		const uint64_t *TagBits::GetWords( TagId tagId ) const
+		{
+			HELIUM_ASSERT( tagId < MAX_TAG_COUNT );
+			return m_Words[ tagId ].GetData();
+		}
+
+		/// @return  Number of words returned by GetWords().  Entities past the last word don't have the tag.
+		size_t TagBits::GetWordCount( TagId tagId ) const
+		{
+			HELIUM_ASSERT( tagId < MAX_TAG_COUNT );
+			return m_Words[ tagId ].GetSize();
+		}
+
+		/// @return  Tags that have been set on an entity in this slice at some point.
+		const TagMask &TagBits::GetUsedTags() const
+		{
+			return m_UsedTags;
+		}
+
+		/// Find the index of the lowest set bit in a word.
+		///
+		/// @param[in] word  Word to scan (must not be zero).
+		///
+		/// @return  Index of the lowest set bit.
+		uint32_t FindFirstSetBit( uint64_t word )
+		{
+			HELIUM_ASSERT( word );
+
+			// Isolate the lowest bit and look its position up with a de Bruijn sequence
+			static const uint32_t s_BitPositions[ 64 ] =
+			{
+				 0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+				62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+				63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+				46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+			};
+
+			const uint64_t lowestBit = word & ( ~word + 1 );
+			return s_BitPositions[ ( lowestBit * 0x03f79d71b4cb0a89ULL ) >> 58 ];
+		}
+	}
+}
@@ -1,6 +1,9 @@
 #include "FrameworkPch.h"
 #include "Framework/GameSystem.h"
 
+#include "Engine/AssetLoadProfiler.h"
+#include "Engine/AsyncDeserializer.h"
+#include "Engine/JobManager.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/FileLocations.h"
 #include "Foundation/FilePath.h"
@@ -105,6 +108,40 @@ bool GameSystem::Initialize(
 		return false;
 	}
 
+	// Initialize the async deserialization threads.
+	bool bAsyncDeserializerInitSuccess = AsyncDeserializer::GetStaticInstance().Initialize();
+	HELIUM_ASSERT( bAsyncDeserializerInitSuccess );
+	if( !bAsyncDeserializerInitSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "GameSystem::Initialize(): Async deserializer initialization failed.\n" ) );
+
+		return false;
+	}
+
+	// Initialize the job worker threads.
+	bool bJobManagerInitSuccess = JobManager::GetStaticInstance().Initialize();
+	HELIUM_ASSERT( bJobManagerInitSuccess );
+	if( !bJobManagerInitSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "GameSystem::Initialize(): Job manager initialization failed.\n" ) );
+
+		return false;
+	}
+
+	// Enable asset load profiling if a trace file was specified with "-load_trace <file>".
+	for( size_t argumentIndex = 0; argumentIndex + 1 < m_arguments.GetSize(); ++argumentIndex )
+	{
+		if( m_arguments[ argumentIndex ] == TXT( "-load_trace" ) )
+		{
+			m_loadTraceFileName = m_arguments[ argumentIndex + 1 ];
+			AssetLoadProfiler::GetStaticInstance().SetEnabled( true );
+
+			break;
+		}
+	}
+
 	//pmd - Initialize the cache manager
 	FilePath baseDirectory;
 	if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
@@ -194,6 +231,17 @@ bool GameSystem::Initialize(
 		return false;
 	}
 
+	// Update each world on its own worker thread if requested with "-parallel_worlds".
+	for( size_t argumentIndex = 0; argumentIndex < m_arguments.GetSize(); ++argumentIndex )
+	{
+		if( m_arguments[ argumentIndex ] == TXT( "-parallel_worlds" ) )
+		{
+			rWorldManager.SetUpdateWorldsInParallel( true );
+
+			break;
+		}
+	}
+
 	// Initialization complete.
 	return true;
 }
@@ -231,6 +279,21 @@ void GameSystem::Shutdown()
 	AssetType::Shutdown();
 	Asset::Shutdown();
 
+	if( !m_loadTraceFileName.IsEmpty() )
+	{
+		AssetLoadProfiler& rProfiler = AssetLoadProfiler::GetStaticInstance();
+		rProfiler.WriteChromeTrace( m_loadTraceFileName );
+
+		String summary;
+		rProfiler.BuildSummary( summary );
+		HELIUM_TRACE( TraceLevels::Info, TXT( "Asset load summary:\n%s" ), *summary );
+
+		m_loadTraceFileName.Clear();
+	}
+
+	AssetLoadProfiler::DestroyStaticInstance();
+	JobManager::DestroyStaticInstance();
+	AsyncDeserializer::DestroyStaticInstance();
 	AsyncLoader::DestroyStaticInstance();
 
 	Reflect::ObjectRefCountSupport::Shutdown();
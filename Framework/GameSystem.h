@@ -65,5 +65,7 @@ namespace Helium
 		AssetAwareThreadSynchronizer m_AssetSyncUtility;
 		TaskSchedule                 m_Schedule;
 		bool                         m_bStopRunning;
+		/// File to which asset load timing is written on shutdown (empty if load profiling is disabled).
+		String                       m_loadTraceFileName;
 	};
 }
@@ -73,6 +73,49 @@ Entity* Slice::CreateEntity(EntityDefinition *pEntityDefinition, ParameterSet *p
     return entity.Get();
 }
 
+/// Create a batch of entities from the same definition.
+///
+/// Each entity is created with CreateEntity(), so components are deployed the same way as for single entities.  The
+/// entity list is grown once up front for the whole batch.
+///
+/// @param[in]  pEntityDefinition  Definition of the entities to create.
+/// @param[in]  count              Number of entities to create.
+/// @param[in]  ppParameterSets    Parameters for each entity (count entries, which may be null), or null to create
+///                                every entity with default parameters.
+/// @param[out] ppEntities         If not null, receives a pointer to each entity created (count entries).
+///
+/// @return  Number of entities created.
+///
+/// @see CreateEntity()
+size_t Slice::SpawnN(EntityDefinition *pEntityDefinition, size_t count, ParameterSet * const *ppParameterSets, Entity **ppEntities)
+{
+    HELIUM_ASSERT( pEntityDefinition );
+    if( !pEntityDefinition )
+    {
+        HELIUM_TRACE( TraceLevels::Error, TXT( "Slice::SpawnN(): EntityDefinition is NULL.\n" ) );
+        return 0;
+    }
+
+    m_entities.Reserve( m_entities.GetSize() + count );
+
+    size_t createdCount = 0;
+    for( size_t spawnIndex = 0; spawnIndex < count; ++spawnIndex )
+    {
+        Entity *pEntity = CreateEntity( pEntityDefinition, ppParameterSets ? ppParameterSets[ spawnIndex ] : NULL );
+        if( ppEntities )
+        {
+            ppEntities[ spawnIndex ] = pEntity;
+        }
+
+        if( pEntity )
+        {
+            ++createdCount;
+        }
+    }
+
+    return createdCount;
+}
+
 /// Destroy an entity in this slice.
 ///
 /// @param[in] pEntity  EntityDefinition to destroy.
@@ -103,7 +146,8 @@ bool Slice::DestroyEntity( Entity* pEntity )
     pEntity->ClearSliceInfo();
     m_entities.RemoveSwap( index );
 
-    // Update the index of the entity which has been moved to fill the entity list entry we just removed.
+    // Update the index of the entity which has been moved to fill the entity list entry we just removed, moving its
+    // tags along with it so that the tags past the end of the entity list stay clear.
     size_t entityCount = m_entities.GetSize();
     if( index < entityCount )
     {
@@ -111,6 +155,11 @@ bool Slice::DestroyEntity( Entity* pEntity )
         HELIUM_ASSERT( pMovedEntity );
         HELIUM_ASSERT( pMovedEntity->GetSliceIndex() == entityCount );
         pMovedEntity->SetSliceIndex( index );
+        m_tagBits.Move( entityCount, index );
+    }
+    else
+    {
+        m_tagBits.ClearAll( index );
     }
 
     return true;
@@ -3,6 +3,7 @@
 #include "Framework/Framework.h"
 
 #include "Framework/ParameterSet.h"
+#include "Framework/EntityTags.h"
 #include "Reflect/Object.h"
 
 namespace Helium
@@ -39,6 +40,7 @@ namespace Helium
         /// @name EntityDefinition Creation
         //@{
 		virtual Helium::Entity* CreateEntity(EntityDefinition *pEntityDefinition, ParameterSet *pParameterSet = NULL);
+		size_t SpawnN(EntityDefinition *pEntityDefinition, size_t count, ParameterSet * const *ppParameterSets = NULL, Entity **ppEntities = NULL);
         virtual bool DestroyEntity( Entity* pEntity );
         //@}
 
@@ -48,6 +50,12 @@ namespace Helium
         Entity* GetEntity( size_t index ) const;
         //@}
 
+        /// @name Entity Tags
+        //@{
+        inline Tags::TagBits& GetTagBits();
+        inline const Tags::TagBits& GetTagBits() const;
+        //@}
+
         /// @name World Registration
         //@{
         World *GetWorld();
@@ -65,6 +73,8 @@ namespace Helium
 
         /// Entities.
         DynamicArray< EntityPtr > m_entities;
+        /// Tags of each entity, indexed the same as m_entities.
+        Tags::TagBits m_tagBits;
 
         /// Slice world.
         WorldWPtr m_spWorld;
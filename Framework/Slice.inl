@@ -21,4 +21,24 @@ namespace Helium
         return m_entities.GetSize();
     }
 
+    /// Get the tags of the entities in this slice, indexed by the slice index of each entity.
+    ///
+    /// @return  Entity tag bits.
+    ///
+    /// @see Entity::SetTag(), Entity::HasTag()
+    Tags::TagBits& Slice::GetTagBits()
+    {
+        return m_tagBits;
+    }
+
+    /// Get the tags of the entities in this slice, indexed by the slice index of each entity.
+    ///
+    /// @return  Entity tag bits.
+    ///
+    /// @see Entity::SetTag(), Entity::HasTag()
+    const Tags::TagBits& Slice::GetTagBits() const
+    {
+        return m_tagBits;
+    }
+
 }
@@ -28,6 +28,13 @@ void SystemDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
 {
 	comp.AddField( &SystemDefinition::m_SystemComponents, "m_SystemComponents" );
 	comp.AddField( &SystemDefinition::m_ComponentTypeConfigs, "m_ComponentTypeConfigs" );
+	comp.AddField( &SystemDefinition::m_UseArchetypeStorage, "m_UseArchetypeStorage" );
+}
+
+SystemDefinition::SystemDefinition()
+	: m_UseArchetypeStorage( false )
+{
+
 }
 
 void SystemDefinition::Initialize()
@@ -77,11 +77,14 @@ namespace Helium
 		HELIUM_DECLARE_ASSET( Helium::SystemDefinition, Helium::Asset )
 		static void PopulateMetaType( Reflect::MetaStruct& comp );
 
+		SystemDefinition();
+
 		void Initialize();
 		void Cleanup();
 
 		DynamicArray< ComponentTypeConfig > m_ComponentTypeConfigs;
 		DynamicArray< SystemComponentDefinitionPtr > m_SystemComponents;
+		bool m_UseArchetypeStorage; // Index component collections by archetype so queries can stream through chunks
 	};
 	typedef Helium::StrongPtr< SystemDefinition > SystemDefinitionPtr;
 }
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Framework/Framework.h"
+
+#include "Framework/EntityTags.h"
+#include "Framework/Entity.h"
+#include "Framework/Slice.h"
+#include "Framework/World.h"
+
+namespace Helium
+{
+	namespace Tags
+	{
+		//! Number of tag words matched at a time, small enough to keep the matches on the stack
+		const static size_t QUERY_BLOCK_WORD_COUNT = 64;
+	}
+
+	/// Call a function for every entity in a world that has all of one set of tags and none of another.
+	///
+	/// Each slice's tag words are matched in blocks with AND/ANDNOT, and only the entities whose bits are set in the
+	/// result are visited.  The function must not add or destroy entities directly; use Entity::DeferredDestroy().
+	///
+	/// @param[in] pWorld    World to query.
+	/// @param[in] rWith     Tags that entities must have (must not be empty).
+	/// @param[in] rWithout  Tags that entities must not have.
+	/// @param[in] function  Function to call with each matching entity.
+	template <class Function>
+	void QueryTags( World *pWorld, const Tags::TagMask &rWith, const Tags::TagMask &rWithout, Function function )
+	{
+		HELIUM_ASSERT( pWorld );
+		HELIUM_ASSERT( !rWith.IsEmpty() );
+
+		// Tags that could not be registered are never set, so nothing can have them
+		if ( rWith.m_bHasInvalidTag )
+		{
+			return;
+		}
+
+		uint64_t matches[ Tags::QUERY_BLOCK_WORD_COUNT ];
+
+		const size_t sliceCount = pWorld->GetSliceCount();
+		for ( size_t sliceIndex = 0; sliceIndex < sliceCount; ++sliceIndex )
+		{
+			Slice *pSlice = pWorld->GetSlice( sliceIndex );
+			HELIUM_ASSERT( pSlice );
+
+			// Skip slices where one of the required tags has never been set
+			const Tags::TagBits &rBits = pSlice->GetTagBits();
+			if ( ( rBits.GetUsedTags().m_Bits & rWith.m_Bits ) != rWith.m_Bits )
+			{
+				continue;
+			}
+
+			const size_t wordCount = ( pSlice->GetEntityCount() + Tags::TAG_WORD_BIT_COUNT - 1 ) / Tags::TAG_WORD_BIT_COUNT;
+			for ( size_t firstWord = 0; firstWord < wordCount; firstWord += Tags::QUERY_BLOCK_WORD_COUNT )
+			{
+				const size_t blockWordCount = Min( wordCount - firstWord, Tags::QUERY_BLOCK_WORD_COUNT );
+				Tags::MatchWords( rBits, rWith, rWithout, firstWord, blockWordCount, matches );
+
+				for ( size_t wordIndex = 0; wordIndex < blockWordCount; ++wordIndex )
+				{
+					uint64_t word = matches[ wordIndex ];
+					while ( word )
+					{
+						const size_t entityIndex = ( firstWord + wordIndex ) * Tags::TAG_WORD_BIT_COUNT + Tags::FindFirstSetBit( word );
+						word &= word - 1;
+
+						Entity *pEntity = pSlice->GetEntity( entityIndex );
+						HELIUM_ASSERT( pEntity );
+						function( pEntity );
+					}
+				}
+			}
+		}
+	}
+
+	/// Call a function for every entity in a world that has all of the given tags.
+	///
+	/// @param[in] pWorld    World to query.
+	/// @param[in] function  Function to call with each matching entity.
+	///
+	/// @see QueryTags( World *, const Tags::TagMask &, const Tags::TagMask &, Function )
+	template <class... Ts, class Function>
+	inline void QueryTags( World *pWorld, Function function )
+	{
+		QueryTags( pWorld, Tags::MakeTagMask< Ts... >(), Tags::TagMask(), function );
+	}
+}
@@ -2,14 +2,140 @@
 #include "FrameworkPch.h"
 #include "TaskScheduler.h"
 #include "Foundation/Map.h"
+#include "Framework/Components.h"
+#include "Engine/JobBase.h"
+#include "Engine/JobManager.h"
 
 using namespace Helium;
 
+namespace Helium
+{
+	// Parameters for running a single task of a schedule stage (or spawning the tasks of the stage that do not wait on
+	// any other task if m_TaskIndex is invalid)
+	struct TaskJobParameters
+	{
+		const TaskSchedule *m_pSchedule;
+		DynamicArray< WorldPtr > *m_pWorlds;
+		volatile int32_t *m_pPendingCounts;
+		size_t m_TaskBegin;
+		size_t m_TaskEnd;
+		size_t m_TaskIndex;
+	};
+
+	typedef JobBase< TaskJobParameters > TaskJob;
+
+	template<>
+	void JobBase< TaskJobParameters >::Run( JobContext *pContext );
+
+	void SpawnTaskJob( JobContext *pContext, const TaskJobParameters &rParameters, size_t taskIndex )
+	{
+		TaskJob *pJob = pContext->Create< TaskJob >();
+		HELIUM_ASSERT( pJob );
+
+		TaskJobParameters &rJobParameters = pJob->GetParameters();
+		rJobParameters = rParameters;
+		rJobParameters.m_TaskIndex = taskIndex;
+	}
+
+	template<>
+	void JobBase< TaskJobParameters >::Run( JobContext *pContext )
+	{
+		HELIUM_ASSERT( pContext );
+
+		const TaskSchedule &rSchedule = *m_parameters.m_pSchedule;
+		const size_t taskIndex = m_parameters.m_TaskIndex;
+
+		if ( IsInvalid( taskIndex ) )
+		{
+			for ( size_t rootTaskIndex = m_parameters.m_TaskBegin; rootTaskIndex < m_parameters.m_TaskEnd; ++rootTaskIndex )
+			{
+				if ( rSchedule.m_PredecessorCounts[ rootTaskIndex ] == 0 )
+				{
+					SpawnTaskJob( pContext, m_parameters, rootTaskIndex );
+				}
+			}
+
+			return;
+		}
+
+		HELIUM_ASSERT( !rSchedule.m_ScheduleInfo[ taskIndex ]->m_Contract.RequiresMainThread() );
+		rSchedule.m_ScheduleFunc[ taskIndex ]( *m_parameters.m_pWorlds );
+
+		// Release any tasks that were only waiting on this one
+		const size_t successorEnd = rSchedule.m_SuccessorOffsets[ taskIndex + 1 ];
+		for ( size_t successorIndex = rSchedule.m_SuccessorOffsets[ taskIndex ]; successorIndex < successorEnd; ++successorIndex )
+		{
+			const size_t nextTaskIndex = rSchedule.m_Successors[ successorIndex ];
+			if ( AtomicDecrement( m_parameters.m_pPendingCounts[ nextTaskIndex ] ) == 0 )
+			{
+				SpawnTaskJob( pContext, m_parameters, nextTaskIndex );
+			}
+		}
+	}
+
+	// Parameters for updating a single world (or spawning a job for every world if m_WorldIndex is invalid). Either
+	// m_pWorldFunc is called for the world, or the schedule tasks from m_TaskBegin up to m_TaskEnd are run in order.
+	struct WorldJobParameters
+	{
+		const TaskSchedule *m_pSchedule;
+		DynamicArray< WorldPtr > *m_pWorldLists;
+		WorldPtr *m_pWorlds;
+		WorldTaskFunc m_pWorldFunc;
+		size_t m_WorldCount;
+		size_t m_WorldIndex;
+		size_t m_TaskBegin;
+		size_t m_TaskEnd;
+	};
+
+	typedef JobBase< WorldJobParameters > WorldJob;
+
+	template<>
+	void JobBase< WorldJobParameters >::Run( JobContext *pContext );
+
+	template<>
+	void JobBase< WorldJobParameters >::Run( JobContext *pContext )
+	{
+		HELIUM_ASSERT( pContext );
+
+		const size_t worldIndex = m_parameters.m_WorldIndex;
+		if ( IsInvalid( worldIndex ) )
+		{
+			for ( size_t childWorldIndex = 0; childWorldIndex < m_parameters.m_WorldCount; ++childWorldIndex )
+			{
+				WorldJob *pJob = pContext->Create< WorldJob >();
+				HELIUM_ASSERT( pJob );
+
+				WorldJobParameters &rJobParameters = pJob->GetParameters();
+				rJobParameters = m_parameters;
+				rJobParameters.m_WorldIndex = childWorldIndex;
+			}
+
+			return;
+		}
+
+		if ( m_parameters.m_pWorldFunc )
+		{
+			m_parameters.m_pWorldFunc( m_parameters.m_pWorlds[ worldIndex ].Get() );
+
+			return;
+		}
+
+		const TaskSchedule &rSchedule = *m_parameters.m_pSchedule;
+		DynamicArray< WorldPtr > &rWorldList = m_parameters.m_pWorldLists[ worldIndex ];
+		for ( size_t taskIndex = m_parameters.m_TaskBegin; taskIndex < m_parameters.m_TaskEnd; ++taskIndex )
+		{
+			rSchedule.m_ScheduleFunc[ taskIndex ]( rWorldList );
+		}
+	}
+}
+
 
 TaskDefinition *TaskDefinition::s_FirstTaskDefinition = NULL;
 bool TaskScheduler::m_ContractsDefined = false;
 
 bool InsertToTaskList(A_TaskDefinitionPtr &rTaskInfoList, DynamicArray<TaskFunc> &rTaskFuncList, A_TaskDefinitionPtr &rTaskStack, const TaskDefinition *pTask, uint32_t tickType);
+bool BuildTaskGraph(TaskSchedule &rSchedule);
+void ExecuteWorldStages(const TaskSchedule &rSchedule, DynamicArray< WorldPtr > &rWorlds);
 
 bool TaskScheduler::CalculateSchedule(uint32_t tickType, TaskSchedule &schedule)
 {	
@@ -106,6 +232,11 @@ bool TaskScheduler::CalculateSchedule(uint32_t tickType, TaskSchedule &schedule)
 		{
 			schedule.m_ScheduleInfo.Clear();
 			schedule.m_ScheduleFunc.Clear();
+			schedule.m_StageOffsets.Clear();
+			schedule.m_PredecessorCounts.Clear();
+			schedule.m_SuccessorOffsets.Clear();
+			schedule.m_Successors.Clear();
+			schedule.m_WorldStageOffsets.Clear();
 			return false;
 		}
 
@@ -205,6 +336,13 @@ bool TaskScheduler::CalculateSchedule(uint32_t tickType, TaskSchedule &schedule)
 	}
 #endif
 
+	if (!BuildTaskGraph(schedule))
+	{
+		schedule.m_ScheduleInfo.Clear();
+		schedule.m_ScheduleFunc.Clear();
+		return false;
+	}
+
 	return true;
 }
 
@@ -280,14 +418,472 @@ bool InsertToTaskList(A_TaskDefinitionPtr &rTaskInfoList, DynamicArray<TaskFunc>
 	return true;
 }
 
-void TaskScheduler::ExecuteSchedule( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds )
+template <class T>
+bool ArrayContains(const DynamicArray<T> &rArray, const T &rValue)
+{
+	for (typename DynamicArray<T>::ConstIterator iter = rArray.Begin(); iter != rArray.End(); ++iter)
+	{
+		if (*iter == rValue)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+typedef Helium::Map<const TaskDefinition *, size_t> M_TaskIndexMap;
+
+// Find the scheduled tasks that must complete before the given task. Requirements on tasks that are not part of the
+// schedule (abstract tasks and tasks for other tick types) are followed through to their own requirements so that
+// ordering is not lost when those tasks are dropped.
+void CollectScheduledPredecessors(const TaskDefinition *pTask, M_TaskIndexMap &rTaskIndices, A_TaskDefinitionPtr &rVisited, DynamicArray<size_t> &rPredecessors)
+{
+	for (A_TaskDefinitionPtr::ConstIterator iter = pTask->m_RequiredTasks.Begin();
+		iter != pTask->m_RequiredTasks.End(); ++iter)
+	{
+		const TaskDefinition *pRequiredTask = *iter;
+		if (ArrayContains(rVisited, pRequiredTask))
+		{
+			continue;
+		}
+
+		rVisited.Push(pRequiredTask);
+
+		M_TaskIndexMap::Iterator index_iter = rTaskIndices.Find(pRequiredTask);
+		if (index_iter != rTaskIndices.End())
+		{
+			rPredecessors.Push(index_iter->Second());
+		}
+		else
+		{
+			CollectScheduledPredecessors(pRequiredTask, rTaskIndices, rVisited, rPredecessors);
+		}
+	}
+}
+
+// Component type IDs a task accesses, including all types derived from the declared types
+struct TaskComponentAccess
+{
+	DynamicArray<Components::TypeId> m_Reads;
+	DynamicArray<Components::TypeId> m_Writes;
+	bool m_Exclusive;
+};
+
+void ExpandComponentTypes(const DynamicArray<const Components::TypeData *> &rTypes, DynamicArray<Components::TypeId> &rTypeIds)
+{
+	for (DynamicArray<const Components::TypeData *>::ConstIterator iter = rTypes.Begin(); iter != rTypes.End(); ++iter)
+	{
+		const Components::TypeData *pTypeData = *iter;
+		HELIUM_ASSERT( pTypeData );
+
+		if (!ArrayContains(rTypeIds, pTypeData->m_TypeId))
+		{
+			rTypeIds.Push(pTypeData->m_TypeId);
+		}
+
+		for (DynamicArray<Components::TypeId>::ConstIterator type_iter = pTypeData->m_ImplementingTypes.Begin();
+			type_iter != pTypeData->m_ImplementingTypes.End(); ++type_iter)
+		{
+			if (!ArrayContains(rTypeIds, *type_iter))
+			{
+				rTypeIds.Push(*type_iter);
+			}
+		}
+	}
+}
+
+bool ComponentTypesIntersect(const DynamicArray<Components::TypeId> &rLhs, const DynamicArray<Components::TypeId> &rRhs)
+{
+	for (DynamicArray<Components::TypeId>::ConstIterator iter = rLhs.Begin(); iter != rLhs.End(); ++iter)
+	{
+		if (ArrayContains(rRhs, *iter))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool TasksConflict(const TaskComponentAccess &rLhs, const TaskComponentAccess &rRhs)
+{
+	if (rLhs.m_Exclusive || rRhs.m_Exclusive)
+	{
+		return true;
+	}
+
+	return ComponentTypesIntersect(rLhs.m_Writes, rRhs.m_Writes) ||
+		ComponentTypesIntersect(rLhs.m_Writes, rRhs.m_Reads) ||
+		ComponentTypesIntersect(rLhs.m_Reads, rRhs.m_Writes);
+}
+
+// Whether a task can be run on a separate worker for each world when updating worlds in parallel
+bool RunsOnWorldWorkers(const TaskContract &rContract)
+{
+	return rContract.m_RunsPerWorld && !rContract.m_RunsOnMainThread;
+}
+
+// Build the dependency graph used by ExecuteSchedule() to run tasks in parallel. Tasks are re-sorted so that every
+// task comes after all of the tasks it requires (keeping the calculated order wherever possible), and tasks with
+// conflicting component access are chained in that order.
+bool BuildTaskGraph(TaskSchedule &rSchedule)
 {
-	int i = 0;
-	for (DynamicArray<TaskFunc>::ConstIterator iter = schedule.m_ScheduleFunc.Begin(); iter != schedule.m_ScheduleFunc.End(); ++iter)
+	const size_t taskCount = rSchedule.m_ScheduleInfo.GetSize();
+
+	M_TaskIndexMap taskIndices;
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		const TaskDefinition *pTask = rSchedule.m_ScheduleInfo[taskIndex];
+		M_TaskIndexMap::Iterator map_entry = taskIndices.Find(pTask);
+		taskIndices.Insert(map_entry, M_TaskIndexMap::ValueType(pTask, taskIndex));
+	}
+
+	DynamicArray< DynamicArray<size_t> > requiredTasks;
+	requiredTasks.Resize(taskCount);
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		A_TaskDefinitionPtr visited;
+		CollectScheduledPredecessors(rSchedule.m_ScheduleInfo[taskIndex], taskIndices, visited, requiredTasks[taskIndex]);
+	}
+
+	// Sort the tasks by their requirements, always taking the earliest task in the calculated schedule that is ready
+	DynamicArray<size_t> sortedTasks;
+	sortedTasks.Reserve(taskCount);
+
+	DynamicArray<size_t> sortedIndices;
+	sortedIndices.Resize(taskCount);
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
 	{
-		(*iter)( rWorlds );
-		HELIUM_ASSERT(schedule.m_ScheduleInfo[i++]->m_Func == *iter);
+		SetInvalid(sortedIndices[taskIndex]);
 	}
+
+	while (sortedTasks.GetSize() < taskCount)
+	{
+		size_t readyTaskIndex = Invalid<size_t>();
+		for (size_t taskIndex = 0; taskIndex < taskCount && IsInvalid(readyTaskIndex); ++taskIndex)
+		{
+			if (IsValid(sortedIndices[taskIndex]))
+			{
+				continue;
+			}
+
+			bool bReady = true;
+			for (DynamicArray<size_t>::ConstIterator iter = requiredTasks[taskIndex].Begin();
+				iter != requiredTasks[taskIndex].End(); ++iter)
+			{
+				if (IsInvalid(sortedIndices[*iter]))
+				{
+					bReady = false;
+					break;
+				}
+			}
+
+			if (bReady)
+			{
+				readyTaskIndex = taskIndex;
+			}
+		}
+
+		if (IsInvalid(readyTaskIndex))
+		{
+			HELIUM_TRACE(TraceLevels::Error, TXT( "Dependency cycle detected in task scheduler while building the task graph. Verify order "
+				"requirements on abstract tasks and tasks that do not run under this tick type.\n" ));
+
+#if HELIUM_TOOLS
+			for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+			{
+				if (IsInvalid(sortedIndices[taskIndex]))
+				{
+					HELIUM_TRACE(TraceLevels::Error, TXT( " - %s\n" ), rSchedule.m_ScheduleInfo[taskIndex]->m_Name);
+				}
+			}
+#endif
+
+			return false;
+		}
+
+		sortedIndices[readyTaskIndex] = sortedTasks.GetSize();
+		sortedTasks.Push(readyTaskIndex);
+	}
+
+	A_TaskDefinitionPtr sortedInfo;
+	DynamicArray<TaskFunc> sortedFuncs;
+	DynamicArray< DynamicArray<size_t> > predecessors;
+	DynamicArray<TaskComponentAccess> componentAccess;
+	sortedInfo.Reserve(taskCount);
+	sortedFuncs.Reserve(taskCount);
+	predecessors.Resize(taskCount);
+	componentAccess.Resize(taskCount);
+
+	for (size_t sortedIndex = 0; sortedIndex < taskCount; ++sortedIndex)
+	{
+		const size_t taskIndex = sortedTasks[sortedIndex];
+		const TaskDefinition *pTask = rSchedule.m_ScheduleInfo[taskIndex];
+		sortedInfo.Push(pTask);
+		sortedFuncs.Push(rSchedule.m_ScheduleFunc[taskIndex]);
+
+		for (DynamicArray<size_t>::ConstIterator iter = requiredTasks[taskIndex].Begin();
+			iter != requiredTasks[taskIndex].End(); ++iter)
+		{
+			predecessors[sortedIndex].Push(sortedIndices[*iter]);
+		}
+
+		// Tasks bound to the main thread are kept apart from every other task so that they can run on their own
+		TaskComponentAccess &rAccess = componentAccess[sortedIndex];
+		rAccess.m_Exclusive = pTask->m_Contract.RequiresMainThread();
+		ExpandComponentTypes(pTask->m_Contract.m_ComponentReads, rAccess.m_Reads);
+		ExpandComponentTypes(pTask->m_Contract.m_ComponentWrites, rAccess.m_Writes);
+	}
+
+	// Tasks that touch the same components keep their relative order
+	for (size_t taskIndex = 1; taskIndex < taskCount; ++taskIndex)
+	{
+		for (size_t priorTaskIndex = 0; priorTaskIndex < taskIndex; ++priorTaskIndex)
+		{
+			if (TasksConflict(componentAccess[priorTaskIndex], componentAccess[taskIndex]) &&
+				!ArrayContains(predecessors[taskIndex], priorTaskIndex))
+			{
+				predecessors[taskIndex].Push(priorTaskIndex);
+			}
+		}
+	}
+
+	// Split the schedule into stages at each task that requires the main thread. Such a task conflicts with all other
+	// tasks, so every task before it is one of its predecessors and every task after it is one of its successors.
+	rSchedule.m_StageOffsets.Clear();
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		if (taskIndex == 0 ||
+			sortedInfo[taskIndex]->m_Contract.RequiresMainThread() ||
+			sortedInfo[taskIndex - 1]->m_Contract.RequiresMainThread())
+		{
+			rSchedule.m_StageOffsets.Push(taskIndex);
+		}
+	}
+
+	rSchedule.m_StageOffsets.Push(taskCount);
+
+	// Only keep dependencies on tasks of the same stage, since earlier stages always complete first
+	const size_t stageCount = rSchedule.m_StageOffsets.GetSize() - 1;
+	for (size_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+	{
+		const size_t taskBegin = rSchedule.m_StageOffsets[stageIndex];
+		const size_t taskEnd = rSchedule.m_StageOffsets[stageIndex + 1];
+		for (size_t taskIndex = taskBegin; taskIndex < taskEnd; ++taskIndex)
+		{
+			DynamicArray<size_t> &rPredecessors = predecessors[taskIndex];
+			size_t keepCount = 0;
+			for (size_t predecessorIndex = 0; predecessorIndex < rPredecessors.GetSize(); ++predecessorIndex)
+			{
+				HELIUM_ASSERT(rPredecessors[predecessorIndex] < taskIndex);
+				if (rPredecessors[predecessorIndex] >= taskBegin)
+				{
+					rPredecessors[keepCount++] = rPredecessors[predecessorIndex];
+				}
+			}
+
+			rPredecessors.Resize(keepCount);
+		}
+	}
+
+	// Flatten the graph into successor lists
+	rSchedule.m_PredecessorCounts.Resize(taskCount);
+	rSchedule.m_SuccessorOffsets.Resize(taskCount + 1);
+
+	for (size_t taskIndex = 0; taskIndex <= taskCount; ++taskIndex)
+	{
+		rSchedule.m_SuccessorOffsets[taskIndex] = 0;
+	}
+
+	size_t edgeCount = 0;
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		const DynamicArray<size_t> &rPredecessors = predecessors[taskIndex];
+		rSchedule.m_PredecessorCounts[taskIndex] = static_cast<uint32_t>(rPredecessors.GetSize());
+
+		for (DynamicArray<size_t>::ConstIterator iter = rPredecessors.Begin(); iter != rPredecessors.End(); ++iter)
+		{
+			++rSchedule.m_SuccessorOffsets[*iter + 1];
+		}
+
+		edgeCount += rPredecessors.GetSize();
+	}
+
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		rSchedule.m_SuccessorOffsets[taskIndex + 1] += rSchedule.m_SuccessorOffsets[taskIndex];
+	}
+
+	DynamicArray<size_t> successorCounts;
+	successorCounts.Resize(taskCount);
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		successorCounts[taskIndex] = 0;
+	}
+
+	rSchedule.m_Successors.Resize(edgeCount);
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		const DynamicArray<size_t> &rPredecessors = predecessors[taskIndex];
+		for (DynamicArray<size_t>::ConstIterator iter = rPredecessors.Begin(); iter != rPredecessors.End(); ++iter)
+		{
+			const size_t priorTaskIndex = *iter;
+			rSchedule.m_Successors[rSchedule.m_SuccessorOffsets[priorTaskIndex] + successorCounts[priorTaskIndex]] = taskIndex;
+			++successorCounts[priorTaskIndex];
+		}
+	}
+
+	// Group consecutive tasks that run per world into stages. Tasks explicitly bound to the main thread never run per
+	// world, even if they only touch state owned by each world.
+	rSchedule.m_WorldStageOffsets.Clear();
+	for (size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+	{
+		if (taskIndex == 0 ||
+			!RunsOnWorldWorkers(sortedInfo[taskIndex]->m_Contract) ||
+			!RunsOnWorldWorkers(sortedInfo[taskIndex - 1]->m_Contract))
+		{
+			rSchedule.m_WorldStageOffsets.Push(taskIndex);
+		}
+	}
+
+	rSchedule.m_WorldStageOffsets.Push(taskCount);
+
+	rSchedule.m_ScheduleInfo = sortedInfo;
+	rSchedule.m_ScheduleFunc = sortedFuncs;
+
+	return true;
+}
+
+// Run the schedule one stage at a time, with each world running through the tasks of a RunsPerWorld() stage on its
+// own worker. A stage only finishes once every world has finished it.
+void ExecuteWorldStages(const TaskSchedule &rSchedule, DynamicArray< WorldPtr > &rWorlds)
+{
+	const size_t worldCount = rWorlds.GetSize();
+
+	// Tasks take an array of worlds, so give each world its own
+	DynamicArray< DynamicArray< WorldPtr > > worldLists;
+	worldLists.Resize(worldCount);
+	for (size_t worldIndex = 0; worldIndex < worldCount; ++worldIndex)
+	{
+		worldLists[worldIndex].Push(rWorlds[worldIndex]);
+	}
+
+	JobManager &rJobManager = JobManager::GetStaticInstance();
+
+	const size_t stageCount = rSchedule.m_WorldStageOffsets.GetSize() - 1;
+	for (size_t stageIndex = 0; stageIndex < stageCount; ++stageIndex)
+	{
+		const size_t taskBegin = rSchedule.m_WorldStageOffsets[stageIndex];
+		const size_t taskEnd = rSchedule.m_WorldStageOffsets[stageIndex + 1];
+
+		if (!RunsOnWorldWorkers(rSchedule.m_ScheduleInfo[taskBegin]->m_Contract))
+		{
+			HELIUM_ASSERT(taskEnd == taskBegin + 1);
+			rSchedule.m_ScheduleFunc[taskBegin](rWorlds);
+			continue;
+		}
+
+		WorldJob job;
+		WorldJobParameters &rParameters = job.GetParameters();
+		rParameters.m_pSchedule = &rSchedule;
+		rParameters.m_pWorldLists = worldLists.GetData();
+		rParameters.m_pWorlds = rWorlds.GetData();
+		rParameters.m_pWorldFunc = NULL;
+		rParameters.m_WorldCount = worldCount;
+		SetInvalid(rParameters.m_WorldIndex);
+		rParameters.m_TaskBegin = taskBegin;
+		rParameters.m_TaskEnd = taskEnd;
+
+		rJobManager.RunJob(job);
+	}
+}
+
+void TaskScheduler::ExecuteSchedule( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds, bool bParallelWorlds )
+{
+	const size_t taskCount = schedule.m_ScheduleFunc.GetSize();
+
+	// Run the tasks in order on this thread if there are no workers to share them with
+	JobManager &rJobManager = JobManager::GetStaticInstance();
+	if ( rJobManager.GetWorkerCount() == 0 || schedule.m_PredecessorCounts.GetSize() != taskCount || schedule.m_StageOffsets.IsEmpty() )
+	{
+		int i = 0;
+		for (DynamicArray<TaskFunc>::ConstIterator iter = schedule.m_ScheduleFunc.Begin(); iter != schedule.m_ScheduleFunc.End(); ++iter)
+		{
+			(*iter)( rWorlds );
+			HELIUM_ASSERT(schedule.m_ScheduleInfo[i++]->m_Func == *iter);
+		}
+
+		return;
+	}
+
+	if ( bParallelWorlds && rWorlds.GetSize() > 1 && !schedule.m_WorldStageOffsets.IsEmpty() )
+	{
+		ExecuteWorldStages( schedule, rWorlds );
+
+		return;
+	}
+
+	DynamicArray<int32_t> pendingCounts;
+	pendingCounts.Resize( taskCount );
+	for ( size_t taskIndex = 0; taskIndex < taskCount; ++taskIndex )
+	{
+		pendingCounts[ taskIndex ] = static_cast< int32_t >( schedule.m_PredecessorCounts[ taskIndex ] );
+	}
+
+	// Tasks that require the main thread run right here, between the stages spread across the job workers
+	const size_t stageCount = schedule.m_StageOffsets.GetSize() - 1;
+	for ( size_t stageIndex = 0; stageIndex < stageCount; ++stageIndex )
+	{
+		const size_t taskBegin = schedule.m_StageOffsets[ stageIndex ];
+		const size_t taskEnd = schedule.m_StageOffsets[ stageIndex + 1 ];
+
+		if ( taskEnd == taskBegin + 1 )
+		{
+			schedule.m_ScheduleFunc[ taskBegin ]( rWorlds );
+			continue;
+		}
+
+		TaskJob job;
+		TaskJobParameters &rParameters = job.GetParameters();
+		rParameters.m_pSchedule = &schedule;
+		rParameters.m_pWorlds = &rWorlds;
+		rParameters.m_pPendingCounts = pendingCounts.GetData();
+		rParameters.m_TaskBegin = taskBegin;
+		rParameters.m_TaskEnd = taskEnd;
+		SetInvalid( rParameters.m_TaskIndex );
+
+		rJobManager.RunJob( job );
+	}
+}
+
+void TaskScheduler::ExecuteForEachWorld( WorldTaskFunc pFunc, DynamicArray< WorldPtr > &rWorlds, bool bParallelWorlds )
+{
+	HELIUM_ASSERT( pFunc );
+
+	JobManager &rJobManager = JobManager::GetStaticInstance();
+	if ( !bParallelWorlds || rWorlds.GetSize() <= 1 || rJobManager.GetWorkerCount() == 0 )
+	{
+		for ( DynamicArray< WorldPtr >::Iterator iter = rWorlds.Begin(); iter != rWorlds.End(); ++iter )
+		{
+			pFunc( iter->Get() );
+		}
+
+		return;
+	}
+
+	WorldJob job;
+	WorldJobParameters &rParameters = job.GetParameters();
+	rParameters.m_pSchedule = NULL;
+	rParameters.m_pWorldLists = NULL;
+	rParameters.m_pWorlds = rWorlds.GetData();
+	rParameters.m_pWorldFunc = pFunc;
+	rParameters.m_WorldCount = rWorlds.GetSize();
+	SetInvalid( rParameters.m_WorldIndex );
+	rParameters.m_TaskBegin = 0;
+	rParameters.m_TaskEnd = 0;
+
+	rJobManager.RunJob( job );
 }
 
 void Helium::TaskScheduler::ResetContracts()
@@ -298,6 +894,12 @@ void Helium::TaskScheduler::ResetContracts()
 		task->m_RequiredTasks.Clear();
 		task->m_Contract.m_ContributedDependencies.Clear();
 		task->m_Contract.m_OrderRequirements.Clear();
+		task->m_Contract.m_ComponentReads.Clear();
+		task->m_Contract.m_ComponentWrites.Clear();
+		task->m_Contract.m_DeclaresComponentAccess = false;
+		task->m_Contract.m_RequiresExclusiveAccess = false;
+		task->m_Contract.m_RunsPerWorld = false;
+		task->m_Contract.m_RunsOnMainThread = false;
 		task = task->m_Next;
 	}
 
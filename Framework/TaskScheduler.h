@@ -6,6 +6,8 @@
 #include "Foundation/DynamicArray.h"
 #include "Foundation/ReferenceCounting.h"
 
+#include <type_traits>
+
 #define HELIUM_DECLARE_TASK(__Type)                         \
 		__Type();                                           \
 		static __Type m_This; 
@@ -38,6 +40,11 @@ namespace Helium
 {	
 	struct TaskDefinition;
 
+	namespace Components
+	{
+		struct TypeData;
+	}
+
 	namespace OrderRequirementTypes
 	{
 		enum OrderRequirementType
@@ -78,6 +85,10 @@ namespace Helium
 	{
 		TaskContract()
 			: m_TickType( TickTypes::Never )
+			, m_DeclaresComponentAccess( false )
+			, m_RequiresExclusiveAccess( false )
+			, m_RunsPerWorld( false )
+			, m_RunsOnMainThread( false )
 		{
 
 		}
@@ -126,6 +137,64 @@ namespace Helium
 			m_TickType = tickType;
 		}
 
+		// Task reads components of type T (or of any type derived from T)
+		template <class T>
+		void ReadsComponents()
+		{
+			m_ComponentReads.Push( &T::GetStaticComponentTypeData() );
+			m_DeclaresComponentAccess = true;
+		}
+
+		// Task modifies components of type T (or of any type derived from T)
+		template <class T>
+		void WritesComponents()
+		{
+			m_ComponentWrites.Push( &T::GetStaticComponentTypeData() );
+			m_DeclaresComponentAccess = true;
+		}
+
+		// Task runs QueryComponents< Ts... >, which reads the const-qualified types and modifies the others
+		template <class... Ts>
+		void QueriesComponents()
+		{
+			int expand[] = { 0, ( QueriesComponent< Ts >( std::is_const< Ts >() ), 0 )... };
+			(void)expand;
+		}
+
+		// Task allocates or frees components, or touches shared state not covered by its component reads and writes,
+		// so it must not run concurrently with any other task
+		void RequiresExclusiveAccess()
+		{
+			m_RequiresExclusiveAccess = true;
+		}
+
+		// Task only touches state owned by each world it is given (it is implemented with ForEachWorld and keeps no
+		// state shared between worlds), so each world can run it on a separate worker when updating worlds in parallel
+		void RunsPerWorld()
+		{
+			m_RunsPerWorld = true;
+		}
+
+		// Task calls into APIs that are bound to the thread running the schedule (rendering devices, window and input
+		// polling), so it must never be handed to a job worker even though its component access is declared
+		void RunsOnMainThread()
+		{
+			m_RunsOnMainThread = true;
+		}
+
+		// Only tasks that declare all of the components they access can run concurrently with other tasks
+		bool CanRunConcurrently() const
+		{
+			return m_DeclaresComponentAccess && !m_RequiresExclusiveAccess && !m_RunsOnMainThread;
+		}
+
+		// Tasks that cannot run concurrently are assumed to touch thread-bound state, so they always run on the thread
+		// that called TaskScheduler::ExecuteSchedule()
+		bool RequiresMainThread() const
+		{
+			return !CanRunConcurrently();
+		}
+
 		// Every requirement to be before or after another dependency goes here
 		DynamicArray<OrderRequirement> m_OrderRequirements;
 
@@ -133,11 +202,41 @@ namespace Helium
 		DynamicArray<const TaskDefinition *> m_ContributedDependencies;
 
 		TickType m_TickType;
+
+		// Component types read and written by the task
+		DynamicArray<const Components::TypeData *> m_ComponentReads;
+		DynamicArray<const Components::TypeData *> m_ComponentWrites;
+
+		// Whether any component reads or writes were declared
+		bool m_DeclaresComponentAccess;
+
+		// Whether the task must run on its own
+		bool m_RequiresExclusiveAccess;
+
+		// Whether the task can run for each world independently
+		bool m_RunsPerWorld;
+
+		// Whether the task must run on the thread that executes the schedule
+		bool m_RunsOnMainThread;
+
+	private:
+		template <class T>
+		void QueriesComponent( std::true_type /*bConst*/ )
+		{
+			ReadsComponents< typename std::remove_const< T >::type >();
+		}
+
+		template <class T>
+		void QueriesComponent( std::false_type /*bConst*/ )
+		{
+			WritesComponents< T >();
+		}
 	};
 
 	class World;
 	typedef Helium::StrongPtr< World > WorldPtr;
 	typedef void (*TaskFunc)( DynamicArray< WorldPtr > & );
+	typedef void (*WorldTaskFunc)( World * );
 
 	struct HELIUM_FRAMEWORK_API TaskDefinition
 	{
@@ -187,13 +286,35 @@ namespace Helium
 	{
 		A_TaskDefinitionPtr m_ScheduleInfo;
 		DynamicArray<TaskFunc> m_ScheduleFunc; // Compact version of our schedule
+
+		// Stages used to run the schedule in parallel. Stage i covers the tasks from m_StageOffsets[i] up to
+		// m_StageOffsets[i + 1]. Tasks that require the main thread conflict with every other task, so each of them is
+		// a stage of its own that runs on the thread executing the schedule, while consecutive tasks that can run
+		// concurrently are grouped into a stage that is spread across the job workers.
+		DynamicArray<size_t> m_StageOffsets;
+
+		// Dependency graph within each stage (all values are indices into m_ScheduleFunc). Task i waits on
+		// m_PredecessorCounts[i] other tasks of its stage, and once complete releases the tasks of its stage listed in
+		// m_Successors from m_SuccessorOffsets[i] up to m_SuccessorOffsets[i + 1]. Tasks are ordered by their
+		// Before/After requirements and by conflicting component access, in which case they run in schedule order.
+		// Every task of a stage depends on all tasks of the previous stages.
+		DynamicArray<uint32_t> m_PredecessorCounts;
+		DynamicArray<size_t> m_SuccessorOffsets;
+		DynamicArray<size_t> m_Successors;
+
+		// Stages used when updating worlds in parallel. Stage i covers the tasks from m_WorldStageOffsets[i] up to
+		// m_WorldStageOffsets[i + 1]. Consecutive RunsPerWorld() tasks are grouped into a single stage that each world
+		// runs through on its own worker, while every other task is a stage of its own that runs once for all worlds on
+		// the thread executing the schedule. Each stage completes for all worlds before the next one starts.
+		DynamicArray<size_t> m_WorldStageOffsets;
 	};
 
 	class HELIUM_FRAMEWORK_API TaskScheduler
 	{
 	public:
 		static bool CalculateSchedule( uint32_t tickType, TaskSchedule &schedule );
-		static void ExecuteSchedule( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds );
+		static void ExecuteSchedule( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds, bool bParallelWorlds = false );
+		static void ExecuteForEachWorld( WorldTaskFunc pFunc, DynamicArray< WorldPtr > &rWorlds, bool bParallelWorlds = false );
 
 		static void ResetContracts();
 
@@ -0,0 +1,324 @@
+#include "Platform/Trace.h"
+
+#include "Foundation/DynamicArray.h"
+
+#include "Reflect/Registry.h"
+
+#include "Engine/JobManager.h"
+
+#include "Framework/Components.h"
+#include "Framework/ComponentQuery.h"
+
+#include <cstdio>
+
+using namespace Helium;
+
+namespace FrameworkTests
+{
+	struct TestBaseComponent : public Component
+	{
+		HELIUM_DECLARE_COMPONENT( FrameworkTests::TestBaseComponent, Helium::Component );
+		static void PopulateMetaType( Reflect::MetaStruct& comp ) { }
+	};
+
+	struct TestDerivedComponent : public TestBaseComponent
+	{
+		HELIUM_DECLARE_COMPONENT( FrameworkTests::TestDerivedComponent, FrameworkTests::TestBaseComponent );
+		static void PopulateMetaType( Reflect::MetaStruct& comp ) { }
+	};
+
+	struct TestOtherComponent : public Component
+	{
+		HELIUM_DECLARE_COMPONENT( FrameworkTests::TestOtherComponent, Helium::Component );
+		static void PopulateMetaType( Reflect::MetaStruct& comp ) { }
+	};
+
+	// Stand-in for an entity, owning a collection of components
+	struct TestOwner : public Components::IHasComponents
+	{
+		TestOwner( ComponentManager *pManager )
+			: m_pManager( pManager )
+		{
+		}
+
+		template < class T >
+		T *Allocate()
+		{
+			return m_pManager->Allocate< T >( this, m_Components );
+		}
+
+		virtual ComponentManager* VirtualGetComponentManager() { return m_pManager; }
+		virtual ComponentCollection& VirtualGetComponents() { return m_Components; }
+
+		ComponentManager *m_pManager;
+		ComponentCollection m_Components;
+	};
+
+	struct TestTuple
+	{
+		TestBaseComponent *m_pBase;
+		TestOtherComponent *m_pOther;
+	};
+
+	// Checks that a query emitted exactly the expected tuples, each of them once
+	bool CheckTuples( const char *pName, const DynamicArray< TestTuple > &rTuples, const DynamicArray< TestTuple > &rExpected )
+	{
+		bool bSuccess = ( rTuples.GetSize() == rExpected.GetSize() );
+
+		for ( size_t expectedIndex = 0; expectedIndex < rExpected.GetSize() && bSuccess; ++expectedIndex )
+		{
+			size_t matchCount = 0;
+			for ( size_t tupleIndex = 0; tupleIndex < rTuples.GetSize(); ++tupleIndex )
+			{
+				if ( rTuples[ tupleIndex ].m_pBase == rExpected[ expectedIndex ].m_pBase &&
+					rTuples[ tupleIndex ].m_pOther == rExpected[ expectedIndex ].m_pOther )
+				{
+					++matchCount;
+				}
+			}
+
+			bSuccess = ( matchCount == 1 );
+		}
+
+		printf( "%s: %s (%d tuples, %d expected)\n", pName, bSuccess ? "passed" : "FAILED", static_cast< int >( rTuples.GetSize() ), static_cast< int >( rExpected.GetSize() ) );
+
+		return bSuccess;
+	}
+
+	// Queries a base type that some owners only have derived components of, and checks that the query returns the same
+	// tuples whichever type the query walks first
+	bool TestDerivedTypeQuery( bool bUseArchetypeStorage )
+	{
+		Components::SetUseArchetypeStorage( bUseArchetypeStorage );
+
+		ComponentManager *pManager = Components::CreateManager( NULL );
+		HELIUM_ASSERT( pManager );
+		HELIUM_ASSERT( ( pManager->GetArchetypeStorage() != NULL ) == bUseArchetypeStorage );
+
+		bool bSuccess = true;
+
+		{
+			DynamicArray< TestTuple > expected;
+
+			// Derived component only, matched through its base type
+			TestOwner derivedOwner( pManager );
+			TestTuple derivedTuple;
+			derivedTuple.m_pBase = derivedOwner.Allocate< TestDerivedComponent >();
+			derivedTuple.m_pOther = derivedOwner.Allocate< TestOtherComponent >();
+			expected.Push( derivedTuple );
+
+			// Both base and derived components, where the base type itself takes precedence
+			TestOwner bothOwner( pManager );
+			TestTuple bothTuple;
+			bothTuple.m_pBase = bothOwner.Allocate< TestBaseComponent >();
+			bothOwner.Allocate< TestDerivedComponent >();
+			bothTuple.m_pOther = bothOwner.Allocate< TestOtherComponent >();
+			expected.Push( bothTuple );
+
+			// Owners missing one of the queried types
+			TestOwner otherOnlyOwner( pManager );
+			otherOnlyOwner.Allocate< TestOtherComponent >();
+
+			TestOwner derivedOnlyOwner( pManager );
+			derivedOnlyOwner.Allocate< TestDerivedComponent >();
+
+			// TestOtherComponent is the rarer type, so pool queries look the base type up through each collection
+			DynamicArray< TestTuple > tuples;
+			QueryComponents< TestBaseComponent, TestOtherComponent >( *pManager, [ &tuples ]( TestBaseComponent *pBase, TestOtherComponent *pOther )
+			{
+				TestTuple tuple;
+				tuple.m_pBase = pBase;
+				tuple.m_pOther = pOther;
+				tuples.Push( tuple );
+			} );
+
+			bSuccess &= CheckTuples( bUseArchetypeStorage ? "Derived type query, other type first, archetype storage" : "Derived type query, other type first, pool storage", tuples, expected );
+
+			// With more TestOtherComponents around, pool queries walk the pools implementing the base type instead
+			TestOwner extraOwner0( pManager );
+			TestOwner extraOwner1( pManager );
+			TestOwner extraOwner2( pManager );
+			extraOwner0.Allocate< TestOtherComponent >();
+			extraOwner1.Allocate< TestOtherComponent >();
+			extraOwner2.Allocate< TestOtherComponent >();
+
+			tuples.Resize( 0 );
+			QueryComponents< TestBaseComponent, TestOtherComponent >( *pManager, [ &tuples ]( TestBaseComponent *pBase, TestOtherComponent *pOther )
+			{
+				TestTuple tuple;
+				tuple.m_pBase = pBase;
+				tuple.m_pOther = pOther;
+				tuples.Push( tuple );
+			} );
+
+			bSuccess &= CheckTuples( bUseArchetypeStorage ? "Derived type query, base type first, archetype storage" : "Derived type query, base type first, pool storage", tuples, expected );
+		}
+
+		delete pManager;
+
+		return bSuccess;
+	}
+
+	//! Number of times each concurrent query job queries the components
+	const static size_t CONCURRENT_QUERY_ITERATIONS = 2000;
+
+	//! Number of query jobs run at the same time
+	const static size_t CONCURRENT_QUERY_JOB_COUNT = 2;
+
+	// Read-only task querying the same components as other tasks running at the same time, like the tasks sharing a
+	// concurrent schedule stage
+	struct ConcurrentQueryJob
+	{
+		ConcurrentQueryJob()
+			: m_pManager( NULL )
+			, m_ExpectedTupleCount( 0 )
+			, m_pbSuccess( NULL )
+		{
+		}
+
+		void Run( JobContext *pContext )
+		{
+			bool bSuccess = true;
+			for ( size_t iteration = 0; iteration < CONCURRENT_QUERY_ITERATIONS; ++iteration )
+			{
+				size_t tupleCount = 0;
+				QueryComponents< const TestBaseComponent, const TestOtherComponent >( *m_pManager, [ &tupleCount ]( const TestBaseComponent *pBase, const TestOtherComponent *pOther )
+				{
+					++tupleCount;
+				} );
+
+				bSuccess &= ( tupleCount == m_ExpectedTupleCount );
+			}
+
+			*m_pbSuccess = bSuccess;
+		}
+
+		static void RunCallback( void *pJob, JobContext *pContext )
+		{
+			static_cast< ConcurrentQueryJob * >( pJob )->Run( pContext );
+		}
+
+		ComponentManager *m_pManager;
+		size_t m_ExpectedTupleCount;
+		bool *m_pbSuccess;
+	};
+
+	// Spawns the concurrent query jobs
+	struct ConcurrentQueryRootJob
+	{
+		void Run( JobContext *pContext )
+		{
+			for ( size_t jobIndex = 0; jobIndex < CONCURRENT_QUERY_JOB_COUNT; ++jobIndex )
+			{
+				ConcurrentQueryJob *pJob = pContext->Create< ConcurrentQueryJob >();
+				pJob->m_pManager = m_pManager;
+				pJob->m_ExpectedTupleCount = m_ExpectedTupleCount;
+				pJob->m_pbSuccess = &m_bSuccess[ jobIndex ];
+			}
+		}
+
+		static void RunCallback( void *pJob, JobContext *pContext )
+		{
+			static_cast< ConcurrentQueryRootJob * >( pJob )->Run( pContext );
+		}
+
+		ComponentManager *m_pManager;
+		size_t m_ExpectedTupleCount;
+		bool m_bSuccess[ CONCURRENT_QUERY_JOB_COUNT ];
+	};
+
+	// Runs read-only queries from several threads at once, then checks that changes made afterwards are visible to the
+	// next query right away (which fails if the archetype query depth was left above zero)
+	bool TestConcurrentQueries( bool bUseArchetypeStorage )
+	{
+		Components::SetUseArchetypeStorage( bUseArchetypeStorage );
+
+		ComponentManager *pManager = Components::CreateManager( NULL );
+		HELIUM_ASSERT( pManager );
+
+		bool bSuccess = true;
+
+		{
+			TestOwner derivedOwner( pManager );
+			derivedOwner.Allocate< TestDerivedComponent >();
+			derivedOwner.Allocate< TestOtherComponent >();
+
+			TestOwner baseOwner( pManager );
+			baseOwner.Allocate< TestBaseComponent >();
+			baseOwner.Allocate< TestOtherComponent >();
+
+			TestOwner otherOnlyOwner( pManager );
+			otherOnlyOwner.Allocate< TestOtherComponent >();
+
+			ConcurrentQueryRootJob rootJob;
+			rootJob.m_pManager = pManager;
+			rootJob.m_ExpectedTupleCount = 2;
+			for ( size_t jobIndex = 0; jobIndex < CONCURRENT_QUERY_JOB_COUNT; ++jobIndex )
+			{
+				rootJob.m_bSuccess[ jobIndex ] = false;
+			}
+
+			JobManager::GetStaticInstance().RunJob( rootJob );
+
+			bool bQueriesSucceeded = true;
+			for ( size_t jobIndex = 0; jobIndex < CONCURRENT_QUERY_JOB_COUNT; ++jobIndex )
+			{
+				bQueriesSucceeded &= rootJob.m_bSuccess[ jobIndex ];
+			}
+
+			TestOwner lateOwner( pManager );
+			lateOwner.Allocate< TestBaseComponent >();
+			lateOwner.Allocate< TestOtherComponent >();
+
+			size_t tupleCount = 0;
+			QueryComponents< TestBaseComponent, TestOtherComponent >( *pManager, [ &tupleCount ]( TestBaseComponent *pBase, TestOtherComponent *pOther )
+			{
+				++tupleCount;
+			} );
+
+			bool bLateOwnerFound = ( tupleCount == 3 );
+
+			printf( "Concurrent queries, %s: %s\n", bUseArchetypeStorage ? "archetype storage" : "pool storage", bQueriesSucceeded && bLateOwnerFound ? "passed" : "FAILED" );
+			bSuccess = bQueriesSucceeded && bLateOwnerFound;
+		}
+
+		delete pManager;
+
+		return bSuccess;
+	}
+}
+
+HELIUM_DEFINE_COMPONENT( FrameworkTests::TestBaseComponent, 16 );
+HELIUM_DEFINE_COMPONENT( FrameworkTests::TestDerivedComponent, 16 );
+HELIUM_DEFINE_COMPONENT( FrameworkTests::TestOtherComponent, 16 );
+
+int main( int argc, const char* argv[] )
+{
+	Reflect::Initialize();
+	Components::Initialize( NULL );
+
+	bool bSuccess = true;
+	bSuccess &= FrameworkTests::TestDerivedTypeQuery( false );
+	bSuccess &= FrameworkTests::TestDerivedTypeQuery( true );
+
+	// Query jobs need worker threads to actually run at the same time
+	JobManager &rJobManager = JobManager::GetStaticInstance();
+	if ( rJobManager.Initialize( FrameworkTests::CONCURRENT_QUERY_JOB_COUNT ) )
+	{
+		bSuccess &= FrameworkTests::TestConcurrentQueries( false );
+		bSuccess &= FrameworkTests::TestConcurrentQueries( true );
+		rJobManager.Shutdown();
+	}
+	else
+	{
+		printf( "Concurrent queries: FAILED (could not start job workers)\n" );
+		bSuccess = false;
+	}
+
+	JobManager::DestroyStaticInstance();
+
+	Components::Cleanup();
+	Reflect::Cleanup();
+
+	return bSuccess ? 0 : 1;
+}
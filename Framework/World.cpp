@@ -60,6 +60,9 @@ bool World::Initialize()
 /// @see Initialize()
 void World::Shutdown()
 {
+	// Entities are about to be destroyed along with their slices anyway.
+	m_DeferredDestroyEntities.Clear();
+
 	// Remove all slices first.
 	while( !m_Slices.IsEmpty() )
 	{
@@ -88,6 +91,68 @@ Slice *World::GetRootSlice()
 	return m_RootSlice;
 }
 
+/// Flag an entity in this world to be destroyed at the next DestroyDeferredEntities() call.
+///
+/// This may be called from multiple threads at once.  Flagging an entity more than once has no effect.
+///
+/// @param[in] pEntity  Entity to destroy.
+///
+/// @see DestroyDeferredEntities()
+void World::DeferredDestroyEntity( Entity* pEntity )
+{
+	HELIUM_ASSERT( pEntity );
+	HELIUM_ASSERT( pEntity->GetWorld() == this );
+
+	MutexScopeLock scopeLock( m_DeferredDestroyLock );
+
+	if ( pEntity->m_DeferredDestroy )
+	{
+		return;
+	}
+
+	pEntity->m_DeferredDestroy = true;
+	m_DeferredDestroyEntities.Push( pEntity );
+}
+
+/// Destroy all entities flagged with DeferredDestroyEntity().
+///
+/// Only the flagged entities are visited.  Their components are gathered and freed together, grouped by pool, before
+/// each entity is removed from its slice.  This must only be called while nothing else is using the world.
+///
+/// @see DeferredDestroyEntity()
+void World::DestroyDeferredEntities()
+{
+	if ( m_DeferredDestroyEntities.IsEmpty() )
+	{
+		return;
+	}
+
+	// Entities flagged while tearing these down are left for the next call
+	DynamicArray< EntityPtr > entities;
+	entities.Swap( m_DeferredDestroyEntities );
+
+	DynamicArray< Component * > components;
+	for ( DynamicArray< EntityPtr >::Iterator iter = entities.Begin(); iter != entities.End(); ++iter )
+	{
+		( *iter )->GetComponents().GetAll( components );
+	}
+
+	GetComponentManager()->FreeComponents( components );
+
+	for ( DynamicArray< EntityPtr >::Iterator iter = entities.Begin(); iter != entities.End(); ++iter )
+	{
+		Entity *pEntity = *iter;
+
+		// The entity may have already been destroyed directly since it was flagged
+		Slice *pSlice = pEntity->GetSlice().Get();
+		if ( pSlice )
+		{
+			// TODO: I don't like that strong pointers might be holding these references alive.. need to find a way to fix this
+			pSlice->DestroyEntity( pEntity );
+		}
+	}
+}
+
 /// @copydoc Asset::PreDestroy()
 void World::RefCountPreDestroy()
 {
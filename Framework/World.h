@@ -3,9 +3,12 @@
 #include "Framework/ComponentQuery.h"
 #include "Framework/Framework.h"
 
+#include "Platform/Locks.h"
+
 namespace Helium
 {
 	class Entity;
+	typedef Helium::StrongPtr< Entity > EntityPtr;
 	class EntityDefinition;
 	
 	class Slice;
@@ -64,6 +67,12 @@ namespace Helium
 		Slice* GetSlice( size_t index ) const;
 		//@}
 
+		/// @name Deferred Entity Destruction
+		//@{
+		void DeferredDestroyEntity( Entity* pEntity );
+		void DestroyDeferredEntities();
+		//@}
+
 	public:
 		// TEMPORARY!
 		ComponentManagerPtr m_ComponentManager;
@@ -77,47 +86,80 @@ namespace Helium
 		/// Active slices.
 		DynamicArray< SlicePtr > m_Slices;
 		SlicePtr m_RootSlice;
+
+		/// Entities flagged for destruction at the next DestroyDeferredEntities() call.
+		DynamicArray< EntityPtr > m_DeferredDestroyEntities;
+		/// Lock for m_DeferredDestroyEntities, as entities may be flagged from tasks running in parallel.
+		Mutex m_DeferredDestroyLock;
 	};
 
 	typedef Helium::StrongPtr< World > WorldPtr;
 	typedef Helium::StrongPtr< const World > ConstWorldPtr;
 
-	template <class A, void (*F)(A *)>
-	inline void QueryComponents( World *pWorld )
-	{ 
+	/// Call a function for every combination of components of the given types owned by the same object in a world.
+	///
+	/// @param[in] pWorld    World to query.
+	/// @param[in] function  Function to call with a typed pointer to each component of every tuple found.
+	///
+	/// @see Helium::QueryComponents( ComponentManager &, Function )
+	template <class... Ts, class Function>
+	inline void QueryComponents( World *pWorld, Function function )
+	{
 		ComponentManager *pComponentManager = pWorld->GetComponentManager();
 		HELIUM_ASSERT( pComponentManager );
-		for (ImplementingComponentIterator<A> iter( *pComponentManager ); iter.GetBaseComponent(); iter.Advance())
-		{
-			F( *iter );
-		}
+		QueryComponents< Ts... >( *pComponentManager, function );
 	}
 
-	template <class A, class B, void (*F)(A *, B *)>
+	template <class A, void (*F)(A *)>
 	inline void QueryComponents( World *pWorld )
 	{
-		static Components::TypeId types[] = {
-			Components::GetType<A>(),
-			Components::GetType<B>()
-		};
+		QueryComponents< A >( pWorld, ComponentQuery::StaticFunction< void (*)(A *), F >() );
+	}
 
-		ComponentManager *pComponentManager = pWorld->GetComponentManager();
-		HELIUM_ASSERT( pComponentManager );
-		QueryComponentsInternal( *pComponentManager, types, HELIUM_ARRAY_COUNT(types), TupleHandler<A, B, F> );
+	template <class A, class B, void (*F)(A *, B *)>
+	inline void QueryComponents( World *pWorld )
+	{
+		QueryComponents< A, B >( pWorld, ComponentQuery::StaticFunction< void (*)(A *, B *), F >() );
 	}
 	
 	template <class A, class B, class C, void (*F)(A *, B *, C *)>
 	inline void QueryComponents( World *pWorld )
 	{
-		static Components::TypeId types[] = {
-			Components::GetType<A>(),
-			Components::GetType<B>(),
-			Components::GetType<C>()
-		};
+		QueryComponents< A, B, C >( pWorld, ComponentQuery::StaticFunction< void (*)(A *, B *, C *), F >() );
+	}
 
+	/// Call a function for every combination of components of the given types owned by the same object in a world,
+	/// processing objects in parallel.
+	///
+	/// @param[in] pWorld    World to query.
+	/// @param[in] function  Function to call with a typed pointer to each component of every tuple found.  It must
+	///                      only modify the components it is called with.
+	///
+	/// @see Helium::ParallelQueryComponents( ComponentManager &, Function )
+	template <class... Ts, class Function>
+	inline void ParallelQueryComponents( World *pWorld, Function function )
+	{
 		ComponentManager *pComponentManager = pWorld->GetComponentManager();
 		HELIUM_ASSERT( pComponentManager );
-		QueryComponentsInternal( *pComponentManager, types, HELIUM_ARRAY_COUNT(types), TupleHandler<A, B, C, F> );
+		ParallelQueryComponents< Ts... >( *pComponentManager, function );
+	}
+
+	template <class A, void (*F)(A *)>
+	inline void ParallelQueryComponents( World *pWorld )
+	{
+		ParallelQueryComponents< A >( pWorld, ComponentQuery::StaticFunction< void (*)(A *), F >() );
+	}
+
+	template <class A, class B, void (*F)(A *, B *)>
+	inline void ParallelQueryComponents( World *pWorld )
+	{
+		ParallelQueryComponents< A, B >( pWorld, ComponentQuery::StaticFunction< void (*)(A *, B *), F >() );
+	}
+	
+	template <class A, class B, class C, void (*F)(A *, B *, C *)>
+	inline void ParallelQueryComponents( World *pWorld )
+	{
+		ParallelQueryComponents< A, B, C >( pWorld, ComponentQuery::StaticFunction< void (*)(A *, B *, C *), F >() );
 	}
 }
 
@@ -19,6 +19,7 @@ WorldManager::WorldManager()
 , m_frameDeltaTickCount( 0 )
 , m_frameDeltaSeconds( 0.0f )
 , m_bProcessedFirstFrame( false )
+, m_bUpdateWorldsInParallel( false )
 {
 }
 
@@ -174,36 +175,45 @@ bool WorldManager::ReleaseWorld( World* pWorld )
 	return false;
 }
 
+/// Apply the component changes deferred during the frame and destroy all entities in a world that have been flagged
+/// for deferred destruction.
+///
+/// @param[in] pWorld  World to update.
+static void ApplyDeferredChanges( World *pWorld )
+{
+	HELIUM_ASSERT( pWorld );
+
+	// Apply component changes first so that components allocated for entities destroyed below are released with them
+	ComponentManager *pComponentManager = pWorld->GetComponentManager();
+	HELIUM_ASSERT( pComponentManager );
+	pComponentManager->ApplyDeferredChanges();
+
+	pWorld->DestroyDeferredEntities();
+}
+
 /// Update all worlds for the current frame.
 void WorldManager::Update( TaskSchedule &schedule )
 {
 	// Update the world time.
 	UpdateTime();
 	
-	Helium::TaskScheduler::ExecuteSchedule( schedule, m_worlds );
-	
-	Components::Tick();
+	Helium::TaskScheduler::ExecuteSchedule( schedule, m_worlds, m_bUpdateWorldsInParallel );
 
-	// TODO: I plan to do a "flag system" - components that are super lightweight.. like bitflags.. that carry no data
-	// but mark an object. This data would be kept parallel with slices/worlds so that they would be far faster to query
-	// than this abomination
-	for ( DynamicArray< WorldPtr >::Iterator worldIter = m_worlds.Begin(); worldIter != m_worlds.End(); ++worldIter )
-	{
-		for ( size_t sliceIndex = 0; sliceIndex < (*worldIter)->GetSliceCount(); ++sliceIndex )
-		{
-			Slice *pSlice = (*worldIter)->GetSlice( sliceIndex );
-			for ( size_t entityIndex = 0; entityIndex < pSlice->GetEntityCount(); ++entityIndex )
-			{
-				Entity *pEntity = pSlice->GetEntity( entityIndex );
-
-				if ( pEntity->IsDeferredDestroySet() )
-				{
-					// TODO: I don't like that strong pointers might be holding these references alive.. need to find a way to fix this
-					pSlice->DestroyEntity( pEntity );
-				}
-			}
-		}
-	}
+	Helium::TaskScheduler::ExecuteForEachWorld( ApplyDeferredChanges, m_worlds, m_bUpdateWorldsInParallel );
+}
+
+/// Set whether worlds are updated in parallel.
+///
+/// When enabled (and more than one world exists), each world runs through consecutive schedule tasks that declare
+/// TaskContract::RunsPerWorld() on its own worker thread, with all worlds finishing a stage before the next task
+/// starts.  Tasks that touch shared state still run once for all worlds.
+///
+/// @param[in] bUpdateWorldsInParallel  True to update worlds in parallel, false to update them in turn.
+///
+/// @see GetUpdateWorldsInParallel()
+void WorldManager::SetUpdateWorldsInParallel( bool bUpdateWorldsInParallel )
+{
+	m_bUpdateWorldsInParallel = bUpdateWorldsInParallel;
 }
 
 /// Get the singleton WorldManager instance, creating it if necessary.
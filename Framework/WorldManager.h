@@ -36,6 +36,9 @@ namespace Helium
         /// @name Updating
         //@{
         void Update( TaskSchedule &schedule );
+
+        void SetUpdateWorldsInParallel( bool bUpdateWorldsInParallel );
+        inline bool GetUpdateWorldsInParallel() const;
         //@}
 
         /// @name Timing
@@ -68,6 +71,8 @@ namespace Helium
 
         /// True if the first frame has been processed.
         bool m_bProcessedFirstFrame;
+        /// True if each world should be updated on its own worker thread during tasks that run per world.
+        bool m_bUpdateWorldsInParallel;
 
         /// Singleton instance.
         static WorldManager* sm_pInstance;
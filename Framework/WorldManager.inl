@@ -35,4 +35,15 @@ namespace Helium
     {
         return m_frameDeltaSeconds;
     }
+
+    /// Get whether worlds are updated in parallel.
+    ///
+    /// @return  True if each world is updated on its own worker thread during tasks that run per world, false if all
+    ///          worlds are updated in turn.
+    ///
+    /// @see SetUpdateWorldsInParallel()
+    bool WorldManager::GetUpdateWorldsInParallel() const
+    {
+        return m_bUpdateWorldsInParallel;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,426 @@
+#include "GraphicsPch.h"
+#include "Graphics/BoundingVolumeTree.h"
+
+using namespace Helium;
+
+/// Fraction of an object's size by which its leaf bounds are enlarged on each side.
+static const float32_t FAT_BOX_MARGIN_SCALE = 0.1f;
+/// Minimum distance by which an object's leaf bounds are enlarged on each side.
+static const float32_t FAT_BOX_MARGIN_MINIMUM = 0.1f;
+
+/// Compute the smallest box containing two boxes.
+static Simd::AaBox UnionBoxes( const Simd::AaBox& rBox0, const Simd::AaBox& rBox1 )
+{
+    const Simd::Vector3& rMinimum0 = rBox0.GetMinimum();
+    const Simd::Vector3& rMaximum0 = rBox0.GetMaximum();
+    const Simd::Vector3& rMinimum1 = rBox1.GetMinimum();
+    const Simd::Vector3& rMaximum1 = rBox1.GetMaximum();
+
+    return Simd::AaBox(
+        Simd::Vector3(
+            Min( rMinimum0.GetElement( 0 ), rMinimum1.GetElement( 0 ) ),
+            Min( rMinimum0.GetElement( 1 ), rMinimum1.GetElement( 1 ) ),
+            Min( rMinimum0.GetElement( 2 ), rMinimum1.GetElement( 2 ) ) ),
+        Simd::Vector3(
+            Max( rMaximum0.GetElement( 0 ), rMaximum1.GetElement( 0 ) ),
+            Max( rMaximum0.GetElement( 1 ), rMaximum1.GetElement( 1 ) ),
+            Max( rMaximum0.GetElement( 2 ), rMaximum1.GetElement( 2 ) ) ) );
+}
+
+/// Compute half the surface area of a box, used as the cost of a node during insertion.
+static float32_t ComputeBoxCost( const Simd::AaBox& rBox )
+{
+    const Simd::Vector3& rMinimum = rBox.GetMinimum();
+    const Simd::Vector3& rMaximum = rBox.GetMaximum();
+
+    float32_t sizeX = rMaximum.GetElement( 0 ) - rMinimum.GetElement( 0 );
+    float32_t sizeY = rMaximum.GetElement( 1 ) - rMinimum.GetElement( 1 );
+    float32_t sizeZ = rMaximum.GetElement( 2 ) - rMinimum.GetElement( 2 );
+
+    return sizeX * sizeY + sizeY * sizeZ + sizeZ * sizeX;
+}
+
+/// Get whether a box fully contains another box.
+static bool BoxContains( const Simd::AaBox& rOuter, const Simd::AaBox& rInner )
+{
+    const Simd::Vector3& rOuterMinimum = rOuter.GetMinimum();
+    const Simd::Vector3& rOuterMaximum = rOuter.GetMaximum();
+    const Simd::Vector3& rInnerMinimum = rInner.GetMinimum();
+    const Simd::Vector3& rInnerMaximum = rInner.GetMaximum();
+
+    for( size_t axis = 0; axis < 3; ++axis )
+    {
+        if( rInnerMinimum.GetElement( axis ) < rOuterMinimum.GetElement( axis ) ||
+            rInnerMaximum.GetElement( axis ) > rOuterMaximum.GetElement( axis ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Enlarge an object's bounds by a margin so that small movements stay within them.
+static Simd::AaBox FattenBox( const Simd::AaBox& rBox )
+{
+    const Simd::Vector3& rMinimum = rBox.GetMinimum();
+    const Simd::Vector3& rMaximum = rBox.GetMaximum();
+
+    float32_t margins[ 3 ];
+    for( size_t axis = 0; axis < 3; ++axis )
+    {
+        margins[ axis ] = Max(
+            ( rMaximum.GetElement( axis ) - rMinimum.GetElement( axis ) ) * FAT_BOX_MARGIN_SCALE,
+            FAT_BOX_MARGIN_MINIMUM );
+    }
+
+    return Simd::AaBox(
+        Simd::Vector3(
+            rMinimum.GetElement( 0 ) - margins[ 0 ],
+            rMinimum.GetElement( 1 ) - margins[ 1 ],
+            rMinimum.GetElement( 2 ) - margins[ 2 ] ),
+        Simd::Vector3(
+            rMaximum.GetElement( 0 ) + margins[ 0 ],
+            rMaximum.GetElement( 1 ) + margins[ 1 ],
+            rMaximum.GetElement( 2 ) + margins[ 2 ] ) );
+}
+
+/// Constructor.
+BoundingVolumeTree::BoundingVolumeTree()
+    : m_root( Invalid< uint32_t >() )
+    , m_freeList( Invalid< uint32_t >() )
+{
+}
+
+/// Destructor.
+BoundingVolumeTree::~BoundingVolumeTree()
+{
+}
+
+/// Add an object to the tree.
+///
+/// @param[in] rBox      World-space bounds of the object.
+/// @param[in] objectId  ID of the object, passed back by queries.
+///
+/// @return  Proxy ID used to move or remove the object.
+///
+/// @see Remove(), Move()
+uint32_t BoundingVolumeTree::Insert( const Simd::AaBox& rBox, size_t objectId )
+{
+    uint32_t leafIndex = AllocateNode();
+
+    Node& rLeaf = m_nodes[ leafIndex ];
+    rLeaf.box = FattenBox( rBox );
+    rLeaf.objectId = objectId;
+    rLeaf.height = 0;
+
+    InsertLeaf( leafIndex );
+
+    return leafIndex;
+}
+
+/// Remove an object from the tree.
+///
+/// @param[in] proxyId  Proxy ID returned by Insert().
+///
+/// @see Insert()
+void BoundingVolumeTree::Remove( uint32_t proxyId )
+{
+    HELIUM_ASSERT( proxyId < m_nodes.GetSize() );
+    HELIUM_ASSERT( m_nodes[ proxyId ].IsLeaf() );
+
+    RemoveLeaf( proxyId );
+    FreeNode( proxyId );
+}
+
+/// Update the bounds of an object in the tree.
+///
+/// The object is only reinserted if its new bounds are no longer contained by the enlarged bounds stored in the tree.
+///
+/// @param[in] proxyId  Proxy ID returned by Insert().
+/// @param[in] rBox     New world-space bounds of the object.
+///
+/// @return  True if the object had to be reinserted, false if its stored bounds still contain it.
+///
+/// @see Insert()
+bool BoundingVolumeTree::Move( uint32_t proxyId, const Simd::AaBox& rBox )
+{
+    HELIUM_ASSERT( proxyId < m_nodes.GetSize() );
+    HELIUM_ASSERT( m_nodes[ proxyId ].IsLeaf() );
+
+    if( BoxContains( m_nodes[ proxyId ].box, rBox ) )
+    {
+        return false;
+    }
+
+    RemoveLeaf( proxyId );
+    m_nodes[ proxyId ].box = FattenBox( rBox );
+    InsertLeaf( proxyId );
+
+    return true;
+}
+
+/// Remove all objects from the tree.
+void BoundingVolumeTree::Clear()
+{
+    m_nodes.Resize( 0 );
+    SetInvalid( m_root );
+    SetInvalid( m_freeList );
+}
+
+/// Allocate a node, reusing a free node if possible.
+///
+/// Note that this can reallocate the node array, invalidating any references to existing nodes.
+///
+/// @return  Index of the allocated node.
+uint32_t BoundingVolumeTree::AllocateNode()
+{
+    uint32_t nodeIndex = m_freeList;
+    if( IsValid( nodeIndex ) )
+    {
+        m_freeList = m_nodes[ nodeIndex ].parent;
+    }
+    else
+    {
+        nodeIndex = static_cast< uint32_t >( m_nodes.GetSize() );
+        HELIUM_VERIFY( m_nodes.New() );
+    }
+
+    Node& rNode = m_nodes[ nodeIndex ];
+    SetInvalid( rNode.objectId );
+    SetInvalid( rNode.parent );
+    SetInvalid( rNode.children[ 0 ] );
+    SetInvalid( rNode.children[ 1 ] );
+    rNode.height = 0;
+
+    return nodeIndex;
+}
+
+/// Return a node to the free list.
+///
+/// @param[in] nodeIndex  Index of the node to free.
+void BoundingVolumeTree::FreeNode( uint32_t nodeIndex )
+{
+    HELIUM_ASSERT( nodeIndex < m_nodes.GetSize() );
+
+    Node& rNode = m_nodes[ nodeIndex ];
+    rNode.parent = m_freeList;
+    SetInvalid( rNode.height );
+    m_freeList = nodeIndex;
+}
+
+/// Insert a leaf into the tree next to the sibling that grows the tree's surface area the least.
+///
+/// @param[in] leafIndex  Index of the leaf node to insert.
+void BoundingVolumeTree::InsertLeaf( uint32_t leafIndex )
+{
+    if( IsInvalid( m_root ) )
+    {
+        m_root = leafIndex;
+        SetInvalid( m_nodes[ leafIndex ].parent );
+
+        return;
+    }
+
+    // Walk down the tree, choosing the child where the leaf increases the cost of the tree the least, until
+    // descending would cost more than pairing the leaf with the current node.
+    Simd::AaBox leafBox = m_nodes[ leafIndex ].box;
+
+    uint32_t siblingIndex = m_root;
+    while( !m_nodes[ siblingIndex ].IsLeaf() )
+    {
+        const Node& rNode = m_nodes[ siblingIndex ];
+
+        float32_t nodeCost = ComputeBoxCost( rNode.box );
+        float32_t combinedCost = ComputeBoxCost( UnionBoxes( rNode.box, leafBox ) );
+
+        // Cost of creating a new parent for this node and the leaf.
+        float32_t pairCost = 2.0f * combinedCost;
+
+        // Minimum cost of pushing the leaf further down the tree.
+        float32_t inheritanceCost = 2.0f * ( combinedCost - nodeCost );
+
+        float32_t childCosts[ 2 ];
+        for( size_t childIndex = 0; childIndex < 2; ++childIndex )
+        {
+            const Node& rChild = m_nodes[ rNode.children[ childIndex ] ];
+            float32_t childCombinedCost = ComputeBoxCost( UnionBoxes( rChild.box, leafBox ) );
+            if( !rChild.IsLeaf() )
+            {
+                childCombinedCost -= ComputeBoxCost( rChild.box );
+            }
+
+            childCosts[ childIndex ] = childCombinedCost + inheritanceCost;
+        }
+
+        if( pairCost < childCosts[ 0 ] && pairCost < childCosts[ 1 ] )
+        {
+            break;
+        }
+
+        siblingIndex = rNode.children[ childCosts[ 0 ] < childCosts[ 1 ] ? 0 : 1 ];
+    }
+
+    // Create a new parent for the sibling and the leaf.
+    uint32_t oldParentIndex = m_nodes[ siblingIndex ].parent;
+    uint32_t newParentIndex = AllocateNode();
+
+    Node& rNewParent = m_nodes[ newParentIndex ];
+    rNewParent.parent = oldParentIndex;
+    rNewParent.box = UnionBoxes( leafBox, m_nodes[ siblingIndex ].box );
+    rNewParent.height = m_nodes[ siblingIndex ].height + 1;
+    rNewParent.children[ 0 ] = siblingIndex;
+    rNewParent.children[ 1 ] = leafIndex;
+
+    m_nodes[ siblingIndex ].parent = newParentIndex;
+    m_nodes[ leafIndex ].parent = newParentIndex;
+
+    if( IsValid( oldParentIndex ) )
+    {
+        Node& rOldParent = m_nodes[ oldParentIndex ];
+        rOldParent.children[ rOldParent.children[ 0 ] == siblingIndex ? 0 : 1 ] = newParentIndex;
+    }
+    else
+    {
+        m_root = newParentIndex;
+    }
+
+    // Walk back up the tree, rebalancing and fixing up the bounds and heights of each ancestor.
+    Refit( m_nodes[ leafIndex ].parent );
+}
+
+/// Remove a leaf from the tree, replacing its parent with its sibling.
+///
+/// @param[in] leafIndex  Index of the leaf node to remove.
+void BoundingVolumeTree::RemoveLeaf( uint32_t leafIndex )
+{
+    if( leafIndex == m_root )
+    {
+        SetInvalid( m_root );
+
+        return;
+    }
+
+    uint32_t parentIndex = m_nodes[ leafIndex ].parent;
+    HELIUM_ASSERT( IsValid( parentIndex ) );
+
+    const Node& rParent = m_nodes[ parentIndex ];
+    uint32_t grandParentIndex = rParent.parent;
+    uint32_t siblingIndex = rParent.children[ rParent.children[ 0 ] == leafIndex ? 1 : 0 ];
+
+    m_nodes[ siblingIndex ].parent = grandParentIndex;
+
+    if( IsValid( grandParentIndex ) )
+    {
+        Node& rGrandParent = m_nodes[ grandParentIndex ];
+        rGrandParent.children[ rGrandParent.children[ 0 ] == parentIndex ? 0 : 1 ] = siblingIndex;
+    }
+    else
+    {
+        m_root = siblingIndex;
+    }
+
+    FreeNode( parentIndex );
+    SetInvalid( m_nodes[ leafIndex ].parent );
+
+    Refit( grandParentIndex );
+}
+
+/// Rebalance a node and each of its ancestors, updating their bounds and heights.
+///
+/// @param[in] nodeIndex  Index of the first node to refit (can be invalid).
+void BoundingVolumeTree::Refit( uint32_t nodeIndex )
+{
+    while( IsValid( nodeIndex ) )
+    {
+        nodeIndex = Balance( nodeIndex );
+
+        Node& rNode = m_nodes[ nodeIndex ];
+        const Node& rChild0 = m_nodes[ rNode.children[ 0 ] ];
+        const Node& rChild1 = m_nodes[ rNode.children[ 1 ] ];
+
+        rNode.box = UnionBoxes( rChild0.box, rChild1.box );
+        rNode.height = Max( rChild0.height, rChild1.height ) + 1;
+
+        nodeIndex = rNode.parent;
+    }
+}
+
+/// Rotate the taller child of a node up if the heights of the node's children differ by more than one.
+///
+/// @param[in] nodeIndex  Index of the node to balance.
+///
+/// @return  Index of the node now in the place of the given node.
+uint32_t BoundingVolumeTree::Balance( uint32_t nodeIndex )
+{
+    HELIUM_ASSERT( nodeIndex < m_nodes.GetSize() );
+
+    Node& rNode = m_nodes[ nodeIndex ];
+    if( rNode.IsLeaf() || rNode.height < 2 )
+    {
+        return nodeIndex;
+    }
+
+    uint32_t childIndices[ 2 ] = { rNode.children[ 0 ], rNode.children[ 1 ] };
+    uint32_t childHeights[ 2 ] = { m_nodes[ childIndices[ 0 ] ].height, m_nodes[ childIndices[ 1 ] ].height };
+
+    // Find the child to rotate up, if any.
+    size_t tallIndex;
+    if( childHeights[ 1 ] > childHeights[ 0 ] + 1 )
+    {
+        tallIndex = 1;
+    }
+    else if( childHeights[ 0 ] > childHeights[ 1 ] + 1 )
+    {
+        tallIndex = 0;
+    }
+    else
+    {
+        return nodeIndex;
+    }
+
+    size_t shortIndex = 1 - tallIndex;
+    uint32_t tallChildIndex = childIndices[ tallIndex ];
+    Node& rTallChild = m_nodes[ tallChildIndex ];
+    HELIUM_ASSERT( !rTallChild.IsLeaf() );
+
+    // The tall child takes the place of the node, which becomes one of the tall child's children.
+    rTallChild.parent = rNode.parent;
+    rNode.parent = tallChildIndex;
+
+    if( IsValid( rTallChild.parent ) )
+    {
+        Node& rParent = m_nodes[ rTallChild.parent ];
+        rParent.children[ rParent.children[ 0 ] == nodeIndex ? 0 : 1 ] = tallChildIndex;
+    }
+    else
+    {
+        m_root = tallChildIndex;
+    }
+
+    // The taller grandchild stays with the tall child, and the shorter one moves to the node.
+    uint32_t grandChildIndices[ 2 ] = { rTallChild.children[ 0 ], rTallChild.children[ 1 ] };
+    Node& rGrandChild0 = m_nodes[ grandChildIndices[ 0 ] ];
+    Node& rGrandChild1 = m_nodes[ grandChildIndices[ 1 ] ];
+
+    size_t keepIndex = ( rGrandChild0.height > rGrandChild1.height ? 0 : 1 );
+    uint32_t keptIndex = grandChildIndices[ keepIndex ];
+    uint32_t movedIndex = grandChildIndices[ 1 - keepIndex ];
+    Node& rKept = m_nodes[ keptIndex ];
+    Node& rMoved = m_nodes[ movedIndex ];
+
+    rTallChild.children[ 0 ] = nodeIndex;
+    rTallChild.children[ 1 ] = keptIndex;
+
+    rNode.children[ tallIndex ] = movedIndex;
+    rMoved.parent = nodeIndex;
+
+    const Node& rShortChild = m_nodes[ childIndices[ shortIndex ] ];
+    rNode.box = UnionBoxes( rShortChild.box, rMoved.box );
+    rNode.height = Max( rShortChild.height, rMoved.height ) + 1;
+
+    rTallChild.box = UnionBoxes( rNode.box, rKept.box );
+    rTallChild.height = Max( rNode.height, rKept.height ) + 1;
+
+    return tallChildIndex;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/AaBox.h"
+#include "MathSimd/Frustum.h"
+
+namespace Helium
+{
+    /// Dynamic bounding volume hierarchy of axis-aligned boxes, used for visibility culling of graphics scene objects.
+    ///
+    /// Each object is stored in a leaf whose box is enlarged by a margin, so objects that move by small amounts do not
+    /// need to be reinserted.  Leaves are inserted next to the sibling that grows the tree's surface area the least,
+    /// and the tree is rebalanced with rotations on the way back up, so the cost of a query is proportional to the
+    /// number of objects it finds rather than the number of objects in the tree.
+    class HELIUM_GRAPHICS_API BoundingVolumeTree
+    {
+    public:
+        /// @name Construction/Destruction
+        //@{
+        BoundingVolumeTree();
+        ~BoundingVolumeTree();
+        //@}
+
+        /// @name Object Management
+        //@{
+        uint32_t Insert( const Simd::AaBox& rBox, size_t objectId );
+        void Remove( uint32_t proxyId );
+        bool Move( uint32_t proxyId, const Simd::AaBox& rBox );
+        void Clear();
+
+        inline size_t GetObjectId( uint32_t proxyId ) const;
+        inline const Simd::AaBox& GetFatBox( uint32_t proxyId ) const;
+        inline uint32_t GetHeight() const;
+        //@}
+
+        /// @name Queries
+        //@{
+        template< typename Function > void Query( const Simd::Frustum& rFrustum, Function function );
+        //@}
+
+    private:
+        /// Tree node.
+        struct Node
+        {
+            /// Bounds of this node (enlarged bounds of the object for leaves).
+            Simd::AaBox box;
+            /// ID of the object stored in this leaf (invalid for internal nodes).
+            size_t objectId;
+            /// Parent node index, or the next free node index for nodes in the free list.
+            uint32_t parent;
+            /// Child node indices (invalid for leaves).
+            uint32_t children[ 2 ];
+            /// Height of this node above its deepest leaf (leaves have height 0, free nodes have an invalid height).
+            uint32_t height;
+
+            inline bool IsLeaf() const;
+        };
+
+        /// Tree nodes, including free nodes.
+        DynamicArray< Node > m_nodes;
+        /// Node traversal stack used during queries.
+        DynamicArray< uint32_t > m_traversalStack;
+        /// Root node index.
+        uint32_t m_root;
+        /// First node in the free node list.
+        uint32_t m_freeList;
+
+        /// @name Private Utility Functions
+        //@{
+        uint32_t AllocateNode();
+        void FreeNode( uint32_t nodeIndex );
+
+        void InsertLeaf( uint32_t leafIndex );
+        void RemoveLeaf( uint32_t leafIndex );
+        void Refit( uint32_t nodeIndex );
+        uint32_t Balance( uint32_t nodeIndex );
+        //@}
+    };
+}
+
+#include "Graphics/BoundingVolumeTree.inl"
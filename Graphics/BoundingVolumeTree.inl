@@ -0,0 +1,87 @@
+namespace Helium
+{
+    /// Get the ID of the object stored for a given proxy.
+    ///
+    /// @param[in] proxyId  Proxy ID returned by Insert().
+    ///
+    /// @return  Object ID.
+    size_t BoundingVolumeTree::GetObjectId( uint32_t proxyId ) const
+    {
+        HELIUM_ASSERT( proxyId < m_nodes.GetSize() );
+        HELIUM_ASSERT( m_nodes[ proxyId ].IsLeaf() );
+
+        return m_nodes[ proxyId ].objectId;
+    }
+
+    /// Get the enlarged bounding box stored for a given proxy.
+    ///
+    /// @param[in] proxyId  Proxy ID returned by Insert().
+    ///
+    /// @return  Enlarged bounding box.
+    ///
+    /// @see Move()
+    const Simd::AaBox& BoundingVolumeTree::GetFatBox( uint32_t proxyId ) const
+    {
+        HELIUM_ASSERT( proxyId < m_nodes.GetSize() );
+        HELIUM_ASSERT( m_nodes[ proxyId ].IsLeaf() );
+
+        return m_nodes[ proxyId ].box;
+    }
+
+    /// Get the height of the tree.
+    ///
+    /// @return  Number of levels below the root node, or zero if the tree is empty.
+    uint32_t BoundingVolumeTree::GetHeight() const
+    {
+        return ( IsValid( m_root ) ? m_nodes[ m_root ].height : 0 );
+    }
+
+    /// Call a function for each object whose enlarged bounds intersect a frustum.
+    ///
+    /// Subtrees whose bounds are outside the frustum are skipped without visiting their objects.  Since leaf bounds
+    /// are enlarged, the function should test the object's own bounds if it needs an exact result.
+    ///
+    /// @param[in] rFrustum  Frustum to test.
+    /// @param[in] function  Function to call with the ID of each object found.
+    template< typename Function >
+    void BoundingVolumeTree::Query( const Simd::Frustum& rFrustum, Function function )
+    {
+        if( IsInvalid( m_root ) )
+        {
+            return;
+        }
+
+        m_traversalStack.Resize( 0 );
+        m_traversalStack.Push( m_root );
+
+        while( !m_traversalStack.IsEmpty() )
+        {
+            uint32_t nodeIndex = m_traversalStack.GetLast();
+            m_traversalStack.Pop();
+
+            const Node& rNode = m_nodes[ nodeIndex ];
+            if( !rFrustum.Intersects( rNode.box ) )
+            {
+                continue;
+            }
+
+            if( rNode.IsLeaf() )
+            {
+                function( rNode.objectId );
+            }
+            else
+            {
+                m_traversalStack.Push( rNode.children[ 0 ] );
+                m_traversalStack.Push( rNode.children[ 1 ] );
+            }
+        }
+    }
+
+    /// Get whether this node is a leaf.
+    ///
+    /// @return  True if this node stores an object, false if it is an internal node.
+    bool BoundingVolumeTree::Node::IsLeaf() const
+    {
+        return IsInvalid( children[ 0 ] );
+    }
+}
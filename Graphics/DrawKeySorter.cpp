@@ -0,0 +1,177 @@
+#include "GraphicsPch.h"
+#include "Graphics/DrawKeySorter.h"
+
+using namespace Helium;
+
+/// Number of key bits sorted in each radix sort pass.
+static const uint32_t RADIX_BITS = 8;
+/// Number of buckets in each radix sort pass.
+static const size_t RADIX_SIZE = static_cast< size_t >( 1 ) << RADIX_BITS;
+/// Number of radix sort passes needed to cover an entire key.
+static const uint32_t RADIX_PASS_COUNT = 64 / RADIX_BITS;
+
+/// Number of key bits used for the render pass.
+static const uint32_t KEY_PASS_BITS = 2;
+
+/// Number of depth key bits used for the depth bucket.
+static const uint32_t DEPTH_KEY_DEPTH_BITS = 24;
+/// Number of depth key bits used for the shader ID.
+static const uint32_t DEPTH_KEY_SHADER_BITS = 14;
+/// Number of depth key bits used for the mesh ID.
+static const uint32_t DEPTH_KEY_MESH_BITS = 24;
+
+/// Number of state key bits used for the shader ID.
+static const uint32_t STATE_KEY_SHADER_BITS = 16;
+/// Number of state key bits used for the material ID.
+static const uint32_t STATE_KEY_MATERIAL_BITS = 24;
+/// Number of state key bits used for the mesh ID.
+static const uint32_t STATE_KEY_MESH_BITS = 22;
+
+HELIUM_COMPILE_ASSERT( 64 % RADIX_BITS == 0 );
+HELIUM_COMPILE_ASSERT( DrawKeySorter::PASS_MAX <= ( 1 << KEY_PASS_BITS ) );
+HELIUM_COMPILE_ASSERT( KEY_PASS_BITS + DEPTH_KEY_DEPTH_BITS + DEPTH_KEY_SHADER_BITS + DEPTH_KEY_MESH_BITS == 64 );
+HELIUM_COMPILE_ASSERT( KEY_PASS_BITS + STATE_KEY_SHADER_BITS + STATE_KEY_MATERIAL_BITS + STATE_KEY_MESH_BITS == 64 );
+
+/// Get the lowest bits of a key field value.
+///
+/// Values too large for the field wrap around.  Fields only serve to group draws sharing the same state, so this
+/// only makes the grouping less effective for the draws affected.  Callers should remap IDs to dense indices so that
+/// they fit.
+///
+/// @param[in] value  Field value.
+/// @param[in] bits   Number of bits in the field.
+///
+/// @return  Field value masked to the field size.
+static uint64_t MaskKeyField( uint32_t value, uint32_t bits )
+{
+    return static_cast< uint64_t >( value ) & ( ( static_cast< uint64_t >( 1 ) << bits ) - 1 );
+}
+
+/// Constructor.
+DrawKeySorter::DrawKeySorter()
+{
+}
+
+/// Destructor.
+DrawKeySorter::~DrawKeySorter()
+{
+}
+
+/// Sort the draws in the list by key, in ascending order.
+///
+/// @see Add(), GetIndex()
+void DrawKeySorter::Sort()
+{
+    size_t entryCount = m_entries.GetSize();
+    if( entryCount < 2 )
+    {
+        return;
+    }
+
+    // Count the keys using each value of each digit in a single pass over the keys.
+    size_t bucketOffsets[ RADIX_PASS_COUNT ][ RADIX_SIZE ];
+    MemoryZero( bucketOffsets, sizeof( bucketOffsets ) );
+
+    const Entry* pEntries = m_entries.GetData();
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        uint64_t key = pEntries[ entryIndex ].key;
+        for( uint32_t passIndex = 0; passIndex < RADIX_PASS_COUNT; ++passIndex )
+        {
+            ++bucketOffsets[ passIndex ][ ( key >> ( passIndex * RADIX_BITS ) ) & ( RADIX_SIZE - 1 ) ];
+        }
+    }
+
+    // Scatter the entries by each digit in turn, from the least significant digit up.  Since each pass is stable,
+    // entries end up ordered by the full key.
+    m_sortBuffer.Resize( entryCount );
+
+    Entry* pSource = m_entries.GetData();
+    Entry* pDest = m_sortBuffer.GetData();
+
+    for( uint32_t passIndex = 0; passIndex < RADIX_PASS_COUNT; ++passIndex )
+    {
+        uint32_t shift = passIndex * RADIX_BITS;
+        size_t* pBucketOffsets = bucketOffsets[ passIndex ];
+
+        // Skip digits that are the same for every key.
+        if( pBucketOffsets[ ( pSource[ 0 ].key >> shift ) & ( RADIX_SIZE - 1 ) ] == entryCount )
+        {
+            continue;
+        }
+
+        size_t offset = 0;
+        for( size_t bucketIndex = 0; bucketIndex < RADIX_SIZE; ++bucketIndex )
+        {
+            size_t bucketCount = pBucketOffsets[ bucketIndex ];
+            pBucketOffsets[ bucketIndex ] = offset;
+            offset += bucketCount;
+        }
+
+        for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+        {
+            const Entry& rEntry = pSource[ entryIndex ];
+            pDest[ pBucketOffsets[ ( rEntry.key >> shift ) & ( RADIX_SIZE - 1 ) ]++ ] = rEntry;
+        }
+
+        Entry* pSwap = pSource;
+        pSource = pDest;
+        pDest = pSwap;
+    }
+
+    if( pSource != m_entries.GetData() )
+    {
+        MemoryCopy( m_entries.GetData(), pSource, entryCount * sizeof( Entry ) );
+    }
+}
+
+/// Create a key for sorting draws front to back.
+///
+/// Draws are ordered by depth first, then grouped by shader and mesh within each depth bucket.
+///
+/// @param[in] pass      Render pass.
+/// @param[in] depth     Distance of the draw along the view direction (any finite value).
+/// @param[in] shaderId  ID of the shader used to draw.
+/// @param[in] meshId    ID of the mesh (vertex and index buffer set) used to draw.
+///
+/// @return  Sort key.
+///
+/// @see MakeStateKey()
+uint64_t DrawKeySorter::MakeDepthKey( EPass pass, float32_t depth, uint32_t shaderId, uint32_t meshId )
+{
+    HELIUM_ASSERT( static_cast< uint32_t >( pass ) < PASS_MAX );
+
+    // Flip the bits of the depth value so it can be ordered as an unsigned integer (negative values have all bits
+    // flipped, positive values only the sign bit), then keep the highest bits as the depth bucket.
+    uint32_t depthBits;
+    MemoryCopy( &depthBits, &depth, sizeof( depthBits ) );
+    depthBits = ( depthBits & 0x80000000 ? ~depthBits : depthBits | 0x80000000 );
+    depthBits >>= 32 - DEPTH_KEY_DEPTH_BITS;
+
+    return ( static_cast< uint64_t >( pass ) << ( 64 - KEY_PASS_BITS ) ) |
+        ( MaskKeyField( depthBits, DEPTH_KEY_DEPTH_BITS ) << ( DEPTH_KEY_SHADER_BITS + DEPTH_KEY_MESH_BITS ) ) |
+        ( MaskKeyField( shaderId, DEPTH_KEY_SHADER_BITS ) << DEPTH_KEY_MESH_BITS ) |
+        MaskKeyField( meshId, DEPTH_KEY_MESH_BITS );
+}
+
+/// Create a key for sorting draws by render state.
+///
+/// Draws are grouped by shader first, then by material, then by mesh.
+///
+/// @param[in] pass        Render pass.
+/// @param[in] shaderId    ID of the shader used to draw (up to 16 bits).
+/// @param[in] materialId  ID of the material used to draw (up to 24 bits).
+/// @param[in] meshId      ID of the mesh (vertex and index buffer set) used to draw.
+///
+/// @return  Sort key.
+///
+/// @see MakeDepthKey()
+uint64_t DrawKeySorter::MakeStateKey( EPass pass, uint32_t shaderId, uint32_t materialId, uint32_t meshId )
+{
+    HELIUM_ASSERT( static_cast< uint32_t >( pass ) < PASS_MAX );
+
+    return ( static_cast< uint64_t >( pass ) << ( 64 - KEY_PASS_BITS ) ) |
+        ( MaskKeyField( shaderId, STATE_KEY_SHADER_BITS ) << ( STATE_KEY_MATERIAL_BITS + STATE_KEY_MESH_BITS ) ) |
+        ( MaskKeyField( materialId, STATE_KEY_MATERIAL_BITS ) << STATE_KEY_MESH_BITS ) |
+        MaskKeyField( meshId, STATE_KEY_MESH_BITS );
+}
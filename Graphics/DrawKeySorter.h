@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    /// Sorter for lists of draw calls identified by 64-bit sort keys.
+    ///
+    /// Each draw is added with a key packing the render pass and the state it should be grouped by, then the list is
+    /// sorted with a least-significant-digit radix sort.  Sorting takes a fixed number of linear passes over the
+    /// key/index pairs, and passes over digits that are the same for every key are skipped.  Draws with equal keys
+    /// keep the order in which they were added.
+    class HELIUM_GRAPHICS_API DrawKeySorter
+    {
+    public:
+        /// Render passes (stored in the highest bits of each key).
+        enum EPass
+        {
+            PASS_SHADOW_DEPTH,
+            PASS_DEPTH_PRE_PASS,
+            PASS_BASE,
+
+            PASS_MAX
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        DrawKeySorter();
+        ~DrawKeySorter();
+        //@}
+
+        /// @name Sorting
+        //@{
+        inline void Clear();
+        inline void Add( uint64_t key, size_t index );
+        void Sort();
+
+        inline size_t GetSize() const;
+        inline size_t GetIndex( size_t entryIndex ) const;
+        //@}
+
+        /// @name Key Creation
+        //@{
+        static uint64_t MakeDepthKey( EPass pass, float32_t depth, uint32_t shaderId, uint32_t meshId );
+        static uint64_t MakeStateKey( EPass pass, uint32_t shaderId, uint32_t materialId, uint32_t meshId );
+        //@}
+
+    private:
+        /// Key/index pair.
+        struct Entry
+        {
+            /// Sort key.
+            uint64_t key;
+            /// Index of the draw in the caller's list.
+            size_t index;
+        };
+
+        /// Draw entries to sort.
+        DynamicArray< Entry > m_entries;
+        /// Scratch buffer for radix sort passes.
+        DynamicArray< Entry > m_sortBuffer;
+    };
+}
+
+#include "Graphics/DrawKeySorter.inl"
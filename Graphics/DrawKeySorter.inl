@@ -0,0 +1,50 @@
+namespace Helium
+{
+    /// Remove all draws from the list to sort.
+    ///
+    /// Allocated memory is kept for reuse.
+    ///
+    /// @see Add()
+    void DrawKeySorter::Clear()
+    {
+        m_entries.Resize( 0 );
+    }
+
+    /// Add a draw to the list to sort.
+    ///
+    /// @param[in] key    Sort key (typically created using MakeDepthKey() or MakeStateKey()).
+    /// @param[in] index  Index of the draw in the caller's list.
+    ///
+    /// @see Clear(), Sort()
+    void DrawKeySorter::Add( uint64_t key, size_t index )
+    {
+        Entry entry;
+        entry.key = key;
+        entry.index = index;
+        m_entries.Push( entry );
+    }
+
+    /// Get the number of draws in the list.
+    ///
+    /// @return  Draw count.
+    ///
+    /// @see GetIndex()
+    size_t DrawKeySorter::GetSize() const
+    {
+        return m_entries.GetSize();
+    }
+
+    /// Get the caller's index of a draw in the list.
+    ///
+    /// @param[in] entryIndex  Position of the draw in the list (in sorted order after Sort() is called).
+    ///
+    /// @return  Index given when the draw was added.
+    ///
+    /// @see GetSize()
+    size_t DrawKeySorter::GetIndex( size_t entryIndex ) const
+    {
+        HELIUM_ASSERT( entryIndex < m_entries.GetSize() );
+
+        return m_entries[ entryIndex ].index;
+    }
+}
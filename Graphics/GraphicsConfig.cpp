@@ -17,6 +17,9 @@ GraphicsConfig::GraphicsConfig()
 , m_maxAnisotropy( 0 )
 , m_shadowMode( EShadowMode::PCF_DITHERED )
 , m_shadowBufferSize( DEFAULT_SHADOW_BUFFER_SIZE )
+, m_shadowCascadeCount( DEFAULT_SHADOW_CASCADE_COUNT )
+, m_shadowCascadeSplitLambda( 0.75f )
+, m_shadowCascadeCacheStart( DEFAULT_SHADOW_CASCADE_CACHE_START )
 , m_bFullscreen( false )
 , m_bVsync( true )
 {
@@ -37,4 +40,7 @@ void GraphicsConfig::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &GraphicsConfig::m_maxAnisotropy, TXT( "m_MaxAnisotropy" ) );
     comp.AddField( &GraphicsConfig::m_shadowMode, TXT( "m_ShadowMode" ) );
     comp.AddField( &GraphicsConfig::m_shadowBufferSize, TXT( "m_ShadowBufferSize" ) );
+    comp.AddField( &GraphicsConfig::m_shadowCascadeCount, TXT( "m_ShadowCascadeCount" ) );
+    comp.AddField( &GraphicsConfig::m_shadowCascadeSplitLambda, TXT( "m_ShadowCascadeSplitLambda" ) );
+    comp.AddField( &GraphicsConfig::m_shadowCascadeCacheStart, TXT( "m_ShadowCascadeCacheStart" ) );
 }
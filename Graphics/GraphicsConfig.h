@@ -41,6 +41,7 @@ namespace Helium
                 NONE,
                 SIMPLE,
                 PCF_DITHERED,
+                CASCADED,
                 MAX,
             };
 
@@ -51,6 +52,7 @@ namespace Helium
                 info.AddElement( NONE,          TXT( "NONE" ) );
                 info.AddElement( SIMPLE,        TXT( "SIMPLE" ) );
                 info.AddElement( PCF_DITHERED,  TXT( "PCF_DITHERED" ) );
+                info.AddElement( CASCADED,      TXT( "CASCADED" ) );
             }
         };
 
@@ -62,6 +64,13 @@ namespace Helium
         /// Default shadow buffer size.
         static const uint32_t DEFAULT_SHADOW_BUFFER_SIZE = 1024;
 
+        /// Maximum number of shadow cascades.
+        static const uint32_t MAX_SHADOW_CASCADE_COUNT = 4;
+        /// Default number of shadow cascades.
+        static const uint32_t DEFAULT_SHADOW_CASCADE_COUNT = 4;
+        /// Default index of the first shadow cascade whose depth is kept between frames.
+        static const uint32_t DEFAULT_SHADOW_CASCADE_CACHE_START = 2;
+
         /// @name Construction/Destruction
         //@{
         GraphicsConfig();
@@ -80,6 +89,9 @@ namespace Helium
 
         inline EShadowMode GetShadowMode() const;
         inline uint32_t GetShadowBufferSize() const;
+        inline uint32_t GetShadowCascadeCount() const;
+        inline float32_t GetShadowCascadeSplitLambda() const;
+        inline uint32_t GetShadowCascadeCacheStart() const;
 
         inline bool GetFullscreen() const;
         inline bool GetVsync() const;
@@ -100,6 +112,13 @@ namespace Helium
         EShadowMode m_shadowMode;
         /// Shadow buffer size (width/height, in texels).
         uint32_t m_shadowBufferSize;
+        /// Number of shadow cascades used in cascaded shadow mode (all cascades share the shadow buffer).
+        uint32_t m_shadowCascadeCount;
+        /// Blend between uniform (0) and logarithmic (1) placement of shadow cascade splits.
+        float32_t m_shadowCascadeSplitLambda;
+        /// Index of the first shadow cascade whose depth is kept between frames, only being re-rendered when the
+        /// light or the geometry inside it changes.
+        uint32_t m_shadowCascadeCacheStart;
 
         /// True to run in fullscreen mode, false to run in windowed mode.
         bool m_bFullscreen;
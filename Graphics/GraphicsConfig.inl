@@ -52,6 +52,36 @@ namespace Helium
         return m_shadowBufferSize;
     }
 
+    /// Get the number of shadow cascades to use in cascaded shadow mode.
+    ///
+    /// @return  Shadow cascade count.
+    ///
+    /// @see GetShadowCascadeSplitLambda(), GetShadowCascadeCacheStart()
+    uint32_t GraphicsConfig::GetShadowCascadeCount() const
+    {
+        return m_shadowCascadeCount;
+    }
+
+    /// Get the weight used to blend between uniform and logarithmic placement of shadow cascade splits.
+    ///
+    /// @return  Shadow cascade split weight, from 0 (uniform) to 1 (logarithmic).
+    ///
+    /// @see GetShadowCascadeCount()
+    float32_t GraphicsConfig::GetShadowCascadeSplitLambda() const
+    {
+        return m_shadowCascadeSplitLambda;
+    }
+
+    /// Get the index of the first shadow cascade whose depth is kept between frames.
+    ///
+    /// @return  Index of the first cached shadow cascade.
+    ///
+    /// @see GetShadowCascadeCount()
+    uint32_t GraphicsConfig::GetShadowCascadeCacheStart() const
+    {
+        return m_shadowCascadeCacheStart;
+    }
+
     /// Get whether fullscreen mode is enabled.
     ///
     /// @return  True if fullscreen mode is enabled, false if not.
@@ -4,7 +4,7 @@
 #include "MathSimd/Plane.h"
 #include "MathSimd/Vector3Soa.h"
 #include "MathSimd/VectorConversion.h"
-#include "EngineJobs/EngineJobsInterface.h"
+#include "Engine/JobManager.h"
 #include "Rendering/RConstantBuffer.h"
 #include "Rendering/RIndexBuffer.h"
 #include "Rendering/RPixelShader.h"
@@ -37,11 +37,69 @@ HELIUM_DEFINE_COMPONENT(Helium::SceneObjectTransform, 32);
 static const size_t SCENE_VIEW_BUFFERED_DRAWER_POOL_BLOCK_SIZE = 4;
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
+/// Shadow projection size scale for cached shadow cascades (the extra room lets the view move before the cascade
+/// needs to be rendered again).
+static const float32_t SHADOW_CASCADE_CACHE_MARGIN = 1.25f;
+
+/// Get the dense sort index assigned to a key, assigning the next free index if the key has not been seen yet.
+///
+/// @param[in] rIndexMap  Map of keys to the sort indices assigned so far.
+/// @param[in] key        Key for which to get the sort index.
+///
+/// @return  Sort index (starting at one).
+template< typename KeyType >
+static uint32_t GetDenseSortIndex( HashMap< KeyType, uint32_t >& rIndexMap, KeyType key )
+{
+    typename HashMap< KeyType, uint32_t >::Iterator indexIterator = rIndexMap.Find( key );
+    if( indexIterator != rIndexMap.End() )
+    {
+        return indexIterator->Second();
+    }
+
+    uint32_t index = static_cast< uint32_t >( rIndexMap.GetSize() + 1 );
+    HELIUM_VERIFY( rIndexMap.Insert( indexIterator, KeyValue< KeyType, uint32_t >( key, index ) ) );
+
+    return index;
+}
+
 namespace Helium
 {
     HELIUM_DECLARE_RPTR( RRenderCommandProxy );
 }
 
+namespace
+{
+    /// Scene object tree query function adding the ID of each scene object found to a list.
+    class SceneObjectIdCollector
+    {
+    public:
+        explicit SceneObjectIdCollector( DynamicArray< size_t >& rSceneObjectIds )
+            : m_rSceneObjectIds( rSceneObjectIds )
+        {
+        }
+
+        void operator()( size_t sceneObjectId ) const
+        {
+            m_rSceneObjectIds.Push( sceneObjectId );
+        }
+
+    private:
+        DynamicArray< size_t >& m_rSceneObjectIds;
+    };
+
+    /// Get the number of rows and columns of tiles into which the shadow depth texture is split for shadow cascades.
+    ///
+    /// @param[in] cascadeCount  Number of shadow cascades in use.
+    ///
+    /// @return  Shadow depth texture tile grid size.
+    uint32_t GetShadowCascadeTileGridSize( uint32_t cascadeCount )
+    {
+        HELIUM_COMPILE_ASSERT( GraphicsConfig::MAX_SHADOW_CASCADE_COUNT <= 4 );
+
+        return ( cascadeCount > 1 ? 2 : 1 );
+    }
+}
+
 /// Constructor.
 GraphicsScene::GraphicsScene()
     :
@@ -62,6 +120,11 @@ GraphicsScene::GraphicsScene()
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
     HELIUM_VERIFY( m_sceneBufferedDrawer.Initialize() );
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+    for( size_t tileIndex = 0; tileIndex < HELIUM_ARRAY_COUNT( m_shadowCascadeTileOwners ); ++tileIndex )
+    {
+        SetInvalid( m_shadowCascadeTileOwners[ tileIndex ] );
+    }
 }
 
 /// Destructor.
@@ -85,6 +148,9 @@ void GraphicsScene::Update( World *pWorld )
         if( rendererStatus == Renderer::STATUS_NOT_RESET )
         {
             rendererStatus = pRenderer->Reset();
+
+            // Shadow depth texture contents do not survive a device reset.
+            InvalidateShadowCascadeCaches();
         }
 
         if( rendererStatus != Renderer::STATUS_READY )
@@ -108,14 +174,18 @@ void GraphicsScene::Update( World *pWorld )
         return;
     }
 
-    // Prepare the array of inverse view/projection matrices for each view's shadow depth pass.
-    if( m_shadowViewInverseViewProjectionMatrices.GetSize() < sceneViewCount )
+    // Prepare the array of shadow cascades for each view's shadow depth pass.
+    size_t shadowCascadeCount = sceneViewCount * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT;
+    if( m_shadowCascades.GetSize() < shadowCascadeCount )
     {
-        m_shadowViewInverseViewProjectionMatrices.Reserve( sceneViewCount );
-        m_shadowViewInverseViewProjectionMatrices.Resize( sceneViewCount );
+        m_shadowCascades.Reserve( shadowCascadeCount );
+        m_shadowCascades.Resize( shadowCascadeCount );
     }
 
-    // Update each scene view as necessary and compute their inverse view/projection matrices.
+    // Update each scene view as necessary and compute their shadow inverse view/projection matrices.
+    bool bCascadedShadows =
+        ( rRenderResourceManager.GetShadowMode() == GraphicsConfig::EShadowMode::CASCADED );
+
     for( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
     {
         if( !m_sceneViews.IsElementValid( viewIndex ) )
@@ -124,21 +194,17 @@ void GraphicsScene::Update( World *pWorld )
         }
 
         m_sceneViews[ viewIndex ].ConditionalUpdate();
-        UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
+        if( bCascadedShadows )
+        {
+            UpdateShadowCascades( viewIndex );
+        }
+        else
+        {
+            UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
+        }
     }
 
     // Update each scene object as necessary.
-     size_t sceneObjectCount = m_sceneObjects.GetSize();
-     //for( size_t objectIndex = 0; objectIndex < sceneObjectCount; ++objectIndex )
-     //{
-     //    if( !m_sceneObjects.IsElementValid( objectIndex ) )
-     //    {
-     //        continue;
-     //    }
- 
-     //    m_sceneObjects[ objectIndex ].ConditionalUpdate( this );
-     //}
-
     for (ImplementingComponentIterator<SceneObjectTransform> iter( *pWorld->m_ComponentManager ); *iter; iter.Advance())
     {
         iter->GraphicsSceneObjectUpdate(this);
@@ -147,10 +213,6 @@ void GraphicsScene::Update( World *pWorld )
     // Swap dynamic constant buffers and update their contents.
     SwapDynamicConstantBuffers();
 
-    // Resize the visible object bit array as necessary.
-    m_visibleSceneObjects.Reserve( sceneObjectCount );
-    m_visibleSceneObjects.Resize( sceneObjectCount );
-
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
     // Set up the scene's buffered drawer for the current frame.
     m_sceneBufferedDrawer.BeginDrawing();
@@ -261,7 +323,24 @@ size_t GraphicsScene::AllocateSceneObject()
     GraphicsSceneObject* pSceneObject = m_sceneObjects.New();
     HELIUM_ASSERT( pSceneObject );
 
-    return m_sceneObjects.GetElementIndex( pSceneObject );
+    size_t id = m_sceneObjects.GetElementIndex( pSceneObject );
+
+    // The object is added to the scene object tree once its bounds are set.
+    size_t proxyIdCount = m_sceneObjectProxyIds.GetSize();
+    if( id >= proxyIdCount )
+    {
+        m_sceneObjectProxyIds.Add( Invalid< uint32_t >(), id + 1 - proxyIdCount );
+        m_sceneObjectSubMeshIds.Resize( id + 1 );
+        m_sceneObjectSphereCentersX.Add( 0.0f, id + 1 - proxyIdCount );
+        m_sceneObjectSphereCentersY.Add( 0.0f, id + 1 - proxyIdCount );
+        m_sceneObjectSphereCentersZ.Add( 0.0f, id + 1 - proxyIdCount );
+        m_sceneObjectSphereRadii.Add( 0.0f, id + 1 - proxyIdCount );
+    }
+
+    HELIUM_ASSERT( IsInvalid( m_sceneObjectProxyIds[ id ] ) );
+    HELIUM_ASSERT( m_sceneObjectSubMeshIds[ id ].IsEmpty() );
+
+    return id;
 }
 
 /// Detach and release a previously allocated scene object.
@@ -274,9 +353,147 @@ void GraphicsScene::ReleaseSceneObject( size_t id )
     HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
     HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
 
+    uint32_t& rProxyId = m_sceneObjectProxyIds[ id ];
+    if( IsValid( rProxyId ) )
+    {
+        InvalidateShadowCascadeCaches( m_sceneObjects[ id ].GetWorldSphere() );
+
+        m_sceneObjectTree.Remove( rProxyId );
+        SetInvalid( rProxyId );
+    }
+
+    HELIUM_ASSERT( m_sceneObjectSubMeshIds[ id ].IsEmpty() );
+    m_sceneObjectSubMeshIds[ id ].Clear();
+
     m_sceneObjects.Remove( id );
 }
 
+/// Set the world-space bounds of a scene object, updating its place in the scene object tree used for culling.
+///
+/// This should be used instead of calling GraphicsSceneObject::SetWorldBounds() directly, as objects are only
+/// found by visibility queries with the bounds last set through this function.
+///
+/// @param[in] id    ID of the object to update.
+/// @param[in] rBox  World-space axis-aligned bounding box to set.
+///
+/// @see GetSceneObject()
+void GraphicsScene::SetSceneObjectWorldBounds( size_t id, const Simd::AaBox& rBox )
+{
+    HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+    HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
+
+    GraphicsSceneObject& rSceneObject = m_sceneObjects[ id ];
+    uint32_t& rProxyId = m_sceneObjectProxyIds[ id ];
+
+    // Any cached shadow cascade covering the object's old or new location needs to be rendered again.
+    if( IsValid( rProxyId ) )
+    {
+        const Simd::AaBox& rOldBox = rSceneObject.GetWorldBox();
+        if( rOldBox.GetMinimum() == rBox.GetMinimum() && rOldBox.GetMaximum() == rBox.GetMaximum() )
+        {
+            return;
+        }
+
+        InvalidateShadowCascadeCaches( rSceneObject.GetWorldSphere() );
+    }
+
+    rSceneObject.SetWorldBounds( rBox );
+
+    const Simd::Sphere& rSphere = rSceneObject.GetWorldSphere();
+    const Simd::Vector3& rCenter = rSphere.GetCenter();
+    m_sceneObjectSphereCentersX[ id ] = rCenter.GetElement( 0 );
+    m_sceneObjectSphereCentersY[ id ] = rCenter.GetElement( 1 );
+    m_sceneObjectSphereCentersZ[ id ] = rCenter.GetElement( 2 );
+    m_sceneObjectSphereRadii[ id ] = rSphere.GetRadius();
+
+    InvalidateShadowCascadeCaches( rSphere );
+
+    if( IsValid( rProxyId ) )
+    {
+        m_sceneObjectTree.Move( rProxyId, rBox );
+    }
+    else
+    {
+        rProxyId = m_sceneObjectTree.Insert( rBox, id );
+    }
+}
+
+/// Set the vertex data of a scene object.
+///
+/// This should be used instead of calling GraphicsSceneObject::SetVertexData() directly so that cached shadow
+/// cascades containing the object are rendered again when its geometry changes.
+///
+/// @param[in] id                  ID of the object to update.
+/// @param[in] pVertexBuffer       Vertex buffer to set.
+/// @param[in] pVertexDescription  Vertex format description.
+/// @param[in] vertexStride        Stride between each vertex in the specified buffer, in bytes.
+///
+/// @see GetSceneObject()
+void GraphicsScene::SetSceneObjectVertexData(
+    size_t id,
+    RVertexBuffer* pVertexBuffer,
+    RVertexDescription* pVertexDescription,
+    uint32_t vertexStride )
+{
+    HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+    HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
+
+    GraphicsSceneObject& rSceneObject = m_sceneObjects[ id ];
+    if( rSceneObject.GetVertexBuffer() == pVertexBuffer &&
+        rSceneObject.GetVertexDescription() == pVertexDescription &&
+        rSceneObject.GetVertexStride() == vertexStride )
+    {
+        return;
+    }
+
+    rSceneObject.SetVertexData( pVertexBuffer, pVertexDescription, vertexStride );
+    InvalidateSceneObjectShadowCascadeCaches( id );
+}
+
+/// Set the index buffer of a scene object.
+///
+/// This should be used instead of calling GraphicsSceneObject::SetIndexBuffer() directly so that cached shadow
+/// cascades containing the object are rendered again when its geometry changes.
+///
+/// @param[in] id            ID of the object to update.
+/// @param[in] pIndexBuffer  Index buffer to set.
+///
+/// @see GetSceneObject()
+void GraphicsScene::SetSceneObjectIndexBuffer( size_t id, RIndexBuffer* pIndexBuffer )
+{
+    HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+    HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
+
+    GraphicsSceneObject& rSceneObject = m_sceneObjects[ id ];
+    if( rSceneObject.GetIndexBuffer() == pIndexBuffer )
+    {
+        return;
+    }
+
+    rSceneObject.SetIndexBuffer( pIndexBuffer );
+    InvalidateSceneObjectShadowCascadeCaches( id );
+}
+
+/// Update the bone transform palette of a skinned scene object.
+///
+/// This should be used instead of calling GraphicsSceneObject::SetBonePalette() directly.  The palette contents can
+/// change without the palette address changing, so cached shadow cascades containing the object are always rendered
+/// again.  Skinned objects are bounded by their reference pose, so poses reaching outside those bounds may still
+/// leave stale shadows in cascades the object's bounds do not touch.
+///
+/// @param[in] id           ID of the object to update.
+/// @param[in] pTransforms  Array of bone transforms.
+///
+/// @see GetSceneObject()
+void GraphicsScene::SetSceneObjectBonePalette( size_t id, const Simd::Matrix44* pTransforms )
+{
+    HELIUM_ASSERT( id < m_sceneObjects.GetSize() );
+    HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
+
+    m_sceneObjects[ id ].SetBonePalette( pTransforms );
+    InvalidateSceneObjectShadowCascadeCaches( id );
+}
+
 /// Allocate new scene object sub-mesh data and add it to the scene.
 ///
 /// @param[in] sceneObjectId  ID of the parent graphics scene object used to control the placement of the sub-mesh
@@ -293,7 +510,12 @@ size_t GraphicsScene::AllocateSceneObjectSubMeshData( size_t sceneObjectId )
     GraphicsSceneObject::SubMeshData* pSubMeshData = m_sceneObjectSubMeshes.New( sceneObjectId );
     HELIUM_ASSERT( pSubMeshData );
 
-    return m_sceneObjectSubMeshes.GetElementIndex( pSubMeshData );
+    size_t id = m_sceneObjectSubMeshes.GetElementIndex( pSubMeshData );
+    m_sceneObjectSubMeshIds[ sceneObjectId ].Push( id );
+
+    InvalidateSceneObjectShadowCascadeCaches( sceneObjectId );
+
+    return id;
 }
 
 /// Detach and release previously allocated scene object sub-mesh data.
@@ -306,9 +528,66 @@ void GraphicsScene::ReleaseSceneObjectSubMeshData( size_t id )
     HELIUM_ASSERT( id < m_sceneObjectSubMeshes.GetSize() );
     HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( id ) );
 
+    size_t sceneObjectId = m_sceneObjectSubMeshes[ id ].GetSceneObjectId();
+    InvalidateSceneObjectShadowCascadeCaches( sceneObjectId );
+
+    DynamicArray< size_t >& rSubMeshIds = m_sceneObjectSubMeshIds[ sceneObjectId ];
+    size_t subMeshIdCount = rSubMeshIds.GetSize();
+    for( size_t subMeshIdIndex = 0; subMeshIdIndex < subMeshIdCount; ++subMeshIdIndex )
+    {
+        if( rSubMeshIds[ subMeshIdIndex ] == id )
+        {
+            rSubMeshIds.RemoveSwap( subMeshIdIndex );
+            break;
+        }
+    }
+
     m_sceneObjectSubMeshes.Remove( id );
 }
 
+/// Set the range of primitives drawn for a scene object sub-mesh.
+///
+/// This should be used instead of setting the primitive range on the sub-mesh data directly so that cached shadow
+/// cascades containing the parent scene object are rendered again when the geometry drawn changes.
+///
+/// @param[in] id              ID of the sub-mesh data to update.
+/// @param[in] type            Primitive type to render.
+/// @param[in] primitiveCount  Number of primitives to render.
+/// @param[in] startVertex     Offset of the first vertex to use within the vertex buffer.
+/// @param[in] vertexRange     Number of vertices used by the sub-mesh.
+/// @param[in] startIndex      Offset of the first index to use within the index buffer.
+///
+/// @see GetSceneObjectSubMeshData()
+void GraphicsScene::SetSceneObjectSubMeshPrimitives(
+    size_t id,
+    ERendererPrimitiveType type,
+    uint32_t primitiveCount,
+    uint32_t startVertex,
+    uint32_t vertexRange,
+    uint32_t startIndex )
+{
+    HELIUM_ASSERT( id < m_sceneObjectSubMeshes.GetSize() );
+    HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( id ) );
+
+    GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ id ];
+    if( rSubMeshData.GetPrimitiveType() == type &&
+        rSubMeshData.GetPrimitiveCount() == primitiveCount &&
+        rSubMeshData.GetStartVertex() == startVertex &&
+        rSubMeshData.GetVertexRange() == vertexRange &&
+        rSubMeshData.GetStartIndex() == startIndex )
+    {
+        return;
+    }
+
+    rSubMeshData.SetPrimitiveType( type );
+    rSubMeshData.SetPrimitiveCount( primitiveCount );
+    rSubMeshData.SetStartVertex( startVertex );
+    rSubMeshData.SetVertexRange( vertexRange );
+    rSubMeshData.SetStartIndex( startIndex );
+
+    InvalidateSceneObjectShadowCascadeCaches( rSubMeshData.GetSceneObjectId() );
+}
+
 /// Set the properties for the scene's ambient lighting.
 ///
 /// @param[in] rTopColor         Ambient light coloring to apply to upward-facing normals.
@@ -339,8 +618,12 @@ void GraphicsScene::SetAmbientLight(
 /// @see GetDirectionalLightDirection(), GetDirectionalLightColor(), GetDirectionalLightBrightness()
 void GraphicsScene::SetDirectionalLight( const Simd::Vector3& rDirection, const Color& rColor, float32_t brightness )
 {
-    m_directionalLightDirection = rDirection;
-    m_directionalLightDirection.Normalize();
+    Simd::Vector3 direction = rDirection.GetNormalized();
+    if( direction != m_directionalLightDirection )
+    {
+        m_directionalLightDirection = direction;
+        InvalidateShadowCascadeCaches();
+    }
 
     m_directionalLightColor = rColor;
     m_directionalLightBrightness = brightness;
@@ -427,12 +710,17 @@ Name GraphicsScene::GetShadowMapTextureName()
 
 /// Update the shadow depth pass inverse view/projection matrix for a given scene view.
 ///
+/// The result is stored in the first shadow cascade of the view.
+///
 /// @param[in] viewIndex  Index of the scene view for which to update the shadow depth pass transform matrix.
 void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIndex )
 {
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
-    HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
+    HELIUM_ASSERT( viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT < m_shadowCascades.GetSize() );
+
+    ShadowCascade& rCascade = m_shadowCascades[ viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT ];
+    rCascade.bCacheValid = false;
 
     // Compute the scene directional light's view basis for shadow calculation.
     Simd::Vector3 shadowViewForward = m_directionalLightDirection;
@@ -448,6 +736,7 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIn
     GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
 
     float32_t shadowCutoffDistance = rView.GetShadowCutoffDistance();
+    rCascade.splitDepth = shadowCutoffDistance;
 
     const Simd::Matrix44& rViewMatrix = rView.GetViewMatrix();
     Simd::Vector3 shadowClipNormal = Vector4ToVector3( rViewMatrix.GetRow( 2 ) );
@@ -457,7 +746,8 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIn
 
     Simd::Plane shadowClipPlane( shadowClipNormal, shadowClipNormal.Dot( shadowClipPoint ) );
 
-    Simd::Frustum shadowClippedViewFrustum = rView.GetFrustum();
+    Simd::Frustum& shadowClippedViewFrustum = rCascade.clippedViewFrustum;
+    shadowClippedViewFrustum = rView.GetFrustum();
     shadowClippedViewFrustum.SetFarClip( shadowClipPlane );
 
     HELIUM_SIMD_ALIGN_PRE float32_t shadowFrustumPointsX[
@@ -540,6 +830,13 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIn
     HELIUM_SIMD_ALIGN_PRE float32_t shadowViewWidthHeight[ 4 ] HELIUM_SIMD_ALIGN_POST;
     Helium::Simd::StoreAligned( shadowViewWidthHeight, projectedWidthHeight );
 
+    HELIUM_SIMD_ALIGN_PRE float32_t shadowViewCenter[ 4 ] HELIUM_SIMD_ALIGN_POST;
+    Helium::Simd::StoreAligned( shadowViewCenter, projectedCenter );
+
+    rCascade.projectionCenterX = shadowViewCenter[ 0 ];
+    rCascade.projectionCenterY = shadowViewCenter[ 1 ];
+    rCascade.projectionSize = Max( shadowViewWidthHeight[ 0 ], shadowViewWidthHeight[ 1 ] );
+
     Simd::Matrix44 projection(
         Simd::Matrix44::INIT_ORTHOGONAL_PROJECTION,
         shadowViewWidthHeight[ 0 ],
@@ -559,7 +856,8 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIn
     inverseView.Invert();
 
     // Compute the combined inverse view/projection matrix.
-    m_shadowViewInverseViewProjectionMatrices[ viewIndex ].MultiplySet( inverseView, projection );
+    rCascade.inverseViewProjection.MultiplySet( inverseView, projection );
+    rCascade.shadowFrustum.Set( rCascade.inverseViewProjection.GetTranspose() );
 }
 
 /// Update the shadow depth pass inverse view/projection matrix for a given scene view, using light-space
@@ -570,12 +868,216 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixLspsm( size_t viewInd
 {
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
-    HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
+    HELIUM_ASSERT( viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT < m_shadowCascades.GetSize() );
 
     // XXX TMC TODO: Implement!!
     UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
 }
 
+/// Update the shadow cascades for a given scene view.
+///
+/// The part of the view within the shadow cutoff distance is split into depth slices, placing the split distances
+/// between a uniform and a logarithmic distribution based on the configured split lambda.  Each slice is covered by a
+/// square shadow projection fit around the slice's bounding sphere, so its size does not change as the view rotates,
+/// and the projection is snapped to whole shadow depth texels so shadow edges do not shimmer as the view moves.
+///
+/// Cascades from the configured cache start onward are given extra room and keep their projection for as long as
+/// their slice stays inside it, allowing their depth data to be reused over multiple frames.
+///
+/// @param[in] viewIndex  Index of the scene view for which to update the shadow cascades.
+void GraphicsScene::UpdateShadowCascades( size_t viewIndex )
+{
+    HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+    HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+    HELIUM_ASSERT( ( viewIndex + 1 ) * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT <= m_shadowCascades.GetSize() );
+
+    GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
+
+    RenderResourceManager& rRenderResourceManager = RenderResourceManager::GetStaticInstance();
+
+    uint32_t cascadeCount = rRenderResourceManager.GetShadowCascadeCount();
+
+    // Splitting the view only makes sense for perspective projections, so orthographic views use the same projection
+    // for each cascade.
+    const Simd::Matrix44& rProjectionMatrix = rView.GetProjectionMatrix();
+    if( rProjectionMatrix.GetElement( 15 ) != 0.0f )
+    {
+        UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
+
+        ShadowCascade* pCascades = &m_shadowCascades[ viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT ];
+        for( uint32_t cascadeIndex = 1; cascadeIndex < cascadeCount; ++cascadeIndex )
+        {
+            pCascades[ cascadeIndex ] = pCascades[ 0 ];
+        }
+
+        return;
+    }
+
+    uint32_t cascadeCacheStart = rRenderResourceManager.GetShadowCascadeCacheStart();
+    float32_t splitLambda = rRenderResourceManager.GetShadowCascadeSplitLambda();
+
+    float32_t tileSize = static_cast< float32_t >(
+        rRenderResourceManager.GetShadowDepthTextureUsableSize() / GetShadowCascadeTileGridSize( cascadeCount ) );
+    tileSize = Max( tileSize, 1.0f );
+
+    // Compute the scene directional light's view basis for shadow calculation.
+    Simd::Vector3 shadowViewForward = m_directionalLightDirection;
+    Simd::Vector3 shadowViewUp( 0.0f, 1.0f, 0.0f );
+
+    Simd::Vector3 shadowViewRight;
+    shadowViewRight.CrossSet( shadowViewUp, shadowViewForward );
+    shadowViewRight.Normalize();
+
+    shadowViewUp.CrossSet( shadowViewForward, shadowViewRight );
+
+    // Compute the view depth range affected by shadowing and the size of the view frustum cross-section at a given
+    // depth.
+    const Simd::Matrix44& rViewMatrix = rView.GetViewMatrix();
+    Simd::Vector3 viewForward = Vector4ToVector3( rViewMatrix.GetRow( 2 ) );
+    Simd::Vector3 viewOrigin = Vector4ToVector3( rViewMatrix.GetRow( 3 ) );
+
+    float32_t nearClip = -rProjectionMatrix.GetElement( 14 ) / rProjectionMatrix.GetElement( 10 );
+    float32_t shadowCutoffDistance = Max( rView.GetShadowCutoffDistance(), nearClip );
+
+    float32_t tanHalfFovX = 1.0f / rProjectionMatrix.GetElement( 0 );
+    float32_t tanHalfFovY = 1.0f / rProjectionMatrix.GetElement( 5 );
+    float32_t cornerScaleSquared = tanHalfFovX * tanHalfFovX + tanHalfFovY * tanHalfFovY;
+
+    float32_t splitStartDepth = nearClip;
+    for( uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+    {
+        ShadowCascade& rCascade = m_shadowCascades[ viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT + cascadeIndex ];
+
+        // Compute the depth at which the cascade ends.
+        float32_t splitEndDepth = shadowCutoffDistance;
+        if( cascadeIndex + 1 < cascadeCount )
+        {
+            float32_t splitFraction =
+                static_cast< float32_t >( cascadeIndex + 1 ) / static_cast< float32_t >( cascadeCount );
+            float32_t logSplitDepth = nearClip * Pow( shadowCutoffDistance / nearClip, splitFraction );
+            float32_t uniformSplitDepth = nearClip + ( shadowCutoffDistance - nearClip ) * splitFraction;
+            splitEndDepth = splitLambda * logSplitDepth + ( 1.0f - splitLambda ) * uniformSplitDepth;
+        }
+
+        rCascade.splitDepth = splitEndDepth;
+
+        // Compute the bounding sphere of the slice, centered on the view axis at the point equally distant from the
+        // near and far slice corners.
+        float32_t sphereDepth = Min(
+            0.5f * ( splitStartDepth + splitEndDepth ) * ( 1.0f + cornerScaleSquared ),
+            splitEndDepth );
+        float32_t sphereFarOffset = splitEndDepth - sphereDepth;
+        float32_t sphereRadius = Sqrt(
+            sphereFarOffset * sphereFarOffset + cornerScaleSquared * splitEndDepth * splitEndDepth );
+
+        Simd::Vector3 sphereCenter = viewOrigin + viewForward * sphereDepth;
+        float32_t sphereCenterX = shadowViewRight.Dot( sphereCenter );
+        float32_t sphereCenterY = shadowViewUp.Dot( sphereCenter );
+
+        splitStartDepth = splitEndDepth;
+
+        // Keep the current projection of a cached cascade if the slice is still inside it.
+        bool bCached = ( cascadeIndex >= cascadeCacheStart );
+        float32_t projectionSize = 2.0f * sphereRadius * ( bCached ? SHADOW_CASCADE_CACHE_MARGIN : 1.0f );
+
+        if( bCached && rCascade.bCacheValid && rCascade.projectionSize == projectionSize )
+        {
+            float32_t projectionSlack = 0.5f * projectionSize - sphereRadius;
+            if( Abs( sphereCenterX - rCascade.projectionCenterX ) <= projectionSlack &&
+                Abs( sphereCenterY - rCascade.projectionCenterY ) <= projectionSlack )
+            {
+                continue;
+            }
+        }
+
+        rCascade.bCacheValid = false;
+
+        // Snap the projection center to the shadow depth texel grid.
+        float32_t texelSize = projectionSize / tileSize;
+        float32_t projectionCenterX = Floor( sphereCenterX / texelSize ) * texelSize;
+        float32_t projectionCenterY = Floor( sphereCenterY / texelSize ) * texelSize;
+
+        rCascade.projectionCenterX = projectionCenterX;
+        rCascade.projectionCenterY = projectionCenterY;
+        rCascade.projectionSize = projectionSize;
+
+        Simd::Vector3 shadowViewOrigin = shadowViewRight * projectionCenterX + shadowViewUp * projectionCenterY +
+            shadowViewForward * -32767.0f;
+
+        Simd::Matrix44 projection(
+            Simd::Matrix44::INIT_ORTHOGONAL_PROJECTION,
+            projectionSize,
+            projectionSize,
+            0.0f,
+            65536.0f );
+
+        Simd::Matrix44 inverseView(
+            RayToVector4( shadowViewRight ),
+            RayToVector4( shadowViewUp ),
+            RayToVector4( shadowViewForward ),
+            PointToVector4( shadowViewOrigin ) );
+        inverseView.Invert();
+
+        rCascade.inverseViewProjection.MultiplySet( inverseView, projection );
+        rCascade.shadowFrustum.Set( rCascade.inverseViewProjection.GetTranspose() );
+
+        // Clip the view frustum to the end of the cascade for shadow caster culling.
+        Simd::Vector3 clipNormal = -viewForward;
+        Simd::Vector3 clipPoint = viewOrigin + viewForward * splitEndDepth;
+
+        rCascade.clippedViewFrustum = rView.GetFrustum();
+        rCascade.clippedViewFrustum.SetFarClip( Simd::Plane( clipNormal, clipNormal.Dot( clipPoint ) ) );
+    }
+}
+
+/// Mark all shadow cascades as needing their depth data to be rendered again.
+///
+/// @see InvalidateShadowCascadeCaches( const Simd::Sphere& )
+void GraphicsScene::InvalidateShadowCascadeCaches()
+{
+    size_t cascadeCount = m_shadowCascades.GetSize();
+    for( size_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+    {
+        m_shadowCascades[ cascadeIndex ].bCacheValid = false;
+    }
+}
+
+/// Mark shadow cascades whose shadow projection intersects a given sphere as needing their depth data to be rendered
+/// again.
+///
+/// @param[in] rSphere  World-space sphere that changed.
+///
+/// @see InvalidateShadowCascadeCaches()
+void GraphicsScene::InvalidateShadowCascadeCaches( const Simd::Sphere& rSphere )
+{
+    size_t cascadeCount = m_shadowCascades.GetSize();
+    for( size_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+    {
+        ShadowCascade& rCascade = m_shadowCascades[ cascadeIndex ];
+        if( rCascade.bCacheValid && rCascade.shadowFrustum.Intersects( rSphere ) )
+        {
+            rCascade.bCacheValid = false;
+        }
+    }
+}
+
+/// Mark shadow cascades containing a scene object as needing their depth data to be rendered again.
+///
+/// Objects whose bounds have not been set yet are not in any cascade, so nothing is invalidated for them.
+///
+/// @param[in] sceneObjectId  ID of the scene object whose geometry changed.
+///
+/// @see InvalidateShadowCascadeCaches( const Simd::Sphere& )
+void GraphicsScene::InvalidateSceneObjectShadowCascadeCaches( size_t sceneObjectId )
+{
+    HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+
+    if( IsValid( m_sceneObjectProxyIds[ sceneObjectId ] ) )
+    {
+        InvalidateShadowCascadeCaches( m_sceneObjects[ sceneObjectId ].GetWorldSphere() );
+    }
+}
+
 /// Swap the dynamic constant buffers for view and instance data and push the current frame's data into the new
 /// buffers.
 void GraphicsScene::SwapDynamicConstantBuffers()
@@ -588,9 +1090,12 @@ void GraphicsScene::SwapDynamicConstantBuffers()
     }
 
     // Pre-compute the inverse shadow map resolution and the transformation matrix from shadow view projection to UV
-    // space for use when applying shadows to the scene.
+    // space for use when applying shadows to the scene.  With cascaded shadows, the matrix maps to the UV space of the
+    // first cascade's projection, and the pixel shader maps that to the shadow depth texture tile of the cascade used.
     float32_t inverseShadowMapResolutionX = 1.0f;
     float32_t inverseShadowMapResolutionY = 1.0f;
+    float32_t shadowCascadeTileScaleX = 1.0f;
+    float32_t shadowCascadeTileScaleY = 1.0f;
 
     Simd::Matrix44 shadowMapUvTransform(
         Simd::Vector4( 0.5f,  0.0f, 0.0f, 0.0f ),
@@ -599,24 +1104,37 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         Simd::Vector4( 0.5f,  0.5f, 0.0f, 1.0f ) );
 
     RenderResourceManager& rRenderResourceManager = RenderResourceManager::GetStaticInstance();
+    bool bCascadedShadows =
+        ( rRenderResourceManager.GetShadowMode() == GraphicsConfig::EShadowMode::CASCADED );
+    uint32_t shadowCascadeCount = rRenderResourceManager.GetShadowCascadeCount();
+    uint32_t shadowCascadeTileGridSize = GetShadowCascadeTileGridSize( shadowCascadeCount );
+
     RTexture2d* pShadowDepthTexture = rRenderResourceManager.GetShadowDepthTexture();
     if( pShadowDepthTexture )
     {
         inverseShadowMapResolutionX = 1.0f / static_cast< float32_t >( pShadowDepthTexture->GetWidth() );
         inverseShadowMapResolutionY = 1.0f / static_cast< float32_t >( pShadowDepthTexture->GetHeight() );
 
-        float32_t shadowMapUsableSize =
-            static_cast< float32_t >( rRenderResourceManager.GetShadowDepthTextureUsableSize() );
-        float32_t shadowMapUsableX = shadowMapUsableSize * inverseShadowMapResolutionX;
-        float32_t shadowMapUsableY = shadowMapUsableSize * inverseShadowMapResolutionY;
+        float32_t shadowMapTileSize = static_cast< float32_t >(
+            rRenderResourceManager.GetShadowDepthTextureUsableSize() / shadowCascadeTileGridSize );
+        shadowCascadeTileScaleX = shadowMapTileSize * inverseShadowMapResolutionX;
+        shadowCascadeTileScaleY = shadowMapTileSize * inverseShadowMapResolutionY;
 
-        float32_t halfShadowMapUsableX = shadowMapUsableX * 0.5f;
-        float32_t negHalfShadowMapUsableY = shadowMapUsableY * -0.5f;
+        if( !bCascadedShadows )
+        {
+            float32_t shadowMapUsableSize =
+                static_cast< float32_t >( rRenderResourceManager.GetShadowDepthTextureUsableSize() );
+            float32_t shadowMapUsableX = shadowMapUsableSize * inverseShadowMapResolutionX;
+            float32_t shadowMapUsableY = shadowMapUsableSize * inverseShadowMapResolutionY;
+
+            float32_t halfShadowMapUsableX = shadowMapUsableX * 0.5f;
+            float32_t negHalfShadowMapUsableY = shadowMapUsableY * -0.5f;
 
-        shadowMapUvTransform.SetElement( 0, halfShadowMapUsableX );
-        shadowMapUvTransform.SetElement( 5, negHalfShadowMapUsableY );
-        shadowMapUvTransform.SetElement( 12, halfShadowMapUsableX );
-        shadowMapUvTransform.SetElement( 13, negHalfShadowMapUsableY + 1.0f );
+            shadowMapUvTransform.SetElement( 0, halfShadowMapUsableX );
+            shadowMapUvTransform.SetElement( 5, negHalfShadowMapUsableY );
+            shadowMapUvTransform.SetElement( 12, halfShadowMapUsableX );
+            shadowMapUvTransform.SetElement( 13, negHalfShadowMapUsableY + 1.0f );
+        }
     }
 
     // Swap buffer sets.
@@ -635,7 +1153,7 @@ void GraphicsScene::SwapDynamicConstantBuffers()
     HELIUM_ASSERT( rViewVertexBasePassDataBuffers.GetSize() == viewBufferCount );
     HELIUM_ASSERT( rViewVertexScreenDataBuffers.GetSize() == viewBufferCount );
     HELIUM_ASSERT( rViewPixelBasePassDataBuffers.GetSize() == viewBufferCount );
-    HELIUM_ASSERT( rShadowViewVertexDataBuffers.GetSize() == viewBufferCount );
+    HELIUM_ASSERT( rShadowViewVertexDataBuffers.GetSize() == viewBufferCount * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT );
     if( viewBufferCount < sceneViewCount )
     {
         size_t additionalBufferCount = sceneViewCount - viewBufferCount;
@@ -643,7 +1161,7 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         rViewVertexBasePassDataBuffers.Add( NULL, additionalBufferCount );
         rViewVertexScreenDataBuffers.Add( NULL, additionalBufferCount );
         rViewPixelBasePassDataBuffers.Add( NULL, additionalBufferCount );
-        rShadowViewVertexDataBuffers.Add( NULL, additionalBufferCount );
+        rShadowViewVertexDataBuffers.Add( NULL, additionalBufferCount * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT );
     }
 
     for( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
@@ -736,10 +1254,10 @@ void GraphicsScene::SwapDynamicConstantBuffers()
             float32_t* pMappedData = static_cast< float32_t* >( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
             HELIUM_ASSERT( pMappedData );
 
-            HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
+            HELIUM_ASSERT( viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT < m_shadowCascades.GetSize() );
             Simd::Matrix44 shadowViewInvViewProj;
             shadowViewInvViewProj.MultiplySet(
-                m_shadowViewInverseViewProjectionMatrices[ viewIndex ],
+                m_shadowCascades[ viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT ].inverseViewProjection,
                 shadowMapUvTransform );
 
             GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
@@ -835,7 +1353,7 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         spBuffer = rViewPixelBasePassDataBuffers[ viewIndex ];
         if( !spBuffer )
         {
-            spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 16, RENDERER_BUFFER_USAGE_DYNAMIC );
+            spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 36, RENDERER_BUFFER_USAGE_DYNAMIC );
             if( !spBuffer )
             {
                 HELIUM_TRACE(
@@ -870,34 +1388,74 @@ void GraphicsScene::SwapDynamicConstantBuffers()
             *( pMappedData++ ) = inverseShadowMapResolutionX;
             *( pMappedData++ ) = inverseShadowMapResolutionY;
             *( pMappedData++ ) = 0.0f;
-            *pMappedData       = 0.0f;
+            *( pMappedData++ ) = 0.0f;
+
+            // Store the transform from the first cascade's UV space to each cascade's shadow depth texture tile,
+            // followed by the view depth at which each cascade ends.  Entries past the cascade count repeat the last
+            // cascade so the shader can select a cascade without knowing the count.
+            const ShadowCascade* pShadowCascades = &m_shadowCascades[ viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT ];
+            const ShadowCascade& rFirstShadowCascade = pShadowCascades[ 0 ];
+
+            for( uint32_t cascadeIndex = 0; cascadeIndex < GraphicsConfig::MAX_SHADOW_CASCADE_COUNT; ++cascadeIndex )
+            {
+                uint32_t usedCascadeIndex = Min( cascadeIndex, shadowCascadeCount - 1 );
+                const ShadowCascade& rShadowCascade = pShadowCascades[ usedCascadeIndex ];
+
+                float32_t inverseProjectionSize = 1.0f / rShadowCascade.projectionSize;
+                float32_t sizeRatio = rFirstShadowCascade.projectionSize * inverseProjectionSize;
+                float32_t tileOffsetX =
+                    static_cast< float32_t >( usedCascadeIndex % shadowCascadeTileGridSize ) * shadowCascadeTileScaleX;
+                float32_t tileOffsetY =
+                    static_cast< float32_t >( usedCascadeIndex / shadowCascadeTileGridSize ) * shadowCascadeTileScaleY;
+
+                *( pMappedData++ ) = sizeRatio * shadowCascadeTileScaleX;
+                *( pMappedData++ ) = sizeRatio * shadowCascadeTileScaleY;
+                *( pMappedData++ ) = tileOffsetX + shadowCascadeTileScaleX * (
+                    ( rFirstShadowCascade.projectionCenterX - rShadowCascade.projectionCenterX ) * inverseProjectionSize +
+                    0.5f - 0.5f * sizeRatio );
+                *( pMappedData++ ) = tileOffsetY + shadowCascadeTileScaleY * (
+                    ( rShadowCascade.projectionCenterY - rFirstShadowCascade.projectionCenterY ) * inverseProjectionSize +
+                    0.5f - 0.5f * sizeRatio );
+            }
+
+            for( uint32_t cascadeIndex = 0; cascadeIndex < GraphicsConfig::MAX_SHADOW_CASCADE_COUNT; ++cascadeIndex )
+            {
+                *( pMappedData++ ) = pShadowCascades[ Min( cascadeIndex, shadowCascadeCount - 1 ) ].splitDepth;
+            }
 
             spBuffer->Unmap();
         }
 
-        // Update the shadow depth pass vertex shader constants.
-        spBuffer = rShadowViewVertexDataBuffers[ viewIndex ];
-        if( !spBuffer )
+        // Update the shadow depth pass vertex shader constants for each cascade.
+        for( uint32_t cascadeIndex = 0; cascadeIndex < shadowCascadeCount; ++cascadeIndex )
         {
-            spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 32, RENDERER_BUFFER_USAGE_DYNAMIC );
+            size_t shadowCascadeIndex = viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT + cascadeIndex;
+
+            spBuffer = rShadowViewVertexDataBuffers[ shadowCascadeIndex ];
             if( !spBuffer )
             {
-                HELIUM_TRACE(
-                    TraceLevels::Error,
-                    ( TXT( "GraphicsScene::SwapDynamicConstantBuffers(): Shadow view vertex data constant buffer " )
-                    TXT( "creation failed!\n" ) ) );
+                spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 32, RENDERER_BUFFER_USAGE_DYNAMIC );
+                if( !spBuffer )
+                {
+                    HELIUM_TRACE(
+                        TraceLevels::Error,
+                        ( TXT( "GraphicsScene::SwapDynamicConstantBuffers(): Shadow view vertex data constant " )
+                        TXT( "buffer creation failed!\n" ) ) );
+                }
+
+                rShadowViewVertexDataBuffers[ shadowCascadeIndex ] = spBuffer;
             }
 
-            rShadowViewVertexDataBuffers[ viewIndex ] = spBuffer;
-        }
+            if( !spBuffer )
+            {
+                continue;
+            }
 
-        if( spBuffer )
-        {
             float32_t* pMappedData = static_cast< float32_t* >( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
             HELIUM_ASSERT( pMappedData );
 
-            HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
-            const Simd::Matrix44& rShadowViewInvViewProj = m_shadowViewInverseViewProjectionMatrices[ viewIndex ];
+            HELIUM_ASSERT( shadowCascadeIndex < m_shadowCascades.GetSize() );
+            const Simd::Matrix44& rShadowViewInvViewProj = m_shadowCascades[ shadowCascadeIndex ].inverseViewProjection;
 
             *( pMappedData++ ) = rShadowViewInvViewProj.GetElement( 0 );
             *( pMappedData++ ) = rShadowViewInvViewProj.GetElement( 4 );
@@ -1103,7 +1661,7 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         rParameters.ppSceneObjectConstantBufferData = m_mappedObjectVertexGlobalDataBuffers.GetData();
         rParameters.pSubMeshes = m_sceneObjectSubMeshes.GetData();
         rParameters.ppSubMeshConstantBufferData = m_mappedSubMeshVertexGlobalDataBuffers.GetData();
-		job.Run();
+		JobManager::GetStaticInstance().RunJob( job );
     }
 
     // Unmap the constant buffers.
@@ -1128,6 +1686,185 @@ void GraphicsScene::SwapDynamicConstantBuffers()
     }
 }
 
+/// Remove scene objects whose bounding spheres are outside a frustum from a list.
+///
+/// Spheres are read from the packed bounds arrays in batches and tested several at a time.  The order of the
+/// objects that remain in the list is preserved.
+///
+/// @param[in]     rFrustum         Frustum to test.
+/// @param[in,out] rSceneObjectIds  IDs of the scene objects to test.  Objects that are not visible are removed.
+void GraphicsScene::CullSceneObjects( const Simd::Frustum& rFrustum, DynamicArray< size_t >& rSceneObjectIds )
+{
+    CullSceneObjects( SphereFrustumCuller( rFrustum ), rSceneObjectIds );
+}
+
+/// Remove scene objects whose bounding spheres fail a culling test from a list.
+///
+/// @param[in]     rCuller          Culling test to apply.
+/// @param[in,out] rSceneObjectIds  IDs of the scene objects to test.  Objects that fail the test are removed.
+void GraphicsScene::CullSceneObjects( const SphereFrustumCuller& rCuller, DynamicArray< size_t >& rSceneObjectIds )
+{
+    SphereFrustumCuller::Batch batch;
+
+    size_t* pSceneObjectIds = rSceneObjectIds.GetData();
+    size_t sceneObjectIdCount = rSceneObjectIds.GetSize();
+    size_t visibleIdCount = 0;
+
+    for( size_t firstIdIndex = 0; firstIdIndex < sceneObjectIdCount; firstIdIndex += SphereFrustumCuller::BATCH_SIZE )
+    {
+        size_t batchCount = Min( sceneObjectIdCount - firstIdIndex, SphereFrustumCuller::BATCH_SIZE );
+        for( size_t batchIndex = 0; batchIndex < batchCount; ++batchIndex )
+        {
+            size_t sceneObjectId = pSceneObjectIds[ firstIdIndex + batchIndex ];
+            HELIUM_ASSERT( sceneObjectId < m_sceneObjectSphereRadii.GetSize() );
+
+            batch.centersX[ batchIndex ] = m_sceneObjectSphereCentersX[ sceneObjectId ];
+            batch.centersY[ batchIndex ] = m_sceneObjectSphereCentersY[ sceneObjectId ];
+            batch.centersZ[ batchIndex ] = m_sceneObjectSphereCentersZ[ sceneObjectId ];
+            batch.radii[ batchIndex ] = m_sceneObjectSphereRadii[ sceneObjectId ];
+        }
+
+        // Visible IDs never move past the batch being read, so the list can be compacted in place.
+        uint64_t visibleMask = rCuller.TestBatch( batch, batchCount );
+        for( size_t batchIndex = 0; visibleMask != 0; ++batchIndex, visibleMask >>= 1 )
+        {
+            if( visibleMask & 1 )
+            {
+                pSceneObjectIds[ visibleIdCount++ ] = pSceneObjectIds[ firstIdIndex + batchIndex ];
+            }
+        }
+    }
+
+    rSceneObjectIds.Resize( visibleIdCount );
+}
+
+/// Add the sub-mesh data IDs of each scene object in a list to a sub-mesh index list.
+///
+/// @param[in]     rSceneObjectIds  IDs of the scene objects whose sub-meshes should be added.
+/// @param[in,out] rSubMeshIndices  Sub-mesh index list to which to add the sub-mesh data IDs.
+void GraphicsScene::GatherSceneObjectSubMeshes(
+    const DynamicArray< size_t >& rSceneObjectIds,
+    DynamicArray< size_t >& rSubMeshIndices )
+{
+    size_t sceneObjectIdCount = rSceneObjectIds.GetSize();
+    for( size_t sceneObjectIdIndex = 0; sceneObjectIdIndex < sceneObjectIdCount; ++sceneObjectIdIndex )
+    {
+        const DynamicArray< size_t >& rSubMeshIds = m_sceneObjectSubMeshIds[ rSceneObjectIds[ sceneObjectIdIndex ] ];
+        size_t subMeshIdCount = rSubMeshIds.GetSize();
+        for( size_t subMeshIdIndex = 0; subMeshIdIndex < subMeshIdCount; ++subMeshIdIndex )
+        {
+            rSubMeshIndices.Push( rSubMeshIds[ subMeshIdIndex ] );
+        }
+    }
+}
+
+/// Sort a list of sub-meshes from front to back along a given direction.
+///
+/// Sub-meshes are ordered by the distance of their scene object along the direction, and sub-meshes at the same
+/// distance are grouped by the depth-only vertex shader they use and by scene object.
+///
+/// @param[in]     pass             Render pass for which the sub-meshes are being sorted.
+/// @param[in]     rDirection       Direction along which to sort.
+/// @param[in,out] rSubMeshIndices  Indices of the sub-meshes to sort.
+///
+/// @see SortSubMeshesByMaterial()
+void GraphicsScene::SortSubMeshesFrontToBack(
+    DrawKeySorter::EPass pass,
+    const Simd::Vector3& rDirection,
+    DynamicArray< size_t >& rSubMeshIndices )
+{
+    m_drawKeySorter.Clear();
+
+    size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+    for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+    {
+        size_t meshIndex = rSubMeshIndices[ meshIndexIndex ];
+        HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
+
+        size_t sceneObjectId = m_sceneObjectSubMeshes[ meshIndex ].GetSceneObjectId();
+        HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+
+        const GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectId ];
+
+        float32_t depth = Simd::Vector4ToVector3( rSceneObject.GetTransform().GetRow( 3 ) ).Dot( rDirection );
+        uint32_t shaderId = ( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() ? 0 : 1 );
+
+        m_drawKeySorter.Add(
+            DrawKeySorter::MakeDepthKey( pass, depth, shaderId, static_cast< uint32_t >( sceneObjectId ) ),
+            meshIndex );
+    }
+
+    m_drawKeySorter.Sort();
+
+    for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+    {
+        rSubMeshIndices[ meshIndexIndex ] = m_drawKeySorter.GetIndex( meshIndexIndex );
+    }
+}
+
+/// Sort a list of sub-meshes by material in order to reduce render state changes.
+///
+/// Sub-meshes are grouped by pixel and vertex shader variant and skinning first, then by material, then by scene
+/// object.  Sub-meshes without a material are sorted first.
+///
+/// @param[in]     pass             Render pass for which the sub-meshes are being sorted.
+/// @param[in,out] rSubMeshIndices  Indices of the sub-meshes to sort.
+///
+/// @see SortSubMeshesFrontToBack()
+void GraphicsScene::SortSubMeshesByMaterial( DrawKeySorter::EPass pass, DynamicArray< size_t >& rSubMeshIndices )
+{
+    m_drawKeySorter.Clear();
+
+    // Asset IDs span the entire asset registry, so remap the shader variants and materials used by the sub-meshes to
+    // dense indices that fit in the sort key fields.  Index zero is reserved for sub-meshes without a material.
+    m_shaderSortIndices.Clear();
+    m_materialSortIndices.Clear();
+
+    size_t subMeshIndexCount = rSubMeshIndices.GetSize();
+    for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+    {
+        size_t meshIndex = rSubMeshIndices[ meshIndexIndex ];
+        HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
+
+        const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
+
+        size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+        HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+
+        uint32_t shaderId = 0;
+        uint32_t materialId = 0;
+
+        Material* pMaterial = rSubMeshData.GetMaterial();
+        if( pMaterial )
+        {
+            ShaderVariant* pVertexShaderVariant = pMaterial->GetShaderVariant( RShader::TYPE_VERTEX );
+            ShaderVariant* pPixelShaderVariant = pMaterial->GetShaderVariant( RShader::TYPE_PIXEL );
+            uint64_t vertexShaderAssetId =
+                ( pVertexShaderVariant ? pVertexShaderVariant->GetId() : Invalid< uint32_t >() );
+            uint64_t pixelShaderAssetId =
+                ( pPixelShaderVariant ? pPixelShaderVariant->GetId() : Invalid< uint32_t >() );
+
+            const GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectId ];
+            uint32_t skinningId = ( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() ? 0 : 1 );
+
+            uint64_t shaderPairKey = ( pixelShaderAssetId << 32 ) | vertexShaderAssetId;
+            shaderId = ( GetDenseSortIndex( m_shaderSortIndices, shaderPairKey ) << 1 ) | skinningId;
+            materialId = GetDenseSortIndex( m_materialSortIndices, pMaterial->GetId() );
+        }
+
+        m_drawKeySorter.Add(
+            DrawKeySorter::MakeStateKey( pass, shaderId, materialId, static_cast< uint32_t >( sceneObjectId ) ),
+            meshIndex );
+    }
+
+    m_drawKeySorter.Sort();
+
+    for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+    {
+        rSubMeshIndices[ meshIndexIndex ] = m_drawKeySorter.GetIndex( meshIndexIndex );
+    }
+}
+
 /// Render the specified scene view.
 ///
 /// @param[in] viewIndex  Index of the scene view to render (can be an invalid element, but must be less than the size
@@ -1155,41 +1892,17 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
         return;
     }
 
-    // Determine which scene objects are visible in the current view.
-    m_visibleSceneObjects.UnsetAll();
-
+    // Determine which scene objects are visible in the current view, only visiting the parts of the scene object
+    // tree that intersect the view frustum.
     const Simd::Frustum& rViewFrustum = rView.GetFrustum();
 
-    size_t sceneObjectCount = m_sceneObjects.GetSize();
-    for( size_t sceneObjectIndex = 0; sceneObjectIndex < sceneObjectCount; ++sceneObjectIndex )
-    {
-        if( m_sceneObjects.IsElementValid( sceneObjectIndex ) )
-        {
-            //const AaBox& rObjectBounds = m_sceneObjects[ sceneObjectIndex ].GetWorldBox();
-            const Simd::Sphere& rObjectBounds = m_sceneObjects[ sceneObjectIndex ].GetWorldSphere();
-            if( rViewFrustum.Intersects( rObjectBounds ) )
-            {
-                m_visibleSceneObjects.SetElement( sceneObjectIndex );
-            }
-        }
-    }
+    m_visibleSceneObjectIds.Resize( 0 );
+    m_sceneObjectTree.Query( rViewFrustum, SceneObjectIdCollector( m_visibleSceneObjectIds ) );
+    CullSceneObjects( rViewFrustum, m_visibleSceneObjectIds );
 
     // Build a list of indices for each visible sub-mesh for sorting.
     m_sceneObjectSubMeshIndices.Resize( 0 );
-
-    size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
-    for( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
-    {
-        if( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
-        {
-            size_t sceneObjectId = m_sceneObjectSubMeshes[ subMeshIndex ].GetSceneObjectId();
-            HELIUM_ASSERT( sceneObjectId < m_visibleSceneObjects.GetSize() );
-            if( m_visibleSceneObjects[ sceneObjectId ] )
-            {
-                m_sceneObjectSubMeshIndices.Push( subMeshIndex );
-            }
-        }
-    }
+    GatherSceneObjectSubMeshes( m_visibleSceneObjectIds, m_sceneObjectSubMeshIndices );
 
     // Get the renderer interface and the main command proxy for the renderer.
     Renderer* pRenderer = Renderer::GetStaticInstance();
@@ -1350,8 +2063,12 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 
 /// Draw the shadow depth render pass.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort by depth if rendering is performed.
+/// - Each shadow cascade is rendered into its own tile of the shadow depth texture.  Cached cascades whose tile still
+///   holds valid depth data are skipped.
+/// - Shadow casters are culled separately from the visible sub-mesh list, as objects outside the view can still cast
+///   shadows into it.  Casters must be inside the cascade's shadow projection and able to cast a shadow into the
+///   view frustum region clipped to the end of the cascade.  The resulting m_shadowCasterSubMeshIndices list is
+///   sorted by depth if rendering is performed.
 /// - Default rasterizer and depth states should be already set.
 ///
 /// @param[in] viewIndex  Index of the view for which the shadow depth pass is being rendered.
@@ -1414,14 +2131,6 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
     HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
     RVertexShader* pPrePassSmoothSkinningVertexShader = static_cast< RVertexShader* >( pPrePassShaderResource );
 
-    // Make sure the shadow depth pass constant buffer exists.
-    RConstantBuffer* pShadowViewVertexDataBuffer =
-        m_shadowViewVertexDataBuffers[ m_constantBufferSetIndex ][ viewIndex ];
-    if( !pShadowViewVertexDataBuffer )
-    {
-        return;
-    }
-
     // Retrieve the shadow depth texture resource (this should exist if shadows are enabled).
     RTexture2d* pShadowDepthTexture = rRenderResourceManager.GetShadowDepthTexture();
     HELIUM_ASSERT( pShadowDepthTexture );
@@ -1433,22 +2142,22 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
     RSurfacePtr spShadowDepthTextureSurface = pShadowDepthTexture->GetSurface( 0 );
     HELIUM_ASSERT( spShadowDepthTextureSurface );
 
-    // Sort meshes based on distance from front to back in order to reduce overdraw.
-    size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+    // Each cascade is rendered into its own tile of the shadow depth texture.  Tiles only keep their contents while
+    // the same shadow depth texture is in use.
+    uint32_t cascadeCount = rRenderResourceManager.GetShadowCascadeCount();
+    uint32_t cascadeCacheStart = ( shadowMode == GraphicsConfig::EShadowMode::CASCADED
+        ? rRenderResourceManager.GetShadowCascadeCacheStart()
+        : cascadeCount );
+    uint32_t tileGridSize = GetShadowCascadeTileGridSize( cascadeCount );
+    uint32_t tileSize = shadowDepthTextureUsableSize / tileGridSize;
 
+    if( m_spShadowCascadeTileTexture != pShadowDepthTexture )
     {
-		SortJob< size_t, SubMeshFrontToBackCompare > job;
-
-        SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = job.GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshFrontToBackCompare(
-            m_directionalLightDirection,
-            m_sceneObjects,
-            m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
-
-		job.Run();
+        m_spShadowCascadeTileTexture = pShadowDepthTexture;
+        for( size_t tileIndex = 0; tileIndex < HELIUM_ARRAY_COUNT( m_shadowCascadeTileOwners ); ++tileIndex )
+        {
+            SetInvalid( m_shadowCascadeTileOwners[ tileIndex ] );
+        }
     }
 
     // Prepare the shadow depth pass scene for rendering.
@@ -1464,7 +2173,6 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
     HELIUM_ASSERT( spSceneTextureSurface );
 
     spCommandProxy->SetRenderSurfaces( spSceneTextureSurface, spShadowDepthTextureSurface );
-    spCommandProxy->SetViewport( 0, 0, shadowDepthTextureUsableSize, shadowDepthTextureUsableSize );
 
     RRasterizerState* pRasterizerStateShadowDepth = rRenderResourceManager.GetRasterizerState(
         RenderResourceManager::RASTERIZER_STATE_SHADOW_DEPTH );
@@ -1474,18 +2182,104 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
         RenderResourceManager::BLEND_STATE_NO_COLOR );
     spCommandProxy->SetBlendState( pBlendStateNoColor );
 
-    // Draw the scene.
+    // Draw the scene for each cascade.
     spCommandProxy->BeginScene();
-    spCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
-
-    spCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
     spCommandProxy->SetPixelShader( NULL );
 
+    for( uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+    {
+        size_t shadowCascadeIndex = viewIndex * GraphicsConfig::MAX_SHADOW_CASCADE_COUNT + cascadeIndex;
+        HELIUM_ASSERT( shadowCascadeIndex < m_shadowCascades.GetSize() );
+        ShadowCascade& rCascade = m_shadowCascades[ shadowCascadeIndex ];
+
+        // Skip cached cascades whose depth data is still in their tile.
+        bool bCached = ( cascadeIndex >= cascadeCacheStart );
+        if( bCached && rCascade.bCacheValid && m_shadowCascadeTileOwners[ cascadeIndex ] == shadowCascadeIndex )
+        {
+            continue;
+        }
+
+        // Make sure the shadow depth pass constant buffer exists.
+        RConstantBuffer* pShadowViewVertexDataBuffer =
+            m_shadowViewVertexDataBuffers[ m_constantBufferSetIndex ][ shadowCascadeIndex ];
+        if( !pShadowViewVertexDataBuffer )
+        {
+            continue;
+        }
+
+        // Find the shadow casters, first by searching the scene object tree for objects inside the shadow
+        // projection, then by discarding any whose shadow cannot reach the part of the view covered by the cascade.
+        // Cached cascades keep all casters in their projection, as the view can move anywhere within it before the
+        // cascade is rendered again.
+        m_shadowCasterSceneObjectIds.Resize( 0 );
+        m_sceneObjectTree.Query( rCascade.shadowFrustum, SceneObjectIdCollector( m_shadowCasterSceneObjectIds ) );
+        if( bCached )
+        {
+            CullSceneObjects( rCascade.shadowFrustum, m_shadowCasterSceneObjectIds );
+        }
+        else
+        {
+            CullSceneObjects(
+                SphereFrustumCuller( rCascade.clippedViewFrustum, m_directionalLightDirection ),
+                m_shadowCasterSceneObjectIds );
+        }
+
+        m_shadowCasterSubMeshIndices.Resize( 0 );
+        GatherSceneObjectSubMeshes( m_shadowCasterSceneObjectIds, m_shadowCasterSubMeshIndices );
+
+        // Sort meshes based on distance from front to back in order to reduce overdraw.
+        SortSubMeshesFrontToBack(
+            DrawKeySorter::PASS_SHADOW_DEPTH,
+            m_directionalLightDirection,
+            m_shadowCasterSubMeshIndices );
+
+        // Draw the cascade into its tile.
+        spCommandProxy->SetViewport(
+            ( cascadeIndex % tileGridSize ) * tileSize,
+            ( cascadeIndex / tileGridSize ) * tileSize,
+            tileSize,
+            tileSize );
+        spCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
+
+        spCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
+
+        DrawShadowCasters( pPrePassNoSkinningVertexShader, pPrePassSmoothSkinningVertexShader );
+
+        m_shadowCascadeTileOwners[ cascadeIndex ] = shadowCascadeIndex;
+        rCascade.bCacheValid = bCached;
+    }
+
+    spCommandProxy->EndScene();
+}
+
+/// Draw the sub-meshes in the shadow caster list for the current shadow depth pass cascade.
+///
+/// - The shadow depth render surfaces, viewport, and per-cascade constant buffer should be already set.
+///
+/// @param[in] pNoSkinningVertexShader      Shadow depth vertex shader for meshes without skinning.
+/// @param[in] pSmoothSkinningVertexShader  Shadow depth vertex shader for skinned meshes.
+///
+/// @see DrawShadowDepthPass()
+void GraphicsScene::DrawShadowCasters(
+    RVertexShader* pNoSkinningVertexShader,
+    RVertexShader* pSmoothSkinningVertexShader )
+{
+    HELIUM_ASSERT( pNoSkinningVertexShader );
+    HELIUM_ASSERT( pSmoothSkinningVertexShader );
+
+    Renderer* pRenderer = Renderer::GetStaticInstance();
+    HELIUM_ASSERT( pRenderer );
+
+    RRenderCommandProxyPtr spCommandProxy = pRenderer->GetImmediateCommandProxy();
+    HELIUM_ASSERT( spCommandProxy );
+
+    size_t subMeshIndexCount = m_shadowCasterSubMeshIndices.GetSize();
+
     RVertexShader* pPreviousVertexShader = NULL;
 
     for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
     {
-        size_t meshIndex = m_sceneObjectSubMeshIndices[ meshIndexIndex ];
+        size_t meshIndex = m_shadowCasterSubMeshIndices[ meshIndexIndex ];
         HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
         GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
@@ -1530,11 +2324,11 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
         RVertexShader* pVertexShader;
         if( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() )
         {
-            pVertexShader = pPrePassNoSkinningVertexShader;
+            pVertexShader = pNoSkinningVertexShader;
         }
         else
         {
-            pVertexShader = pPrePassSmoothSkinningVertexShader;
+            pVertexShader = pSmoothSkinningVertexShader;
         }
 
         pVertexShader->CacheDescription( pRenderer, pVertexDescription );
@@ -1573,7 +2367,6 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
             primitiveCount );
     }
 
-    spCommandProxy->EndScene();
 }
 
 /// Draw the depth-only pre-pass for the given scene view.
@@ -1642,16 +2435,7 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
     const Simd::Vector3& rViewDirection = rView.GetForward();
 
     size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
-
-    {
-		SortJob< size_t, SubMeshFrontToBackCompare > job;
-        SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = job.GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshFrontToBackCompare( rViewDirection, m_sceneObjects, m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
-		job.Run();
-    }
+    SortSubMeshesFrontToBack( DrawKeySorter::PASS_DEPTH_PRE_PASS, rViewDirection, m_sceneObjectSubMeshIndices );
 
     // Initialize the blend state and shaders for performing no color writes.
     Renderer* pRenderer = Renderer::GetStaticInstance();
@@ -1800,7 +2584,8 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
     {
         GetNoneOptionName(),
         Name( TXT( "SHADOWS_SIMPLE" ) ),
-        Name( TXT( "SHADOWS_PCF_DITHERED" ) )
+        Name( TXT( "SHADOWS_PCF_DITHERED" ) ),
+        Name( TXT( "SHADOWS_CASCADED" ) )
     };
 
     Shader::SelectPair systemSelections[] =
@@ -1823,17 +2608,7 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 
     // Sort meshes based on material in order to reduce shader switches.
     size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
-
-	{
-		SortJob< size_t, SubMeshMaterialCompare > job;
-        SortJob< size_t, SubMeshMaterialCompare >::Parameters& rParameters = job.GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshMaterialCompare( m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
-
-		job.Run();
-    }
+    SortSubMeshesByMaterial( DrawKeySorter::PASS_BASE, m_sceneObjectSubMeshIndices );
 
     // Set the opaque rendering blend state and per-view constant buffers for this pass.
     Renderer* pRenderer = Renderer::GetStaticInstance();
@@ -2150,110 +2925,12 @@ Name GraphicsScene::GetSkinningRigidOptionName()
 }
 
 /// Constructor.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare()
-: m_cameraDirection( 0.0f )
-, m_pSceneObjects( NULL )
-, m_pSubMeshes( NULL )
+GraphicsScene::ShadowCascade::ShadowCascade()
+: inverseViewProjection( Simd::Matrix44::IDENTITY )
+, projectionCenterX( 0.0f )
+, projectionCenterY( 0.0f )
+, projectionSize( 1.0f )
+, splitDepth( 0.0f )
+, bCacheValid( false )
 {
 }
-
-/// Constructor.
-///
-/// @param[in] rCameraDirection  Camera world direction.
-/// @param[in] rSceneObjects     List of graphics scene objects in the scene.
-/// @param[in] rSubMeshes        List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare(
-    const Simd::Vector3& rCameraDirection,
-    const SparseArray< GraphicsSceneObject >& rSceneObjects,
-    const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-    : m_cameraDirection( rCameraDirection )
-    , m_pSceneObjects( &rSceneObjects )
-    , m_pSubMeshes( &rSubMeshes )
-{
-}
-
-/// Compare two sub-meshes for sorting.
-///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
-///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshFrontToBackCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
-{
-    const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-    const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-    size_t sceneObjectIndex0 = rSubMesh0.GetSceneObjectId();
-    HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex0 ) );
-    size_t sceneObjectIndex1 = rSubMesh1.GetSceneObjectId();
-    HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex1 ) );
-
-    const GraphicsSceneObject& rSceneObject0 = m_pSceneObjects->GetElement( sceneObjectIndex0 );
-    const GraphicsSceneObject& rSceneObject1 = m_pSceneObjects->GetElement( sceneObjectIndex1 );
-
-    Simd::Vector3 object0Pos = Simd::Vector4ToVector3( rSceneObject0.GetTransform().GetRow( 3 ) );
-    Simd::Vector3 object1Pos = Simd::Vector4ToVector3( rSceneObject1.GetTransform().GetRow( 3 ) );
-
-    float distance0 = object0Pos.Dot( m_cameraDirection );
-    float distance1 = object1Pos.Dot( m_cameraDirection );
-
-    return ( distance0 < distance1 );
-}
-
-/// Constructor.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare()
-: m_pSubMeshes( NULL )
-{
-}
-
-/// Constructor.
-///
-/// @param[in] rSubMeshes  List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare(
-    const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-    : m_pSubMeshes( &rSubMeshes )
-{
-}
-
-/// Compare two sub-meshes for sorting.
-///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
-///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshMaterialCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
-{
-    const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-    const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-    Material* pMaterial0 = rSubMesh0.GetMaterial();
-    Material* pMaterial1 = rSubMesh1.GetMaterial();
-    if( pMaterial0 == pMaterial1 )
-    {
-        return false;
-    }
-
-    if( !pMaterial0 )
-    {
-        return true;
-    }
-
-    if( !pMaterial1 )
-    {
-        return false;
-    }
-
-    ShaderVariant* pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_VERTEX );
-    ShaderVariant* pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_VERTEX );
-    if( pVariant0 != pVariant1 )
-    {
-        return ( pVariant0 < pVariant1 );
-    }
-
-    pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_PIXEL );
-    pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_PIXEL );
-
-    return ( pVariant0 < pVariant1 );
-}
@@ -3,9 +3,13 @@
 #include "Graphics/Graphics.h"
 //#include "Engine/Asset.h"
 #include "Reflect/Object.h"
+#include "Foundation/HashMap.h"
 
-#include "Foundation/BitArray.h"
 #include "Rendering/RRenderResource.h"
+#include "Graphics/BoundingVolumeTree.h"
+#include "Graphics/DrawKeySorter.h"
+#include "Graphics/GraphicsConfig.h"
+#include "Graphics/SphereFrustumCuller.h"
 #include "GraphicsTypes/GraphicsSceneObject.h"
 #include "GraphicsTypes/GraphicsSceneView.h"
 
@@ -17,6 +21,9 @@
 namespace Helium
 {
     HELIUM_DECLARE_RPTR( RConstantBuffer );
+    HELIUM_DECLARE_RPTR( RTexture2d );
+
+    class RVertexShader;
 
     class HELIUM_GRAPHICS_API SceneObjectTransform : public Helium::Component
     {
@@ -56,6 +63,12 @@ namespace Helium
         size_t AllocateSceneObject();
         void ReleaseSceneObject( size_t id );
         inline GraphicsSceneObject* GetSceneObject( size_t id );
+
+        void SetSceneObjectWorldBounds( size_t id, const Simd::AaBox& rBox );
+        void SetSceneObjectVertexData(
+            size_t id, RVertexBuffer* pVertexBuffer, RVertexDescription* pVertexDescription, uint32_t vertexStride );
+        void SetSceneObjectIndexBuffer( size_t id, RIndexBuffer* pIndexBuffer );
+        void SetSceneObjectBonePalette( size_t id, const Simd::Matrix44* pTransforms );
         //@}
 
         /// @name Scene Asset Sub-mesh Allocation
@@ -63,6 +76,10 @@ namespace Helium
         size_t AllocateSceneObjectSubMeshData( size_t sceneObjectId );
         void ReleaseSceneObjectSubMeshData( size_t id );
         inline GraphicsSceneObject::SubMeshData* GetSceneObjectSubMeshData( size_t id );
+
+        void SetSceneObjectSubMeshPrimitives(
+            size_t id, ERendererPrimitiveType type, uint32_t primitiveCount, uint32_t startVertex, uint32_t vertexRange,
+            uint32_t startIndex );
         //@}
 
         /// @name Lighting
@@ -96,50 +113,30 @@ namespace Helium
         //@}
 
     private:
-        /// Front-to-back sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshFrontToBackCompare
+        /// Shadow depth rendering data for a single shadow cascade of a scene view.
+        struct ShadowCascade
         {
-        public:
-            /// @name Construction/Destruction
-            //@{
-            SubMeshFrontToBackCompare();
-            SubMeshFrontToBackCompare(
-                const Simd::Vector3& rCameraDirection, const SparseArray< GraphicsSceneObject >& rSceneObjects,
-                const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
+            /// Shadow depth pass inverse view/projection matrix.
+            Simd::Matrix44 inverseViewProjection;
+            /// Region covered by the shadow projection.
+            Simd::Frustum shadowFrustum;
+            /// View frustum clipped to the far end of the cascade (region into which casters must cast shadows).
+            Simd::Frustum clippedViewFrustum;
+            /// Shadow projection center along the light view's horizontal axis.
+            float32_t projectionCenterX;
+            /// Shadow projection center along the light view's vertical axis.
+            float32_t projectionCenterY;
+            /// Shadow projection width and height.
+            float32_t projectionSize;
+            /// View depth at which the cascade ends.
+            float32_t splitDepth;
+            /// True if the depth data last rendered for this cascade can be reused.
+            bool bCacheValid;
 
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
-            //@}
-
-        private:
-            /// Camera direction.
-            Simd::Vector3 m_cameraDirection;
-            /// Scene object list.
-            const SparseArray< GraphicsSceneObject >* m_pSceneObjects;
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
-        };
-
-        /// Material-based sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshMaterialCompare
-        {
-        public:
             /// @name Construction/Destruction
             //@{
-            SubMeshMaterialCompare();
-            explicit SubMeshMaterialCompare( const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
-
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
+            ShadowCascade();
             //@}
-
-        private:
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
         };
 
         /// Scene view list.
@@ -158,10 +155,34 @@ namespace Helium
         DynamicArray< BufferedDrawer* > m_viewBufferedDrawers;
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
-        /// Visible scene objects for the current view.
-        BitArray<> m_visibleSceneObjects;
+        /// Hierarchy of scene object bounds used for visibility culling.
+        BoundingVolumeTree m_sceneObjectTree;
+        /// Proxy ID of each scene object in the scene object tree (invalid until its bounds are first set).
+        DynamicArray< uint32_t > m_sceneObjectProxyIds;
+        /// Sub-mesh data IDs belonging to each scene object.
+        DynamicArray< DynamicArray< size_t > > m_sceneObjectSubMeshIds;
+        /// Scene object bounding sphere center X coordinates (packed for SIMD culling).
+        DynamicArray< float32_t > m_sceneObjectSphereCentersX;
+        /// Scene object bounding sphere center Y coordinates (packed for SIMD culling).
+        DynamicArray< float32_t > m_sceneObjectSphereCentersY;
+        /// Scene object bounding sphere center Z coordinates (packed for SIMD culling).
+        DynamicArray< float32_t > m_sceneObjectSphereCentersZ;
+        /// Scene object bounding sphere radii (packed for SIMD culling).
+        DynamicArray< float32_t > m_sceneObjectSphereRadii;
+        /// Visible scene object ID list for the current view.
+        DynamicArray< size_t > m_visibleSceneObjectIds;
+        /// Shadow caster scene object ID list for the current view.
+        DynamicArray< size_t > m_shadowCasterSceneObjectIds;
+        /// Shadow caster sub-mesh index list for the current view (for sorting during shadow depth rendering).
+        DynamicArray< size_t > m_shadowCasterSubMeshIndices;
         /// Scene object sub-data index list (for sorting during rendering).
         DynamicArray< size_t > m_sceneObjectSubMeshIndices;
+        /// Draw key sorter used to order sub-meshes during rendering.
+        DrawKeySorter m_drawKeySorter;
+        /// Dense sort indices of the pixel/vertex shader variant asset ID pairs used by the sub-meshes being sorted.
+        HashMap< uint64_t, uint32_t > m_shaderSortIndices;
+        /// Dense sort indices of the material asset IDs used by the sub-meshes being sorted.
+        HashMap< uint32_t, uint32_t > m_materialSortIndices;
 
         /// Ambient light top color.
         Color m_ambientLightTopColor;
@@ -182,8 +203,13 @@ namespace Helium
         /// ID of the currently active scene view.
         uint32_t m_activeViewId;
 
-        /// Pre-computed shadow depth pass inverse view/projection matrices.
-        DynamicArray< Simd::Matrix44 > m_shadowViewInverseViewProjectionMatrices;
+        /// Shadow cascades for each view (MAX_SHADOW_CASCADE_COUNT entries per view, only the first of which is used
+        /// unless cascaded shadows are enabled).
+        DynamicArray< ShadowCascade > m_shadowCascades;
+        /// Index in m_shadowCascades of the cascade last rendered into each shadow depth texture tile.
+        size_t m_shadowCascadeTileOwners[ GraphicsConfig::MAX_SHADOW_CASCADE_COUNT ];
+        /// Shadow depth texture into which the shadow depth texture tiles were last rendered.
+        RTexture2dPtr m_spShadowCascadeTileTexture;
 
         /// Per-view global vertex constant buffers.
         DynamicArray< RConstantBufferPtr > m_viewVertexGlobalDataBuffers[ 2 ];
@@ -195,7 +221,7 @@ namespace Helium
         /// Per-view base-pass pixel constant buffers.
         DynamicArray< RConstantBufferPtr > m_viewPixelBasePassDataBuffers[ 2 ];
 
-        /// Per-view vertex constant buffers for shadow depth rendering.
+        /// Per-cascade vertex constant buffers for shadow depth rendering (indexed as m_shadowCascades).
         DynamicArray< RConstantBufferPtr > m_shadowViewVertexDataBuffers[ 2 ];
 
         /// Pool of per-instance vertex constant buffers for non-skinned meshes.
@@ -220,12 +246,26 @@ namespace Helium
         //@{
         void UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIndex );
         void UpdateShadowInverseViewProjectionMatrixLspsm( size_t viewIndex );
+        void UpdateShadowCascades( size_t viewIndex );
+
+        void InvalidateShadowCascadeCaches();
+        void InvalidateShadowCascadeCaches( const Simd::Sphere& rSphere );
+        void InvalidateSceneObjectShadowCascadeCaches( size_t sceneObjectId );
 
         void SwapDynamicConstantBuffers();
 
+        void CullSceneObjects( const Simd::Frustum& rFrustum, DynamicArray< size_t >& rSceneObjectIds );
+        void CullSceneObjects( const SphereFrustumCuller& rCuller, DynamicArray< size_t >& rSceneObjectIds );
+        void GatherSceneObjectSubMeshes( const DynamicArray< size_t >& rSceneObjectIds, DynamicArray< size_t >& rSubMeshIndices );
+
+        void SortSubMeshesFrontToBack(
+            DrawKeySorter::EPass pass, const Simd::Vector3& rDirection, DynamicArray< size_t >& rSubMeshIndices );
+        void SortSubMeshesByMaterial( DrawKeySorter::EPass pass, DynamicArray< size_t >& rSubMeshIndices );
+
         void DrawSceneView( uint_fast32_t viewIndex );
 
         void DrawShadowDepthPass( uint_fast32_t viewIndex );
+        void DrawShadowCasters( RVertexShader* pNoSkinningVertexShader, RVertexShader* pSmoothSkinningVertexShader );
         void DrawDepthPrePass( uint_fast32_t viewIndex );
         void DrawBasePass( uint_fast32_t viewIndex );
         //@}
@@ -24,6 +24,9 @@ RenderResourceManager::RenderResourceManager()
     , m_viewportWidthMax( 0 )
     , m_viewportHeightMax( 0 )
     , m_shadowDepthTextureUsableSize( 0 )
+    , m_shadowCascadeCount( 1 )
+    , m_shadowCascadeSplitLambda( 0.0f )
+    , m_shadowCascadeCacheStart( 1 )
 {
 }
 
@@ -519,6 +522,9 @@ void RenderResourceManager::PostConfigUpdate()
 
     m_shadowMode = GraphicsConfig::EShadowMode::NONE;
     m_shadowDepthTextureUsableSize = 0;
+    m_shadowCascadeCount = 1;
+    m_shadowCascadeSplitLambda = 0.0f;
+    m_shadowCascadeCacheStart = 1;
 
     // Get the renderer and graphics configuration.
     Renderer* pRenderer = Renderer::GetStaticInstance();
@@ -595,6 +601,15 @@ void RenderResourceManager::PostConfigUpdate()
     m_shadowMode = shadowMode;
     m_shadowDepthTextureUsableSize = shadowBufferUsableSize;
 
+    // Cascaded shadows split the shadow buffer into a grid of tiles, one for each cascade.
+    if( shadowMode == GraphicsConfig::EShadowMode::CASCADED )
+    {
+        uint32_t shadowCascadeCountMax = GraphicsConfig::MAX_SHADOW_CASCADE_COUNT;
+        m_shadowCascadeCount = Max< uint32_t >( Min( spGraphicsConfig->GetShadowCascadeCount(), shadowCascadeCountMax ), 1 );
+        m_shadowCascadeSplitLambda = Max( Min( spGraphicsConfig->GetShadowCascadeSplitLambda(), 1.0f ), 0.0f );
+        m_shadowCascadeCacheStart = Min( spGraphicsConfig->GetShadowCascadeCacheStart(), m_shadowCascadeCount );
+    }
+
     // Recreate render and depth targets.
     UpdateMaxViewportSize( spGraphicsConfig->m_width, spGraphicsConfig->m_height );
 	
@@ -171,6 +171,9 @@ namespace Helium
 
         inline GraphicsConfig::EShadowMode GetShadowMode() const;
         inline uint32_t GetShadowDepthTextureUsableSize() const;
+        inline uint32_t GetShadowCascadeCount() const;
+        inline float32_t GetShadowCascadeSplitLambda() const;
+        inline uint32_t GetShadowCascadeCacheStart() const;
         //@}
 
         /// @name Static Access
@@ -238,6 +241,12 @@ namespace Helium
 
         /// Shadow depth texture usable size (cached from graphics config object value).
         uint32_t m_shadowDepthTextureUsableSize;
+        /// Number of shadow cascades in use (one unless cascaded shadows are enabled).
+        uint32_t m_shadowCascadeCount;
+        /// Shadow cascade split weight (cached from graphics config object value).
+        float32_t m_shadowCascadeSplitLambda;
+        /// Index of the first shadow cascade whose depth is kept between frames (cascade count if none are).
+        uint32_t m_shadowCascadeCacheStart;
 
         /// Singleton instance.
         static RenderResourceManager* sm_pInstance;
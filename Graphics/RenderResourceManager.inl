@@ -18,4 +18,35 @@ namespace Helium
     {
         return m_shadowDepthTextureUsableSize;
     }
+
+    /// Get the number of shadow cascades in use.
+    ///
+    /// @return  Number of shadow cascades sharing the shadow depth texture.  This is always one unless cascaded
+    ///          shadows are enabled.
+    ///
+    /// @see GetShadowCascadeSplitLambda(), GetShadowCascadeCacheStart()
+    uint32_t RenderResourceManager::GetShadowCascadeCount() const
+    {
+        return m_shadowCascadeCount;
+    }
+
+    /// Get the weight used to blend between uniform and logarithmic placement of shadow cascade splits.
+    ///
+    /// @return  Shadow cascade split weight, from 0 (uniform) to 1 (logarithmic).
+    ///
+    /// @see GetShadowCascadeCount()
+    float32_t RenderResourceManager::GetShadowCascadeSplitLambda() const
+    {
+        return m_shadowCascadeSplitLambda;
+    }
+
+    /// Get the index of the first shadow cascade whose depth is kept between frames.
+    ///
+    /// @return  Index of the first cached shadow cascade, or the cascade count if no cascades are cached.
+    ///
+    /// @see GetShadowCascadeCount()
+    uint32_t RenderResourceManager::GetShadowCascadeCacheStart() const
+    {
+        return m_shadowCascadeCacheStart;
+    }
 }
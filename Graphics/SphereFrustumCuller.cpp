@@ -0,0 +1,154 @@
+#include "GraphicsPch.h"
+#include "Graphics/SphereFrustumCuller.h"
+
+#include "MathSimd/Plane.h"
+#include "MathSimd/Vector4.h"
+
+using namespace Helium;
+
+const size_t SphereFrustumCuller::BATCH_SIZE;
+
+/// Constructor.
+///
+/// @param[in] rFrustum  Frustum against which to test spheres.
+SphereFrustumCuller::SphereFrustumCuller( const Simd::Frustum& rFrustum )
+{
+    for( size_t planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+    {
+        Simd::Vector4 plane( rFrustum.GetPlane( static_cast< Simd::Frustum::EPlane >( planeIndex ) ).GetSimdVector() );
+        m_planeA[ planeIndex ] = plane.GetElement( 0 );
+        m_planeB[ planeIndex ] = plane.GetElement( 1 );
+        m_planeC[ planeIndex ] = plane.GetElement( 2 );
+        m_planeD[ planeIndex ] = plane.GetElement( 3 );
+    }
+}
+
+/// Constructor.
+///
+/// Spheres are treated as swept infinitely along the given direction, so a sphere passes if any part of its sweep
+/// intersects the frustum.  This is used to find shadow casters for a directional light: an object can only cast a
+/// shadow into the frustum if it lies on the light side of every frustum plane the light travels out through.
+///
+/// Testing only against those planes is conservative; a few swept spheres that pass every remaining plane may
+/// still miss the frustum near its corners.
+///
+/// @param[in] rFrustum         Frustum against which to test spheres.
+/// @param[in] rSweepDirection  Direction along which spheres are swept (need not be normalized).
+SphereFrustumCuller::SphereFrustumCuller( const Simd::Frustum& rFrustum, const Simd::Vector3& rSweepDirection )
+{
+    float32_t sweepX = rSweepDirection.GetElement( 0 );
+    float32_t sweepY = rSweepDirection.GetElement( 1 );
+    float32_t sweepZ = rSweepDirection.GetElement( 2 );
+
+    for( size_t planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+    {
+        Simd::Vector4 plane( rFrustum.GetPlane( static_cast< Simd::Frustum::EPlane >( planeIndex ) ).GetSimdVector() );
+        float32_t planeA = plane.GetElement( 0 );
+        float32_t planeB = plane.GetElement( 1 );
+        float32_t planeC = plane.GetElement( 2 );
+
+        // Every sweep eventually crosses to the inside of planes facing against the sweep direction, so replace
+        // them with a plane that all spheres pass.
+        if( planeA * sweepX + planeB * sweepY + planeC * sweepZ > 0.0f )
+        {
+            m_planeA[ planeIndex ] = 0.0f;
+            m_planeB[ planeIndex ] = 0.0f;
+            m_planeC[ planeIndex ] = 0.0f;
+            m_planeD[ planeIndex ] = 0.0f;
+        }
+        else
+        {
+            m_planeA[ planeIndex ] = planeA;
+            m_planeB[ planeIndex ] = planeB;
+            m_planeC[ planeIndex ] = planeC;
+            m_planeD[ planeIndex ] = plane.GetElement( 3 );
+        }
+    }
+}
+
+/// Test a batch of spheres against the frustum.
+///
+/// A sphere is considered visible unless it lies entirely behind one of the frustum planes, which matches
+/// Simd::Frustum::Intersects() for spheres.
+///
+/// @param[in] rBatch       Sphere data to test.
+/// @param[in] sphereCount  Number of spheres in the batch to test (no more than BATCH_SIZE).
+///
+/// @return  Mask with the bit for each sphere that intersects the frustum set.
+uint64_t SphereFrustumCuller::TestBatch( const Batch& rBatch, size_t sphereCount ) const
+{
+    HELIUM_ASSERT( sphereCount <= BATCH_SIZE );
+
+    uint64_t visibleMask = 0;
+
+#if HELIUM_SIMD_SSE
+    Simd::Register planeA[ PLANE_COUNT ];
+    Simd::Register planeB[ PLANE_COUNT ];
+    Simd::Register planeC[ PLANE_COUNT ];
+    Simd::Register planeD[ PLANE_COUNT ];
+    for( size_t planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+    {
+        planeA[ planeIndex ] = Simd::SetSplatF32( m_planeA[ planeIndex ] );
+        planeB[ planeIndex ] = Simd::SetSplatF32( m_planeB[ planeIndex ] );
+        planeC[ planeIndex ] = Simd::SetSplatF32( m_planeC[ planeIndex ] );
+        planeD[ planeIndex ] = Simd::SetSplatF32( m_planeD[ planeIndex ] );
+    }
+
+    Simd::Register zeroVec = Simd::SetSplatF32( 0.0f );
+
+    // Spheres past the requested count are tested along with the rest of their group and masked off afterward.
+    for( size_t sphereIndex = 0; sphereIndex < sphereCount; sphereIndex += 4 )
+    {
+        Simd::Register centersX = Simd::LoadAligned( rBatch.centersX + sphereIndex );
+        Simd::Register centersY = Simd::LoadAligned( rBatch.centersY + sphereIndex );
+        Simd::Register centersZ = Simd::LoadAligned( rBatch.centersZ + sphereIndex );
+        Simd::Register negRadii = Simd::SubtractF32( zeroVec, Simd::LoadAligned( rBatch.radii + sphereIndex ) );
+
+        Simd::Register insideMask = _mm_cmpeq_ps( zeroVec, zeroVec );
+        for( size_t planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+        {
+            Simd::Register distances = Simd::AddF32(
+                Simd::AddF32(
+                    Simd::MultiplyF32( planeA[ planeIndex ], centersX ),
+                    Simd::MultiplyF32( planeB[ planeIndex ], centersY ) ),
+                Simd::AddF32(
+                    Simd::MultiplyF32( planeC[ planeIndex ], centersZ ),
+                    planeD[ planeIndex ] ) );
+            insideMask = _mm_and_ps( insideMask, _mm_cmpge_ps( distances, negRadii ) );
+        }
+
+        visibleMask |= static_cast< uint64_t >( _mm_movemask_ps( insideMask ) ) << sphereIndex;
+    }
+#else
+    for( size_t sphereIndex = 0; sphereIndex < sphereCount; ++sphereIndex )
+    {
+        float32_t centerX = rBatch.centersX[ sphereIndex ];
+        float32_t centerY = rBatch.centersY[ sphereIndex ];
+        float32_t centerZ = rBatch.centersZ[ sphereIndex ];
+        float32_t negRadius = -rBatch.radii[ sphereIndex ];
+
+        size_t planeIndex;
+        for( planeIndex = 0; planeIndex < PLANE_COUNT; ++planeIndex )
+        {
+            float32_t distance = m_planeA[ planeIndex ] * centerX + m_planeB[ planeIndex ] * centerY +
+                m_planeC[ planeIndex ] * centerZ + m_planeD[ planeIndex ];
+            if( distance < negRadius )
+            {
+                break;
+            }
+        }
+
+        if( planeIndex == PLANE_COUNT )
+        {
+            visibleMask |= static_cast< uint64_t >( 1 ) << sphereIndex;
+        }
+    }
+#endif  // HELIUM_SIMD_SSE
+
+    if( sphereCount < BATCH_SIZE )
+    {
+        visibleMask &= ( static_cast< uint64_t >( 1 ) << sphereCount ) - 1;
+    }
+
+    return visibleMask;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "MathSimd/Frustum.h"
+#include "MathSimd/Vector3.h"
+
+namespace Helium
+{
+    /// Frustum test for batches of bounding spheres stored in structure-of-arrays form.
+    ///
+    /// The frustum planes are captured once, and each batch is tested against all planes several spheres at a time
+    /// using SIMD registers, producing a bit mask of the spheres that intersect the frustum.
+    class HELIUM_GRAPHICS_API SphereFrustumCuller
+    {
+    public:
+        /// Maximum number of spheres in a batch (one bit per sphere in the result mask).
+        static const size_t BATCH_SIZE = 64;
+
+        /// Sphere batch data (SIMD-aligned, unused entries past the sphere count are ignored).
+        HELIUM_SIMD_ALIGN_PRE struct Batch
+        {
+            /// Sphere center X coordinates.
+            float32_t centersX[ BATCH_SIZE ];
+            /// Sphere center Y coordinates.
+            float32_t centersY[ BATCH_SIZE ];
+            /// Sphere center Z coordinates.
+            float32_t centersZ[ BATCH_SIZE ];
+            /// Sphere radii.
+            float32_t radii[ BATCH_SIZE ];
+        } HELIUM_SIMD_ALIGN_POST;
+
+        /// @name Construction/Destruction
+        //@{
+        explicit SphereFrustumCuller( const Simd::Frustum& rFrustum );
+        SphereFrustumCuller( const Simd::Frustum& rFrustum, const Simd::Vector3& rSweepDirection );
+        //@}
+
+        /// @name Culling
+        //@{
+        uint64_t TestBatch( const Batch& rBatch, size_t sphereCount ) const;
+        //@}
+
+    private:
+        /// Number of frustum planes.
+        static const size_t PLANE_COUNT = Simd::Frustum::PLANE_MAX;
+
+        /// Plane "A" coefficients.
+        float32_t m_planeA[ PLANE_COUNT ];
+        /// Plane "B" coefficients.
+        float32_t m_planeB[ PLANE_COUNT ];
+        /// Plane "C" coefficients.
+        float32_t m_planeC[ PLANE_COUNT ];
+        /// Plane "D" coefficients.
+        float32_t m_planeD[ PLANE_COUNT ];
+    };
+}
@@ -3,6 +3,7 @@
 #include "GraphicsJobs/GraphicsJobs.h"
 #include "Platform/Assert.h"
 #include "GraphicsTypes/GraphicsSceneObject.h"
+#include "Engine/JobContext.h"
 
 namespace Helium
 {
@@ -48,8 +49,8 @@ public:
 
     /// @name Job Execution
     //@{
-    void Run();
-    inline static void RunCallback( void* pJob );
+    void Run( JobContext* pContext );
+    inline static void RunCallback( void* pJob, JobContext* pContext );
     //@}
 
 private:
@@ -91,8 +92,8 @@ public:
 
     /// @name Job Execution
     //@{
-    void Run();
-    inline static void RunCallback( void* pJob );
+    void Run( JobContext* pContext );
+    inline static void RunCallback( void* pJob, JobContext* pContext );
     //@}
 
 private:
@@ -136,8 +137,8 @@ public:
 
     /// @name Job Execution
     //@{
-    void Run();
-    inline static void RunCallback( void* pJob );
+    void Run( JobContext* pContext );
+    inline static void RunCallback( void* pJob, JobContext* pContext );
     //@}
 
 private:
@@ -179,8 +180,8 @@ public:
 
     /// @name Job Execution
     //@{
-    void Run();
-    inline static void RunCallback( void* pJob );
+    void Run( JobContext* pContext );
+    inline static void RunCallback( void* pJob, JobContext* pContext );
     //@}
 
 private:
@@ -224,8 +225,8 @@ public:
 
     /// @name Job Execution
     //@{
-    void Run();
-    inline static void RunCallback( void* pJob );
+    void Run( JobContext* pContext );
+    inline static void RunCallback( void* pJob, JobContext* pContext );
     //@}
 
 private:
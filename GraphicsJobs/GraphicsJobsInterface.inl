@@ -45,10 +45,11 @@ namespace Helium
 	///
 	/// @param[in] pJob      Job to run.
 	/// @param[in] pContext  Context associated with the running job instance.
-	void UpdateGraphicsSceneConstantBuffersJobSpawner::RunCallback( void* pJob )
+	void UpdateGraphicsSceneConstantBuffersJobSpawner::RunCallback( void* pJob, JobContext* pContext )
 	{
 		HELIUM_ASSERT( pJob );
-		static_cast< UpdateGraphicsSceneConstantBuffersJobSpawner* >( pJob )->Run();
+		HELIUM_ASSERT( pContext );
+		static_cast< UpdateGraphicsSceneConstantBuffersJobSpawner* >( pJob )->Run( pContext );
 	}
 
 	/// Constructor.
@@ -100,10 +101,11 @@ namespace Helium
 	///
 	/// @param[in] pJob      Job to run.
 	/// @param[in] pContext  Context associated with the running job instance.
-	void UpdateGraphicsSceneObjectBuffersJobSpawner::RunCallback( void* pJob )
+	void UpdateGraphicsSceneObjectBuffersJobSpawner::RunCallback( void* pJob, JobContext* pContext )
 	{
 		HELIUM_ASSERT( pJob );
-		static_cast< UpdateGraphicsSceneObjectBuffersJobSpawner* >( pJob )->Run();
+		HELIUM_ASSERT( pContext );
+		static_cast< UpdateGraphicsSceneObjectBuffersJobSpawner* >( pJob )->Run( pContext );
 	}
 
 	/// Constructor.
@@ -155,10 +157,11 @@ namespace Helium
 	///
 	/// @param[in] pJob      Job to run.
 	/// @param[in] pContext  Context associated with the running job instance.
-	void UpdateGraphicsSceneSubMeshBuffersJobSpawner::RunCallback( void* pJob )
+	void UpdateGraphicsSceneSubMeshBuffersJobSpawner::RunCallback( void* pJob, JobContext* pContext )
 	{
 		HELIUM_ASSERT( pJob );
-		static_cast< UpdateGraphicsSceneSubMeshBuffersJobSpawner* >( pJob )->Run();
+		HELIUM_ASSERT( pContext );
+		static_cast< UpdateGraphicsSceneSubMeshBuffersJobSpawner* >( pJob )->Run( pContext );
 	}
 
 	/// Constructor.
@@ -210,10 +213,11 @@ namespace Helium
 	///
 	/// @param[in] pJob      Job to run.
 	/// @param[in] pContext  Context associated with the running job instance.
-	void UpdateGraphicsSceneObjectBuffersJob::RunCallback( void* pJob )
+	void UpdateGraphicsSceneObjectBuffersJob::RunCallback( void* pJob, JobContext* pContext )
 	{
 		HELIUM_ASSERT( pJob );
-		static_cast< UpdateGraphicsSceneObjectBuffersJob* >( pJob )->Run();
+		HELIUM_ASSERT( pContext );
+		static_cast< UpdateGraphicsSceneObjectBuffersJob* >( pJob )->Run( pContext );
 	}
 
 	/// Constructor.
@@ -265,10 +269,11 @@ namespace Helium
 	///
 	/// @param[in] pJob      Job to run.
 	/// @param[in] pContext  Context associated with the running job instance.
-	void UpdateGraphicsSceneSubMeshBuffersJob::RunCallback( void* pJob )
+	void UpdateGraphicsSceneSubMeshBuffersJob::RunCallback( void* pJob, JobContext* pContext )
 	{
 		HELIUM_ASSERT( pJob );
-		static_cast< UpdateGraphicsSceneSubMeshBuffersJob* >( pJob )->Run();
+		HELIUM_ASSERT( pContext );
+		static_cast< UpdateGraphicsSceneSubMeshBuffersJob* >( pJob )->Run( pContext );
 	}
 
 	/// Constructor.
@@ -9,23 +9,24 @@ using namespace Helium;
 /// Spawn jobs to update all instance constant buffers for graphics scene objects and sub-meshes.
 ///
 /// @param[in] pContext  Context in which this job is running.
-void UpdateGraphicsSceneConstantBuffersJobSpawner::Run()
+void UpdateGraphicsSceneConstantBuffersJobSpawner::Run( JobContext* pContext )
 {
-	{
-		// NOTE: These were running in parallel, but now synchronous since we're removing tbb
-		UpdateGraphicsSceneObjectBuffersJobSpawner objectJob;
-		UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters& rObjectParameters = objectJob.GetParameters();
-		rObjectParameters.sceneObjectCount = m_parameters.sceneObjectCount;
-		rObjectParameters.pSceneObjects = m_parameters.pSceneObjects;
-		rObjectParameters.ppConstantBufferData = m_parameters.ppSceneObjectConstantBufferData;
-		objectJob.Run();
+	HELIUM_ASSERT( pContext );
 
-		UpdateGraphicsSceneSubMeshBuffersJobSpawner subMeshJob;
-		UpdateGraphicsSceneSubMeshBuffersJobSpawner::Parameters& rSubMeshParameters = subMeshJob.GetParameters();
-		rSubMeshParameters.subMeshCount = m_parameters.subMeshCount;
-		rSubMeshParameters.pSubMeshes = m_parameters.pSubMeshes;
-		rSubMeshParameters.pSceneObjects = m_parameters.pSceneObjects;
-		rSubMeshParameters.ppConstantBufferData = m_parameters.ppSubMeshConstantBufferData;
-		subMeshJob.Run();
-	}
+	UpdateGraphicsSceneObjectBuffersJobSpawner* pObjectJob =
+		pContext->Create< UpdateGraphicsSceneObjectBuffersJobSpawner >();
+	HELIUM_ASSERT( pObjectJob );
+	UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters& rObjectParameters = pObjectJob->GetParameters();
+	rObjectParameters.sceneObjectCount = m_parameters.sceneObjectCount;
+	rObjectParameters.pSceneObjects = m_parameters.pSceneObjects;
+	rObjectParameters.ppConstantBufferData = m_parameters.ppSceneObjectConstantBufferData;
+
+	UpdateGraphicsSceneSubMeshBuffersJobSpawner* pSubMeshJob =
+		pContext->Create< UpdateGraphicsSceneSubMeshBuffersJobSpawner >();
+	HELIUM_ASSERT( pSubMeshJob );
+	UpdateGraphicsSceneSubMeshBuffersJobSpawner::Parameters& rSubMeshParameters = pSubMeshJob->GetParameters();
+	rSubMeshParameters.subMeshCount = m_parameters.subMeshCount;
+	rSubMeshParameters.pSubMeshes = m_parameters.pSubMeshes;
+	rSubMeshParameters.pSceneObjects = m_parameters.pSceneObjects;
+	rSubMeshParameters.ppConstantBufferData = m_parameters.ppSubMeshConstantBufferData;
 }
@@ -8,7 +8,7 @@ namespace Helium
     /// Update the instance buffer data for a set of graphics scene objects.
     ///
     /// @param[in] pContext  Context in which this job is running.
-    void UpdateGraphicsSceneObjectBuffersJob::Run()
+    void UpdateGraphicsSceneObjectBuffersJob::Run( JobContext* /*pContext*/ )
     {
         const GraphicsSceneObject* pSceneObjects = m_parameters.pSceneObjects;
         HELIUM_ASSERT( pSceneObjects );
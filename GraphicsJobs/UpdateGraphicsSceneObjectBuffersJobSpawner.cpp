@@ -6,12 +6,14 @@ static const uint_fast32_t SCENE_OBJECT_CHILD_JOB_MAX = 128;
 /// Maximum number of graphics scene objects to update in each child job.
 static const uint_fast32_t SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX = 100;
 
-
 using namespace Helium;
 
 /// Spawn jobs to update the constant buffer data for all graphics scene objects.
-void UpdateGraphicsSceneObjectBuffersJobSpawner::Run()
+///
+/// @param[in] pContext  Context in which this job is running.
+void UpdateGraphicsSceneObjectBuffersJobSpawner::Run( JobContext* pContext )
 {
+    HELIUM_ASSERT( pContext );
 
     const GraphicsSceneObject* pSceneObjects = m_parameters.pSceneObjects;
     float32_t* const* ppConstantBufferData = m_parameters.ppConstantBufferData;
@@ -25,34 +27,32 @@ void UpdateGraphicsSceneObjectBuffersJobSpawner::Run()
         jobCount = SCENE_OBJECT_CHILD_JOB_MAX;
     }
 
+    for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+    {
+        uint_fast32_t jobObjectCount = Min( sceneObjectCount, SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX );
+        HELIUM_ASSERT( jobObjectCount != 0 );
+        sceneObjectCount -= jobObjectCount;
+
+        UpdateGraphicsSceneObjectBuffersJob* pJob = pContext->Create< UpdateGraphicsSceneObjectBuffersJob >();
+        HELIUM_ASSERT( pJob );
+        UpdateGraphicsSceneObjectBuffersJob::Parameters& rParameters = pJob->GetParameters();
+        rParameters.sceneObjectCount = static_cast< uint32_t >( jobObjectCount );
+        rParameters.pSceneObjects = pSceneObjects;
+        rParameters.ppConstantBufferData = ppConstantBufferData;
+
+        pSceneObjects += jobObjectCount;
+        ppConstantBufferData += jobObjectCount;
+    }
+
+    // Spawn the remaining objects from a continuation once the current batch of child jobs has completed.
+    if( sceneObjectCount != 0 )
     {
-        for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
-        {
-            uint_fast32_t jobObjectCount = Min( sceneObjectCount, SCENE_OBJECT_CHILD_JOB_OBJECT_COUNT_MAX );
-            HELIUM_ASSERT( jobObjectCount != 0 );
-            sceneObjectCount -= jobObjectCount;
-
-			// NOTE: These were run in parallel but now synchronous since TBB has been removed
-			UpdateGraphicsSceneObjectBuffersJob job;
-            UpdateGraphicsSceneObjectBuffersJob::Parameters& rParameters = job.GetParameters();
-            rParameters.sceneObjectCount = static_cast< uint32_t >( jobObjectCount );
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-
-            pSceneObjects += jobObjectCount;
-            ppConstantBufferData += jobObjectCount;
-        }
-
-		// This was a continuation task but now just exectues inline here since TBB was removed
-        if( sceneObjectCount != 0 )
-        {
-			UpdateGraphicsSceneObjectBuffersJobSpawner job;
-            UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters& rParameters = job.GetParameters();
-            rParameters.sceneObjectCount = sceneObjectCount;
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-        }
+        UpdateGraphicsSceneObjectBuffersJobSpawner* pJob =
+            pContext->CreateContinuation< UpdateGraphicsSceneObjectBuffersJobSpawner >();
+        HELIUM_ASSERT( pJob );
+        UpdateGraphicsSceneObjectBuffersJobSpawner::Parameters& rParameters = pJob->GetParameters();
+        rParameters.sceneObjectCount = static_cast< uint32_t >( sceneObjectCount );
+        rParameters.pSceneObjects = pSceneObjects;
+        rParameters.ppConstantBufferData = ppConstantBufferData;
     }
 }
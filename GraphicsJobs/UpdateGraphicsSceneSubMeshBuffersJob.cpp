@@ -12,7 +12,7 @@ using namespace Helium;
 /// Update the instance buffer data for a set of graphics scene object sub-meshes.
 ///
 /// @param[in] pContext  Context in which this job is running.
-void UpdateGraphicsSceneSubMeshBuffersJob::Run()
+void UpdateGraphicsSceneSubMeshBuffersJob::Run( JobContext* /*pContext*/ )
 {
     const GraphicsSceneObject* pSceneObjects = m_parameters.pSceneObjects;
     HELIUM_ASSERT( pSceneObjects );
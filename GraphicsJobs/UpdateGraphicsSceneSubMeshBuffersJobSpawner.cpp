@@ -11,8 +11,10 @@ using namespace Helium;
 /// Spawn jobs to update the constant buffer data for all graphics scene object sub-meshes.
 ///
 /// @param[in] pContext  Context in which this job is running.
-void UpdateGraphicsSceneSubMeshBuffersJobSpawner::Run()
+void UpdateGraphicsSceneSubMeshBuffersJobSpawner::Run( JobContext* pContext )
 {
+    HELIUM_ASSERT( pContext );
+
     const GraphicsSceneObject::SubMeshData* pSubMeshes = m_parameters.pSubMeshes;
     float32_t* const* ppConstantBufferData = m_parameters.ppConstantBufferData;
 
@@ -27,37 +29,34 @@ void UpdateGraphicsSceneSubMeshBuffersJobSpawner::Run()
         jobCount = SUB_MESH_CHILD_JOB_MAX;
     }
 
+    for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+    {
+        uint_fast32_t jobObjectCount = Min( subMeshCount, SUB_MESH_CHILD_JOB_OBJECT_COUNT_MAX );
+        HELIUM_ASSERT( jobObjectCount != 0 );
+        subMeshCount -= jobObjectCount;
+
+        UpdateGraphicsSceneSubMeshBuffersJob* pJob = pContext->Create< UpdateGraphicsSceneSubMeshBuffersJob >();
+        HELIUM_ASSERT( pJob );
+        UpdateGraphicsSceneSubMeshBuffersJob::Parameters& rParameters = pJob->GetParameters();
+        rParameters.subMeshCount = static_cast< uint32_t >( jobObjectCount );
+        rParameters.pSubMeshes = pSubMeshes;
+        rParameters.pSceneObjects = pSceneObjects;
+        rParameters.ppConstantBufferData = ppConstantBufferData;
+
+        pSubMeshes += jobObjectCount;
+        ppConstantBufferData += jobObjectCount;
+    }
+
+    // Spawn the remaining sub-meshes from a continuation once the current batch of child jobs has completed.
+    if( subMeshCount != 0 )
     {
-        for( uint_fast32_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
-        {
-			// These were all in parallel but TBB was removed
-            uint_fast32_t jobObjectCount = Min( subMeshCount, SUB_MESH_CHILD_JOB_OBJECT_COUNT_MAX );
-            HELIUM_ASSERT( jobObjectCount != 0 );
-            subMeshCount -= jobObjectCount;
-
-			UpdateGraphicsSceneSubMeshBuffersJob job;
-            UpdateGraphicsSceneSubMeshBuffersJob::Parameters& rParameters = job.GetParameters();
-            rParameters.subMeshCount = static_cast< uint32_t >( jobObjectCount );
-            rParameters.pSubMeshes = pSubMeshes;
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-
-            pSubMeshes += jobObjectCount;
-            ppConstantBufferData += jobObjectCount;
-        }
-
-        if( subMeshCount != 0 )
-        {
-			// NOTE: This was a continuation job from above but is now inline since TBB was removed
-			UpdateGraphicsSceneSubMeshBuffersJobSpawner job;
-            UpdateGraphicsSceneSubMeshBuffersJobSpawner::Parameters& rParameters =
-                job.GetParameters();
-            rParameters.subMeshCount = subMeshCount;
-            rParameters.pSubMeshes = pSubMeshes;
-            rParameters.pSceneObjects = pSceneObjects;
-            rParameters.ppConstantBufferData = ppConstantBufferData;
-			job.Run();
-        }
+        UpdateGraphicsSceneSubMeshBuffersJobSpawner* pJob =
+            pContext->CreateContinuation< UpdateGraphicsSceneSubMeshBuffersJobSpawner >();
+        HELIUM_ASSERT( pJob );
+        UpdateGraphicsSceneSubMeshBuffersJobSpawner::Parameters& rParameters = pJob->GetParameters();
+        rParameters.subMeshCount = static_cast< uint32_t >( subMeshCount );
+        rParameters.pSubMeshes = pSubMeshes;
+        rParameters.pSceneObjects = pSceneObjects;
+        rParameters.ppConstantBufferData = ppConstantBufferData;
     }
 }
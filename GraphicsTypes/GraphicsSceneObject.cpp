@@ -34,6 +34,9 @@ void GraphicsSceneObject::SetTransform( const Simd::Matrix44& rTransform )
 
 /// Set the world-space axis-aligned bounding box for this instance.
 ///
+/// Objects owned by a GraphicsScene should have their bounds set through GraphicsScene::SetSceneObjectWorldBounds()
+/// so that the scene's culling hierarchy is kept up to date.
+///
 /// @param[in] rBox  World-space axis-aligned bounding box to set.
 ///
 /// @see GetWorldBox(), GetWorldSphere()
@@ -45,6 +48,9 @@ void GraphicsSceneObject::SetWorldBounds( const Simd::AaBox& rBox )
 
 /// Set the instance vertex information.
 ///
+/// Objects owned by a GraphicsScene should have their vertex data set through
+/// GraphicsScene::SetSceneObjectVertexData() so that cached shadow cascades are kept up to date.
+///
 /// @param[in] pVertexBuffer       Vertex buffer to set.
 /// @param[in] pVertexDescription  Vertex format description.
 /// @param[in] vertexStride        Stride between each vertex in the specified buffer, in bytes.
@@ -62,6 +68,9 @@ void GraphicsSceneObject::SetVertexData(
 
 /// Set the index buffer used for rendering.
 ///
+/// Objects owned by a GraphicsScene should have their index buffer set through
+/// GraphicsScene::SetSceneObjectIndexBuffer() so that cached shadow cascades are kept up to date.
+///
 /// @param[in] pIndexBuffer  Sub-mesh index buffer.
 ///
 /// @see GetIndexBuffer()
@@ -106,6 +115,9 @@ void GraphicsSceneObject::SetBoneData( const Simd::Matrix44* pInverseReferencePo
 
 /// Update the bone transform palette for skinned mesh rendering.
 ///
+/// Objects owned by a GraphicsScene should have their bone palette set through
+/// GraphicsScene::SetSceneObjectBonePalette() so that cached shadow cascades are kept up to date.
+///
 /// @param[in] pTransforms  Array of bone transforms.  Note that this should contain as many bones as specified in
 ///                         the most recent call to SetBoneData().
 ///
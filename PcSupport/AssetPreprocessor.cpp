@@ -21,6 +21,8 @@ AssetPreprocessor* AssetPreprocessor::sm_pInstance = NULL;
 
 /// Constructor.
 AssetPreprocessor::AssetPreprocessor()
+: m_cacheCompression( Cache::COMPRESSION_ZLIB )
+, m_cacheBatchDepth( 0 )
 {
 	MemoryZero( m_pPlatformPreprocessors, sizeof( m_pPlatformPreprocessors ) );
 }
@@ -28,6 +30,8 @@ AssetPreprocessor::AssetPreprocessor()
 /// Destructor.
 AssetPreprocessor::~AssetPreprocessor()
 {
+	HELIUM_ASSERT( m_cacheBatchDepth == 0 );
+
 	for( size_t platformIndex = 0; platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ); ++platformIndex )
 	{
 		delete m_pPlatformPreprocessors[ platformIndex ];
@@ -75,6 +79,9 @@ bool AssetPreprocessor::CacheObject(
 
 	bool bCacheFailure = false;
 
+	// Batch all cache writes for this object so that each cache's TOC is only rewritten once.
+	BeginCacheBatch();
+
 	DynamicArray< uint8_t > objectStreamBuffer;
 
 	Helium::DynamicMemoryStream directStream;
@@ -134,6 +141,8 @@ bool AssetPreprocessor::CacheObject(
 
 		bUpdatedAnyCache = true;
 
+		AddCacheToBatch( pCache );
+
 		// Prepare for writing out the property and persistent resource data for the current platform.
 		objectStreamBuffer.Resize( 0 );
 		directStream.Open( &objectStreamBuffer );
@@ -142,8 +151,10 @@ bool AssetPreprocessor::CacheObject(
 		Stream& rObjectStream =
 			( bSwapBytes ? static_cast< Stream& >( byteSwappingStream ) : static_cast< Stream& >( directStream ) );
 		
+		// Record the assets referenced by the object so that loaders can prefetch them along with the object.
 		DynamicArray<uint8_t> data_buffer;
-		Cache::WriteCacheObjectToBuffer( pObject, data_buffer);
+		DynamicArray< AssetPath > dependencies;
+		Cache::WriteCacheObjectToBuffer( pObject, data_buffer, &dependencies );
 
 		if (!data_buffer.IsEmpty())
 		{
@@ -210,7 +221,9 @@ bool AssetPreprocessor::CacheObject(
 			0,
 			objectStreamBuffer.GetData(),
 			timestamp,
-			static_cast< uint32_t >( objectDataSize ) );
+			static_cast< uint32_t >( objectDataSize ),
+			m_cacheCompression,
+			&dependencies );
 		if( !bCacheResult )
 		{
 			HELIUM_TRACE(
@@ -242,6 +255,8 @@ bool AssetPreprocessor::CacheObject(
 					HELIUM_ASSERT( pResourceCache );
 					pResourceCache->EnforceTocLoad();
 
+					AddCacheToBatch( pResourceCache );
+
 					for( size_t subDataBufferIndex = 0;
 						subDataBufferIndex < subDataBufferCount;
 						++subDataBufferIndex )
@@ -253,7 +268,8 @@ bool AssetPreprocessor::CacheObject(
 							static_cast< uint32_t >( subDataBufferIndex ),
 							rSubData.GetData(),
 							timestamp,
-							static_cast< uint32_t >( rSubData.GetSize() ) );
+							static_cast< uint32_t >( rSubData.GetSize() ),
+							m_cacheCompression );
 						if( !bCacheResult )
 						{
 							HELIUM_TRACE(
@@ -280,6 +296,16 @@ bool AssetPreprocessor::CacheObject(
 		}
 	}
 
+	if( !CommitCacheBatch() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "AssetPreprocessor: Failed to update cache TOC files for object \"%s\".\n" ),
+			*objectPath.ToString() );
+
+		bCacheFailure = true;
+	}
+
 	// Notify the object that it has been cached.
 	if( bUpdatedAnyCache )
 	{
@@ -299,6 +325,46 @@ bool AssetPreprocessor::CacheObject(
 #endif  // HELIUM_TOOLS
 }
 
+/// Begin a batch of cache writes.
+///
+/// Until the batch is committed, each cache updated through CacheObject() keeps a write transaction open so that its
+/// TOC file is rewritten only once when the batch is committed instead of after every entry.  Batches may be nested.
+///
+/// @see CommitCacheBatch(), Cache::BeginWrite()
+void AssetPreprocessor::BeginCacheBatch()
+{
+	++m_cacheBatchDepth;
+}
+
+/// Commit a batch of cache writes, rewriting the TOC files of all caches updated since the outermost batch began.
+///
+/// @return  True if all cache TOC files were written successfully (or the batch is still nested within another
+///          batch), false if not.
+///
+/// @see BeginCacheBatch(), Cache::CommitWrite()
+bool AssetPreprocessor::CommitCacheBatch()
+{
+	HELIUM_ASSERT( m_cacheBatchDepth != 0 );
+	if( --m_cacheBatchDepth != 0 )
+	{
+		return true;
+	}
+
+	bool bSuccess = true;
+
+	size_t cacheCount = m_batchCaches.GetSize();
+	for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+	{
+		Cache* pCache = m_batchCaches[ cacheIndex ];
+		HELIUM_ASSERT( pCache );
+		bSuccess &= pCache->CommitWrite();
+	}
+
+	m_batchCaches.Resize( 0 );
+
+	return bSuccess;
+}
+
 /// Load data for the specified resource into memory, preprocessing it from source data if it is out-of-date.
 ///
 /// @param[in] pResource        Resource to load.
@@ -430,6 +496,79 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 
 #if HELIUM_TOOLS
 
+/// Open a write transaction on the given cache for the current cache batch, if one is not already open.
+///
+/// @param[in] pCache  Cache about to be updated.
+void AssetPreprocessor::AddCacheToBatch( Cache* pCache )
+{
+	HELIUM_ASSERT( pCache );
+	HELIUM_ASSERT( m_cacheBatchDepth != 0 );
+
+	size_t cacheCount = m_batchCaches.GetSize();
+	for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+	{
+		if( m_batchCaches[ cacheIndex ] == pCache )
+		{
+			return;
+		}
+	}
+
+	pCache->BeginWrite();
+	m_batchCaches.Push( pCache );
+}
+
+/// Read the data for a cache entry, decompressing it if necessary.
+///
+/// @param[in]  pFileStream  Open stream for the cache file containing the entry.
+/// @param[in]  rEntry       Cache entry to read.
+/// @param[out] rData        Uncompressed entry data.
+///
+/// @return  True if the entire entry was read successfully, false if not.
+static bool ReadCacheEntryData( FileStream* pFileStream, const Cache::Entry& rEntry, DynamicArray< uint8_t >& rData )
+{
+	HELIUM_ASSERT( pFileStream );
+
+	rData.Resize( 0 );
+
+	int64_t newOffset = pFileStream->Seek( rEntry.offset, SeekOrigins::Begin );
+	if( static_cast< uint64_t >( newOffset ) != rEntry.offset )
+	{
+		return false;
+	}
+
+	Cache::ECompression compression = static_cast< Cache::ECompression >( rEntry.compression );
+	if( compression == Cache::COMPRESSION_NONE )
+	{
+		rData.Reserve( rEntry.size );
+		rData.Resize( rEntry.size );
+
+		size_t bytesRead = pFileStream->Read( rData.GetData(), 1, rEntry.size );
+
+		return ( bytesRead == rEntry.size );
+	}
+
+	DynamicArray< uint8_t > compressedData;
+	compressedData.Resize( rEntry.size );
+
+	size_t bytesRead = pFileStream->Read( compressedData.GetData(), 1, rEntry.size );
+	if( bytesRead != rEntry.size )
+	{
+		return false;
+	}
+
+	rData.Reserve( rEntry.uncompressedSize );
+	rData.Resize( rEntry.uncompressedSize );
+
+	size_t decompressedSize = Cache::DecompressData(
+		compression,
+		rData.GetData(),
+		rData.GetSize(),
+		compressedData.GetData(),
+		compressedData.GetSize() );
+
+	return ( decompressedSize == rEntry.uncompressedSize );
+}
+
 /// Load the persistent resource data for the specified resource from the object cache.
 ///
 /// @param[in]  resourcePath           FilePath of the resource object.
@@ -507,30 +646,32 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 		return Invalid< uint32_t >();
 	}
 
-	BufferedStream bufferedStream( pFileStream );
+	// Read the entire cached object data stream (decompressing it if necessary) and parse it from memory.
+	DynamicArray< uint8_t > objectData;
+	bool bReadResult = ReadCacheEntryData( pFileStream, *pCacheEntry, objectData );
+	delete pFileStream;
 
-	int64_t seekLocation = bufferedStream.Seek( pCacheEntry->offset, SeekOrigins::Begin );
-	if( static_cast< uint64_t >( seekLocation ) != pCacheEntry->offset )
+	if( !bReadResult )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
-			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Failed to seek to byte offset %" ) PRIu64
-			TXT( " in cache file \"%s\" for retrieving cached object data for \"%s\".\n" ) ),
+			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Failed to read cached object data for " )
+			TXT( "\"%s\" from byte offset %" ) PRIu64 TXT( " in cache file \"%s\".\n" ) ),
+			*resourcePath.ToString(),
 			pCacheEntry->offset,
-			*pCache->GetCacheFileName(),
-			*resourcePath.ToString() );
-
-		bufferedStream.Close();
-		delete pFileStream;
+			*pCache->GetCacheFileName() );
 
 		return Invalid< uint32_t >();
 	}
 
-	ByteSwappingStream byteSwapStream( &bufferedStream );
+	size_t objectDataSize = objectData.GetSize();
+
+	StaticMemoryStream memoryStream( objectData.GetData(), objectDataSize );
+	ByteSwappingStream byteSwapStream( &memoryStream );
 	Stream* pReadStream =
 		( pPreprocessor->SwapBytes()
 		? static_cast< Stream* >( &byteSwapStream )
-		: static_cast< Stream* >( &bufferedStream ) );
+		: static_cast< Stream* >( &memoryStream ) );
 
 	uint32_t propertyDataSize = 0;
 	size_t readCount = pReadStream->Read( &propertyDataSize, sizeof( propertyDataSize ), 1 );
@@ -543,28 +684,24 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 			*resourcePath.ToString(),
 			*pCache->GetCacheFileName() );
 
-		byteSwapStream.Close();
-		bufferedStream.Close();
-		delete pFileStream;
-
 		return Invalid< uint32_t >();
 	}
 
-	if( propertyDataSize > pCacheEntry->size - sizeof( propertyDataSize ) )
+	if( propertyDataSize > objectDataSize - sizeof( propertyDataSize ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
 			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Property data stream for \"%s\" (%" ) PRIu32
-			TXT( " bytes) extends past the end of its cached object data stream (%" ) PRIu32 TXT( " bytes).  " )
+			TXT( " bytes) extends past the end of its cached object data stream (%" ) PRIuSZ TXT( " bytes).  " )
 			TXT( "Size will be clamped.\n" ) ),
 			*resourcePath.ToString(),
 			propertyDataSize,
-			pCacheEntry->size );
+			objectDataSize );
 
-		propertyDataSize = pCacheEntry->size - sizeof( propertyDataSize );
+		propertyDataSize = static_cast< uint32_t >( objectDataSize - sizeof( propertyDataSize ) );
 	}
 
-	if( pCacheEntry->size - sizeof( propertyDataSize ) - propertyDataSize < sizeof( uint32_t ) )
+	if( objectDataSize - sizeof( propertyDataSize ) - propertyDataSize < sizeof( uint32_t ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
@@ -572,49 +709,38 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 			TXT( "large enough to provide the resource sub-data count.\n" ) ),
 			*resourcePath.ToString() );
 
-		byteSwapStream.Close();
-		bufferedStream.Close();
-		delete pFileStream;
-
 		return Invalid< uint32_t >();
 	}
 
-	uint64_t newOffset = pCacheEntry->offset + sizeof( propertyDataSize ) + propertyDataSize;
-	seekLocation = bufferedStream.Seek( newOffset, SeekOrigins::Begin );
-	if( static_cast< uint64_t >( seekLocation ) != newOffset )
+	int64_t newOffset = static_cast< int64_t >( sizeof( propertyDataSize ) + propertyDataSize );
+	int64_t seekLocation = memoryStream.Seek( newOffset, SeekOrigins::Begin );
+	if( seekLocation != newOffset )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
-			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Failed to seek to byte offset %" ) PRIu64
-			TXT( " in cache file \"%s\" for the cached persistent resource data for \"%s\".\n" ) ),
-			newOffset,
-			*pCache->GetCacheFileName(),
+			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Failed to seek to the cached persistent " )
+			TXT( "resource data for \"%s\".\n" ) ),
 			*resourcePath.ToString() );
 
-		byteSwapStream.Close();
-		bufferedStream.Close();
-		delete pFileStream;
-
 		return Invalid< uint32_t >();
 	}
 
 	size_t resourceDataStreamSize =
-		pCacheEntry->size - sizeof( propertyDataSize ) - propertyDataSize - sizeof( uint32_t );
+		objectDataSize - sizeof( propertyDataSize ) - propertyDataSize - sizeof( uint32_t );
 
 	rPersistentDataBuffer.Reserve( resourceDataStreamSize );
 	rPersistentDataBuffer.Resize( resourceDataStreamSize );
 
-	size_t bytesRead = bufferedStream.Read( rPersistentDataBuffer.GetData(), 1, resourceDataStreamSize );
+	size_t bytesRead = memoryStream.Read( rPersistentDataBuffer.GetData(), 1, resourceDataStreamSize );
 	if( bytesRead != resourceDataStreamSize )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Warning,
 			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Attempted to load %" ) PRIuSZ
-			TXT( " bytes from offset %" ) PRIu64 TXT( " in cache file \"%s\", but only %" ) PRIuSZ
+			TXT( " bytes of persistent resource data for \"%s\", but only %" ) PRIuSZ
 			TXT( " bytes could be read.\n" ) ),
 			resourceDataStreamSize,
-			newOffset,
-			*pCache->GetCacheFileName(),
+			*resourcePath.ToString(),
 			bytesRead );
 
 		rPersistentDataBuffer.Resize( bytesRead );
@@ -623,7 +749,7 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 	rPersistentDataBuffer.Trim();
 
 	uint32_t subDataCount = 0;
-	readCount = bufferedStream.Read( &subDataCount, sizeof( subDataCount ), 1 );
+	readCount = memoryStream.Read( &subDataCount, sizeof( subDataCount ), 1 );
 	if( readCount != 1 )
 	{
 		HELIUM_TRACE(
@@ -633,10 +759,6 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 			*resourcePath.ToString() );
 	}
 
-	byteSwapStream.Close();
-	bufferedStream.Close();
-	delete pFileStream;
-
 	return subDataCount;
 }
 #endif  // HELIUM_TOOLS
@@ -770,13 +892,15 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 				return false;
 			}
 
-			int64_t newOffset = pFileStream->Seek( pResourceCacheEntry->offset, SeekOrigins::Begin );
-			if( static_cast< uint64_t >( newOffset ) != pResourceCacheEntry->offset )
+			DynamicArray< uint8_t >& rSubData = rSubDataBuffers[ subDataIndex ];
+			if( !ReadCacheEntryData( pFileStream, *pResourceCacheEntry, rSubData ) )
 			{
 				HELIUM_TRACE(
 					TraceLevels::Error,
-					( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to seek to offset %" ) PRIu64
-					TXT( " in cache \"%s\" when loading sub-data %" ) PRIu32 TXT( " of resource \"%s\".\n" ) ),
+					( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to read %" ) PRIu32
+					TXT( " bytes from offset %" ) PRIu64 TXT( " in cache \"%s\" for sub-data %" ) PRIu32
+					TXT( " of resource \"%s\".\n" ) ),
+					pResourceCacheEntry->size,
 					pResourceCacheEntry->offset,
 					*resourceCacheName,
 					subDataIndex,
@@ -787,31 +911,7 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 				return false;
 			}
 
-			uint32_t subDataSize = pResourceCacheEntry->size;
-
-			DynamicArray< uint8_t >& rSubData = rSubDataBuffers[ subDataIndex ];
-			rSubData.Reserve( subDataSize );
-			rSubData.Resize( subDataSize );
 			rSubData.Trim();
-
-			size_t bytesRead = pFileStream->Read( rSubData.GetData(), 1, subDataSize );
-			if( bytesRead != subDataSize )
-			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to read %" ) PRIu32
-					TXT( " bytes from cache \"%s\" for sub-data %" ) PRIu32 TXT( " of resource \"%s\" (only %" )
-					PRIuSZ TXT( " bytes read).\n" ) ),
-					subDataSize,
-					*resourceCacheName,
-					subDataIndex,
-					*path.ToString(),
-					bytesRead );
-
-				delete pFileStream;
-
-				return false;
-			}
 		}
 
 		delete pFileStream;
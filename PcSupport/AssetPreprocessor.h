@@ -23,6 +23,12 @@ namespace Helium
         /// @name Asset Caching
         //@{
         bool CacheObject( const AssetPath &objectPath, Asset* pObject, int64_t timestamp, bool bEvictPlatformPreprocessedResourceData = true );
+
+        void BeginCacheBatch();
+        bool CommitCacheBatch();
+
+        inline void SetCacheCompression( Cache::ECompression compression );
+        inline Cache::ECompression GetCacheCompression() const;
         //@}
 
         /// @name Resource Preprocessing
@@ -41,6 +47,13 @@ namespace Helium
     private:
         /// Platform-specific preprocessing support.
         PlatformPreprocessor* m_pPlatformPreprocessors[ Cache::PLATFORM_MAX ];
+        /// Compression method used when writing object and resource sub-data cache entries.
+        Cache::ECompression m_cacheCompression;
+
+        /// Number of active (possibly nested) cache write batches.
+        uint32_t m_cacheBatchDepth;
+        /// Caches with a write transaction open for the current batch.
+        DynamicArray< Cache* > m_batchCaches;
 
         /// Singleton instance.
         static AssetPreprocessor* sm_pInstance;
@@ -54,6 +67,8 @@ namespace Helium
         /// @name Private Utility Functions
         //@{
 #if HELIUM_TOOLS
+        void AddCacheToBatch( Cache* pCache );
+
         bool LoadCachedResourceData( const AssetPath &path, Resource* pResource, Cache::EPlatform platform );
         bool PreprocessResource( const AssetPath &path, Resource* pResource, const String& rSourceFilePath );
 
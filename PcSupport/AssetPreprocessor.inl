@@ -13,4 +13,28 @@ namespace Helium
 
         return m_pPlatformPreprocessors[ platform ];
     }
+
+    /// Set the compression method used when writing cached object data and resource sub-data.
+    ///
+    /// Entries are still stored uncompressed if compression does not reduce their size.
+    ///
+    /// @param[in] compression  Compression method to use.
+    ///
+    /// @see GetCacheCompression()
+    void AssetPreprocessor::SetCacheCompression( Cache::ECompression compression )
+    {
+        HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( Cache::COMPRESSION_MAX ) );
+
+        m_cacheCompression = compression;
+    }
+
+    /// Get the compression method used when writing cached object data and resource sub-data.
+    ///
+    /// @return  Cache entry compression method.
+    ///
+    /// @see SetCacheCompression()
+    Cache::ECompression AssetPreprocessor::GetCacheCompression() const
+    {
+        return m_cacheCompression;
+    }
 }
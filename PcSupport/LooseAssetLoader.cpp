@@ -52,6 +52,25 @@ bool LooseAssetLoader::InitializeStaticInstance()
 	return true;
 }
 
+/// @copydoc AssetLoader::Tick()
+void LooseAssetLoader::Tick()
+{
+	// Objects finishing their loads this tick are cached as they complete, so batch their cache writes to rewrite each
+	// cache TOC at most once per tick.
+	AssetPreprocessor* pAssetPreprocessor = AssetPreprocessor::GetStaticInstance();
+	if( pAssetPreprocessor )
+	{
+		pAssetPreprocessor->BeginCacheBatch();
+	}
+
+	AssetLoader::Tick();
+
+	if( pAssetPreprocessor )
+	{
+		pAssetPreprocessor->CommitCacheBatch();
+	}
+}
+
 /// @copydoc AssetLoader::GetPackageLoader()
 PackageLoader* LooseAssetLoader::GetPackageLoader( AssetPath path )
 {
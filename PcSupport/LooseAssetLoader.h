@@ -26,6 +26,8 @@ namespace Helium
 		/// @name Loading Interface
 		//@{
 		virtual bool CacheObject( Asset* pObject, bool bEvictPlatformPreprocessedResourceData = true );
+
+		virtual void Tick();
 		//@}
 
 		/// @name Static Initialization
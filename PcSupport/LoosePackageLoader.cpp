@@ -6,10 +6,12 @@
 #include "Foundation/DirectoryIterator.h"
 #include "Foundation/FileStream.h"
 #include "Foundation/MemoryStream.h"
+#include "Engine/AsyncDeserializer.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/CacheManager.h"
 #include "Engine/Config.h"
 #include "Engine/AssetLoader.h"
+#include "Engine/AssetLoadProfiler.h"
 #include "Engine/Resource.h"
 #include "PcSupport/AssetPreprocessor.h"
 #include "PcSupport/ResourceHandler.h"
@@ -187,6 +189,41 @@ void LoosePackageLoader::Shutdown()
 		{
 			LoadRequest* pRequest = m_loadRequests[ requestIndex ];
 			HELIUM_ASSERT( pRequest );
+			if( IsValid( pRequest->deserializeId ) )
+			{
+				AsyncDeserializer::GetStaticInstance().SyncRequest( pRequest->deserializeId );
+				SetInvalid( pRequest->deserializeId );
+			}
+
+			// Wait for any reads into the request buffers before freeing them.
+			AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+			if( IsValid( pRequest->asyncFileLoadId ) )
+			{
+				rAsyncLoader.SyncRequest( pRequest->asyncFileLoadId );
+				SetInvalid( pRequest->asyncFileLoadId );
+			}
+
+			if( IsValid( pRequest->persistentResourceDataLoadId ) )
+			{
+				rAsyncLoader.SyncRequest( pRequest->persistentResourceDataLoadId );
+				SetInvalid( pRequest->persistentResourceDataLoadId );
+			}
+
+			DefaultAllocator().Free( pRequest->pAsyncFileLoadBuffer );
+			pRequest->pAsyncFileLoadBuffer = NULL;
+			pRequest->asyncFileLoadBufferSize = 0;
+
+			DefaultAllocator().Free( pRequest->pCachedObjectDataBuffer );
+			pRequest->pCachedObjectDataBuffer = NULL;
+			pRequest->cachedObjectDataBufferSize = 0;
+
+			pRequest->pResolver = NULL;
+			pRequest->spObject.Release();
+			pRequest->spType.Release();
+			pRequest->spTemplate.Release();
+			pRequest->spOwner.Release();
+			pRequest->spDeserializedObject.Release();
+
 			m_loadRequestPool.Release( pRequest );
 		}
 	}
@@ -340,6 +377,7 @@ size_t LoosePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 		SetInvalid( pRequest->asyncFileLoadId );
 		pRequest->pAsyncFileLoadBuffer = NULL;
 		pRequest->asyncFileLoadBufferSize = 0;
+		SetInvalid( pRequest->deserializeId );
 		pRequest->pResolver = NULL;
 		pRequest->forceReload = forceReload;
 
@@ -437,6 +475,8 @@ size_t LoosePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	SetInvalid( pRequest->asyncFileLoadId );
 	pRequest->pAsyncFileLoadBuffer = NULL;
 	pRequest->asyncFileLoadBufferSize = 0;
+	SetInvalid( pRequest->deserializeId );
+	HELIUM_ASSERT( !pRequest->spDeserializedObject );
 	pRequest->pResolver = pResolver;
 	pRequest->forceReload = forceReload;
 
@@ -534,6 +574,7 @@ bool LoosePackageLoader::TryFinishLoadObject( size_t requestId, AssetPtr& rspObj
 	pRequest->spType.Release();
 	pRequest->spTemplate.Release();
 	pRequest->spOwner.Release();
+	HELIUM_ASSERT( !pRequest->spDeserializedObject );
 
 	m_loadRequests.Remove( requestId );
 	m_loadRequestPool.Release( pRequest );
@@ -924,13 +965,20 @@ void LoosePackageLoader::TickPreload()
 	pPackage->ConditionalFinalizeLoad();
 
 	AtomicExchangeRelease( m_preloadedCounter, 1 );
+	NotifyProgress();
 
 	LooseAssetLoader::OnPackagePreloaded( this );
 }
 
 /// Update load processing of object load requests.
+///
+/// Publishing of deserialized objects is limited to the asset loader's publish time budget, which is shared with the
+/// other package loaders ticked in the same asset loader tick.  At least one object is always published, so that this
+/// loader still makes progress when ticked after the budget has run out.
 void LoosePackageLoader::TickLoadRequests()
 {
+	bool bPublishedObject = false;
+
 	size_t loadRequestCount = m_loadRequests.GetSize();
 	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestCount; ++loadRequestIndex )
 	{
@@ -942,12 +990,20 @@ void LoosePackageLoader::TickLoadRequests()
 		LoadRequest* pRequest = m_loadRequests[ loadRequestIndex ];
 		HELIUM_ASSERT( pRequest );
 
+		// Skip requests that have finished preloading but have not been claimed through TryFinishLoadObject() yet.
+		if( ( pRequest->flags & LOAD_FLAG_PRELOADED ) == LOAD_FLAG_PRELOADED )
+		{
+			continue;
+		}
+
 		if( !( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) )
 		{
-			if( !TickDeserialize( pRequest ) )
+			if( !TickDeserialize( pRequest, !bPublishedObject ) )
 			{
 				continue;
 			}
+
+			bPublishedObject = true;
 		}
 
 		//TODO: Investigate removing need to preload properties first. Probably need to have the
@@ -961,6 +1017,8 @@ void LoosePackageLoader::TickLoadRequests()
 				continue;
 			}
 		}
+
+		NotifyProgress();
 	}
 }
 
@@ -998,10 +1056,11 @@ size_t LoosePackageLoader::FindObjectByName( const Name &name ) const
 
 /// Update processing of object property preloading for a given load request.
 ///
-/// @param[in] pRequest  Load request to process.
+/// @param[in] pRequest        Load request to process.
+/// @param[in] bIgnoreBudget  True to publish the object even if the publish time budget has run out.
 ///
 /// @return  True if object property preloading for the given load request has completed, false if not.
-bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
+bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest, bool bIgnoreBudget )
 {
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) );
@@ -1011,10 +1070,26 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	HELIUM_ASSERT( pRequest->index < m_objects.GetSize() );
 	SerializedObjectData& rObjectData = m_objects[ pRequest->index ];
 
-	// Wait for the template and owner objects to load.
 	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
 	HELIUM_ASSERT( pAssetLoader );
 
+	// If the object properties are being parsed on a deserialization worker thread, wait for that to complete, then
+	// finish up on this thread as long as the current tick has time left.
+	if( IsValid( pRequest->deserializeId ) )
+	{
+		if( ( !bIgnoreBudget && !pAssetLoader->HasPublishTimeRemaining() ) ||
+			!AsyncDeserializer::GetStaticInstance().TrySyncRequest( pRequest->deserializeId ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->deserializeId );
+
+		return FinishDeserialize( pRequest, !PublishDeserializedObject( pRequest ) );
+	}
+
+	// Wait for the template and owner objects to load.
+
 	if( !rObjectData.templatePath.IsEmpty() )
 	{
 		if( IsValid( pRequest->templateLoadId ) )
@@ -1190,18 +1265,56 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	{
 		HELIUM_ASSERT( IsValid( pRequest->asyncFileLoadId ) );
 
-		if ( !rAsyncLoader.TrySyncRequest( pRequest->asyncFileLoadId, bytesRead ) )
+		AsyncLoader::RequestTiming timing;
+		if ( !rAsyncLoader.TrySyncRequest( pRequest->asyncFileLoadId, bytesRead, &timing ) )
 		{
 			return false;
 		}
+
+		AssetLoadProfiler& rProfiler = AssetLoadProfiler::GetStaticInstance();
+		rProfiler.MarkStage( rObjectData.objectPath, AssetLoadProfiler::STAGE_IO_BEGIN, timing.startTime );
+		rProfiler.MarkStage( rObjectData.objectPath, AssetLoadProfiler::STAGE_IO_END, timing.endTime );
+		if ( IsValid( bytesRead ) )
+		{
+			rProfiler.AddIoBytes( rObjectData.objectPath, bytesRead );
+		}
 	}
 
-	/////// POINT OF NO RETURN: We *will* return true after this point, and the object *will* be finished preloading,
-	/////// for good or for bad.
+	/////// POINT OF NO RETURN: The object *will* be finished preloading after this point, for good or for bad (once
+	/////// its properties have been parsed on a deserialization worker thread, if there are any to parse).
 
 	SetInvalid(pRequest->asyncFileLoadId);
 	bool object_creation_failure = false;
 
+	// Make sure the object file was read in full before parsing it.
+	bool parse_object_file = false;
+	if (load_properties_from_file)
+	{
+		HELIUM_ASSERT( bytesRead == pRequest->asyncFileLoadBufferSize );
+		if( IsInvalid( bytesRead ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "LoosePackageLoader: Failed to read the contents of object file \"%s\" in async load request \"%d\".\n" ),
+				object_file_path.c_str(),
+				pRequest->asyncFileLoadId );
+		}
+		else if( bytesRead != pRequest->asyncFileLoadBufferSize )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				( TXT( "LoosePackageLoader: Attempted to read %" ) PRIuSZ TXT( " bytes from object file \"%s\", " )
+				TXT( "but only %" ) PRIuSZ TXT( " bytes were read.\n" ) ),
+				pRequest->asyncFileLoadBufferSize,
+				object_file_path.c_str(),
+				bytesRead );
+		}
+		else
+		{
+			parse_object_file = true;
+		}
+	}
+
 	// If we already had an existing object, make sure the type and template match.
 	if( pObject )
 	{
@@ -1223,7 +1336,7 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 			object_creation_failure = true;
 		}
 	}
-	else
+	else if (!parse_object_file)
 	{
 		bool bCreateResult = false;
 		if (pRequest->forceReload)
@@ -1261,46 +1374,60 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 		HELIUM_ASSERT( pObject );
 	}
 
-	if (load_properties_from_file && !object_creation_failure)
+	if (parse_object_file && !object_creation_failure)
 	{
-		// Sanity checks for file load, then success path
-		HELIUM_ASSERT( bytesRead == pRequest->asyncFileLoadBufferSize );
-		if( IsInvalid( bytesRead ) )
+		// Parse the object properties on a deserialization worker thread into a detached instance with no name or
+		// owner, so nothing can find it through the asset registry while it is being written.  The object is
+		// published on this thread by PublishDeserializedObject() once parsing completes.
+		HELIUM_ASSERT( !pRequest->spDeserializedObject );
+		if( !Asset::CreateObject( pRequest->spDeserializedObject, pType, Name( NULL_NAME ), NULL, pTemplate ) )
 		{
 			HELIUM_TRACE(
 				TraceLevels::Error,
-				TXT( "LoosePackageLoader: Failed to read the contents of object file \"%s\" in async load request \"%d\".\n" ),
-				object_file_path.c_str(),
-				pRequest->asyncFileLoadId );
-		}
-		else if( bytesRead != pRequest->asyncFileLoadBufferSize )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Warning,
-				( TXT( "LoosePackageLoader: Attempted to read %" ) PRIuSZ TXT( " bytes from object file \"%s\", " )
-				TXT( "but only %" ) PRIuSZ TXT( " bytes were read.\n" ) ),
-				pRequest->asyncFileLoadBufferSize,
-				object_file_path.c_str(),
-				bytesRead );
+				TXT( "LoosePackageLoader: Failed to create \"%s\" during loading.\n" ),
+				*rObjectData.objectPath.ToString() );
+
+			object_creation_failure = true;
 		}
 		else
 		{
-			StaticMemoryStream archiveStream ( pRequest->pAsyncFileLoadBuffer, pRequest->asyncFileLoadBufferSize );
-
 			HELIUM_TRACE(
 				TraceLevels::Info,
 				TXT( "LoosePackageLoader: Reading %s. pResolver = %x\n"), 
 				object_file_path.c_str(),
 				pRequest->pResolver);
 
-			DynamicArray< Reflect::ObjectPtr > objects;
-			objects.Push( pRequest->spObject.Get() ); // use existing objects
-			Persist::ArchiveReaderJson::ReadFromStream( archiveStream, objects, pRequest->pResolver );
-			HELIUM_ASSERT( objects[0].Get() == pRequest->spObject.Get() );
+			pRequest->deserializedObjectPath = rObjectData.objectPath;
+			pRequest->deserializeId = AsyncDeserializer::GetStaticInstance().QueueRequest(
+				DeserializeObjectFile,
+				pRequest );
+			HELIUM_ASSERT( IsValid( pRequest->deserializeId ) );
+
+			return false;
 		}
 	}
 
-	if (load_properties_from_file)
+	return FinishDeserialize( pRequest, object_creation_failure );
+}
+
+/// Finish property preloading for a given load request once its object file has been parsed (or if no parsing was
+/// necessary), and begin loading of any persistent resource data.
+///
+/// @param[in] pRequest                Load request to process.
+/// @param[in] bObjectCreationFailure  True if the object could not be created.
+///
+/// @return  True (property preloading is always complete once this is called).
+bool LoosePackageLoader::FinishDeserialize( LoadRequest* pRequest, bool bObjectCreationFailure )
+{
+	HELIUM_ASSERT( pRequest );
+
+	HELIUM_ASSERT( pRequest->index < m_objects.GetSize() );
+	SerializedObjectData& rObjectData = m_objects[ pRequest->index ];
+
+	Asset* pObject = pRequest->spObject;
+	HELIUM_ASSERT( pObject || bObjectCreationFailure );
+
+	if( pRequest->pAsyncFileLoadBuffer )
 	{
 		DefaultAllocator().Free(pRequest->pAsyncFileLoadBuffer);
 		pRequest->pAsyncFileLoadBuffer = NULL;
@@ -1309,15 +1436,18 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 
 	pRequest->flags |= LOAD_FLAG_PROPERTY_PRELOADED;
 
-	if( object_creation_failure )
+	if( bObjectCreationFailure )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
 			TXT( "LoosePackageLoader: Deserialization of object \"%s\" failed.\n" ),
 			*rObjectData.objectPath.ToString() );
 		
-		pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
-		pObject->ConditionalFinalizeLoad();
+		if( pObject )
+		{
+			pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
+			pObject->ConditionalFinalizeLoad();
+		}
 
 		pRequest->flags |= LOAD_FLAG_ERROR;
 	}
@@ -1336,22 +1466,20 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 			pCache->EnforceTocLoad();
 
 			const Cache::Entry* pEntry = pCache->FindEntry( rObjectData.objectPath, 0 );
-			if( pEntry && pEntry->size != 0 )
+			if( pEntry && pEntry->uncompressedSize != 0 )
 			{
 				HELIUM_ASSERT( IsInvalid( pRequest->persistentResourceDataLoadId ) );
 				HELIUM_ASSERT( !pRequest->pCachedObjectDataBuffer );
 
 				pRequest->pCachedObjectDataBuffer =
-					static_cast< uint8_t* >( DefaultAllocator().Allocate( pEntry->size ) );
+					static_cast< uint8_t* >( DefaultAllocator().Allocate( pEntry->uncompressedSize ) );
 				HELIUM_ASSERT( pRequest->pCachedObjectDataBuffer );
-				pRequest->cachedObjectDataBufferSize = pEntry->size;
+				pRequest->cachedObjectDataBufferSize = pEntry->uncompressedSize;
 
-				AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
-				pRequest->persistentResourceDataLoadId = rAsyncLoader.QueueRequest(
+				pRequest->persistentResourceDataLoadId = pCache->BeginLoadEntry(
+					*pEntry,
 					pRequest->pCachedObjectDataBuffer,
-					pCache->GetCacheFileName(),
-					pEntry->offset,
-					pEntry->size );
+					pEntry->uncompressedSize );
 				HELIUM_ASSERT( IsValid( pRequest->persistentResourceDataLoadId ) );
 			}
 		}
@@ -1360,7 +1488,11 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	if( IsInvalid( pRequest->persistentResourceDataLoadId ) )
 	{
 		// No persistent resource data needs to be loaded.
-		pObject->SetFlags( Asset::FLAG_PRELOADED );
+		if( pObject )
+		{
+			pObject->SetFlags( Asset::FLAG_PRELOADED );
+		}
+
 		pRequest->flags |= LOAD_FLAG_PERSISTENT_RESOURCE_PRELOADED;
 	}
 
@@ -1368,6 +1500,82 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	return true;
 }
 
+/// Publish an object parsed on a deserialization worker thread.
+///
+/// If an existing object is being loaded, the parsed properties are copied onto it.  Otherwise, the detached instance
+/// becomes the loaded object and is given its name and owner (unless it is being force-reloaded, in which case it is
+/// left unnamed just like objects created directly for force-reloading).
+///
+/// @param[in] pRequest  Load request to process.
+///
+/// @return  True if the object was published successfully, false if not.
+bool LoosePackageLoader::PublishDeserializedObject( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	AssetPtr spDeserializedObject = pRequest->spDeserializedObject;
+	HELIUM_ASSERT( spDeserializedObject );
+	pRequest->spDeserializedObject.Release();
+
+	Asset* pObject = pRequest->spObject;
+	if( pObject )
+	{
+		spDeserializedObject->CopyTo( pObject );
+
+		return true;
+	}
+
+	pRequest->spObject = spDeserializedObject;
+	if( pRequest->forceReload )
+	{
+		return true;
+	}
+
+	HELIUM_ASSERT( pRequest->index < m_objects.GetSize() );
+	const SerializedObjectData& rObjectData = m_objects[ pRequest->index ];
+
+	Asset::RenameParameters params;
+	params.name = rObjectData.objectPath.GetName();
+	params.spOwner = pRequest->spOwner;
+	if( !spDeserializedObject->Rename( params ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "LoosePackageLoader: Failed to name \"%s\" after loading it.\n" ),
+			*rObjectData.objectPath.ToString() );
+
+		return false;
+	}
+
+	return true;
+}
+
+/// Parse the object file of a load request into its detached object instance.
+///
+/// This is run on an AsyncDeserializer worker thread once the object file has been read and the detached instance
+/// has been created.
+///
+/// @param[in] pData  Load request.
+void LoosePackageLoader::DeserializeObjectFile( void* pData )
+{
+	LoadRequest* pRequest = static_cast< LoadRequest* >( pData );
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->pAsyncFileLoadBuffer );
+	HELIUM_ASSERT( pRequest->spDeserializedObject );
+
+	AssetLoadProfiler& rProfiler = AssetLoadProfiler::GetStaticInstance();
+	rProfiler.MarkStage( pRequest->deserializedObjectPath, AssetLoadProfiler::STAGE_DESERIALIZE_BEGIN );
+
+	StaticMemoryStream archiveStream ( pRequest->pAsyncFileLoadBuffer, pRequest->asyncFileLoadBufferSize );
+
+	DynamicArray< Reflect::ObjectPtr > objects;
+	objects.Push( pRequest->spDeserializedObject.Get() ); // use existing objects
+	Persist::ArchiveReaderJson::ReadFromStream( archiveStream, objects, pRequest->pResolver );
+	HELIUM_ASSERT( objects[0].Get() == pRequest->spDeserializedObject.Get() );
+
+	rProfiler.MarkStage( pRequest->deserializedObjectPath, AssetLoadProfiler::STAGE_DESERIALIZE_END );
+}
+
 /// Update processing of persistent resource data loading for a given load request.
 ///
 /// @param[in] pRequest  Load request to process.
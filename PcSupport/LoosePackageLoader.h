@@ -130,6 +130,13 @@ namespace Helium
 			void* pAsyncFileLoadBuffer;
 			size_t asyncFileLoadBufferSize;
 
+			/// Async deserialization request ID for parsing the object file.
+			size_t deserializeId;
+			/// Detached instance (with no name or owner) into which the object file is parsed.
+			AssetPtr spDeserializedObject;
+			/// Path of the object being parsed.
+			AssetPath deserializedObjectPath;
+
 			/// Load flags.
 			uint32_t flags;
 
@@ -183,8 +190,12 @@ namespace Helium
 		void TickPreload();
 
 		void TickLoadRequests();
-		bool TickDeserialize( LoadRequest* pRequest );
+		bool TickDeserialize( LoadRequest* pRequest, bool bIgnoreBudget );
+		bool PublishDeserializedObject( LoadRequest* pRequest );
+		bool FinishDeserialize( LoadRequest* pRequest, bool bObjectCreationFailure );
 		bool TickPersistentResourcePreload( LoadRequest* pRequest );
+
+		static void DeserializeObjectFile( void* pData );
 		//@}
 
 		size_t FindObjectByPath( const AssetPath &path ) const;
@@ -22,6 +22,8 @@ project( prefix .. "Engine" )
 			prefix .. "Persist",
 			prefix .. "Math",
 			prefix .. "MathSimd",
+
+			"zlib",
 		}
 
 project( prefix .. "EngineJobs" )
@@ -389,6 +391,49 @@ project( prefix .. "Framework" )
 			prefix .. "MathSimd",
 		}
 
+project( prefix .. "FrameworkTests" )
+
+	kind "ConsoleApp"
+
+	Helium.DoBasicProjectSettings()
+
+	files
+	{
+		"Framework/Tests/*.cpp",
+	}
+
+	defines
+	{
+		"HELIUM_MODULE=FrameworkTests",
+	}
+
+	links
+	{
+		prefix .. "Framework",
+		prefix .. "EngineJobs",
+		prefix .. "Engine",
+
+		-- core
+		prefix .. "MathSimd",
+		prefix .. "Math",
+		prefix .. "Persist",
+		prefix .. "Reflect",
+		prefix .. "Foundation",
+		prefix .. "Platform",
+	}
+
+	configuration "linux"
+		links
+		{
+			"pthread",
+			"dl",
+			"rt",
+			"m",
+			"stdc++",
+		}
+
+	configuration {}
+
 project( prefix .. "FrameworkImpl" )
 
 	Helium.DoModuleProjectSettings( ".", "HELIUM", "FrameworkImpl", "FRAMEWORK_IMPL" )
@@ -558,6 +603,7 @@ project( prefix .. "ExampleGame" )
 
 			"ois",
 			"mongo-c",
+			"zlib",
 		}
 
 project( prefix .. "ExampleMain_PhysicsDemo" )
@@ -642,6 +688,7 @@ project( prefix .. "EmptyGame" )
 
 			"ois",
 			"mongo-c",
+			"zlib",
 		}
 
 project( prefix .. "EmptyMain" )
@@ -748,6 +795,7 @@ project( prefix .. "EmptyMain" )
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	configuration "linux"